@@ -11,6 +11,8 @@
 #include <rte_per_lcore.h>
 #include <rte_lcore.h>
 #include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
 
 #define	PRINT_USAGE_START	"%s [EAL options] --\n"
 
@@ -41,6 +43,7 @@
 #define	OPT_ITER_NUM		"iter"
 #define	OPT_VERBOSE		"verbose"
 #define	OPT_IPV6		"ipv6"
+#define	OPT_CHURN		"churn"
 
 #define	TRACE_DEFAULT_NUM	0x10000
 #define	TRACE_STEP_MAX		0x1000
@@ -113,10 +116,15 @@ static struct {
 	uint32_t            iter_num;
 	uint32_t            verbose;
 	uint32_t            ipv6;
+	uint32_t            churn;
 	struct acl_alg      alg;
 	uint32_t            used_traces;
 	void               *traces;
 	struct rte_acl_ctx *acx;
+	uint32_t            nb_churn_rules;
+	uint8_t            *churn_rules;
+	struct rte_rcu_qsbr *rcu;
+	RTE_ATOMIC(uint32_t) nb_searching;
 } config = {
 	.bld_categories = 3,
 	.run_categories = 1,
@@ -950,8 +958,18 @@ add_cb_rules(FILE *f, struct rte_acl_ctx *ctx)
 				i, rc, strerror(-rc));
 			return rc;
 		}
+
+		/* keep a copy of the last rules to delete and add back. */
+		if (config.churn != 0) {
+			memcpy(config.churn_rules +
+				(config.nb_churn_rules % config.churn) *
+				prm.rule_size, &v, prm.rule_size);
+			config.nb_churn_rules++;
+		}
 	}
 
+	config.nb_churn_rules = RTE_MIN(config.nb_churn_rules, config.churn);
+
 	return 0;
 }
 
@@ -986,6 +1004,13 @@ acx_init(void)
 	if (config.acx == NULL)
 		rte_exit(rte_errno, "failed to create ACL context\n");
 
+	if (config.churn != 0) {
+		config.churn_rules = rte_malloc(NULL,
+			(size_t)config.churn * prm.rule_size, 0);
+		if (config.churn_rules == NULL)
+			rte_exit(-ENOMEM, "failed to allocate churn rules\n");
+	}
+
 	/* set default classify method for this context. */
 	if (config.alg.alg != RTE_ACL_CLASSIFY_DEFAULT) {
 		ret = rte_acl_set_ctx_classify(config.acx, config.alg.alg);
@@ -1019,6 +1044,32 @@ acx_init(void)
 		rte_exit(ret, "failed to build search context\n");
 }
 
+static void
+acx_incr_init(void)
+{
+	struct rte_acl_incr_config cfg;
+	size_t sz;
+	int ret;
+
+	if (rte_lcore_count() < 2)
+		rte_exit(-EINVAL, "%s requires at least one worker lcore\n",
+			OPT_CHURN);
+
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	config.rcu = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (config.rcu == NULL)
+		rte_exit(-ENOMEM, "failed to allocate RCU QSBR variable\n");
+	rte_rcu_qsbr_init(config.rcu, RTE_MAX_LCORE);
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.v = config.rcu;
+	cfg.mode = RTE_ACL_QSBR_MODE_DQ;
+
+	ret = rte_acl_incr_enable(config.acx, &cfg);
+	if (ret != 0)
+		rte_exit(ret, "failed to enable incremental mode\n");
+}
+
 static uint32_t
 search_ip5tuples_once(uint32_t categories, uint32_t step, const char *alg)
 {
@@ -1044,6 +1095,9 @@ search_ip5tuples_once(uint32_t categories, uint32_t step, const char *alg)
 			rte_exit(ret, "classify for ipv%c_5tuples returns %d\n",
 				config.ipv6 ? '6' : '4', ret);
 
+		if (config.rcu != NULL)
+			rte_rcu_qsbr_quiescent(config.rcu, rte_lcore_id());
+
 		for (r = 0, j = 0; j != n; j++) {
 			for (k = 0; k != categories; k++, r++) {
 				dump_verbose(DUMP_PKT, stdout,
@@ -1070,6 +1124,12 @@ search_ip5tuples(__rte_unused void *arg)
 	long double st;
 
 	lcore = rte_lcore_id();
+
+	if (config.rcu != NULL) {
+		rte_rcu_qsbr_thread_register(config.rcu, lcore);
+		rte_rcu_qsbr_thread_online(config.rcu, lcore);
+	}
+
 	start = rte_rdtsc_precise();
 	pkt = 0;
 
@@ -1080,6 +1140,13 @@ search_ip5tuples(__rte_unused void *arg)
 
 	tm = rte_rdtsc_precise() - start;
 
+	if (config.rcu != NULL) {
+		rte_rcu_qsbr_thread_offline(config.rcu, lcore);
+		rte_rcu_qsbr_thread_unregister(config.rcu, lcore);
+		rte_atomic_fetch_sub_explicit(&config.nb_searching, 1,
+			rte_memory_order_release);
+	}
+
 	st = (long double)tm / rte_get_timer_hz();
 	dump_verbose(DUMP_NONE, stdout,
 		"%s  @lcore %u: %" PRIu32 " iterations, %" PRIu64 " pkts, %"
@@ -1092,6 +1159,99 @@ search_ip5tuples(__rte_unused void *arg)
 	return 0;
 }
 
+struct churn_stat {
+	uint64_t num;
+	uint64_t cycles;
+	uint64_t max;
+};
+
+static void
+churn_stat_update(struct churn_stat *st, uint64_t start)
+{
+	uint64_t tm;
+
+	tm = rte_rdtsc_precise() - start;
+	st->num++;
+	st->cycles += tm;
+	st->max = RTE_MAX(st->max, tm);
+}
+
+static void
+churn_stat_dump(const char *name, const struct churn_stat *st)
+{
+	dump_verbose(DUMP_NONE, stdout,
+		"%s: %" PRIu64 " updates, %.2Lf cycles/update avg, "
+		"%" PRIu64 " cycles max\n",
+		name, st->num,
+		(st->num == 0) ? 0 : (long double)st->cycles / st->num,
+		st->max);
+}
+
+/*
+ * Delete the churn rules, add them back one by one and merge them into
+ * the main trie, until all the worker lcores are done with the search.
+ */
+static void
+churn_acl_rules(void)
+{
+	struct churn_stat add, del, merge;
+	const struct rte_acl_rule *r;
+	uint32_t i, *userdata;
+	uint64_t start;
+	int ret;
+
+	userdata = rte_malloc(NULL,
+		config.nb_churn_rules * sizeof(userdata[0]), 0);
+	if (userdata == NULL)
+		rte_exit(-ENOMEM, "failed to allocate churn userdata\n");
+
+	for (i = 0; i != config.nb_churn_rules; i++) {
+		r = (const struct rte_acl_rule *)(config.churn_rules +
+			i * prm.rule_size);
+		userdata[i] = r->data.userdata;
+	}
+
+	memset(&add, 0, sizeof(add));
+	memset(&del, 0, sizeof(del));
+	memset(&merge, 0, sizeof(merge));
+
+	while (rte_atomic_load_explicit(&config.nb_searching,
+			rte_memory_order_acquire) != 0) {
+
+		start = rte_rdtsc_precise();
+		ret = rte_acl_incr_del_rules(config.acx, userdata,
+			config.nb_churn_rules);
+		if (ret != 0)
+			rte_exit(ret, "failed to delete rules\n");
+		churn_stat_update(&del, start);
+
+		for (i = 0; i != config.nb_churn_rules; i++) {
+			r = (const struct rte_acl_rule *)(config.churn_rules +
+				i * prm.rule_size);
+			start = rte_rdtsc_precise();
+			ret = rte_acl_incr_add_rules(config.acx, r, 1);
+			if (ret != 0)
+				rte_exit(ret, "failed to add rule\n");
+			churn_stat_update(&add, start);
+		}
+
+		start = rte_rdtsc_precise();
+		ret = rte_acl_incr_merge(config.acx);
+		if (ret != 0)
+			rte_exit(ret, "failed to merge rules\n");
+		churn_stat_update(&merge, start);
+	}
+
+	dump_verbose(DUMP_NONE, stdout,
+		"%s: %u rules, %" PRIu64 " cycles/sec\n", __func__,
+		config.nb_churn_rules, rte_get_timer_hz());
+	churn_stat_dump("rte_acl_incr_add_rules(1)", &add);
+	churn_stat_dump("rte_acl_incr_del_rules(all)", &del);
+	churn_stat_dump("rte_acl_incr_merge", &merge);
+
+	rte_free(userdata);
+}
+
 static unsigned long
 get_ulong_opt(const char *opt, const char *name, size_t min, size_t max)
 {
@@ -1194,7 +1354,11 @@ print_usage(const char *prgname)
 		"[--" OPT_ITER_NUM "=<number of iterations to perform>]\n"
 		"[--" OPT_VERBOSE "=<verbose level>]\n"
 		"[--" OPT_SEARCH_ALG "=%s]\n"
-		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n",
+		"[--" OPT_IPV6 "(=4B | 8B) <IPv6 rules and trace files>]\n"
+		"[--" OPT_CHURN
+			"=<number of rules to delete and add back "
+			"in incremental mode on the main lcore, "
+			"while the worker lcores classify>]\n",
 		prgname, RTE_ACL_RESULTS_MULTIPLIER,
 		(uint32_t)RTE_ACL_MAX_CATEGORIES,
 		buf);
@@ -1217,6 +1381,7 @@ dump_config(FILE *f)
 	fprintf(f, "%s:%u(%s)\n", OPT_SEARCH_ALG, config.alg.alg,
 		config.alg.name);
 	fprintf(f, "%s:%u\n", OPT_IPV6, config.ipv6);
+	fprintf(f, "%s:%u\n", OPT_CHURN, config.churn);
 }
 
 static void
@@ -1246,6 +1411,7 @@ get_input_opts(int argc, char **argv)
 		{OPT_VERBOSE, 1, 0, 0},
 		{OPT_SEARCH_ALG, 1, 0, 0},
 		{OPT_IPV6, 2, 0, 0},
+		{OPT_CHURN, 1, 0, 0},
 		{NULL, 0, 0, 0}
 	};
 
@@ -1297,6 +1463,9 @@ get_input_opts(int argc, char **argv)
 			config.ipv6 = IPV6_FRMT_U32;
 			if (optarg != NULL)
 				get_ipv6_opt(optarg, lgopts[opt_idx].name);
+		} else if (strcmp(lgopts[opt_idx].name, OPT_CHURN) == 0) {
+			config.churn = get_ulong_opt(optarg,
+				lgopts[opt_idx].name, 1, RTE_ACL_MAX_INDEX + 1);
 		}
 	}
 	config.trace_sz = config.ipv6 ? sizeof(struct ipv6_5tuple) :
@@ -1325,16 +1494,29 @@ main(int argc, char **argv)
 
 	acx_init();
 
+	if (config.churn != 0)
+		acx_incr_init();
+
 	if (config.trace_file != NULL)
 		tracef_init();
 
+	if (config.churn != 0)
+		rte_atomic_store_explicit(&config.nb_searching,
+			rte_lcore_count() - 1, rte_memory_order_relaxed);
+
 	RTE_LCORE_FOREACH_WORKER(lcore)
 		 rte_eal_remote_launch(search_ip5tuples, NULL, lcore);
 
-	search_ip5tuples(NULL);
+	/* with churn, the main lcore updates the rules instead */
+	if (config.churn != 0)
+		churn_acl_rules();
+	else
+		search_ip5tuples(NULL);
 
 	rte_eal_mp_wait_lcore();
 
 	rte_acl_free(config.acx);
+	rte_free(config.churn_rules);
+	rte_free(config.rcu);
 	return 0;
 }
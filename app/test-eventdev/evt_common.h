@@ -63,6 +63,7 @@ struct evt_options {
 	uint8_t timdev_cnt;
 	uint8_t nb_timer_adptrs;
 	uint8_t timdev_use_burst;
+	uint8_t timdev_use_wheel;
 	uint8_t per_port_pool;
 	uint8_t preschedule;
 	uint8_t preschedule_opted;
@@ -38,6 +38,7 @@
 #define EVT_PROD_DMADEV          ("prod_type_dmadev")
 #define EVT_PROD_TIMERDEV        ("prod_type_timerdev")
 #define EVT_PROD_TIMERDEV_BURST  ("prod_type_timerdev_burst")
+#define EVT_TIMDEV_WHEEL         ("timdev_wheel")
 #define EVT_DMA_ADPTR_MODE       ("dma_adptr_mode")
 #define EVT_CRYPTO_ADPTR_MODE	 ("crypto_adptr_mode")
 #define EVT_CRYPTO_OP_TYPE	 ("crypto_op_type")
@@ -294,6 +295,8 @@ evt_dump_producer_type(struct evt_options *opt)
 		else
 			snprintf(name, EVT_PROD_MAX_NAME_LEN,
 				"Event timer adapter producer");
+		if (opt->timdev_use_wheel)
+			evt_dump("timer_engine", "%s", "wheel");
 		evt_dump("nb_timer_adapters", "%d", opt->nb_timer_adptrs);
 		evt_dump("max_tmo_nsec", "%"PRIu64"", opt->max_tmo_nsec);
 		evt_dump("expiry_nsec", "%"PRIu64"", opt->expiry_nsec);
@@ -250,6 +250,9 @@ static void cmd_help_long_parsed(void *parsed_result,
 
 			"show port (port_id) rxq|txq (queue_id) desc used count\n"
 			"    Show current number of used descriptor count for rx|tx.\n\n"
+			"show port (port_id) rxq balance\n"
+			"    Show the share of the packets received on each Rx queue,"
+			" and the cost per packet of the software RSS.\n\n"
 
 			"show port (port_id) macs|mcast_macs"
 			"       Display list of mac addresses added to port.\n\n"
@@ -13355,6 +13358,114 @@ static cmdline_parse_inst_t cmd_show_rx_tx_queue_desc_used_count = {
 	},
 };
 
+/* *** display the balance of the packets received on the Rx queues *** */
+struct cmd_show_port_rxq_balance_result {
+	cmdline_fixed_string_t show;
+	cmdline_fixed_string_t port;
+	portid_t port_id;
+	cmdline_fixed_string_t rxq;
+	cmdline_fixed_string_t balance;
+};
+
+static void
+cmd_show_port_rxq_balance_parsed(void *parsed_result,
+				 __rte_unused struct cmdline *cl,
+				 __rte_unused void *data)
+{
+	struct cmd_show_port_rxq_balance_result *res = parsed_result;
+	uint64_t total = 0, max = 0, min = UINT64_MAX;
+	uint64_t packets, cycles;
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_stats stats;
+	uint64_t ids[2];
+	uint16_t nb_rxq, q;
+	double avg;
+	int ret;
+
+	if (port_id_is_invalid(res->port_id, ENABLED_WARN))
+		return;
+
+	ret = eth_dev_info_get_print_err(res->port_id, &dev_info);
+	if (ret != 0)
+		return;
+
+	ret = rte_eth_stats_get(res->port_id, &stats);
+	if (ret != 0) {
+		fprintf(stderr, "Failed to get stats of port %u: %s\n",
+			res->port_id, rte_strerror(-ret));
+		return;
+	}
+
+	nb_rxq = RTE_MIN(dev_info.nb_rx_queues,
+			 (uint16_t)RTE_ETHDEV_QUEUE_STAT_CNTRS);
+	if (nb_rxq == 0) {
+		fprintf(stderr, "No Rx queue configured on port %u\n",
+			res->port_id);
+		return;
+	}
+
+	for (q = 0; q < nb_rxq; q++) {
+		total += stats.q_ipackets[q];
+		max = RTE_MAX(max, stats.q_ipackets[q]);
+		min = RTE_MIN(min, stats.q_ipackets[q]);
+	}
+
+	printf("Rx queue balance of port %u (%s):\n", res->port_id,
+	       dev_info.driver_name);
+	for (q = 0; q < nb_rxq; q++)
+		printf("  RX-queue %2u: %14"PRIu64" packets  %6.2f%%\n", q,
+		       stats.q_ipackets[q],
+		       total != 0 ? 100.0 * stats.q_ipackets[q] / total : 0.0);
+
+	/* spread of the busiest and idlest queues around the average */
+	avg = (double)total / nb_rxq;
+	if (total != 0)
+		printf("  Imbalance: max %+.2f%%, min %+.2f%% of the average\n",
+		       100.0 * (max - avg) / avg, 100.0 * (min - avg) / avg);
+
+	/* cost of the software RSS, for the drivers providing it */
+	if (rte_eth_xstats_get_id_by_name(res->port_id, "sw_rss_packets",
+					  &ids[0]) != 0 ||
+	    rte_eth_xstats_get_id_by_name(res->port_id, "sw_rss_cycles",
+					  &ids[1]) != 0)
+		return;
+	if (rte_eth_xstats_get_by_id(res->port_id, &ids[0], &packets, 1) != 1 ||
+	    rte_eth_xstats_get_by_id(res->port_id, &ids[1], &cycles, 1) != 1)
+		return;
+	if (packets != 0)
+		printf("  Software RSS: %"PRIu64" packets, %.1f cycles/packet\n",
+		       packets, (double)cycles / packets);
+}
+
+static cmdline_parse_token_string_t cmd_show_port_rxq_balance_show =
+	TOKEN_STRING_INITIALIZER
+		(struct cmd_show_port_rxq_balance_result, show, "show");
+static cmdline_parse_token_string_t cmd_show_port_rxq_balance_port =
+	TOKEN_STRING_INITIALIZER
+		(struct cmd_show_port_rxq_balance_result, port, "port");
+static cmdline_parse_token_num_t cmd_show_port_rxq_balance_port_id =
+	TOKEN_NUM_INITIALIZER
+		(struct cmd_show_port_rxq_balance_result, port_id, RTE_UINT16);
+static cmdline_parse_token_string_t cmd_show_port_rxq_balance_rxq =
+	TOKEN_STRING_INITIALIZER
+		(struct cmd_show_port_rxq_balance_result, rxq, "rxq");
+static cmdline_parse_token_string_t cmd_show_port_rxq_balance_balance =
+	TOKEN_STRING_INITIALIZER
+		(struct cmd_show_port_rxq_balance_result, balance, "balance");
+static cmdline_parse_inst_t cmd_show_port_rxq_balance = {
+	.f = cmd_show_port_rxq_balance_parsed,
+	.data = NULL,
+	.help_str = "show port <port_id> rxq balance",
+	.tokens = {
+		(void *)&cmd_show_port_rxq_balance_show,
+		(void *)&cmd_show_port_rxq_balance_port,
+		(void *)&cmd_show_port_rxq_balance_port_id,
+		(void *)&cmd_show_port_rxq_balance_rxq,
+		(void *)&cmd_show_port_rxq_balance_balance,
+		NULL,
+	},
+};
+
 /* Common result structure for set port ptypes */
 struct cmd_set_port_ptypes_result {
 	cmdline_fixed_string_t set;
@@ -13927,6 +14038,7 @@ static cmdline_parse_ctx_t builtin_ctx[] = {
 	&cmd_show_tx_metadata,
 	&cmd_show_rx_tx_desc_status,
 	&cmd_show_rx_tx_queue_desc_used_count,
+	&cmd_show_port_rxq_balance,
 	&cmd_set_raw,
 	&cmd_show_set_raw,
 	&cmd_show_set_raw_all,
@@ -1609,6 +1609,140 @@ test_misc(void)
 	return 0;
 }
 
+static int
+test_incr_add_rules(struct rte_acl_ctx *acx,
+	const struct rte_acl_ipv4vlan_rule *rules, uint32_t num)
+{
+	struct acl_ipv4vlan_rule rv;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i != num; i++) {
+		acl_ipv4vlan_convert_rule(rules + i, &rv);
+		ret = rte_acl_incr_add_rules(acx, (struct rte_acl_rule *)&rv, 1);
+		if (ret != 0) {
+			printf("Line %i: Adding rule #%u to ACL context "
+				"in incremental mode failed: %d\n",
+				__LINE__, i, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Test ACL lookup while rules are added to and deleted from
+ * a context in incremental mode.
+ */
+static int
+test_incremental(void)
+{
+	struct rte_acl_incr_config cfg = {
+		/* small delta to exercise the merges */
+		.max_delta_rules = 4,
+	};
+	uint32_t i, num_main, userdata[RTE_DIM(acl_test_rules)];
+	struct acl_ipv4vlan_rule rv;
+	struct rte_acl_ctx *acx;
+	int ret;
+
+	acx = rte_acl_create(&acl_param);
+	if (acx == NULL) {
+		printf("Line %i: Error creating ACL context!\n", __LINE__);
+		return -1;
+	}
+
+	/* build the main trie with half of the rules */
+	num_main = RTE_DIM(acl_test_rules) / 2;
+	ret = test_classify_buid(acx, acl_test_rules, num_main);
+	if (ret != 0)
+		goto err;
+
+	ret = rte_acl_incr_enable(acx, &cfg);
+	if (ret != 0) {
+		printf("Line %i: Enabling incremental mode failed: %d\n",
+			__LINE__, ret);
+		goto err;
+	}
+
+	ret = rte_acl_incr_enable(acx, &cfg);
+	if (ret != -EEXIST) {
+		printf("Line %i: Enabling incremental mode twice did not "
+			"fail with -EEXIST: %d\n", __LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	/* the rules can only be changed incrementally */
+	acl_ipv4vlan_convert_rule(acl_test_rules, &rv);
+	ret = rte_acl_add_rules(acx, (struct rte_acl_rule *)&rv, 1);
+	if (ret != -EBUSY) {
+		printf("Line %i: Adding rule to incremental context did not "
+			"fail with -EBUSY: %d\n", __LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	/* add the other rules through the delta trie */
+	ret = test_incr_add_rules(acx, acl_test_rules + num_main,
+		RTE_DIM(acl_test_rules) - num_main);
+	if (ret != 0)
+		goto err;
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0) {
+		printf("Line %i: Classify after incremental add failed!\n",
+			__LINE__);
+		goto err;
+	}
+
+	/* delete all the rules, then add them all back */
+	for (i = 0; i != RTE_DIM(acl_test_rules); i++)
+		userdata[i] = acl_test_rules[i].data.userdata;
+
+	ret = rte_acl_incr_del_rules(acx, userdata, RTE_DIM(userdata));
+	if (ret != 0) {
+		printf("Line %i: Deleting rules failed: %d\n", __LINE__, ret);
+		goto err;
+	}
+
+	ret = rte_acl_incr_del_rules(acx, userdata, 1);
+	if (ret != -ENOENT) {
+		printf("Line %i: Deleting missing rule did not fail "
+			"with -ENOENT: %d\n", __LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	ret = test_incr_add_rules(acx, acl_test_rules,
+		RTE_DIM(acl_test_rules));
+	if (ret != 0)
+		goto err;
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0) {
+		printf("Line %i: Classify after incremental re-add failed!\n",
+			__LINE__);
+		goto err;
+	}
+
+	ret = rte_acl_incr_merge(acx);
+	if (ret != 0) {
+		printf("Line %i: Merging delta trie failed: %d\n",
+			__LINE__, ret);
+		goto err;
+	}
+
+	ret = test_classify_run(acx, acl_test_data, RTE_DIM(acl_test_data));
+	if (ret != 0)
+		printf("Line %i: Classify after merge failed!\n", __LINE__);
+
+err:
+	rte_acl_free(acx);
+	return ret;
+}
+
 static uint32_t
 get_u32_range_max(void)
 {
@@ -1743,6 +1877,8 @@ test_acl(void)
 		return -1;
 	if (test_u32_range() < 0)
 		return -1;
+	if (test_incremental() < 0)
+		return -1;
 
 	return 0;
 }
@@ -10,6 +10,8 @@
 #include <rte_net.h>
 #include <rte_mbuf.h>
 #include <rte_ip.h>
+#include <rte_errno.h>
+#include <rte_random.h>
 
 #include "test.h"
 
@@ -17,6 +19,11 @@
 #define MBUF_DATA_SIZE          256
 #define NB_MBUF                 128
 
+#define VEC_MAX_LEN             2048
+#define BURST_NB_PKTS           4
+#define BURST_MAX_PAYLOAD       600
+#define BURST_MAX_LEN           (BURST_MAX_PAYLOAD + 128)
+
 /*
  * Test L3/L4 checksum API.
  */
@@ -223,6 +230,221 @@ test_l4_cksum(struct rte_mempool *pktmbuf_pool, const char *pktdata, size_t len)
 	return -1;
 }
 
+/* compare the vector raw checksum with the scalar one */
+static int
+test_raw_cksum_vec(void)
+{
+	static uint8_t buf[VEC_MAX_LEN + RTE_CACHE_LINE_SIZE];
+	unsigned int i, off, len;
+
+	for (i = 0; i < RTE_DIM(buf); i++)
+		buf[i] = (uint8_t)rte_rand();
+
+	for (len = 0; len <= VEC_MAX_LEN; len++) {
+		off = rte_rand_max(RTE_CACHE_LINE_SIZE);
+		if (rte_raw_cksum_vec(buf + off, len) !=
+				rte_raw_cksum(buf + off, len))
+			GOTO_FAIL("invalid vector checksum, len %u off %u",
+				len, off);
+	}
+
+	/* check the carries with the largest words */
+	memset(buf, 0xff, sizeof(buf));
+	for (len = 0; len <= VEC_MAX_LEN; len += 7) {
+		if (rte_raw_cksum_vec(buf + 1, len) != rte_raw_cksum(buf + 1, len))
+			GOTO_FAIL("invalid vector checksum of ones, len %u", len);
+	}
+
+	return 0;
+
+fail:
+	return -1;
+}
+
+/*
+ * Generate an Ether/IPv4 or IPv6/UDP or TCP packet with a random payload
+ * and valid checksums, return its length and the matching Tx offload flags.
+ */
+static uint32_t
+test_cksum_gen_pkt(uint8_t *data, bool ipv6, bool tcp, uint64_t *ol_flags,
+		   uint32_t *hdr_len)
+{
+	struct rte_ether_hdr *eth = (struct rte_ether_hdr *)data;
+	struct rte_ipv4_hdr *ipv4 = (struct rte_ipv4_hdr *)(eth + 1);
+	struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)(eth + 1);
+	uint32_t l3_len = ipv6 ? sizeof(*ipv6_hdr) : sizeof(*ipv4);
+	uint32_t l4_len = tcp ? sizeof(struct rte_tcp_hdr) :
+		sizeof(struct rte_udp_hdr);
+	uint32_t payload = rte_rand_max(BURST_MAX_PAYLOAD);
+	uint32_t len = sizeof(*eth) + l3_len + l4_len + payload;
+	void *l4_hdr = (char *)(eth + 1) + l3_len;
+	struct rte_udp_hdr *udp = l4_hdr;
+	struct rte_tcp_hdr *th = l4_hdr;
+	uint16_t cksum;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		data[i] = (uint8_t)rte_rand();
+
+	if (ipv6) {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		ipv6_hdr->vtc_flow = rte_cpu_to_be_32(0x60000000);
+		ipv6_hdr->payload_len = rte_cpu_to_be_16(l4_len + payload);
+		ipv6_hdr->proto = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+		*ol_flags = RTE_MBUF_F_TX_IPV6;
+	} else {
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		ipv4->version_ihl = RTE_IPV4_VHL_DEF;
+		ipv4->total_length = rte_cpu_to_be_16(l3_len + l4_len + payload);
+		ipv4->fragment_offset = 0;
+		ipv4->next_proto_id = tcp ? IPPROTO_TCP : IPPROTO_UDP;
+		ipv4->hdr_checksum = 0;
+		ipv4->hdr_checksum = rte_ipv4_cksum(ipv4);
+		*ol_flags = RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM;
+	}
+
+	if (tcp) {
+		th->data_off = sizeof(*th) << 2;
+		th->cksum = 0;
+		cksum = ipv6 ? rte_ipv6_udptcp_cksum(ipv6_hdr, th) :
+			rte_ipv4_udptcp_cksum(ipv4, th);
+		th->cksum = cksum;
+		*ol_flags |= RTE_MBUF_F_TX_TCP_CKSUM;
+	} else {
+		udp->dgram_len = rte_cpu_to_be_16(l4_len + payload);
+		udp->dgram_cksum = 0;
+		cksum = ipv6 ? rte_ipv6_udptcp_cksum(ipv6_hdr, udp) :
+			rte_ipv4_udptcp_cksum(ipv4, udp);
+		udp->dgram_cksum = cksum;
+		*ol_flags |= RTE_MBUF_F_TX_UDP_CKSUM;
+	}
+
+	*hdr_len = sizeof(*eth) + l3_len + l4_len;
+	return len;
+}
+
+/* copy a packet into a chain of segments of random lengths */
+static struct rte_mbuf *
+test_cksum_build_mbuf(struct rte_mempool *pktmbuf_pool, const uint8_t *data,
+		      uint32_t len, uint32_t hdr_len)
+{
+	struct rte_mbuf *m = NULL;
+	struct rte_mbuf *seg;
+	uint32_t off, seglen;
+	char *p;
+
+	for (off = 0; off < len; off += seglen) {
+		seg = rte_pktmbuf_alloc(pktmbuf_pool);
+		if (seg == NULL)
+			goto fail;
+
+		/* the headers must be in the first segment */
+		seglen = 1 + rte_rand_max(rte_pktmbuf_tailroom(seg));
+		if (off == 0)
+			seglen = RTE_MAX(seglen, hdr_len);
+		seglen = RTE_MIN(seglen, len - off);
+
+		p = rte_pktmbuf_append(seg, seglen);
+		if (p == NULL) {
+			rte_pktmbuf_free(seg);
+			goto fail;
+		}
+		memcpy(p, data + off, seglen);
+
+		if (m == NULL) {
+			m = seg;
+		} else if (rte_pktmbuf_chain(m, seg) != 0) {
+			rte_pktmbuf_free(seg);
+			goto fail;
+		}
+	}
+
+	return m;
+
+fail:
+	rte_pktmbuf_free(m);
+	return NULL;
+}
+
+/* check the checksums computed by rte_net_cksum_burst() */
+static int
+test_cksum_burst(struct rte_mempool *pktmbuf_pool)
+{
+	static uint8_t data[BURST_NB_PKTS][BURST_MAX_LEN];
+	static uint8_t out[BURST_MAX_LEN];
+	struct rte_mbuf *pkts[BURST_NB_PKTS] = { NULL };
+	struct rte_udp_hdr *udp;
+	struct rte_tcp_hdr *th;
+	uint32_t len[BURST_NB_PKTS];
+	uint32_t hdr_len;
+	uint64_t ol_flags;
+	unsigned int i, iter;
+	const void *p;
+
+	for (iter = 0; iter < 64; iter++) {
+		for (i = 0; i < BURST_NB_PKTS; i++) {
+			bool ipv6 = i & 1;
+			bool tcp = i & 2;
+
+			len[i] = test_cksum_gen_pkt(data[i], ipv6, tcp,
+				&ol_flags, &hdr_len);
+			pkts[i] = test_cksum_build_mbuf(pktmbuf_pool, data[i],
+				len[i], hdr_len);
+			if (pkts[i] == NULL)
+				GOTO_FAIL("cannot build packet");
+
+			pkts[i]->ol_flags = ol_flags;
+			pkts[i]->l2_len = sizeof(struct rte_ether_hdr);
+			pkts[i]->l3_len = ipv6 ? sizeof(struct rte_ipv6_hdr) :
+				sizeof(struct rte_ipv4_hdr);
+
+			/* corrupt the checksums to compute */
+			if (!ipv6)
+				rte_pktmbuf_mtod_offset(pkts[i],
+					struct rte_ipv4_hdr *,
+					pkts[i]->l2_len)->hdr_checksum ^= 0x1234;
+			if (tcp) {
+				th = rte_pktmbuf_mtod_offset(pkts[i],
+					struct rte_tcp_hdr *,
+					pkts[i]->l2_len + pkts[i]->l3_len);
+				th->cksum ^= 0x4321;
+			} else {
+				udp = rte_pktmbuf_mtod_offset(pkts[i],
+					struct rte_udp_hdr *,
+					pkts[i]->l2_len + pkts[i]->l3_len);
+				udp->dgram_cksum ^= 0x4321;
+			}
+		}
+
+		/* segmentation is not supported, the burst stops there */
+		pkts[BURST_NB_PKTS - 1]->ol_flags |= RTE_MBUF_F_TX_TCP_SEG;
+		if (rte_net_cksum_burst(pkts, BURST_NB_PKTS) !=
+				BURST_NB_PKTS - 1 || rte_errno != ENOTSUP)
+			GOTO_FAIL("unsupported offload not detected");
+		pkts[BURST_NB_PKTS - 1]->ol_flags &= ~RTE_MBUF_F_TX_TCP_SEG;
+
+		if (rte_net_cksum_burst(pkts, BURST_NB_PKTS) != BURST_NB_PKTS)
+			GOTO_FAIL("cannot compute burst checksums");
+
+		for (i = 0; i < BURST_NB_PKTS; i++) {
+			p = rte_pktmbuf_read(pkts[i], 0, len[i], out);
+			if (p == NULL || memcmp(p, data[i], len[i]) != 0)
+				GOTO_FAIL("invalid burst checksum, packet %u, %u segments",
+					i, pkts[i]->nb_segs);
+			rte_pktmbuf_free(pkts[i]);
+			pkts[i] = NULL;
+		}
+	}
+
+	return 0;
+
+fail:
+	for (i = 0; i < BURST_NB_PKTS; i++)
+		rte_pktmbuf_free(pkts[i]);
+
+	return -1;
+}
+
 static int
 test_cksum(void)
 {
@@ -256,6 +478,12 @@ test_cksum(void)
 			  sizeof(test_cksum_ipv4_opts_udp)) < 0)
 		GOTO_FAIL("checksum error on ipv4_opts_udp");
 
+	if (test_raw_cksum_vec() < 0)
+		GOTO_FAIL("checksum error on vector raw checksum");
+
+	if (test_cksum_burst(pktmbuf_pool) < 0)
+		GOTO_FAIL("checksum error on burst");
+
 	rte_mempool_free(pktmbuf_pool);
 
 	return 0;
@@ -8,6 +8,8 @@
 #include <rte_cycles.h>
 #include <rte_ip.h>
 #include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_net.h>
 #include <rte_random.h>
 
 #include "test.h"
@@ -15,7 +17,15 @@
 #define NUM_BLOCKS 10
 #define ITERATIONS 1000000
 
+#define BURST_ITERATIONS 100000
+#define MAX_BURST 64
+#define NB_MBUF (2 * MAX_BURST)
+
 static const size_t data_sizes[] = { 20, 21, 100, 101, 1500, 1501 };
+static const uint16_t pkt_sizes[] = { 64, 512, 1500 };
+static const uint16_t burst_sizes[] = { 1, 8, 32, 64 };
+
+typedef uint16_t (*cksum_fn_t)(const void *buf, size_t len);
 
 static __rte_noinline uint16_t
 do_rte_raw_cksum(const void *buf, size_t len)
@@ -23,6 +33,12 @@ do_rte_raw_cksum(const void *buf, size_t len)
 	return rte_raw_cksum(buf, len);
 }
 
+static __rte_noinline uint16_t
+do_rte_raw_cksum_vec(const void *buf, size_t len)
+{
+	return rte_raw_cksum_vec(buf, len);
+}
+
 static void
 init_block(char *buf, size_t len)
 {
@@ -33,7 +49,7 @@ init_block(char *buf, size_t len)
 }
 
 static int
-test_cksum_perf_size_alignment(size_t block_size, bool aligned)
+test_cksum_perf_size_alignment(cksum_fn_t fn, size_t block_size, bool aligned)
 {
 	char *data[NUM_BLOCKS];
 	char *blocks[NUM_BLOCKS];
@@ -63,7 +79,7 @@ test_cksum_perf_size_alignment(size_t block_size, bool aligned)
 	for (i = 0; i < ITERATIONS; i++) {
 		unsigned int j;
 		for (j = 0; j < NUM_BLOCKS; j++)
-			sum += do_rte_raw_cksum(blocks[j], block_size);
+			sum += fn(blocks[j], block_size);
 	}
 
 	end = rte_rdtsc();
@@ -81,31 +97,31 @@ test_cksum_perf_size_alignment(size_t block_size, bool aligned)
 }
 
 static int
-test_cksum_perf_size(size_t block_size)
+test_cksum_perf_size(cksum_fn_t fn, size_t block_size)
 {
 	int rc;
 
-	rc = test_cksum_perf_size_alignment(block_size, true);
+	rc = test_cksum_perf_size_alignment(fn, block_size, true);
 	if (rc != TEST_SUCCESS)
 		return rc;
 
-	rc = test_cksum_perf_size_alignment(block_size, false);
+	rc = test_cksum_perf_size_alignment(fn, block_size, false);
 
 	return rc;
 }
 
 static int
-test_cksum_perf(void)
+test_cksum_perf_fn(cksum_fn_t fn, const char *name)
 {
 	uint16_t i;
 
-	printf("### rte_raw_cksum() performance ###\n");
+	printf("### %s() performance ###\n", name);
 	printf("Alignment  Block size    TSC cycles/block  TSC cycles/byte\n");
 
 	for (i = 0; i < RTE_DIM(data_sizes); i++) {
 		int rc;
 
-		rc = test_cksum_perf_size(data_sizes[i]);
+		rc = test_cksum_perf_size(fn, data_sizes[i]);
 		if (rc != TEST_SUCCESS)
 			return rc;
 	}
@@ -113,4 +129,124 @@ test_cksum_perf(void)
 	return TEST_SUCCESS;
 }
 
+/* build an Ether/IPv4/UDP packet requesting the Tx checksum offloads */
+static int
+init_pkt(struct rte_mbuf *m, uint16_t pkt_size)
+{
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *udp;
+	char *data;
+
+	data = rte_pktmbuf_append(m, pkt_size);
+	if (data == NULL)
+		return -1;
+	init_block(data, pkt_size);
+
+	ip = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *,
+		sizeof(struct rte_ether_hdr));
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(pkt_size -
+		sizeof(struct rte_ether_hdr));
+	ip->next_proto_id = IPPROTO_UDP;
+	udp = (struct rte_udp_hdr *)(ip + 1);
+	udp->dgram_len = rte_cpu_to_be_16(pkt_size -
+		sizeof(struct rte_ether_hdr) - sizeof(*ip));
+
+	m->l2_len = sizeof(struct rte_ether_hdr);
+	m->l3_len = sizeof(*ip);
+	m->ol_flags = RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM |
+		RTE_MBUF_F_TX_UDP_CKSUM;
+
+	return 0;
+}
+
+static int
+test_cksum_perf_burst_size(struct rte_mempool *mp, uint16_t pkt_size,
+			   uint16_t burst_size)
+{
+	struct rte_mbuf *pkts[MAX_BURST];
+	uint64_t start;
+	uint64_t end;
+	double pkt_latency;
+	unsigned int i;
+	int rc = TEST_FAILED;
+
+	if (rte_pktmbuf_alloc_bulk(mp, pkts, burst_size) != 0) {
+		printf("Failed to allocate mbufs\n");
+		return TEST_FAILED;
+	}
+
+	for (i = 0; i < burst_size; i++) {
+		if (init_pkt(pkts[i], pkt_size) != 0) {
+			printf("Failed to build packet\n");
+			goto out;
+		}
+	}
+
+	start = rte_rdtsc();
+
+	for (i = 0; i < BURST_ITERATIONS; i++) {
+		if (rte_net_cksum_burst(pkts, burst_size) != burst_size) {
+			printf("Failed to compute checksums\n");
+			goto out;
+		}
+	}
+
+	end = rte_rdtsc();
+
+	pkt_latency = (end - start) / (double)(BURST_ITERATIONS * burst_size);
+
+	printf("%11u %10u %19.1f %16.2f\n", pkt_size, burst_size,
+	       pkt_latency, pkt_latency / pkt_size);
+
+	rc = TEST_SUCCESS;
+out:
+	rte_pktmbuf_free_bulk(pkts, burst_size);
+
+	return rc;
+}
+
+static int
+test_cksum_perf_burst(void)
+{
+	struct rte_mempool *mp;
+	unsigned int i, j;
+	int rc = TEST_SUCCESS;
+
+	mp = rte_pktmbuf_pool_create("test_cksum_perf_pool", NB_MBUF, 0, 0,
+		RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	if (mp == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	printf("### rte_net_cksum_burst() performance, IPv4/UDP ###\n");
+	printf("Packet size  Burst size    TSC cycles/packet  TSC cycles/byte\n");
+
+	for (i = 0; i < RTE_DIM(pkt_sizes) && rc == TEST_SUCCESS; i++)
+		for (j = 0; j < RTE_DIM(burst_sizes) && rc == TEST_SUCCESS; j++)
+			rc = test_cksum_perf_burst_size(mp, pkt_sizes[i],
+				burst_sizes[j]);
+
+	rte_mempool_free(mp);
+
+	return rc;
+}
+
+static int
+test_cksum_perf(void)
+{
+	int rc;
+
+	rc = test_cksum_perf_fn(do_rte_raw_cksum, "rte_raw_cksum");
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	rc = test_cksum_perf_fn(do_rte_raw_cksum_vec, "rte_raw_cksum_vec");
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	return test_cksum_perf_burst();
+}
+
 REGISTER_PERF_TEST(cksum_perf_autotest, test_cksum_perf);
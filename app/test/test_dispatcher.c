@@ -792,19 +792,13 @@ test_app_get_errors(struct test_app *app)
 	return rte_atomic_load_explicit(&app->errors, rte_memory_order_relaxed);
 }
 
-static int
-test_basic(void)
+static void
+test_app_send_events(struct test_app *app, int num_events)
 {
-	int rc;
-	int i;
-
-	rc = test_app_start(test_app);
-	if (rc != TEST_SUCCESS)
-		return rc;
-
 	uint64_t sns[NUM_FLOWS] = { 0 };
+	int i;
 
-	for (i = 0; i < NUM_EVENTS;) {
+	for (i = 0; i < num_events;) {
 		struct rte_event events[ENQUEUE_BURST_SIZE];
 		int left;
 		int batch_size;
@@ -812,7 +806,7 @@ test_basic(void)
 		uint16_t n = 0;
 
 		batch_size = 1 + rte_rand_max(ENQUEUE_BURST_SIZE);
-		left = NUM_EVENTS - i;
+		left = num_events - i;
 
 		batch_size = RTE_MIN(left, batch_size);
 
@@ -836,7 +830,7 @@ test_basic(void)
 		}
 
 		while (n < batch_size)
-			n += rte_event_enqueue_new_burst(test_app->event_dev_id,
+			n += rte_event_enqueue_new_burst(app->event_dev_id,
 							 DRIVER_PORT_ID,
 							 events + n,
 							 batch_size - n);
@@ -844,8 +838,20 @@ test_basic(void)
 		i += batch_size;
 	}
 
-	while (test_app_get_completed_events(test_app) != NUM_EVENTS)
-		rte_event_maintain(test_app->event_dev_id, DRIVER_PORT_ID, 0);
+	while (test_app_get_completed_events(app) != num_events)
+		rte_event_maintain(app->event_dev_id, DRIVER_PORT_ID, 0);
+}
+
+static int
+test_basic(void)
+{
+	int rc;
+
+	rc = test_app_start(test_app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	test_app_send_events(test_app, NUM_EVENTS);
 
 	rc = test_app_get_errors(test_app);
 	TEST_ASSERT(rc == 0, "%d errors occurred", rc);
@@ -894,6 +900,144 @@ test_basic(void)
 	return TEST_SUCCESS;
 }
 
+#define NUM_ADAPTIVE_EVENTS 1000000
+#define MIN_ADAPTIVE_BATCH_SIZE 4
+
+static int
+test_adaptive_batch(void)
+{
+	struct rte_dispatcher_stats stats;
+	struct rte_dispatcher_stats lcore_stats;
+	uint64_t handler_count = 0;
+	uint64_t lcore_count = 0;
+	int rc;
+	int i;
+
+	for (i = 0; i < NUM_WORKERS; i++) {
+		rc = rte_dispatcher_port_batch_size_adapt(test_app->dispatcher,
+			WORKER_PORT_ID(i), MIN_ADAPTIVE_BATCH_SIZE,
+			test_app->service_lcores[i]);
+		TEST_ASSERT_SUCCESS(rc, "Unable to enable adaptive batch size "
+				    "on port %d", WORKER_PORT_ID(i));
+	}
+
+	rc = rte_dispatcher_port_batch_size_adapt(test_app->dispatcher,
+		WORKER_PORT_ID(0), DEQUEUE_BURST_SIZE + 1,
+		test_app->service_lcores[0]);
+	TEST_ASSERT_EQUAL(rc, -EINVAL, "Minimum batch size larger than "
+			  "batch size accepted");
+
+	rc = rte_dispatcher_port_batch_size_adapt(test_app->dispatcher,
+		DRIVER_PORT_ID, MIN_ADAPTIVE_BATCH_SIZE,
+		test_app->service_lcores[0]);
+	TEST_ASSERT_EQUAL(rc, -ENOENT, "Adaptive batch size enabled on "
+			  "unbound port");
+
+	rc = test_app_start(test_app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	test_app_send_events(test_app, NUM_ADAPTIVE_EVENTS);
+
+	rc = test_app_get_errors(test_app);
+	TEST_ASSERT(rc == 0, "%d errors occurred", rc);
+
+	rc = test_app_stop(test_app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	rte_dispatcher_stats_get(test_app->dispatcher, &stats);
+
+	TEST_ASSERT_EQUAL(stats.ev_dispatch_count,
+			  NUM_ADAPTIVE_EVENTS * NUM_QUEUES,
+			  "Invalid dispatch count");
+	TEST_ASSERT(stats.busy_cycles > 0, "Busy cycles is zero");
+
+	for (i = 0; i < NUM_QUEUES; i++) {
+		int reg_id = test_app->queues[i].dispatcher_reg_id;
+
+		TEST_ASSERT(stats.handlers[reg_id].cycles > 0,
+			    "Handler %d cycles is zero", reg_id);
+		handler_count += stats.handlers[reg_id].ev_count;
+	}
+
+	TEST_ASSERT_EQUAL(handler_count, stats.ev_dispatch_count,
+			  "Handler event counts do not match dispatch count");
+
+	for (i = 0; i < NUM_SERVICE_CORES; i++) {
+		rc = rte_dispatcher_lcore_stats_get(test_app->dispatcher,
+			test_app->service_lcores[i], &lcore_stats);
+		TEST_ASSERT_SUCCESS(rc, "Unable to get lcore stats");
+		lcore_count += lcore_stats.ev_dispatch_count;
+	}
+
+	TEST_ASSERT_EQUAL(lcore_count, stats.ev_dispatch_count,
+			  "Lcore dispatch counts do not match dispatch count");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rebalance(void)
+{
+	unsigned int lcore_id = test_app->service_lcores[0];
+	int rc;
+	int i;
+
+	/* Scale down: the port of an unmapped lcore is moved */
+	rc = rte_service_map_lcore_set(test_app->dispatcher_service_id,
+				       lcore_id, 0);
+	TEST_ASSERT_SUCCESS(rc, "Unable to unmap dispatcher service");
+
+	rc = rte_dispatcher_rebalance(test_app->dispatcher);
+	TEST_ASSERT_EQUAL(rc, 1, "Expected one port moved, but was %d", rc);
+
+	rc = rte_dispatcher_unbind_port_from_lcore(test_app->dispatcher,
+						   WORKER_PORT_ID(0), lcore_id);
+	TEST_ASSERT_EQUAL(rc, -ENOENT, "Port still bound to unmapped lcore");
+
+	/* Scale up: an lcore without port gets one */
+	rc = rte_service_map_lcore_set(test_app->dispatcher_service_id,
+				       lcore_id, 1);
+	TEST_ASSERT_SUCCESS(rc, "Unable to map dispatcher service");
+
+	rc = rte_dispatcher_rebalance(test_app->dispatcher);
+	TEST_ASSERT_EQUAL(rc, 1, "Expected one port moved, but was %d", rc);
+
+	rc = rte_dispatcher_rebalance(test_app->dispatcher);
+	TEST_ASSERT_EQUAL(rc, 0, "Expected no port moved, but was %d", rc);
+
+	/* Restore the initial binding */
+	for (i = 0; i < NUM_WORKERS; i++) {
+		rc = rte_dispatcher_move_port(test_app->dispatcher,
+					      WORKER_PORT_ID(0),
+					      test_app->service_lcores[i],
+					      lcore_id);
+		if (rc == 0)
+			break;
+	}
+	TEST_ASSERT_SUCCESS(rc, "Port 0 not bound to any service lcore");
+
+	for (i = 1; i < NUM_WORKERS; i++) {
+		rc = rte_dispatcher_move_port(test_app->dispatcher,
+					      WORKER_PORT_ID(i), lcore_id,
+					      test_app->service_lcores[i]);
+		TEST_ASSERT(rc == 0 || rc == -ENOENT, "Unable to move port %d",
+			    WORKER_PORT_ID(i));
+	}
+
+	rc = test_app_start(test_app);
+	if (rc != TEST_SUCCESS)
+		return rc;
+
+	test_app_send_events(test_app, NUM_ADAPTIVE_EVENTS);
+
+	rc = test_app_get_errors(test_app);
+	TEST_ASSERT(rc == 0, "%d errors occurred", rc);
+
+	return test_app_stop(test_app);
+}
+
 static int
 test_drop(void)
 {
@@ -1038,6 +1182,8 @@ static struct unit_test_suite test_suite = {
 	.suite_name = "Event dispatcher test suite",
 	.unit_test_cases = {
 		TEST_CASE_ST(test_setup, test_teardown, test_basic),
+		TEST_CASE_ST(test_setup, test_teardown, test_adaptive_batch),
+		TEST_CASE_ST(test_setup, test_teardown, test_rebalance),
 		TEST_CASE_ST(test_setup, test_teardown, test_drop),
 		TEST_CASE_ST(test_setup, test_teardown,
 			     test_many_handler_registrations),
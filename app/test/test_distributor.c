@@ -729,6 +729,93 @@ sanity_mark_test(struct worker_params *wp, struct rte_mempool *p)
 	return 0;
 }
 
+/* flow_affinity_test sends several bursts of a flow, flushing the
+ * distributor between them, so that the flow has no packet in flight
+ * when the next burst is processed.
+ * With flow affinity enabled, all bursts must be handled by the same worker.
+ */
+static int
+flow_affinity_test(struct worker_params *wp, struct rte_mempool *p)
+{
+	const unsigned int rounds = 4;
+	const unsigned int burst = 8;
+	const unsigned int buf_count = rounds * burst;
+	const unsigned int tag = 3 << 12;
+	const unsigned int seq_shift = 10;
+
+	struct rte_distributor *db = wp->dist;
+	struct rte_mbuf *bufs[buf_count];
+	struct rte_mbuf *returns[buf_count];
+	unsigned int i, count, processed, seq, id;
+	unsigned int first = UINT_MAX;
+	unsigned int failed = 0;
+	int ret;
+
+	printf("=== Flow affinity test ===\n");
+	clear_packet_count();
+
+	ret = rte_distributor_flow_affinity_enable(db, US_PER_S);
+	if (ret != 0) {
+		printf("line %d: Error enabling flow affinity: %d\n",
+				__LINE__, ret);
+		return -1;
+	}
+
+	if (rte_mempool_get_bulk(p, (void *)bufs, buf_count) != 0) {
+		printf("line %d: Error getting mbufs from pool\n", __LINE__);
+		rte_distributor_flow_affinity_disable(db);
+		return -1;
+	}
+
+	for (i = 0; i < buf_count; i++) {
+		bufs[i]->hash.usr = tag;
+		*seq_field(bufs[i]) = i << seq_shift;
+	}
+
+	count = 0;
+	for (i = 0; i < rounds; i++) {
+		processed = 0;
+		while (processed < burst)
+			processed += rte_distributor_process(db,
+				&bufs[i * burst + processed],
+				burst - processed);
+		do {
+			rte_distributor_flush(db);
+			count += rte_distributor_returned_pkts(db,
+				&returns[count], buf_count - count);
+		} while (count < (i + 1) * burst);
+	}
+
+	for (i = 0; i < buf_count; i++) {
+		seq = *seq_field(returns[i]) >> seq_shift;
+		id = *seq_field(returns[i]) - (seq << seq_shift) - 1;
+		if (first == UINT_MAX)
+			first = id;
+		if (id != first) {
+			printf("Packet number %u processed by worker %u,"
+				" but should be processed by worker %u\n",
+				seq, id, first);
+			failed = 1;
+		}
+	}
+
+	ret = rte_distributor_flow_worker_get(db, tag);
+	if (ret != (int)first) {
+		printf("line %d: Flow pinned to worker %d, expected %u\n",
+				__LINE__, ret, first);
+		failed = 1;
+	}
+
+	rte_mempool_put_bulk(p, (void *)bufs, buf_count);
+	rte_distributor_flow_affinity_disable(db);
+
+	if (failed)
+		return -1;
+
+	printf("Flow affinity test passed\n");
+	return 0;
+}
+
 static
 int test_error_distributor_create_name(void)
 {
@@ -932,6 +1019,14 @@ test_distributor(void)
 				goto err;
 			quit_workers(&worker_params, p);
 
+			if (i) {
+				rte_eal_mp_remote_launch(handle_and_mark_work,
+						&worker_params, SKIP_MAIN);
+				if (flow_affinity_test(&worker_params, p) < 0)
+					goto err;
+				quit_workers(&worker_params, p);
+			}
+
 		} else {
 			printf("Too few cores to run worker shutdown test\n");
 		}
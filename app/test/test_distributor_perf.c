@@ -28,6 +28,10 @@ test_distributor_perf(void)
 #define ITER_POWER 21 /* log 2 of how many iterations we do when timing. */
 #define BURST 64
 #define BIG_BATCH 1024
+#define FLOW_AGING_US 1000 /* flow affinity aging */
+
+/* number of workers of the flow affinity tests */
+static const unsigned int affinity_workers[] = { 4, 8, 16, 32 };
 
 /* static vars - zero initialized by default */
 static volatile int quit;
@@ -143,7 +147,8 @@ handle_work(void *arg)
  * threads and finally how long per packet the processing took.
  */
 static inline int
-perf_test(struct rte_distributor *d, struct rte_mempool *p)
+perf_test(struct rte_distributor *d, struct rte_mempool *p,
+		unsigned int num_workers)
 {
 	unsigned int i;
 	uint64_t start, end;
@@ -175,7 +180,7 @@ perf_test(struct rte_distributor *d, struct rte_mempool *p)
 			((end - start) >> ITER_POWER)/BURST);
 	rte_mempool_put_bulk(p, (void *)bufs, BURST);
 
-	for (i = 0; i < rte_lcore_count() - 1; i++)
+	for (i = 0; i < num_workers; i++)
 		printf("Worker %u handled %u packets\n", i,
 				worker_stats[i].handled_packets);
 	printf("Total packets: %u (%x)\n", total_packet_count(),
@@ -187,9 +192,9 @@ perf_test(struct rte_distributor *d, struct rte_mempool *p)
 
 /* Useful function which ensures that all worker functions terminate */
 static void
-quit_workers(struct rte_distributor *d, struct rte_mempool *p)
+quit_workers(struct rte_distributor *d, struct rte_mempool *p,
+		unsigned int num_workers)
 {
-	const unsigned int num_workers = rte_lcore_count() - 1;
 	unsigned int i;
 	struct rte_mbuf *bufs[RTE_MAX_LCORE];
 
@@ -210,6 +215,64 @@ quit_workers(struct rte_distributor *d, struct rte_mempool *p)
 	worker_idx = 0;
 }
 
+/* Launch the worker function on the first num_workers worker lcores */
+static void
+launch_workers(struct rte_distributor *d, unsigned int num_workers)
+{
+	unsigned int lcore_id, n = 0;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (n++ == num_workers)
+			break;
+		rte_eal_remote_launch(handle_work, d, lcore_id);
+	}
+}
+
+/*
+ * Performance test of the burst distributor with flow affinity,
+ * for an increasing number of workers.
+ */
+static int
+perf_test_affinity(struct rte_mempool *p)
+{
+	static struct rte_distributor *da[RTE_DIM(affinity_workers)];
+	char name[RTE_MEMZONE_NAMESIZE];
+	unsigned int i, num_workers;
+
+	for (i = 0; i < RTE_DIM(affinity_workers); i++) {
+		num_workers = affinity_workers[i];
+		if (num_workers > rte_lcore_count() - 1)
+			break;
+
+		if (da[i] == NULL) {
+			snprintf(name, sizeof(name), "Test_affinity%u",
+					num_workers);
+			da[i] = rte_distributor_create(name, rte_socket_id(),
+					num_workers, RTE_DIST_ALG_BURST);
+			if (da[i] == NULL) {
+				printf("Error creating burst distributor\n");
+				return -1;
+			}
+			if (rte_distributor_flow_affinity_enable(da[i],
+					FLOW_AGING_US) != 0) {
+				printf("Error enabling flow affinity\n");
+				return -1;
+			}
+		} else {
+			rte_distributor_clear_returns(da[i]);
+		}
+
+		printf("=== Performance test of distributor (burst mode, "
+				"flow affinity, %u workers) ===\n", num_workers);
+		launch_workers(da[i], num_workers);
+		if (perf_test(da[i], p, num_workers) < 0)
+			return -1;
+		quit_workers(da[i], p, num_workers);
+	}
+
+	return 0;
+}
+
 static int
 test_distributor_perf(void)
 {
@@ -262,17 +325,17 @@ test_distributor_perf(void)
 
 	printf("=== Performance test of distributor (single mode) ===\n");
 	rte_eal_mp_remote_launch(handle_work, ds, SKIP_MAIN);
-	if (perf_test(ds, p) < 0)
+	if (perf_test(ds, p, rte_lcore_count() - 1) < 0)
 		return -1;
-	quit_workers(ds, p);
+	quit_workers(ds, p, rte_lcore_count() - 1);
 
 	printf("=== Performance test of distributor (burst mode) ===\n");
 	rte_eal_mp_remote_launch(handle_work, db, SKIP_MAIN);
-	if (perf_test(db, p) < 0)
+	if (perf_test(db, p, rte_lcore_count() - 1) < 0)
 		return -1;
-	quit_workers(db, p);
+	quit_workers(db, p, rte_lcore_count() - 1);
 
-	return 0;
+	return perf_test_affinity(p);
 }
 
 #endif /* !RTE_EXEC_ENV_WINDOWS */
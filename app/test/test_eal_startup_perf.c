@@ -0,0 +1,113 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include "test.h"
+
+#ifndef RTE_EXEC_ENV_LINUX
+static int
+test_eal_startup_perf(void)
+{
+	printf("eal_startup_perf only supported on Linux, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <limits.h>
+
+#include "process.h"
+
+/* Memory preallocated by each process, in MB */
+#define STARTUP_MEM_SIZE "1024"
+#define STARTUP_REPEAT 3
+
+static uint64_t
+time_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NS_PER_S + ts.tv_nsec;
+}
+
+/*
+ * Start a primary process with the given arguments a few times, return the
+ * average startup time in microseconds, or 0 if the process failed.
+ */
+#define startup_time(ARGV) startup_time_n(ARGV, RTE_DIM(ARGV))
+
+static uint64_t
+startup_time_n(const char * const argv[], int argc)
+{
+	uint64_t start, total = 0;
+	unsigned int i;
+
+	for (i = 0; i < STARTUP_REPEAT; i++) {
+		start = time_ns();
+		if (process_dup(argv, argc, "test_eal_startup_perf") != 0)
+			return 0;
+		total += time_ns() - start;
+	}
+
+	return total / STARTUP_REPEAT / 1000;
+}
+
+static int
+test_eal_startup_perf(void)
+{
+	char prefix[PATH_MAX], tmp[PATH_MAX];
+	const char * const argv_serial[] = {prgname, "-m", STARTUP_MEM_SIZE,
+			prefix, "--no-pci"};
+	const char * const argv_2[] = {prgname, "-m", STARTUP_MEM_SIZE,
+			prefix, "--no-pci", "--huge-init-threads=2"};
+	const char * const argv_4[] = {prgname, "-m", STARTUP_MEM_SIZE,
+			prefix, "--no-pci", "--huge-init-threads=4"};
+	uint64_t serial, t;
+
+	/* use a prefix of our own, not to clash with other test runs */
+	if (get_current_prefix(tmp, sizeof(tmp)) == NULL) {
+		printf("Error - unable to get current prefix!\n");
+		return TEST_FAILED;
+	}
+	snprintf(prefix, sizeof(prefix), "--file-prefix=%s_startup_perf", tmp);
+
+	printf("Startup time with %s MB of memory (average of %u runs)\n",
+		STARTUP_MEM_SIZE, STARTUP_REPEAT);
+
+	serial = startup_time(argv_serial);
+	if (serial == 0) {
+		printf("Cannot start a process with %s MB of memory, skipping test\n",
+			STARTUP_MEM_SIZE);
+		return TEST_SKIPPED;
+	}
+	printf("  serial init: %"PRIu64" us\n", serial);
+
+	t = startup_time(argv_2);
+	if (t == 0) {
+		printf("Error - process did not run ok with --huge-init-threads=2\n");
+		return TEST_FAILED;
+	}
+	printf("  2 init threads: %"PRIu64" us\n", t);
+
+	t = startup_time(argv_4);
+	if (t == 0) {
+		printf("Error - process did not run ok with --huge-init-threads=4\n");
+		return TEST_FAILED;
+	}
+	printf("  4 init threads: %"PRIu64" us\n", t);
+
+	return TEST_SUCCESS;
+}
+
+#endif /* RTE_EXEC_ENV_LINUX */
+
+REGISTER_PERF_TEST(eal_startup_perf_autotest, test_eal_startup_perf);
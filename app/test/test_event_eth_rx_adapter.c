@@ -30,6 +30,7 @@ test_event_eth_rx_intr_adapter_common(void)
 
 #include <rte_eventdev.h>
 #include <rte_bus_vdev.h>
+#include <rte_service.h>
 
 #include <rte_event_eth_rx_adapter.h>
 
@@ -41,6 +42,8 @@ test_event_eth_rx_intr_adapter_common(void)
 #define TEST_DEV_ID		0
 #define TEST_ETHDEV_ID		0
 #define TEST_ETH_QUEUE_ID	0
+#define TEST_NULL_NO_RX_NAME	"net_null_rxa_no_rx"
+#define TEST_ADAPTIVE_ITERS	1024
 
 struct event_eth_rx_adapter_test_params {
 	struct rte_mempool *mp;
@@ -655,6 +658,199 @@ adapter_queue_stats_test(void)
 	return TEST_SUCCESS;
 }
 
+static int
+adapter_queue_adaptive_test(void)
+{
+	int err;
+	uint32_t cap;
+	struct rte_event_eth_rx_adapter_queue_conf queue_config = {0};
+	struct rte_event_eth_rx_adapter_queue_adaptive_stats a_stats;
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&a_stats);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	err = rte_event_eth_rx_adapter_caps_get(TEST_DEV_ID, TEST_ETHDEV_ID,
+					 &cap);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	queue_config.ev.queue_id = 0;
+	queue_config.ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	queue_config.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+	queue_config.servicing_weight = 1;
+
+	/* Queue added without the adaptive flag */
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+					TEST_ETHDEV_ID, 0,
+					&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&a_stats);
+	if (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT)
+		TEST_ASSERT(err == -ENOTSUP, "Expected -ENOTSUP got %d", err);
+	else
+		TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						0);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	if (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT)
+		return TEST_SUCCESS;
+
+	queue_config.rx_queue_flags = RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID,
+					TEST_ETHDEV_ID, 0,
+					&queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	memset(&queue_config, 0, sizeof(queue_config));
+	err = rte_event_eth_rx_adapter_queue_conf_get(TEST_INST_ID,
+						      TEST_ETHDEV_ID,
+						      0, &queue_config);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(queue_config.rx_queue_flags &
+		    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE,
+		    "Adaptive flag not reported by queue conf");
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						NULL);
+	TEST_ASSERT(err == -EINVAL, "Expected -EINVAL got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&a_stats);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(a_stats.rx_burst_size > 0, "Invalid Rx burst size %u",
+		    a_stats.rx_burst_size);
+
+	err = rte_event_eth_rx_adapter_stats_reset(TEST_INST_ID);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						TEST_ETHDEV_ID, 0,
+						&a_stats);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	TEST_ASSERT(a_stats.rx_poll_count == 0 && a_stats.rx_packets == 0,
+		    "Adaptive stats not reset");
+
+	err = rte_event_eth_rx_adapter_queue_del(TEST_INST_ID,
+						TEST_ETHDEV_ID,
+						0);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	return TEST_SUCCESS;
+}
+
+static int
+adapter_queue_adaptive_backoff_test(void)
+{
+	int err;
+	uint32_t cap, service_id, i;
+	uint16_t port_id;
+	struct rte_eth_conf port_conf = {0};
+	struct rte_event_eth_rx_adapter_queue_conf queue_config = {0};
+	struct rte_event_eth_rx_adapter_queue_adaptive_stats a_stats;
+	int rc = TEST_FAILED;
+
+	/* A port which never receives packets, so its queue stays empty */
+	err = rte_vdev_init(TEST_NULL_NO_RX_NAME, "no-rx=1");
+	TEST_ASSERT(err == 0, "Failed to create %s. err=%d",
+		    TEST_NULL_NO_RX_NAME, err);
+	err = rte_eth_dev_get_port_by_name(TEST_NULL_NO_RX_NAME, &port_id);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+
+	err = rte_event_eth_rx_adapter_caps_get(TEST_DEV_ID, port_id, &cap);
+	TEST_ASSERT(err == 0, "Expected 0 got %d", err);
+	if (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT) {
+		rc = TEST_SKIPPED;
+		goto vdev_uninit;
+	}
+
+	if (rte_eth_dev_configure(port_id, 1, 1, &port_conf) != 0 ||
+	    rte_eth_rx_queue_setup(port_id, 0, 512, rte_eth_dev_socket_id(port_id),
+				   NULL, default_params.mp) != 0 ||
+	    rte_eth_tx_queue_setup(port_id, 0, 512, rte_eth_dev_socket_id(port_id),
+				   NULL) != 0 ||
+	    rte_eth_dev_start(port_id) != 0) {
+		printf("Failed to start port %u\n", port_id);
+		goto vdev_uninit;
+	}
+
+	queue_config.ev.queue_id = 0;
+	queue_config.ev.sched_type = RTE_SCHED_TYPE_ATOMIC;
+	queue_config.ev.priority = RTE_EVENT_DEV_PRIORITY_NORMAL;
+	queue_config.servicing_weight = 1;
+	queue_config.rx_queue_flags = RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE;
+	err = rte_event_eth_rx_adapter_queue_add(TEST_INST_ID, port_id, 0,
+						 &queue_config);
+	if (err != 0) {
+		printf("Failed to add queue, err=%d\n", err);
+		goto port_stop;
+	}
+
+	if (rte_event_eth_rx_adapter_service_id_get(TEST_INST_ID,
+						    &service_id) != 0 ||
+	    rte_event_eth_rx_adapter_start(TEST_INST_ID) != 0) {
+		printf("Failed to start adapter\n");
+		goto queue_del;
+	}
+
+	for (i = 0; i < TEST_ADAPTIVE_ITERS; i++)
+		rte_service_run_iter_on_app_lcore(service_id, 1);
+
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						port_id, 0, &a_stats);
+	if (err != 0) {
+		printf("Failed to get adaptive stats, err=%d\n", err);
+		goto adapter_stop;
+	}
+
+	/* The empty queue is polled less and less often */
+	if (a_stats.rx_packets != 0 || a_stats.rx_empty_poll_count == 0 ||
+	    a_stats.rx_poll_backoff <= 1 ||
+	    a_stats.rx_skip_count <= a_stats.rx_empty_poll_count) {
+		printf("No backoff: %" PRIu64 " empty polls, %" PRIu64
+		       " skipped polls, backoff %u\n",
+		       a_stats.rx_empty_poll_count, a_stats.rx_skip_count,
+		       a_stats.rx_poll_backoff);
+		goto adapter_stop;
+	}
+
+	/* The adapter has no queue event buffers, only adaptive stats */
+	err = rte_event_eth_rx_adapter_queue_stats_reset(TEST_INST_ID,
+							 port_id, 0);
+	if (err != 0) {
+		printf("Failed to reset queue stats, err=%d\n", err);
+		goto adapter_stop;
+	}
+	err = rte_event_eth_rx_adapter_queue_adaptive_stats_get(TEST_INST_ID,
+						port_id, 0, &a_stats);
+	if (err != 0 || a_stats.rx_empty_poll_count != 0 ||
+	    a_stats.rx_skip_count != 0) {
+		printf("Adaptive stats not reset by queue stats reset\n");
+		goto adapter_stop;
+	}
+
+	rc = TEST_SUCCESS;
+adapter_stop:
+	rte_event_eth_rx_adapter_stop(TEST_INST_ID);
+queue_del:
+	rte_event_eth_rx_adapter_queue_del(TEST_INST_ID, port_id, 0);
+port_stop:
+	rte_eth_dev_stop(port_id);
+	rte_eth_dev_close(port_id);
+vdev_uninit:
+	rte_vdev_uninit(TEST_NULL_NO_RX_NAME);
+
+	return rc;
+}
+
 static int
 adapter_create_free(void)
 {
@@ -1518,6 +1714,10 @@ static struct unit_test_suite event_eth_rx_tests = {
 			     adapter_queue_event_buf_test),
 		TEST_CASE_ST(adapter_create_with_params, adapter_free,
 			     adapter_queue_stats_test),
+		TEST_CASE_ST(adapter_create, adapter_free,
+			     adapter_queue_adaptive_test),
+		TEST_CASE_ST(adapter_create, adapter_free,
+			     adapter_queue_adaptive_backoff_test),
 		TEST_CASE_ST(adapter_create, adapter_free,
 			     adapter_pollq_instance_get),
 		TEST_CASE_ST(adapter_create, adapter_free,
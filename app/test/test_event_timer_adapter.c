@@ -424,6 +424,40 @@ timdev_setup_sec_periodic(void)
 	return _timdev_setup(180 * NSECPERSEC, NSECPERSEC, flags);
 }
 
+static int
+timdev_setup_usec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_WHEEL;
+
+	return using_services ?
+		/* Max timeout is 10,000us and bucket interval is 100us */
+		_timdev_setup(1E7, 1E5, flags) :
+		/* Max timeout is 100us and bucket interval is 1us */
+		_timdev_setup(1E5, 1E3, flags);
+}
+
+static int
+timdev_setup_sec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_WHEEL;
+
+	/* Max timeout is 100sec and bucket interval is 1sec */
+	return _timdev_setup(1E11, 1E9, flags);
+}
+
+static int
+timdev_setup_sec_periodic_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_PERIODIC |
+			 RTE_EVENT_TIMER_ADAPTER_F_WHEEL;
+
+	/* Periodic mode with 1 sec resolution */
+	return _timdev_setup(180 * NSECPERSEC, NSECPERSEC, flags);
+}
+
 static int
 timdev_setup_sec_multicore(void)
 {
@@ -1989,6 +2023,18 @@ static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 				test_timer_cancel_multicore),
 		TEST_CASE_ST(timdev_setup_sec_multicore, timdev_teardown,
 				test_timer_cancel_burst_multicore),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst_multicore),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel_random),
+		TEST_CASE_ST(timdev_setup_sec_periodic_wheel, timdev_teardown,
+				test_timer_cancel_periodic),
 		TEST_CASE(adapter_create),
 		TEST_CASE_ST(timdev_setup_msec, NULL, adapter_free),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
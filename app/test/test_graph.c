@@ -999,6 +999,328 @@ test_print_stats(void)
 	return 0;
 }
 
+static int
+test_graph_node_hist(void)
+{
+	/* 90% of the calls in bucket 1, 9% in bucket 20, 1% in bucket 40 */
+	const uint64_t hist[RTE_GRAPH_HIST_OBJS_BUCKETS] = {[1] = 90, [20] = 9, [40] = 1};
+	rte_graph_t cloned_graph_id = RTE_GRAPH_ID_INVALID;
+	struct rte_graph_param graph_conf = {0};
+	struct rte_node_hist *node_hist;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	uint64_t calls = 0;
+	int i, ret = 0;
+
+	if (rte_graph_node_hist_percentile(hist, RTE_DIM(hist), 50) != 1 ||
+	    rte_graph_node_hist_percentile(hist, RTE_DIM(hist), 99) != 25 ||
+	    rte_graph_node_hist_percentile(hist, RTE_DIM(hist), 99.9) != 143) {
+		printf("Wrong histogram percentile\n");
+		return -1;
+	}
+
+	rte_graph_node_hist_enable(true);
+	cloned_graph_id = rte_graph_clone(graph_id, "cloned-hist", &graph_conf);
+	rte_graph_node_hist_enable(false);
+	if (cloned_graph_id == RTE_GRAPH_ID_INVALID) {
+		printf("Failed to clone graph with histograms\n");
+		return -1;
+	}
+
+	graph = rte_graph_lookup("worker0-cloned-hist");
+	for (i = 0; i < 5; i++)
+		rte_graph_walk(graph);
+
+	node = rte_graph_node_get_by_name("worker0-cloned-hist", node_names[0]);
+	if (node == NULL || node->hist_off == 0) {
+		printf("No histogram in the cloned graph\n");
+		ret = -1;
+		goto fail;
+	}
+
+	/* Each call of the node is recorded once */
+	node_hist = RTE_PTR_ADD(node, node->hist_off);
+	for (i = 0; i < RTE_GRAPH_HIST_CYCLES_BUCKETS; i++)
+		calls += node_hist->cycles[i];
+	if (rte_graph_has_stats_feature() && calls != node->total_calls) {
+		printf("Histogram calls %" PRIu64 " expected %" PRIu64 "\n", calls,
+		       node->total_calls);
+		ret = -1;
+	}
+
+fail:
+	rte_graph_destroy(cloned_graph_id);
+
+	return ret;
+}
+
+/*
+ * Work steal model: the source node produces objects of a few flows on
+ * one graph only, the ordered node checks the flows are seen in order,
+ * and the streams of the work node are published and stolen.
+ */
+#define STEAL_TEST_FLOWS 4
+#define STEAL_TEST_BATCH 8
+#define STEAL_TEST_WALKS 64
+
+static struct rte_graph *steal_test_busy;
+static bool steal_test_produce;
+static uint64_t steal_test_produced;
+static uint64_t steal_test_local;
+static uint64_t steal_test_stolen;
+static uint32_t steal_test_seq[STEAL_TEST_FLOWS];
+static uint32_t steal_test_expected[STEAL_TEST_FLOWS];
+static bool steal_test_disorder;
+
+static uint16_t
+test_steal_src(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	uint32_t flow;
+	uint16_t i;
+
+	RTE_SET_USED(nb_objs);
+
+	if (graph != steal_test_busy || !steal_test_produce)
+		return 0;
+
+	/* The objects are never dereferenced, they encode a flow sequence */
+	objs = rte_node_next_stream_get(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+	for (i = 0; i < RTE_GRAPH_BURST_SIZE; i++) {
+		flow = i % STEAL_TEST_FLOWS;
+		objs[i] = (void *)(uintptr_t)((flow << 24) |
+					      steal_test_seq[flow]++);
+	}
+	rte_node_next_stream_put(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+	steal_test_produced += RTE_GRAPH_BURST_SIZE;
+
+	return RTE_GRAPH_BURST_SIZE;
+}
+
+static struct rte_node_register test_steal_src_node = {
+	.name = "test_steal_src",
+	.process = test_steal_src,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"test_steal_order"},
+};
+RTE_NODE_REGISTER(test_steal_src_node);
+
+static uint16_t
+test_steal_order(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	uint32_t flow, seq;
+	uint16_t i;
+
+	for (i = 0; i < nb_objs; i++) {
+		flow = (uintptr_t)objs[i] >> 24;
+		seq = (uintptr_t)objs[i] & 0xffffff;
+		if (seq != steal_test_expected[flow])
+			steal_test_disorder = true;
+		steal_test_expected[flow] = seq + 1;
+	}
+
+	rte_node_next_stream_move(graph, node, 0);
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_steal_order_node = {
+	.name = "test_steal_order",
+	.process = test_steal_order,
+	.nb_edges = 1,
+	.next_nodes = {"test_steal_work"},
+};
+RTE_NODE_REGISTER(test_steal_order_node);
+
+static uint16_t
+test_steal_work(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+
+	rte_node_next_stream_move(graph, node, 0);
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_steal_work_node = {
+	.name = "test_steal_work",
+	.process = test_steal_work,
+	.nb_edges = 1,
+	.next_nodes = {"test_steal_sink"},
+};
+RTE_NODE_REGISTER(test_steal_work_node);
+
+static uint16_t
+test_steal_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	if (graph == steal_test_busy)
+		steal_test_local += nb_objs;
+	else
+		steal_test_stolen += nb_objs;
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_steal_sink_node = {
+	.name = "test_steal_sink",
+	.process = test_steal_sink,
+};
+RTE_NODE_REGISTER(test_steal_sink_node);
+
+static rte_graph_t
+test_steal_graph_create(struct rte_graph_param *prm)
+{
+	static const char *patterns[] = {"test_steal_src", "test_steal_order",
+					 "test_steal_work", "test_steal_sink"};
+	rte_graph_t id;
+
+	memset(prm, 0, sizeof(*prm));
+	prm->socket_id = SOCKET_ID_ANY;
+	prm->node_patterns = patterns;
+	prm->nb_node_patterns = RTE_DIM(patterns);
+	prm->steal.batch_size = STEAL_TEST_BATCH;
+
+	steal_test_produce = true;
+	steal_test_produced = 0;
+	steal_test_local = 0;
+	steal_test_stolen = 0;
+	steal_test_disorder = false;
+	memset(steal_test_seq, 0, sizeof(steal_test_seq));
+	memset(steal_test_expected, 0, sizeof(steal_test_expected));
+
+	id = rte_graph_create("test_steal", prm);
+	if (id == RTE_GRAPH_ID_INVALID)
+		return id;
+
+	/* The model must be set before cloning to create the deques */
+	if (rte_graph_worker_model_set(RTE_GRAPH_MODEL_WORK_STEAL) != 0) {
+		rte_graph_destroy(id);
+		return RTE_GRAPH_ID_INVALID;
+	}
+
+	return id;
+}
+
+static int
+test_graph_work_steal_parent_walk(void)
+{
+	rte_graph_t id, clone_id = RTE_GRAPH_ID_INVALID;
+	struct rte_graph_param prm;
+	int i, ret = -1;
+
+	id = test_steal_graph_create(&prm);
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Work steal graph creation failed\n");
+		return -1;
+	}
+
+	/* Cloning sets up the steal group in the parent graph */
+	clone_id = rte_graph_clone(id, "w0", &prm);
+	if (clone_id == RTE_GRAPH_ID_INVALID) {
+		printf("Work steal graph clone failed\n");
+		goto fail;
+	}
+
+	/* The parent graph has no deque, it runs to completion */
+	steal_test_busy = rte_graph_lookup("test_steal");
+	for (i = 0; i < STEAL_TEST_WALKS; i++)
+		rte_graph_walk(steal_test_busy);
+
+	if (steal_test_local != steal_test_produced || steal_test_stolen != 0) {
+		printf("Parent graph processed %" PRIu64 " objs out of %" PRIu64 "\n",
+		       steal_test_local, steal_test_produced);
+		goto fail;
+	}
+	ret = 0;
+
+fail:
+	if (clone_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(clone_id);
+	rte_graph_destroy(id);
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_DEFAULT);
+
+	return ret;
+}
+
+static int
+test_graph_work_steal_ordered(void)
+{
+	rte_graph_t id, busy_id = RTE_GRAPH_ID_INVALID, idle_id = RTE_GRAPH_ID_INVALID;
+	struct rte_graph *busy, *idle;
+	struct rte_graph_param prm;
+	int i, ret = -1;
+
+	if (rte_graph_model_work_steal_node_ordered_set("test_steal_order", true) != 0) {
+		printf("Failed to set node ordered\n");
+		return -1;
+	}
+
+	id = test_steal_graph_create(&prm);
+	if (id == RTE_GRAPH_ID_INVALID) {
+		printf("Work steal graph creation failed\n");
+		return -1;
+	}
+
+	busy_id = rte_graph_clone(id, "busy", &prm);
+	idle_id = rte_graph_clone(id, "idle", &prm);
+	if (busy_id == RTE_GRAPH_ID_INVALID || idle_id == RTE_GRAPH_ID_INVALID) {
+		printf("Work steal graph clone failed\n");
+		goto fail;
+	}
+	busy = rte_graph_lookup("test_steal-busy");
+	idle = rte_graph_lookup("test_steal-idle");
+	steal_test_busy = busy;
+
+	/*
+	 * The idle graph finds no work and lets the busy graph publish,
+	 * then steals what the busy graph did not drain from its deque.
+	 */
+	rte_graph_walk(idle);
+	for (i = 0; i < STEAL_TEST_WALKS; i++) {
+		rte_graph_walk(busy);
+		rte_graph_walk(idle);
+	}
+
+	steal_test_produce = false;
+	for (i = 0; i < STEAL_TEST_WALKS; i++) {
+		rte_graph_walk(busy);
+		rte_graph_walk(idle);
+	}
+
+	if (steal_test_disorder) {
+		printf("Flow out of order in the ordered node\n");
+		goto fail;
+	}
+	if (steal_test_stolen == 0) {
+		printf("No object stolen\n");
+		goto fail;
+	}
+	if (steal_test_local + steal_test_stolen != steal_test_produced) {
+		printf("Processed %" PRIu64 " objs out of %" PRIu64 "\n",
+		       steal_test_local + steal_test_stolen, steal_test_produced);
+		goto fail;
+	}
+	ret = 0;
+
+fail:
+	if (idle_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(idle_id);
+	if (busy_id != RTE_GRAPH_ID_INVALID)
+		rte_graph_destroy(busy_id);
+	rte_graph_destroy(id);
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_DEFAULT);
+	rte_graph_model_work_steal_node_ordered_set("test_steal_order", false);
+
+	return ret;
+}
+
 static int
 graph_setup(void)
 {
@@ -1055,6 +1377,9 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
 		TEST_CASE(test_print_stats),
+		TEST_CASE(test_graph_node_hist),
+		TEST_CASE(test_graph_work_steal_parent_walk),
+		TEST_CASE(test_graph_work_steal_ordered),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
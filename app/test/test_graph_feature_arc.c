@@ -0,0 +1,401 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+
+#include "test.h"
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_graph_feature_arc(void)
+{
+	printf("graph_feature_arc not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+static int
+test_graph_feature_arc_perf(void)
+{
+	printf("graph_feature_arc_perf not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_graph.h>
+#include <rte_graph_feature_arc.h>
+#include <rte_graph_worker.h>
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
+
+#define ARC_NAME       "arc_test"
+#define ARC_GRAPH      "arc_test_graph"
+#define ARC_SRC        "arc_test_src"
+#define ARC_START      "arc_test_start"
+#define ARC_FEAT0      "arc_test_feat0"
+#define ARC_FEAT1      "arc_test_feat1"
+#define ARC_END        "arc_test_end"
+#define ARC_INDEXES    2
+#define ARC_NB_PKTS    RTE_GRAPH_BURST_SIZE
+#define ARC_PERF_WALKS 100000
+
+struct arc_test_pkt {
+	uint16_t index;
+	uint8_t feature; /* Current feature of the packet in the arc */
+	uint8_t nb_visited;
+	uint8_t visited[2];
+	uint32_t data;
+};
+
+static struct arc_test_pkt arc_pkts[ARC_NB_PKTS];
+static void *arc_objs[ARC_NB_PKTS];
+/* The start node bypasses the arc when NULL */
+static struct rte_graph_feature_arc *arc_test_arc;
+static uint64_t arc_end_objs;
+
+static uint16_t
+arc_test_src(struct rte_graph *graph, struct rte_node *node, void **objs,
+	     uint16_t nb_objs)
+{
+	void **to_next;
+	uint16_t i;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	for (i = 0; i < ARC_NB_PKTS; i++)
+		arc_pkts[i].nb_visited = 0;
+
+	to_next = rte_node_next_stream_get(graph, node, 0, ARC_NB_PKTS);
+	memcpy(to_next, arc_objs, ARC_NB_PKTS * sizeof(void *));
+	rte_node_next_stream_put(graph, node, 0, ARC_NB_PKTS);
+
+	return ARC_NB_PKTS;
+}
+
+static struct rte_node_register arc_test_src_node = {
+	.name = ARC_SRC,
+	.process = arc_test_src,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {ARC_START},
+};
+
+RTE_NODE_REGISTER(arc_test_src_node);
+
+static uint16_t
+arc_test_start(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	const struct rte_graph_feature_arc *arc = arc_test_arc;
+	struct arc_test_pkt *pkt;
+	rte_edge_t edge;
+	uint16_t i;
+
+	if (arc == NULL || likely(!rte_graph_feature_arc_has_any(arc))) {
+		rte_node_next_stream_move(graph, node, 0);
+		return nb_objs;
+	}
+
+	for (i = 0; i < nb_objs; i++) {
+		pkt = objs[i];
+		edge = rte_graph_feature_arc_first(arc, pkt->index, &pkt->feature);
+		rte_node_enqueue_x1(graph, node, edge, objs[i]);
+	}
+
+	return nb_objs;
+}
+
+static struct rte_node_register arc_test_start_node = {
+	.name = ARC_START,
+	.process = arc_test_start,
+	.nb_edges = 1,
+	.next_nodes = {ARC_END},
+};
+
+RTE_NODE_REGISTER(arc_test_start_node);
+
+static uint16_t
+arc_test_feat(struct rte_graph *graph, struct rte_node *node, void **objs,
+	      uint16_t nb_objs)
+{
+	const struct rte_graph_feature_arc *arc = arc_test_arc;
+	struct arc_test_pkt *pkt;
+	rte_edge_t edge;
+	uint16_t i;
+
+	for (i = 0; i < nb_objs; i++) {
+		pkt = objs[i];
+		if (pkt->nb_visited < RTE_DIM(pkt->visited))
+			pkt->visited[pkt->nb_visited++] = pkt->feature;
+		pkt->data = rte_graph_feature_data_get(arc, pkt->index, pkt->feature);
+		edge = rte_graph_feature_arc_next(arc, pkt->index, pkt->feature,
+						  &pkt->feature);
+		rte_node_enqueue_x1(graph, node, edge, objs[i]);
+	}
+
+	return nb_objs;
+}
+
+static struct rte_node_register arc_test_feat0_node = {
+	.name = ARC_FEAT0,
+	.process = arc_test_feat,
+};
+
+RTE_NODE_REGISTER(arc_test_feat0_node);
+
+static struct rte_node_register arc_test_feat1_node = {
+	.name = ARC_FEAT1,
+	.process = arc_test_feat,
+};
+
+RTE_NODE_REGISTER(arc_test_feat1_node);
+
+static uint16_t
+arc_test_end(struct rte_graph *graph, struct rte_node *node, void **objs,
+	     uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	arc_end_objs += nb_objs;
+
+	return nb_objs;
+}
+
+static struct rte_node_register arc_test_end_node = {
+	.name = ARC_END,
+	.process = arc_test_end,
+};
+
+RTE_NODE_REGISTER(arc_test_end_node);
+
+static rte_graph_t
+arc_test_setup(void)
+{
+	const char *patterns[] = {ARC_SRC, ARC_START, ARC_FEAT0, ARC_FEAT1, ARC_END};
+	struct rte_graph_param prm;
+	rte_graph_t id;
+	uint16_t i;
+
+	for (i = 0; i < ARC_NB_PKTS; i++) {
+		arc_pkts[i].index = i % ARC_INDEXES;
+		arc_objs[i] = &arc_pkts[i];
+	}
+
+	arc_test_arc = rte_graph_feature_arc_create(ARC_NAME, ARC_START, ARC_END,
+						    ARC_INDEXES, SOCKET_ID_ANY);
+	if (arc_test_arc == NULL) {
+		printf("Failed to create feature arc\n");
+		return RTE_GRAPH_ID_INVALID;
+	}
+
+	/* Features are added before the graph is created */
+	if (rte_graph_feature_add(arc_test_arc, ARC_FEAT0) != 0 ||
+	    rte_graph_feature_add(arc_test_arc, ARC_FEAT1) != 0) {
+		printf("Failed to add features\n");
+		goto arc_destroy;
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = SOCKET_ID_ANY;
+	prm.node_patterns = patterns;
+	prm.nb_node_patterns = RTE_DIM(patterns);
+
+	id = rte_graph_create(ARC_GRAPH, &prm);
+	if (id != RTE_GRAPH_ID_INVALID)
+		return id;
+
+	printf("Failed to create graph\n");
+arc_destroy:
+	rte_graph_feature_arc_destroy(arc_test_arc);
+	arc_test_arc = NULL;
+	return RTE_GRAPH_ID_INVALID;
+}
+
+static void
+arc_test_teardown(rte_graph_t id)
+{
+	rte_graph_destroy(id);
+	rte_graph_feature_arc_destroy(arc_test_arc);
+	arc_test_arc = NULL;
+}
+
+/* Check the features visited by the packets of an index */
+static int
+arc_test_check(uint16_t index, const uint8_t *features, uint8_t nb_features)
+{
+	uint16_t i;
+
+	for (i = index; i < ARC_NB_PKTS; i += ARC_INDEXES) {
+		if (arc_pkts[i].nb_visited != nb_features ||
+		    memcmp(arc_pkts[i].visited, features, nb_features) != 0) {
+			printf("Packet %u of index %u visited %u features, expected %u\n",
+			       i, index, arc_pkts[i].nb_visited, nb_features);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int
+test_graph_feature_arc(void)
+{
+	const uint8_t feat0[] = {0}, feat1[] = {1}, both[] = {0, 1};
+	struct rte_rcu_qsbr *qsbr = NULL;
+	struct rte_graph *graph;
+	int ret = TEST_FAILED;
+	rte_graph_t id;
+	size_t sz;
+
+	id = arc_test_setup();
+	if (id == RTE_GRAPH_ID_INVALID)
+		return TEST_FAILED;
+	graph = rte_graph_lookup(ARC_GRAPH);
+
+	TEST_ASSERT_EQUAL(rte_graph_feature_arc_lookup(ARC_NAME), arc_test_arc,
+			  "Feature arc lookup failed");
+	TEST_ASSERT_NULL(rte_graph_feature_arc_create(ARC_NAME, ARC_START, ARC_END,
+						      ARC_INDEXES, SOCKET_ID_ANY),
+			 "Duplicate feature arc created");
+	TEST_ASSERT_EQUAL(rte_graph_feature_add(arc_test_arc, ARC_FEAT0), -EEXIST,
+			  "Duplicate feature added");
+	TEST_ASSERT_EQUAL(rte_graph_feature_add(arc_test_arc, ARC_SRC), -EBUSY,
+			  "Feature added to an arc in use");
+	TEST_ASSERT_EQUAL(rte_graph_feature_lookup(arc_test_arc, ARC_FEAT1), 1,
+			  "Feature lookup failed");
+
+	/* No feature enabled */
+	arc_end_objs = 0;
+	rte_graph_walk(graph);
+	if (arc_test_check(0, feat0, 0) || arc_test_check(1, feat0, 0))
+		goto out;
+	TEST_ASSERT_EQUAL(arc_end_objs, ARC_NB_PKTS, "Objects lost in the arc");
+
+	/* Features run in the order they were added */
+	TEST_ASSERT_SUCCESS(rte_graph_feature_enable(arc_test_arc, 1, ARC_FEAT1, 11),
+			    "Failed to enable feature");
+	TEST_ASSERT_SUCCESS(rte_graph_feature_enable(arc_test_arc, 1, ARC_FEAT0, 10),
+			    "Failed to enable feature");
+	TEST_ASSERT_SUCCESS(rte_graph_feature_enable(arc_test_arc, 0, ARC_FEAT0, 0),
+			    "Failed to enable feature");
+	TEST_ASSERT_EQUAL(rte_graph_feature_enable(arc_test_arc, 0, ARC_FEAT0, 0),
+			  -EALREADY, "Feature enabled twice");
+	TEST_ASSERT_FAIL(rte_graph_feature_enable(arc_test_arc, ARC_INDEXES, ARC_FEAT0, 0),
+			 "Feature enabled on invalid index");
+
+	arc_end_objs = 0;
+	rte_graph_walk(graph);
+	if (arc_test_check(0, feat0, 1) || arc_test_check(1, both, 2))
+		goto out;
+	TEST_ASSERT_EQUAL(arc_end_objs, ARC_NB_PKTS, "Objects lost in the arc");
+	TEST_ASSERT_EQUAL(arc_pkts[1].data, 11, "Wrong feature data");
+
+	/* Disable a feature once the worker went through a quiescent state */
+	sz = rte_rcu_qsbr_get_memsize(1);
+	qsbr = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (qsbr == NULL || rte_rcu_qsbr_init(qsbr, 1) != 0)
+		goto out;
+	rte_rcu_qsbr_thread_register(qsbr, 0);
+	rte_rcu_qsbr_thread_online(qsbr, 0);
+	rte_graph_walk(graph);
+	rte_rcu_qsbr_quiescent(qsbr, 0);
+	rte_rcu_qsbr_thread_offline(qsbr, 0);
+
+	TEST_ASSERT_SUCCESS(rte_graph_feature_disable(arc_test_arc, 1, ARC_FEAT0, qsbr),
+			    "Failed to disable feature");
+	TEST_ASSERT_EQUAL(rte_graph_feature_disable(arc_test_arc, 1, ARC_FEAT0, NULL),
+			  -EALREADY, "Feature disabled twice");
+
+	rte_graph_walk(graph);
+	if (arc_test_check(0, feat0, 1) || arc_test_check(1, feat1, 1))
+		goto out;
+
+	TEST_ASSERT_SUCCESS(rte_graph_feature_disable(arc_test_arc, 0, ARC_FEAT0, NULL),
+			    "Failed to disable feature");
+	TEST_ASSERT_SUCCESS(rte_graph_feature_disable(arc_test_arc, 1, ARC_FEAT1, NULL),
+			    "Failed to disable feature");
+	TEST_ASSERT(!rte_graph_feature_arc_has_any(arc_test_arc),
+		    "Feature still enabled on the arc");
+
+	rte_graph_walk(graph);
+	if (arc_test_check(0, feat0, 0) || arc_test_check(1, feat0, 0))
+		goto out;
+
+	ret = TEST_SUCCESS;
+out:
+	rte_free(qsbr);
+	arc_test_teardown(id);
+	return ret;
+}
+
+/* Average walk cost per object, in TSC cycles */
+static double
+arc_test_walk_cycles(struct rte_graph *graph)
+{
+	uint64_t start;
+	unsigned int i;
+
+	start = rte_rdtsc_precise();
+	for (i = 0; i < ARC_PERF_WALKS; i++)
+		rte_graph_walk(graph);
+
+	return (double)(rte_rdtsc_precise() - start) / ARC_PERF_WALKS / ARC_NB_PKTS;
+}
+
+static int
+test_graph_feature_arc_perf(void)
+{
+	struct rte_graph_feature_arc *arc;
+	struct rte_graph *graph;
+	double cycles;
+	rte_graph_t id;
+
+	id = arc_test_setup();
+	if (id == RTE_GRAPH_ID_INVALID)
+		return TEST_FAILED;
+	graph = rte_graph_lookup(ARC_GRAPH);
+	arc = arc_test_arc;
+
+	printf("Graph walk cost with a feature arc of 2 features:\n");
+
+	arc_test_arc = NULL;
+	cycles = arc_test_walk_cycles(graph);
+	printf("  no arc: %.2f cycles/obj\n", cycles);
+
+	arc_test_arc = arc;
+	cycles = arc_test_walk_cycles(graph);
+	printf("  arc, no feature enabled: %.2f cycles/obj\n", cycles);
+
+	rte_graph_feature_enable(arc, 1, ARC_FEAT0, 0);
+	cycles = arc_test_walk_cycles(graph);
+	printf("  arc, 1 feature enabled on 1 of %u indexes: %.2f cycles/obj\n",
+	       ARC_INDEXES, cycles);
+
+	rte_graph_feature_enable(arc, 0, ARC_FEAT0, 0);
+	rte_graph_feature_enable(arc, 0, ARC_FEAT1, 0);
+	rte_graph_feature_enable(arc, 1, ARC_FEAT1, 0);
+	cycles = arc_test_walk_cycles(graph);
+	printf("  arc, 2 features enabled on all indexes: %.2f cycles/obj\n", cycles);
+
+	rte_graph_feature_disable(arc, 0, ARC_FEAT0, NULL);
+	rte_graph_feature_disable(arc, 0, ARC_FEAT1, NULL);
+	rte_graph_feature_disable(arc, 1, ARC_FEAT0, NULL);
+	rte_graph_feature_disable(arc, 1, ARC_FEAT1, NULL);
+	arc_test_teardown(id);
+
+	return TEST_SUCCESS;
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_FAST_TEST(graph_feature_arc_autotest, true, true, test_graph_feature_arc);
+REGISTER_PERF_TEST(graph_feature_arc_perf_autotest, test_graph_feature_arc_perf);
@@ -27,6 +27,8 @@ test_graph_perf_func(void)
 #include <rte_lcore.h>
 #include <rte_malloc.h>
 #include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_stdatomic.h>
 
 #define TEST_GRAPH_PERF_MZ	     "graph_perf_data"
 #define TEST_GRAPH_SRC_NAME	     "test_graph_perf_source"
@@ -979,6 +981,211 @@ graph_init_parallel_tree(void)
 			  snk_map, edge_map, 0);
 }
 
+#define TEST_GRAPH_DISP_NAME	"graph_perf_disp"
+#define TEST_GRAPH_DISP_SRC	"test_graph_perf_disp_source"
+#define TEST_GRAPH_DISP_SLOW	"test_graph_perf_disp_slow"
+/* Cost of the slow consumer for one object, in TSC cycles */
+#define TEST_GRAPH_DISP_OBJ_CYCLES 200
+#define TEST_GRAPH_DISP_INTERVALS  10
+#define TEST_GRAPH_DISP_COALESCE   64
+
+static RTE_ATOMIC(uint64_t) disp_slow_objs[RTE_MAX_LCORE];
+static RTE_ATOMIC(bool) disp_stop;
+
+static uint16_t
+test_perf_node_disp_source(struct rte_graph *graph, struct rte_node *node,
+			   void **objs, uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	/* The objects are never dereferenced, leave the stream as is */
+	rte_node_next_stream_get(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+	rte_node_next_stream_put(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+
+	return RTE_GRAPH_BURST_SIZE;
+}
+
+static struct rte_node_register test_graph_perf_disp_source = {
+	.name = TEST_GRAPH_DISP_SRC,
+	.process = test_perf_node_disp_source,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {TEST_GRAPH_DISP_SLOW},
+};
+
+RTE_NODE_REGISTER(test_graph_perf_disp_source);
+
+static uint16_t
+test_perf_node_disp_slow(struct rte_graph *graph, struct rte_node *node,
+			 void **objs, uint16_t nb_objs)
+{
+	uint64_t end;
+
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	end = rte_rdtsc() + (uint64_t)nb_objs * TEST_GRAPH_DISP_OBJ_CYCLES;
+	while (rte_rdtsc() < end)
+		rte_pause();
+
+	rte_atomic_fetch_add_explicit(&disp_slow_objs[rte_lcore_id()], nb_objs,
+				      rte_memory_order_relaxed);
+
+	return nb_objs;
+}
+
+static struct rte_node_register test_graph_perf_disp_slow = {
+	.name = TEST_GRAPH_DISP_SLOW,
+	.process = test_perf_node_disp_slow,
+};
+
+RTE_NODE_REGISTER(test_graph_perf_disp_slow);
+
+static int
+graph_perf_disp_worker(void *arg)
+{
+	struct rte_graph *graph = arg;
+
+	while (!rte_atomic_load_explicit(&disp_stop, rte_memory_order_relaxed))
+		rte_graph_walk(graph);
+
+	return 0;
+}
+
+/*
+ * The source on the first lcore produces objects faster than the slow node
+ * bound to the second lcore can process them. Print the throughput of the
+ * slow node on its lcore over several intervals, and the objects which were
+ * processed on the source lcore instead.
+ */
+static int
+graph_perf_disp_run(bool backpressure)
+{
+	const char *patterns[] = {TEST_GRAPH_DISP_SRC, TEST_GRAPH_DISP_SLOW};
+	uint64_t sched_objs = 0, sched_fail = 0, sched_stall = 0, local;
+	uint64_t prev, cur, start, rate, min = UINT64_MAX, max = 0;
+	rte_graph_t id, clones[2] = {RTE_GRAPH_ID_INVALID, RTE_GRAPH_ID_INVALID};
+	unsigned int lcores[2], i;
+	struct rte_graph_param prm;
+	struct rte_node *node;
+	char name[RTE_GRAPH_NAMESIZE];
+	int ret = TEST_FAILED;
+
+	lcores[0] = rte_get_next_lcore(-1, 1, 0);
+	lcores[1] = rte_get_next_lcore(lcores[0], 1, 0);
+
+	if (rte_graph_model_mcore_dispatch_node_lcore_affinity_set(TEST_GRAPH_DISP_SRC,
+								   lcores[0]) ||
+	    rte_graph_model_mcore_dispatch_node_lcore_affinity_set(TEST_GRAPH_DISP_SLOW,
+								   lcores[1]) ||
+	    rte_graph_model_mcore_dispatch_node_backpressure_set(TEST_GRAPH_DISP_SLOW,
+								 backpressure) ||
+	    rte_graph_model_mcore_dispatch_node_coalesce_set(TEST_GRAPH_DISP_SLOW,
+							     backpressure ?
+							     TEST_GRAPH_DISP_COALESCE : 0,
+							     rte_get_timer_hz() / 100000)) {
+		printf("Failed to configure dispatch nodes\n");
+		return TEST_FAILED;
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = SOCKET_ID_ANY;
+	prm.node_patterns = patterns;
+	prm.nb_node_patterns = RTE_DIM(patterns);
+
+	id = rte_graph_create(TEST_GRAPH_DISP_NAME, &prm);
+	if (id == RTE_GRAPH_ID_INVALID)
+		return TEST_FAILED;
+
+	/* The model must be set before cloning to create the work queues */
+	if (rte_graph_worker_model_set(RTE_GRAPH_MODEL_MCORE_DISPATCH) != 0)
+		goto graph_destroy;
+
+	for (i = 0; i < RTE_DIM(clones); i++) {
+		snprintf(name, sizeof(name), "w%u", i);
+		clones[i] = rte_graph_clone(id, name, &prm);
+		if (clones[i] == RTE_GRAPH_ID_INVALID ||
+		    rte_graph_model_mcore_dispatch_core_bind(clones[i], lcores[i]) != 0)
+			goto graph_destroy;
+	}
+
+	memset(disp_slow_objs, 0, sizeof(disp_slow_objs));
+	rte_atomic_store_explicit(&disp_stop, false, rte_memory_order_relaxed);
+	for (i = 0; i < RTE_DIM(clones); i++)
+		rte_eal_remote_launch(graph_perf_disp_worker,
+				      rte_graph_lookup(rte_graph_id_to_name(clones[i])),
+				      lcores[i]);
+
+	prev = 0;
+	for (i = 0; i < TEST_GRAPH_DISP_INTERVALS; i++) {
+		start = rte_get_timer_cycles();
+		rte_delay_ms(100);
+		cur = rte_atomic_load_explicit(&disp_slow_objs[lcores[1]],
+					       rte_memory_order_relaxed);
+		rate = (cur - prev) * rte_get_timer_hz() / (rte_get_timer_cycles() - start);
+		min = RTE_MIN(min, rate);
+		max = RTE_MAX(max, rate);
+		prev = cur;
+	}
+
+	rte_atomic_store_explicit(&disp_stop, true, rte_memory_order_relaxed);
+	for (i = 0; i < RTE_DIM(clones); i++)
+		rte_eal_wait_lcore(lcores[i]);
+
+	local = rte_atomic_load_explicit(&disp_slow_objs[lcores[0]], rte_memory_order_relaxed);
+	for (i = 0; i < RTE_DIM(clones); i++) {
+		node = rte_graph_node_get(clones[i], rte_node_from_name(TEST_GRAPH_DISP_SLOW));
+		if (node == NULL) {
+			printf("Node %s not found in graph %s\n", TEST_GRAPH_DISP_SLOW,
+			       rte_graph_id_to_name(clones[i]));
+			ret = TEST_FAILED;
+			goto graph_destroy;
+		}
+		sched_objs += node->dispatch.total_sched_objs;
+		sched_fail += node->dispatch.total_sched_fail;
+		sched_stall += node->dispatch.total_sched_stall;
+	}
+
+	printf("  backpressure %s: slow node %" PRIu64 "-%" PRIu64 " objs/sec,"
+	       " %" PRIu64 " objs on source lcore\n", backpressure ? "on" : "off",
+	       min, max, local);
+	printf("  sched objs %" PRIu64 ", sched fail %" PRIu64 ", sched stall %" PRIu64 "\n",
+	       sched_objs, sched_fail, sched_stall);
+
+	ret = TEST_SUCCESS;
+	/* With backpressure, the slow node never runs out of its lcore */
+	if (backpressure && (sched_fail != 0 || local != 0)) {
+		printf("Slow node objects processed on the source lcore\n");
+		ret = TEST_FAILED;
+	}
+
+graph_destroy:
+	for (i = 0; i < RTE_DIM(clones); i++)
+		if (clones[i] != RTE_GRAPH_ID_INVALID)
+			rte_graph_destroy(clones[i]);
+	rte_graph_destroy(id);
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_DEFAULT);
+
+	return ret;
+}
+
+static int
+graph_mcore_dispatch_slow_consumer(void)
+{
+	if (rte_lcore_count() < 3) {
+		printf("Test requires at least 3 lcores\n");
+		return TEST_SKIPPED;
+	}
+
+	printf("Mcore dispatch, slow consumer on a dedicated lcore\n");
+	if (graph_perf_disp_run(false) != TEST_SUCCESS)
+		return TEST_FAILED;
+
+	return graph_perf_disp_run(true);
+}
+
 /** Graph Creation cheat sheet
  *  edge_map -> dictates graph flow from worker stage 0 to worker stage n-1.
  *  src_map  -> dictates source nodes enqueue percentage to worker stage 0.
@@ -1061,6 +1268,7 @@ static struct unit_test_suite graph_perf_testsuite = {
 			     graph_reverse_tree_3s_4n_1src_1snk),
 		TEST_CASE_ST(graph_init_parallel_tree, graph_fini,
 			     graph_parallel_tree_5s_4n_4src_4snk),
+		TEST_CASE(graph_mcore_dispatch_slow_consumer),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
 };
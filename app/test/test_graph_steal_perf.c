@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_pause.h>
+#include <rte_stdatomic.h>
+
+#include "test.h"
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_graph_steal_perf(void)
+{
+	printf("graph_steal_perf not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+
+#define STEAL_PERF_GRAPH   "steal_perf"
+#define STEAL_PERF_SRC     "steal_perf_src"
+#define STEAL_PERF_WORK    "steal_perf_work"
+#define STEAL_PERF_SINK    "steal_perf_sink"
+#define STEAL_PERF_WORKERS 4
+/* Cost of the work node for one object, in TSC cycles */
+#define STEAL_PERF_OBJ_CYCLES 500
+#define STEAL_PERF_DURATION_MS 1000
+
+/* Only the source node of this graph produces objects */
+static struct rte_graph *steal_perf_busy;
+static RTE_ATOMIC(bool) steal_perf_stop;
+static uint64_t steal_perf_objs[RTE_MAX_LCORE];
+
+static uint16_t
+steal_perf_src(struct rte_graph *graph, struct rte_node *node, void **objs,
+	       uint16_t nb_objs)
+{
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (graph != steal_perf_busy)
+		return 0;
+
+	/* The objects are never dereferenced, leave the stream as is */
+	rte_node_next_stream_get(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+	rte_node_next_stream_put(graph, node, 0, RTE_GRAPH_BURST_SIZE);
+
+	return RTE_GRAPH_BURST_SIZE;
+}
+
+static struct rte_node_register steal_perf_src_node = {
+	.name = STEAL_PERF_SRC,
+	.process = steal_perf_src,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {STEAL_PERF_WORK},
+};
+
+RTE_NODE_REGISTER(steal_perf_src_node);
+
+static uint16_t
+steal_perf_work(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	uint64_t end;
+
+	RTE_SET_USED(objs);
+
+	end = rte_rdtsc() + (uint64_t)nb_objs * STEAL_PERF_OBJ_CYCLES;
+	while (rte_rdtsc() < end)
+		rte_pause();
+
+	rte_node_next_stream_move(graph, node, 0);
+
+	return nb_objs;
+}
+
+static struct rte_node_register steal_perf_work_node = {
+	.name = STEAL_PERF_WORK,
+	.process = steal_perf_work,
+	.nb_edges = 1,
+	.next_nodes = {STEAL_PERF_SINK},
+};
+
+RTE_NODE_REGISTER(steal_perf_work_node);
+
+static uint16_t
+steal_perf_sink(struct rte_graph *graph, struct rte_node *node, void **objs,
+		uint16_t nb_objs)
+{
+	RTE_SET_USED(graph);
+	RTE_SET_USED(node);
+	RTE_SET_USED(objs);
+
+	steal_perf_objs[rte_lcore_id()] += nb_objs;
+
+	return nb_objs;
+}
+
+static struct rte_node_register steal_perf_sink_node = {
+	.name = STEAL_PERF_SINK,
+	.process = steal_perf_sink,
+};
+
+RTE_NODE_REGISTER(steal_perf_sink_node);
+
+static int
+steal_perf_worker(void *arg)
+{
+	struct rte_graph *graph = arg;
+
+	while (!rte_atomic_load_explicit(&steal_perf_stop, rte_memory_order_relaxed))
+		rte_graph_walk(graph);
+
+	return 0;
+}
+
+/*
+ * Run one busy and several idle graphs with the given model, return the
+ * number of objects processed per second, or 0 on error.
+ */
+static uint64_t
+steal_perf_run(uint8_t model, unsigned int nb_workers)
+{
+	const char *patterns[] = {STEAL_PERF_SRC, STEAL_PERF_WORK, STEAL_PERF_SINK};
+	rte_graph_t clones[STEAL_PERF_WORKERS];
+	unsigned int lcores[STEAL_PERF_WORKERS];
+	uint64_t publish = 0, steal = 0, objs = 0;
+	struct rte_graph_param prm;
+	char name[RTE_GRAPH_NAMESIZE];
+	struct rte_node *node;
+	unsigned int i, lcore_id;
+	rte_graph_t id;
+	uint64_t start;
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = SOCKET_ID_ANY;
+	prm.node_patterns = patterns;
+	prm.nb_node_patterns = RTE_DIM(patterns);
+
+	id = rte_graph_create(STEAL_PERF_GRAPH, &prm);
+	if (id == RTE_GRAPH_ID_INVALID)
+		return 0;
+
+	/* The model must be set before cloning to create the deques */
+	if (rte_graph_worker_model_set(model) != 0)
+		goto graph_destroy;
+
+	for (i = 0; i < nb_workers; i++) {
+		snprintf(name, sizeof(name), "w%u", i);
+		clones[i] = rte_graph_clone(id, name, &prm);
+		if (clones[i] == RTE_GRAPH_ID_INVALID)
+			goto clones_destroy;
+	}
+
+	steal_perf_busy = rte_graph_lookup(STEAL_PERF_GRAPH "-w0");
+	rte_atomic_store_explicit(&steal_perf_stop, false, rte_memory_order_relaxed);
+	memset(steal_perf_objs, 0, sizeof(steal_perf_objs));
+
+	lcore_id = -1;
+	for (i = 0; i < nb_workers; i++) {
+		lcore_id = rte_get_next_lcore(lcore_id, 1, 0);
+		lcores[i] = lcore_id;
+		snprintf(name, sizeof(name), STEAL_PERF_GRAPH "-w%u", i);
+		rte_eal_remote_launch(steal_perf_worker, rte_graph_lookup(name),
+				      lcore_id);
+	}
+
+	start = rte_get_timer_cycles();
+	rte_delay_ms(STEAL_PERF_DURATION_MS);
+	rte_atomic_store_explicit(&steal_perf_stop, true, rte_memory_order_relaxed);
+	for (i = 0; i < nb_workers; i++)
+		rte_eal_wait_lcore(lcores[i]);
+	start = rte_get_timer_cycles() - start;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		objs += steal_perf_objs[i];
+
+	for (i = 0; i < nb_workers; i++) {
+		node = rte_graph_node_get(clones[i], rte_node_from_name(STEAL_PERF_WORK));
+		if (node == NULL)
+			continue;
+		publish += node->steal.total_publish_objs;
+		steal += node->steal.total_steal_objs;
+	}
+
+	if (model == RTE_GRAPH_MODEL_WORK_STEAL)
+		printf("  published objs: %" PRIu64 ", stolen objs: %" PRIu64 "\n",
+		       publish, steal);
+
+	objs = objs * rte_get_timer_hz() / start;
+	i = nb_workers;
+
+clones_destroy:
+	while (i-- > 0)
+		rte_graph_destroy(clones[i]);
+graph_destroy:
+	rte_graph_destroy(id);
+	rte_graph_worker_model_set(RTE_GRAPH_MODEL_DEFAULT);
+
+	return objs;
+}
+
+static int
+test_graph_steal_perf(void)
+{
+	unsigned int nb_workers = RTE_MIN(rte_lcore_count() - 1,
+					  (unsigned int)STEAL_PERF_WORKERS);
+	uint64_t rtc, steal;
+
+	if (nb_workers < 2) {
+		printf("Need at least 2 worker lcores, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	/* The sink only counts, publishing its streams would cost more than it saves */
+	if (rte_graph_model_work_steal_node_ordered_set(STEAL_PERF_SINK, true) != 0) {
+		printf("Failed to set node %s ordered\n", STEAL_PERF_SINK);
+		return TEST_FAILED;
+	}
+
+	printf("Imbalanced graph, 1 busy graph out of %u\n", nb_workers);
+
+	rtc = steal_perf_run(RTE_GRAPH_MODEL_RTC, nb_workers);
+	if (rtc == 0) {
+		printf("Failed to run graphs with rtc model\n");
+		return TEST_FAILED;
+	}
+	printf("  rtc model: %" PRIu64 " objs/sec\n", rtc);
+
+	steal = steal_perf_run(RTE_GRAPH_MODEL_WORK_STEAL, nb_workers);
+	if (steal == 0) {
+		printf("Failed to run graphs with work steal model\n");
+		return TEST_FAILED;
+	}
+	printf("  work steal model: %" PRIu64 " objs/sec (%.2fx)\n", steal,
+	       (double)steal / rtc);
+
+	return TEST_SUCCESS;
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_PERF_TEST(graph_steal_perf_autotest, test_graph_steal_perf);
@@ -0,0 +1,228 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_tcp.h>
+
+#include "test.h"
+
+/*
+ * The flow tables of a GRO context are indexed by a hash table with
+ * linear probing, at most half full. With tens of flows, the home
+ * positions of some flows collide, so their lookups go through probe
+ * sequences. The flows are deleted from the index when flushed; partial
+ * flushes remove flows from the middle of the probe sequences, and the
+ * following lookups must still find the flows left in the table.
+ */
+#define MAX_FLOWS 1024
+#define ROUNDS 8
+#define PAYLOAD_LEN 64
+#define HDR_LEN (sizeof(struct rte_ether_hdr) + \
+		sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_tcp_hdr))
+#define MBUF_DATA_SIZE (RTE_PKTMBUF_HEADROOM + HDR_LEN + PAYLOAD_LEN)
+#define NB_MBUF (MAX_FLOWS * ROUNDS + MAX_FLOWS)
+
+static const uint32_t flow_nums[] = { 16, 64, MAX_FLOWS };
+
+static struct rte_mempool *pkt_pool;
+/* Next sequence number and number of segments held by GRO, per flow */
+static uint32_t flow_seq[MAX_FLOWS];
+static uint32_t flow_segs[MAX_FLOWS];
+
+static struct rte_mbuf *
+build_tcp4_pkt(uint32_t flow, uint32_t seq)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m,
+			HDR_LEN + PAYLOAD_LEN);
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+
+	memset(eth, 0, HDR_LEN);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + sizeof(*tcp) +
+			PAYLOAD_LEN);
+	ip->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip->time_to_live = 64;
+	ip->next_proto_id = IPPROTO_TCP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(10, 1, 0, 0) + flow);
+	tcp->src_port = rte_cpu_to_be_16(1024);
+	tcp->dst_port = rte_cpu_to_be_16(80);
+	tcp->sent_seq = rte_cpu_to_be_32(seq);
+	tcp->data_off = (sizeof(*tcp) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+
+	m->l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip);
+	m->l4_len = sizeof(*tcp);
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+		RTE_PTYPE_L4_TCP;
+
+	return m;
+}
+
+/* Check the packets flushed by GRO hold all the segments of their flow */
+static int
+check_flushed(struct rte_mbuf **pkts, uint16_t nb_pkts, uint32_t nb_flows)
+{
+	const struct rte_ipv4_hdr *ip;
+	uint32_t flow;
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		ip = rte_pktmbuf_mtod_offset(pkts[i], const struct rte_ipv4_hdr *,
+				sizeof(struct rte_ether_hdr));
+		flow = rte_be_to_cpu_32(ip->dst_addr) - RTE_IPV4(10, 1, 0, 0);
+		TEST_ASSERT(flow < nb_flows, "Unexpected flow %u flushed", flow);
+		TEST_ASSERT(flow_segs[flow] != 0,
+				"Flow %u flushed twice", flow);
+		TEST_ASSERT_EQUAL(pkts[i]->pkt_len,
+				HDR_LEN + flow_segs[flow] * PAYLOAD_LEN,
+				"Flow %u flushed with %u bytes instead of %u segments",
+				flow, pkts[i]->pkt_len, flow_segs[flow]);
+		flow_segs[flow] = 0;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+flush_pkts(void *ctx, uint32_t nb_flows, uint16_t max_pkts, uint16_t *nb_out)
+{
+	struct rte_mbuf *pkts[MAX_FLOWS];
+	int ret;
+
+	*nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4, pkts,
+			max_pkts);
+	ret = check_flushed(pkts, *nb_out, nb_flows);
+	rte_pktmbuf_free_bulk(pkts, *nb_out);
+
+	return ret;
+}
+
+static int
+test_gro_flows(uint32_t nb_flows)
+{
+	struct rte_gro_param param = {
+		.gro_types = RTE_GRO_TCP_IPV4,
+		.max_flow_num = nb_flows,
+		.max_item_per_flow = 1,
+		.socket_id = rte_socket_id(),
+	};
+	struct rte_mbuf *pkt;
+	uint32_t flow, round, held;
+	uint16_t nb_out;
+	void *ctx;
+	int ret = TEST_FAILED;
+
+	ctx = rte_gro_ctx_create(&param);
+	TEST_ASSERT_NOT_NULL(ctx, "Failed to create GRO context for %u flows",
+			nb_flows);
+
+	memset(flow_seq, 0, sizeof(flow_seq));
+	memset(flow_segs, 0, sizeof(flow_segs));
+
+	for (round = 0; round < ROUNDS; round++) {
+		/*
+		 * One segment per flow: it is merged if the flow is still in
+		 * the table, or it starts a new flow taking a freed entry.
+		 */
+		for (flow = 0; flow < nb_flows; flow++) {
+			pkt = build_tcp4_pkt(flow, flow_seq[flow]);
+			if (pkt == NULL) {
+				printf("Failed to allocate mbuf\n");
+				goto exit;
+			}
+			if (rte_gro_reassemble(&pkt, 1, ctx) != 0) {
+				printf("Flow %u segment not merged nor inserted, round %u\n",
+						flow, round);
+				rte_pktmbuf_free(pkt);
+				goto exit;
+			}
+			flow_seq[flow] += PAYLOAD_LEN;
+			flow_segs[flow]++;
+		}
+
+		held = rte_gro_get_pkt_count(ctx);
+		if (held != nb_flows) {
+			printf("%u packets held instead of %u, round %u\n",
+					held, nb_flows, round);
+			goto exit;
+		}
+
+		/* Delete a varying part of the flows, leaving holes. */
+		if (flush_pkts(ctx, nb_flows, nb_flows * (round + 1) / (ROUNDS + 1),
+				&nb_out) != TEST_SUCCESS)
+			goto exit;
+	}
+
+	/* Flush everything left, every flow must come out once. */
+	do {
+		if (flush_pkts(ctx, nb_flows, MAX_FLOWS, &nb_out) != TEST_SUCCESS)
+			goto exit;
+	} while (nb_out != 0);
+
+	for (flow = 0; flow < nb_flows; flow++)
+		if (flow_segs[flow] != 0) {
+			printf("Flow %u not flushed\n", flow);
+			goto exit;
+		}
+
+	ret = TEST_SUCCESS;
+exit:
+	/* Free the packets still held on failure */
+	do {
+		struct rte_mbuf *pkts[MAX_FLOWS];
+
+		nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4, pkts,
+				MAX_FLOWS);
+		rte_pktmbuf_free_bulk(pkts, nb_out);
+	} while (nb_out != 0);
+	rte_gro_ctx_destroy(ctx);
+
+	return ret;
+}
+
+static int
+test_gro(void)
+{
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	pkt_pool = rte_pktmbuf_pool_create("gro_test_pool", NB_MBUF, 0, 0,
+			MBUF_DATA_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(pkt_pool, "Failed to create mbuf pool");
+
+	for (i = 0; i < RTE_DIM(flow_nums); i++) {
+		ret = test_gro_flows(flow_nums[i]);
+		if (ret != TEST_SUCCESS) {
+			printf("GRO test failed with %u flows\n", flow_nums[i]);
+			break;
+		}
+	}
+
+	rte_mempool_free(pkt_pool);
+	return ret;
+}
+
+REGISTER_FAST_TEST(gro_autotest, true, true, test_gro);
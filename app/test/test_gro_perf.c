@@ -0,0 +1,168 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_tcp.h>
+
+#include "test.h"
+
+#define MAX_FLOWS UINT16_MAX
+/* Packets sent per flow between two flushes, all but the first are merged */
+#define PKTS_PER_FLOW 4
+#define BURST_SIZE 32U
+#define PASSES 8
+#define PAYLOAD_LEN 64
+#define HDR_LEN (sizeof(struct rte_ether_hdr) + \
+		sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_tcp_hdr))
+#define MBUF_DATA_SIZE (RTE_PKTMBUF_HEADROOM + HDR_LEN + PAYLOAD_LEN)
+#define NB_MBUF (MAX_FLOWS * PKTS_PER_FLOW + BURST_SIZE)
+
+static const uint32_t flow_nums[] = { 16, 64, 256, 1024, 4096, 16384, MAX_FLOWS };
+
+static struct rte_mempool *pkt_pool;
+
+static struct rte_mbuf *
+build_tcp4_pkt(uint32_t flow, uint32_t seq)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(pkt_pool);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m,
+			HDR_LEN + PAYLOAD_LEN);
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+
+	memset(eth, 0, HDR_LEN);
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + sizeof(*tcp) +
+			PAYLOAD_LEN);
+	ip->fragment_offset = rte_cpu_to_be_16(RTE_IPV4_HDR_DF_FLAG);
+	ip->time_to_live = 64;
+	ip->next_proto_id = IPPROTO_TCP;
+	ip->src_addr = rte_cpu_to_be_32(RTE_IPV4(10, 0, 0, 1));
+	ip->dst_addr = rte_cpu_to_be_32(RTE_IPV4(10, 1, 0, 0) + flow);
+	tcp->src_port = rte_cpu_to_be_16(1024);
+	tcp->dst_port = rte_cpu_to_be_16(80);
+	tcp->sent_seq = rte_cpu_to_be_32(seq);
+	tcp->data_off = (sizeof(*tcp) / 4) << 4;
+	tcp->tcp_flags = RTE_TCP_ACK_FLAG;
+
+	m->l2_len = sizeof(*eth);
+	m->l3_len = sizeof(*ip);
+	m->l4_len = sizeof(*tcp);
+	m->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4 |
+		RTE_PTYPE_L4_TCP;
+
+	return m;
+}
+
+static int
+test_gro_perf_flows(uint32_t nb_flows)
+{
+	struct rte_mbuf *pkts[BURST_SIZE];
+	struct rte_gro_param param = {
+		.gro_types = RTE_GRO_TCP_IPV4,
+		.max_flow_num = nb_flows,
+		.max_item_per_flow = 1,
+		.socket_id = rte_socket_id(),
+	};
+	uint64_t start, cycles = 0, nb_pkts = 0;
+	uint32_t flow, pass, seq, i, n;
+	uint16_t nb_left, nb_out;
+	void *ctx;
+
+	ctx = rte_gro_ctx_create(&param);
+	if (ctx == NULL) {
+		printf("Failed to create GRO context for %u flows\n", nb_flows);
+		return TEST_FAILED;
+	}
+
+	for (pass = 0; pass < PASSES; pass++) {
+		/* Send PKTS_PER_FLOW in-order segments of every flow. */
+		for (seq = 0; seq < PKTS_PER_FLOW; seq++) {
+			for (flow = 0; flow < nb_flows; flow += n) {
+				n = RTE_MIN(nb_flows - flow, BURST_SIZE);
+				for (i = 0; i < n; i++) {
+					pkts[i] = build_tcp4_pkt(flow + i,
+						(pass * PKTS_PER_FLOW + seq) *
+						PAYLOAD_LEN);
+					if (pkts[i] == NULL) {
+						printf("Failed to allocate mbuf\n");
+						rte_pktmbuf_free_bulk(pkts, i);
+						goto fail;
+					}
+				}
+
+				start = rte_rdtsc_precise();
+				nb_left = rte_gro_reassemble(pkts, n, ctx);
+				cycles += rte_rdtsc_precise() - start;
+				nb_pkts += n;
+
+				rte_pktmbuf_free_bulk(pkts, nb_left);
+			}
+		}
+
+		/* Flush the merged packets, this is not accounted. */
+		do {
+			nb_out = rte_gro_timeout_flush(ctx, 0, RTE_GRO_TCP_IPV4,
+					pkts, BURST_SIZE);
+			rte_pktmbuf_free_bulk(pkts, nb_out);
+		} while (nb_out != 0);
+	}
+
+	printf("%8u %14.1f\n", nb_flows, (double)cycles / nb_pkts);
+
+	rte_gro_ctx_destroy(ctx);
+	return TEST_SUCCESS;
+
+fail:
+	rte_gro_ctx_destroy(ctx);
+	return TEST_FAILED;
+}
+
+static int
+test_gro_perf(void)
+{
+	unsigned int i;
+	int ret = TEST_SUCCESS;
+
+	pkt_pool = rte_pktmbuf_pool_create("gro_perf_pool", NB_MBUF, 0, 0,
+			MBUF_DATA_SIZE, SOCKET_ID_ANY);
+	if (pkt_pool == NULL) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	printf("### rte_gro_reassemble() TCP/IPv4 performance ###\n");
+	printf("%u segments per flow and flush, %u bytes payload\n",
+			PKTS_PER_FLOW, PAYLOAD_LEN);
+	printf("   Flows  Cycles/packet\n");
+
+	for (i = 0; i < RTE_DIM(flow_nums); i++) {
+		ret = test_gro_perf_flows(flow_nums[i]);
+		if (ret != TEST_SUCCESS)
+			break;
+	}
+
+	rte_mempool_free(pkt_pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(gro_perf_autotest, test_gro_perf);
@@ -807,6 +807,99 @@ static int test_five_keys(void)
 	return 0;
 }
 
+/*
+ * Sequence of operations for 5 keys, updated in bulk
+ *	- bulk add keys
+ *	- bulk lookup keys: hit
+ *	- bulk add keys (update)
+ *	- bulk delete keys : hit
+ *	- bulk delete keys : miss
+ *	- bulk lookup keys: miss
+ */
+static int test_five_keys_bulk(void)
+{
+	struct rte_hash *handle;
+	const void *key_array[5] = {0};
+	void *data[5];
+	void *lkp_data[5];
+	uint64_t hit_mask;
+	int32_t pos[5];
+	int32_t expected_pos[5];
+	unsigned i;
+	int ret;
+
+	ut_params.name = "test_bulk";
+	handle = rte_hash_create(&ut_params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < 5; i++) {
+		key_array[i] = &keys[i];
+		data[i] = (void *)(uintptr_t)(i + 1);
+	}
+
+	ret = rte_hash_add_key_bulk(handle, key_array, NULL, 0, pos);
+	RETURN_IF_ERROR(ret != -EINVAL, "bulk add of no key did not fail");
+
+	/* Add */
+	ret = rte_hash_add_key_bulk(handle, key_array, NULL, 5, pos);
+	RETURN_IF_ERROR(ret != 5, "failed to add keys (ret=%d)", ret);
+	for (i = 0; i < 5; i++) {
+		print_key_info("Add", key_array[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] < 0,
+				"failed to add key (pos[%u]=%d)", i, pos[i]);
+		expected_pos[i] = pos[i];
+	}
+
+	/* Lookup */
+	ret = rte_hash_lookup_bulk(handle, key_array, 5, pos);
+	RETURN_IF_ERROR(ret != 0, "failed to lookup keys");
+	for (i = 0; i < 5; i++) {
+		print_key_info("Lkp", key_array[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+				"failed to find key (pos[%u]=%d)", i, pos[i]);
+	}
+
+	/* Add - update with data */
+	ret = rte_hash_add_key_bulk(handle, key_array, data, 5, pos);
+	RETURN_IF_ERROR(ret != 5, "failed to update keys (ret=%d)", ret);
+	for (i = 0; i < 5; i++)
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+				"failed to update key (pos[%u]=%d)", i, pos[i]);
+
+	ret = rte_hash_lookup_bulk_data(handle, key_array, 5, &hit_mask,
+			lkp_data);
+	RETURN_IF_ERROR(ret != 5, "failed to lookup keys (ret=%d)", ret);
+	for (i = 0; i < 5; i++)
+		RETURN_IF_ERROR(lkp_data[i] != data[i],
+				"wrong data for key %u", i);
+
+	/* Delete */
+	ret = rte_hash_del_key_bulk(handle, key_array, 5, pos);
+	RETURN_IF_ERROR(ret != 5, "failed to delete keys (ret=%d)", ret);
+	for (i = 0; i < 5; i++) {
+		print_key_info("Del", key_array[i], pos[i]);
+		RETURN_IF_ERROR(pos[i] != expected_pos[i],
+				"failed to delete key (pos[%u]=%d)", i, pos[i]);
+	}
+
+	ret = rte_hash_del_key_bulk(handle, key_array, 5, pos);
+	RETURN_IF_ERROR(ret != 0, "deleted non-existent keys (ret=%d)", ret);
+	for (i = 0; i < 5; i++)
+		RETURN_IF_ERROR(pos[i] != -ENOENT,
+				"deleted non-existent key (pos[%u]=%d)", i, pos[i]);
+
+	/* Lookup */
+	ret = rte_hash_lookup_bulk(handle, key_array, 5, pos);
+	RETURN_IF_ERROR(ret != 0, "failed to lookup keys");
+	for (i = 0; i < 5; i++)
+		RETURN_IF_ERROR(pos[i] != -ENOENT,
+				"found non-existent key (pos[%u]=%d)", i, pos[i]);
+
+	rte_hash_free(handle);
+
+	return 0;
+}
+
 /*
  * Add keys to the same bucket until bucket full.
  *	- add 9 keys to the same bucket (hash created with 8 keys per bucket):
@@ -2353,6 +2446,8 @@ test_hash(void)
 		return -1;
 	if (test_five_keys() < 0)
 		return -1;
+	if (test_five_keys_bulk() < 0)
+		return -1;
 	if (test_full_bucket() < 0)
 		return -1;
 	if (test_extendable_bucket() < 0)
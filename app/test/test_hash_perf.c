@@ -34,6 +34,8 @@ enum operations {
 	OP_LOOKUP,
 	OP_LOOKUP_MULTI,
 	OP_DELETE,
+	OP_ADD_BULK,
+	OP_DELETE_BULK,
 	NUM_OPERATIONS
 };
 
@@ -559,6 +561,87 @@ timed_deletes(unsigned int with_hash, unsigned int with_data,
 	return 0;
 }
 
+static int
+timed_adds_bulk(unsigned int with_data, unsigned int table_index,
+				unsigned int ext)
+{
+	unsigned int i, j, n;
+	const void *keys_burst[BURST_SIZE];
+	void *data_burst[BURST_SIZE];
+	int32_t pos_burst[BURST_SIZE];
+	int ret;
+	unsigned int keys_to_add;
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add; i += n) {
+		n = RTE_MIN(keys_to_add - i, (unsigned int)BURST_SIZE);
+		for (j = 0; j < n; j++) {
+			keys_burst[j] = keys[i + j];
+			data_burst[j] = (void *) ((uintptr_t) signatures[i + j]);
+		}
+
+		ret = rte_hash_add_key_bulk(h[table_index], keys_burst,
+					with_data ? data_burst : NULL,
+					n, pos_burst);
+		if (ret != (int)n) {
+			printf("Failed to bulk add key number %u\n", i);
+			return -1;
+		}
+		for (j = 0; j < n; j++)
+			positions[i + j] = pos_burst[j];
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	cycles[table_index][OP_ADD_BULK][0][with_data] = time_taken/keys_to_add;
+
+	return 0;
+}
+
+static int
+timed_deletes_bulk(unsigned int with_data, unsigned int table_index,
+				unsigned int ext)
+{
+	unsigned int i, j, n;
+	const void *keys_burst[BURST_SIZE];
+	int32_t pos_burst[BURST_SIZE];
+	int ret;
+	unsigned int keys_to_add;
+	if (!ext)
+		keys_to_add = KEYS_TO_ADD * ADD_PERCENT;
+	else
+		keys_to_add = KEYS_TO_ADD;
+
+	const uint64_t start_tsc = rte_rdtsc();
+
+	for (i = 0; i < keys_to_add; i += n) {
+		n = RTE_MIN(keys_to_add - i, (unsigned int)BURST_SIZE);
+		for (j = 0; j < n; j++)
+			keys_burst[j] = keys[i + j];
+
+		ret = rte_hash_del_key_bulk(h[table_index], keys_burst,
+					n, pos_burst);
+		if (ret != (int)n) {
+			printf("Failed to bulk delete key number %u\n", i);
+			return -1;
+		}
+	}
+
+	const uint64_t end_tsc = rte_rdtsc();
+	const uint64_t time_taken = end_tsc - start_tsc;
+
+	cycles[table_index][OP_DELETE_BULK][0][with_data] =
+		time_taken/keys_to_add;
+
+	return 0;
+}
+
 static void
 free_table(unsigned table_index)
 {
@@ -604,6 +687,17 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 				if (timed_deletes(with_hash, with_data, i, ext) < 0)
 					return -1;
 
+				/* Bulk updates compute the hash values */
+				if (!with_hash) {
+					if (timed_adds_bulk(with_data, i,
+							ext) < 0)
+						return -1;
+
+					if (timed_deletes_bulk(with_data, i,
+							ext) < 0)
+						return -1;
+				}
+
 				/* Print a dot to show progress on operations */
 				printf(".");
 				fflush(stdout);
@@ -627,12 +721,18 @@ run_all_tbl_perf_tests(unsigned int with_pushes, unsigned int with_locks,
 			else
 				printf("\nWithout pre-computed hash values\n");
 
-			printf("\n%-18s%-18s%-18s%-18s%-18s\n",
-			"Keysize", "Add", "Lookup", "Lookup_bulk", "Delete");
+			printf("\n%-18s%-18s%-18s%-18s%-18s%-18s%-18s\n",
+			"Keysize", "Add", "Lookup", "Lookup_bulk", "Delete",
+			"Add_bulk", "Delete_bulk");
 			for (i = 0; i < NUM_KEYSIZES; i++) {
 				printf("%-18d", hashtest_key_lens[i]);
-				for (j = 0; j < NUM_OPERATIONS; j++)
-					printf("%-18"PRIu64, cycles[i][j][with_hash][with_data]);
+				for (j = 0; j < NUM_OPERATIONS; j++) {
+					if (with_hash && j >= OP_ADD_BULK)
+						printf("%-18s", "-");
+					else
+						printf("%-18"PRIu64,
+						cycles[i][j][with_hash][with_data]);
+				}
 				printf("\n");
 			}
 		}
@@ -23,6 +23,7 @@
 #include <rte_lcore.h>
 #include <rte_branch_prediction.h>
 #include <rte_mempool.h>
+#include <rte_ring.h>
 #include <rte_spinlock.h>
 #include <rte_malloc.h>
 #include <rte_mbuf_pool_ops.h>
@@ -66,6 +67,10 @@
  *      - 2048
  *      - 8192
  *      - 32768
+ *
+ *    A separate test measures a producer/consumer split, where the objects
+ *    allocated on one core are freed on another one, with and without a
+ *    shared cache attached to both cores.
  */
 
 #define TIME_S 1
@@ -483,7 +488,140 @@ test_mempool_perf(void)
 	return ret;
 }
 
+/*
+ * Producer/consumer split: the main lcore allocates objects and passes
+ * them through a ring to a worker lcore, which frees them. Without a
+ * shared cache, the cache of the worker flushes to the common pool, and
+ * the cache of the main lcore refills from it. With a shared cache
+ * attached to both lcores, the objects stay out of the common pool.
+ * The intended use case is two lcores of the same physical core.
+ */
+#define SPLIT_BULK 32
+#define SPLIT_RING_SIZE 1024
+#define SPLIT_SHARED_CACHE_SIZE (RTE_MEMPOOL_CACHE_MAX_SIZE * 4)
+
+static struct rte_ring *split_ring;
+static RTE_ATOMIC(uint32_t) split_stop;
+
+static int
+split_consumer(void *arg)
+{
+	struct rte_mempool *mp = arg;
+	void *obj_table[SPLIT_BULK];
+	unsigned int n;
+
+	while (rte_atomic_load_explicit(&split_stop,
+			rte_memory_order_relaxed) == 0) {
+		n = rte_ring_sc_dequeue_burst(split_ring, obj_table,
+				SPLIT_BULK, NULL);
+		if (n != 0)
+			rte_mempool_put_bulk(mp, obj_table, n);
+	}
+
+	/* Free the objects left in the ring. */
+	while ((n = rte_ring_sc_dequeue_burst(split_ring, obj_table,
+			SPLIT_BULK, NULL)) != 0)
+		rte_mempool_put_bulk(mp, obj_table, n);
+
+	return 0;
+}
+
+static int
+split_launch(struct rte_mempool *mp, unsigned int consumer_lcore)
+{
+	void *obj_table[SPLIT_BULK];
+	uint64_t start_cycles, time_diff = 0, count = 0;
+	uint64_t hz = rte_get_timer_hz();
+
+	rte_atomic_store_explicit(&split_stop, 0, rte_memory_order_relaxed);
+	if (rte_eal_remote_launch(split_consumer, mp, consumer_lcore) < 0)
+		RET_ERR();
+
+	start_cycles = rte_get_timer_cycles();
+	while (time_diff / hz < TIME_S) {
+		time_diff = rte_get_timer_cycles() - start_cycles;
+		/* The pool may be empty while the consumer lags behind. */
+		if (rte_mempool_get_bulk(mp, obj_table, SPLIT_BULK) < 0)
+			continue;
+		while (rte_ring_sp_enqueue_bulk(split_ring, obj_table,
+				SPLIT_BULK, NULL) == 0)
+			rte_pause();
+		count += SPLIT_BULK;
+	}
+
+	rte_atomic_store_explicit(&split_stop, 1, rte_memory_order_relaxed);
+	if (rte_eal_wait_lcore(consumer_lcore) < 0)
+		RET_ERR();
+
+	printf("mempool_autotest split cache=%u n_bulk=%u rate_persec=%"
+	       PRIu64 "\n", mp->cache_size, SPLIT_BULK,
+	       (uint64_t)((double)count * hz / time_diff));
+
+	return 0;
+}
+
+static int
+test_mempool_perf_shared_cache(void)
+{
+	struct rte_mempool_shared_cache *sc = NULL;
+	struct rte_mempool *mp;
+	unsigned int consumer_lcore;
+	int ret = -1;
+
+	if (rte_lcore_count() < 2) {
+		printf("not enough lcores\n");
+		return -1;
+	}
+	consumer_lcore = rte_get_next_lcore(-1, 1, 0);
+
+	mp = rte_mempool_create("perf_test_shared_cache", MEMPOOL_SIZE,
+				MEMPOOL_ELT_SIZE,
+				RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+				NULL, NULL,
+				my_obj_init, NULL,
+				SOCKET_ID_ANY, 0);
+	split_ring = rte_ring_create("perf_test_split", SPLIT_RING_SIZE,
+				     SOCKET_ID_ANY,
+				     RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (mp == NULL || split_ring == NULL) {
+		printf("cannot allocate mempool or ring\n");
+		goto err;
+	}
+
+	printf("start producer/consumer test (without shared cache)\n");
+	if (split_launch(mp, consumer_lcore) < 0)
+		goto err;
+
+	sc = rte_mempool_shared_cache_create(mp, "split",
+			SPLIT_SHARED_CACHE_SIZE, SOCKET_ID_ANY);
+	if (sc == NULL) {
+		printf("cannot create shared cache\n");
+		goto err;
+	}
+	if (rte_mempool_shared_cache_attach(sc, rte_get_main_lcore()) < 0 ||
+	    rte_mempool_shared_cache_attach(sc, consumer_lcore) < 0) {
+		printf("cannot attach shared cache\n");
+		goto err;
+	}
+
+	printf("start producer/consumer test (with shared cache)\n");
+	if (split_launch(mp, consumer_lcore) < 0)
+		goto err;
+
+	rte_mempool_dump(stdout, mp);
+
+	ret = 0;
+
+err:
+	rte_mempool_shared_cache_free(sc);
+	rte_ring_free(split_ring);
+	rte_mempool_free(mp);
+	return ret;
+}
+
 REGISTER_PERF_TEST(mempool_perf_autotest, test_mempool_perf);
 REGISTER_PERF_TEST(mempool_perf_autotest_1core, test_mempool_perf_1core);
 REGISTER_PERF_TEST(mempool_perf_autotest_2cores, test_mempool_perf_2cores);
 REGISTER_PERF_TEST(mempool_perf_autotest_allcores, test_mempool_perf_allcores);
+REGISTER_PERF_TEST(mempool_perf_autotest_shared_cache,
+		test_mempool_perf_shared_cache);
@@ -0,0 +1,305 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_ether.h>
+#include <rte_geneve.h>
+#include <rte_gre.h>
+#include <rte_gtp.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_net.h>
+#include <rte_random.h>
+#include <rte_sctp.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vxlan.h>
+
+#include "test.h"
+
+#define NB_MBUF 128
+#define MAX_BURST 64
+#define MAX_PKT_LEN 160
+#define ITERATIONS 2000
+
+/*
+ * Check that rte_net_get_ptype_burst() gives the same packet types as
+ * rte_net_get_ptype(), for packets classified by the vector path as well
+ * as for the ones left to the scalar parser: tunnels, IP options and
+ * extension headers, fragments, truncated and corrupted headers.
+ */
+
+enum pkt_kind {
+	PKT_IPV4_TCP,
+	PKT_IPV4_UDP,
+	PKT_IPV4_SCTP,
+	PKT_IPV4_ICMP,
+	PKT_IPV4_OPT_TCP,
+	PKT_IPV4_FRAG_UDP,
+	PKT_IPV6_TCP,
+	PKT_IPV6_UDP,
+	PKT_IPV6_EXT_UDP,
+	PKT_VLAN_IPV4_UDP,
+	PKT_IPV4_VXLAN,
+	PKT_IPV6_GENEVE,
+	PKT_IPV4_GRE,
+	PKT_IPV4_GTPC,
+	PKT_ARP,
+	PKT_KIND_NUM
+};
+
+static const uint32_t test_layers[] = {
+	RTE_PTYPE_ALL_MASK,
+	RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK,
+	RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK,
+	RTE_PTYPE_L2_MASK | RTE_PTYPE_L4_MASK,
+	RTE_PTYPE_L2_MASK,
+	0,
+};
+
+static uint8_t *
+put_ether(uint8_t *p, uint16_t ether_type)
+{
+	struct rte_ether_hdr *eh = (struct rte_ether_hdr *)p;
+
+	memset(eh, 0, sizeof(*eh));
+	eh->ether_type = rte_cpu_to_be_16(ether_type);
+	return p + sizeof(*eh);
+}
+
+static uint8_t *
+put_ipv4(uint8_t *p, uint8_t proto, uint8_t opt_words, uint16_t frag)
+{
+	struct rte_ipv4_hdr *ih = (struct rte_ipv4_hdr *)p;
+
+	memset(ih, 0, sizeof(*ih) + opt_words * 4);
+	ih->version_ihl = RTE_IPV4_VHL_DEF + opt_words;
+	ih->fragment_offset = rte_cpu_to_be_16(frag);
+	ih->time_to_live = 64;
+	ih->next_proto_id = proto;
+	return p + sizeof(*ih) + opt_words * 4;
+}
+
+static uint8_t *
+put_ipv6(uint8_t *p, uint8_t proto)
+{
+	struct rte_ipv6_hdr *ih = (struct rte_ipv6_hdr *)p;
+
+	memset(ih, 0, sizeof(*ih));
+	ih->vtc_flow = rte_cpu_to_be_32(6 << 28);
+	ih->proto = proto;
+	ih->hop_limits = 64;
+	return p + sizeof(*ih);
+}
+
+static uint8_t *
+put_udp(uint8_t *p, uint16_t src_port, uint16_t dst_port)
+{
+	struct rte_udp_hdr *uh = (struct rte_udp_hdr *)p;
+
+	memset(uh, 0, sizeof(*uh));
+	uh->src_port = rte_cpu_to_be_16(src_port);
+	uh->dst_port = rte_cpu_to_be_16(dst_port);
+	return p + sizeof(*uh);
+}
+
+static uint8_t *
+put_tcp(uint8_t *p)
+{
+	struct rte_tcp_hdr *th = (struct rte_tcp_hdr *)p;
+
+	memset(th, 0, sizeof(*th));
+	th->src_port = rte_cpu_to_be_16(1024);
+	th->dst_port = rte_cpu_to_be_16(80);
+	th->data_off = (sizeof(*th) / 4) << 4;
+	return p + sizeof(*th);
+}
+
+/* Build a packet of the given kind, return its length. */
+static uint16_t
+build_pkt(uint8_t *buf, enum pkt_kind kind)
+{
+	uint8_t *p = buf;
+
+	switch (kind) {
+	case PKT_IPV4_TCP:
+		p = put_tcp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_TCP, 0, 0));
+		break;
+	case PKT_IPV4_UDP:
+		p = put_udp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_UDP, 0, 0), 1024, 53);
+		break;
+	case PKT_IPV4_SCTP:
+		p = put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_SCTP, 0, 0);
+		memset(p, 0, sizeof(struct rte_sctp_hdr));
+		p += sizeof(struct rte_sctp_hdr);
+		break;
+	case PKT_IPV4_ICMP:
+		p = put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_ICMP, 0, 0);
+		memset(p, 0, 8);
+		p += 8;
+		break;
+	case PKT_IPV4_OPT_TCP:
+		p = put_tcp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_TCP, 2, 0));
+		break;
+	case PKT_IPV4_FRAG_UDP:
+		p = put_udp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_UDP, 0, RTE_IPV4_HDR_MF_FLAG), 1024, 53);
+		break;
+	case PKT_IPV6_TCP:
+		p = put_tcp(put_ipv6(put_ether(p, RTE_ETHER_TYPE_IPV6),
+				IPPROTO_TCP));
+		break;
+	case PKT_IPV6_UDP:
+		p = put_udp(put_ipv6(put_ether(p, RTE_ETHER_TYPE_IPV6),
+				IPPROTO_UDP), 1024, 53);
+		break;
+	case PKT_IPV6_EXT_UDP:
+		p = put_ipv6(put_ether(p, RTE_ETHER_TYPE_IPV6),
+				IPPROTO_HOPOPTS);
+		memset(p, 0, 8);
+		p[0] = IPPROTO_UDP;
+		p = put_udp(p + 8, 1024, 53);
+		break;
+	case PKT_VLAN_IPV4_UDP:
+		p = put_ether(p, RTE_ETHER_TYPE_VLAN);
+		memset(p, 0, sizeof(struct rte_vlan_hdr));
+		((struct rte_vlan_hdr *)p)->eth_proto =
+			rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		p += sizeof(struct rte_vlan_hdr);
+		p = put_udp(put_ipv4(p, IPPROTO_UDP, 0, 0), 1024, 53);
+		break;
+	case PKT_IPV4_VXLAN:
+		p = put_udp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_UDP, 0, 0), 1024, RTE_VXLAN_DEFAULT_PORT);
+		memset(p, 0, sizeof(struct rte_vxlan_hdr));
+		p += sizeof(struct rte_vxlan_hdr);
+		p = put_tcp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_TCP, 0, 0));
+		break;
+	case PKT_IPV6_GENEVE:
+		p = put_udp(put_ipv6(put_ether(p, RTE_ETHER_TYPE_IPV6),
+				IPPROTO_UDP), 1024, RTE_GENEVE_DEFAULT_PORT);
+		memset(p, 0, sizeof(struct rte_geneve_hdr));
+		((struct rte_geneve_hdr *)p)->proto =
+			rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		p += sizeof(struct rte_geneve_hdr);
+		p = put_udp(put_ipv4(p, IPPROTO_UDP, 0, 0), 1024, 53);
+		break;
+	case PKT_IPV4_GRE:
+		p = put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_GRE, 0, 0);
+		memset(p, 0, sizeof(struct rte_gre_hdr));
+		((struct rte_gre_hdr *)p)->proto =
+			rte_cpu_to_be_16(RTE_ETHER_TYPE_TEB);
+		p += sizeof(struct rte_gre_hdr);
+		p = put_udp(put_ipv6(put_ether(p, RTE_ETHER_TYPE_IPV6),
+				IPPROTO_UDP), 1024, 53);
+		break;
+	case PKT_IPV4_GTPC:
+		p = put_udp(put_ipv4(put_ether(p, RTE_ETHER_TYPE_IPV4),
+				IPPROTO_UDP, 0, 0), RTE_GTPC_UDP_PORT, 1024);
+		memset(p, 0, sizeof(struct rte_gtp_hdr));
+		p += sizeof(struct rte_gtp_hdr);
+		break;
+	case PKT_ARP:
+	default:
+		p = put_ether(p, RTE_ETHER_TYPE_ARP);
+		memset(p, 0, 28);
+		p += 28;
+		break;
+	}
+
+	return p - buf;
+}
+
+/* Fill a packet with a random kind, maybe truncated or corrupted. */
+static int
+fill_pkt(struct rte_mbuf *m)
+{
+	uint8_t buf[MAX_PKT_LEN];
+	uint16_t len;
+	char *data;
+
+	len = build_pkt(buf, rte_rand_max(PKT_KIND_NUM));
+	if (rte_rand_max(8) == 0)
+		len = rte_rand_max(len + 1);
+	if (len != 0 && rte_rand_max(8) == 0)
+		buf[rte_rand_max(RTE_MIN(len, 64))] = rte_rand();
+
+	rte_pktmbuf_reset(m);
+	data = rte_pktmbuf_append(m, len);
+	if (data == NULL)
+		return -1;
+	memcpy(data, buf, len);
+	return 0;
+}
+
+static int
+test_net_ptype(void)
+{
+	struct rte_mbuf *pkts[MAX_BURST];
+	struct rte_mempool *mp;
+	unsigned int iter, i, j, nb_pkts;
+	uint32_t layers, ptype;
+	int ret = TEST_FAILED;
+
+	mp = rte_pktmbuf_pool_create("test_net_ptype", NB_MBUF, 0, 0,
+			RTE_PKTMBUF_HEADROOM + MAX_PKT_LEN, SOCKET_ID_ANY);
+	if (mp == NULL) {
+		printf("Cannot create mbuf pool\n");
+		return TEST_FAILED;
+	}
+	if (rte_pktmbuf_alloc_bulk(mp, pkts, MAX_BURST) != 0) {
+		printf("Cannot allocate mbufs\n");
+		goto free_pool;
+	}
+
+	for (iter = 0; iter < ITERATIONS; iter++) {
+		nb_pkts = rte_rand_max(MAX_BURST) + 1;
+		layers = test_layers[iter % RTE_DIM(test_layers)];
+
+		for (i = 0; i < nb_pkts; i++) {
+			if (fill_pkt(pkts[i]) != 0) {
+				printf("Cannot fill packet\n");
+				goto free_pkts;
+			}
+			pkts[i]->packet_type = RTE_PTYPE_UNKNOWN;
+		}
+
+		rte_net_get_ptype_burst(pkts, nb_pkts, layers);
+
+		for (i = 0; i < nb_pkts; i++) {
+			ptype = rte_net_get_ptype(pkts[i], NULL, layers);
+			if (pkts[i]->packet_type == ptype)
+				continue;
+
+			printf("Packet %u of %u, layers 0x%x: ptype 0x%x instead of 0x%x\n",
+				i, nb_pkts, layers, pkts[i]->packet_type,
+				ptype);
+			for (j = 0; j < RTE_MIN(pkts[i]->data_len, 64U); j++)
+				printf("%02x%s", rte_pktmbuf_mtod(pkts[i],
+					uint8_t *)[j], (j % 16) == 15 ? "\n" : " ");
+			printf("\n");
+			goto free_pkts;
+		}
+	}
+
+	ret = TEST_SUCCESS;
+
+free_pkts:
+	rte_pktmbuf_free_bulk(pkts, MAX_BURST);
+free_pool:
+	rte_mempool_free(mp);
+	return ret;
+}
+
+REGISTER_FAST_TEST(net_ptype_autotest, true, true, test_net_ptype);
@@ -0,0 +1,547 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include "test.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+
+#ifdef RTE_EXEC_ENV_WINDOWS
+static int
+test_node_lookup_perf(void)
+{
+	printf("node_lookup_perf not supported on Windows, skipping test\n");
+	return TEST_SKIPPED;
+}
+
+#else
+
+#include <rte_ether.h>
+#include <rte_fib.h>
+#include <rte_fib6.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_node_ip4_api.h>
+#include <rte_node_ip6_api.h>
+#include <rte_random.h>
+
+#define TEST_LOOKUP_SRC4_LPM "test_lookup_perf_src4_lpm"
+#define TEST_LOOKUP_SRC4_FIB "test_lookup_perf_src4_fib"
+#define TEST_LOOKUP_SRC6_LPM "test_lookup_perf_src6_lpm"
+#define TEST_LOOKUP_SRC6_FIB "test_lookup_perf_src6_fib"
+
+/* Full table sizes */
+#define TEST_LOOKUP_ROUTES4 (1 << 20)
+#define TEST_LOOKUP_ROUTES6 200000
+
+#define TEST_LOOKUP_NB_ADDRS (1 << 16)
+#define TEST_LOOKUP_NB_MBUFS 4096
+#define TEST_LOOKUP_WALKS 8192
+#define TEST_LOOKUP_NH 1
+
+struct test_route4 {
+	uint32_t ip;
+	uint8_t depth;
+};
+
+struct test_route6 {
+	struct rte_ipv6_addr ip;
+	uint8_t depth;
+};
+
+struct test_lookup_perf {
+	struct rte_mempool *mp;
+	rte_be32_t *dst4;
+	struct rte_ipv6_addr *dst6;
+	unsigned int idx;
+};
+
+static struct test_lookup_perf lookup_perf;
+
+static uint16_t
+test_lookup_src4(struct rte_graph *graph, struct rte_node *node,
+		 void **objs, uint16_t nb_objs)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	unsigned int i;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (rte_pktmbuf_alloc_bulk(lookup_perf.mp, mbufs, RTE_DIM(mbufs)) != 0)
+		return 0;
+
+	for (i = 0; i < RTE_DIM(mbufs); i++) {
+		eth = rte_pktmbuf_mtod(mbufs[i], struct rte_ether_hdr *);
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+		ip = (struct rte_ipv4_hdr *)(eth + 1);
+		ip->version_ihl = RTE_IPV4_VHL_DEF;
+		ip->time_to_live = 64;
+		ip->dst_addr = lookup_perf.dst4[lookup_perf.idx++ &
+						(TEST_LOOKUP_NB_ADDRS - 1)];
+		mbufs[i]->data_len = sizeof(*eth) + sizeof(*ip);
+		mbufs[i]->pkt_len = mbufs[i]->data_len;
+	}
+
+	rte_node_enqueue(graph, node, 0, (void **)mbufs, RTE_DIM(mbufs));
+
+	return RTE_DIM(mbufs);
+}
+
+static uint16_t
+test_lookup_src6(struct rte_graph *graph, struct rte_node *node,
+		 void **objs, uint16_t nb_objs)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	struct rte_ether_hdr *eth;
+	struct rte_ipv6_hdr *ip;
+	unsigned int i;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(nb_objs);
+
+	if (rte_pktmbuf_alloc_bulk(lookup_perf.mp, mbufs, RTE_DIM(mbufs)) != 0)
+		return 0;
+
+	for (i = 0; i < RTE_DIM(mbufs); i++) {
+		eth = rte_pktmbuf_mtod(mbufs[i], struct rte_ether_hdr *);
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6);
+		ip = (struct rte_ipv6_hdr *)(eth + 1);
+		ip->vtc_flow = rte_cpu_to_be_32(0x60000000);
+		ip->hop_limits = 64;
+		ip->dst_addr = lookup_perf.dst6[lookup_perf.idx++ &
+						(TEST_LOOKUP_NB_ADDRS - 1)];
+		mbufs[i]->data_len = sizeof(*eth) + sizeof(*ip);
+		mbufs[i]->pkt_len = mbufs[i]->data_len;
+	}
+
+	rte_node_enqueue(graph, node, 0, (void **)mbufs, RTE_DIM(mbufs));
+
+	return RTE_DIM(mbufs);
+}
+
+static struct rte_node_register test_lookup_src4_lpm = {
+	.name = TEST_LOOKUP_SRC4_LPM,
+	.process = test_lookup_src4,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"ip4_lookup"},
+};
+RTE_NODE_REGISTER(test_lookup_src4_lpm);
+
+static struct rte_node_register test_lookup_src4_fib = {
+	.name = TEST_LOOKUP_SRC4_FIB,
+	.process = test_lookup_src4,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"ip4_lookup_fib"},
+};
+RTE_NODE_REGISTER(test_lookup_src4_fib);
+
+static struct rte_node_register test_lookup_src6_lpm = {
+	.name = TEST_LOOKUP_SRC6_LPM,
+	.process = test_lookup_src6,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"ip6_lookup"},
+};
+RTE_NODE_REGISTER(test_lookup_src6_lpm);
+
+static struct rte_node_register test_lookup_src6_fib = {
+	.name = TEST_LOOKUP_SRC6_FIB,
+	.process = test_lookup_src6,
+	.flags = RTE_NODE_SOURCE_F,
+	.nb_edges = 1,
+	.next_nodes = {"ip6_lookup_fib"},
+};
+RTE_NODE_REGISTER(test_lookup_src6_fib);
+
+/*
+ * Set the rewrite edge of a lookup node, so that the packets with a route
+ * are freed by pkt_drop instead of being rewritten.
+ */
+static int
+lookup_rewrite_edge_set(const char *lookup, rte_edge_t edge, const char *next)
+{
+	const char *next_nodes[] = {next};
+	rte_node_t id;
+
+	id = rte_node_from_name(lookup);
+	if (id == RTE_NODE_ID_INVALID)
+		return -1;
+
+	return rte_node_edge_update(id, edge, next_nodes, 1) == 0 ? -1 : 0;
+}
+
+static void
+routes4_gen(struct test_route4 *routes, unsigned int nb_routes)
+{
+	unsigned int i, r;
+	uint8_t depth;
+
+	/* Mostly /24 with a few long prefixes, as in an Internet table */
+	for (i = 0; i < nb_routes; i++) {
+		r = rte_rand_max(100);
+		if (r < 5)
+			depth = 25 + rte_rand_max(8);
+		else if (r < 65)
+			depth = 24;
+		else
+			depth = 8 + rte_rand_max(16);
+		routes[i].depth = depth;
+		routes[i].ip = (uint32_t)rte_rand() &
+			(uint32_t)(UINT64_MAX << (32 - depth));
+	}
+}
+
+static void
+routes6_gen(struct test_route6 *routes, unsigned int nb_routes)
+{
+	unsigned int i;
+	uint8_t depth;
+
+	/* Mostly /48 allocated from a few /32 blocks */
+	for (i = 0; i < nb_routes; i++) {
+		depth = rte_rand_max(100) < 70 ? 48 : 33 + rte_rand_max(15);
+		memset(&routes[i].ip, 0, sizeof(routes[i].ip));
+		routes[i].ip.a[0] = 0x20;
+		routes[i].ip.a[1] = 0x01;
+		routes[i].ip.a[2] = 0x0d;
+		routes[i].ip.a[3] = 0xb0 + rte_rand_max(16);
+		routes[i].ip.a[4] = rte_rand();
+		routes[i].ip.a[5] = rte_rand();
+		rte_ipv6_addr_mask(&routes[i].ip, depth);
+		routes[i].depth = depth;
+	}
+}
+
+/* Generate destinations matching the first nb_routes routes. */
+static void
+dst4_gen(const struct test_route4 *routes, unsigned int nb_routes)
+{
+	const struct test_route4 *r;
+	uint32_t mask;
+	unsigned int i;
+
+	for (i = 0; i < TEST_LOOKUP_NB_ADDRS; i++) {
+		r = &routes[rte_rand_max(nb_routes)];
+		mask = (uint32_t)(UINT64_MAX << (32 - r->depth));
+		lookup_perf.dst4[i] = rte_cpu_to_be_32(r->ip |
+						       ((uint32_t)rte_rand() & ~mask));
+	}
+}
+
+static void
+dst6_gen(const struct test_route6 *routes, unsigned int nb_routes)
+{
+	struct rte_ipv6_addr host;
+	const struct test_route6 *r;
+	unsigned int i, j;
+
+	for (i = 0; i < TEST_LOOKUP_NB_ADDRS; i++) {
+		r = &routes[rte_rand_max(nb_routes)];
+		for (j = 0; j < RTE_IPV6_ADDR_SIZE; j++) {
+			/* Number of prefix bits in this byte */
+			int bits = RTE_MIN(RTE_MAX((int)r->depth - (int)j * 8, 0), 8);
+
+			host.a[j] = ((uint8_t)rte_rand() & (0xff >> bits)) | r->ip.a[j];
+		}
+		lookup_perf.dst6[i] = host;
+	}
+}
+
+/* Run a graph and return the number of cycles per packet. */
+static uint64_t
+lookup_graph_measure(const char *name, const char *src)
+{
+	struct rte_graph_param prm;
+	const char *patterns[] = {src};
+	uint64_t start, cycles;
+	struct rte_graph *graph;
+	rte_graph_t graph_id;
+	unsigned int i;
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = rte_socket_id();
+	prm.nb_node_patterns = RTE_DIM(patterns);
+	prm.node_patterns = patterns;
+
+	graph_id = rte_graph_create(name, &prm);
+	if (graph_id == RTE_GRAPH_ID_INVALID)
+		return 0;
+	graph = rte_graph_lookup(name);
+
+	/* Warm up */
+	for (i = 0; i < TEST_LOOKUP_WALKS / 8; i++)
+		rte_graph_walk(graph);
+
+	start = rte_rdtsc_precise();
+	for (i = 0; i < TEST_LOOKUP_WALKS; i++)
+		rte_graph_walk(graph);
+	cycles = rte_rdtsc_precise() - start;
+
+	rte_graph_destroy(graph_id);
+
+	return cycles / ((uint64_t)TEST_LOOKUP_WALKS * RTE_GRAPH_BURST_SIZE);
+}
+
+/* Create the graph, so that the LPM tables exist, then add routes. */
+static int
+lookup4_lpm_setup(const struct test_route4 *routes, unsigned int *nb_routes)
+{
+	struct rte_graph_param prm;
+	const char *patterns[] = {TEST_LOOKUP_SRC4_LPM};
+	rte_graph_t graph_id;
+	unsigned int i;
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = rte_socket_id();
+	prm.nb_node_patterns = RTE_DIM(patterns);
+	prm.node_patterns = patterns;
+	graph_id = rte_graph_create("lookup_perf_setup", &prm);
+	if (graph_id == RTE_GRAPH_ID_INVALID)
+		return -1;
+	rte_graph_destroy(graph_id);
+
+	/* The LPM of the node is small, fill it as much as possible */
+	for (i = 0; i < *nb_routes; i++)
+		if (rte_node_ip4_route_add(routes[i].ip, routes[i].depth,
+				TEST_LOOKUP_NH, RTE_NODE_IP4_LOOKUP_NEXT_REWRITE) < 0)
+			break;
+	*nb_routes = i;
+
+	return i == 0 ? -1 : 0;
+}
+
+static int
+lookup6_lpm_setup(const struct test_route6 *routes, unsigned int *nb_routes)
+{
+	struct rte_graph_param prm;
+	const char *patterns[] = {TEST_LOOKUP_SRC6_LPM};
+	rte_graph_t graph_id;
+	unsigned int i;
+
+	memset(&prm, 0, sizeof(prm));
+	prm.socket_id = rte_socket_id();
+	prm.nb_node_patterns = RTE_DIM(patterns);
+	prm.node_patterns = patterns;
+	graph_id = rte_graph_create("lookup_perf_setup", &prm);
+	if (graph_id == RTE_GRAPH_ID_INVALID)
+		return -1;
+	rte_graph_destroy(graph_id);
+
+	for (i = 0; i < *nb_routes; i++)
+		if (rte_node_ip6_route_add(&routes[i].ip, routes[i].depth,
+				TEST_LOOKUP_NH, RTE_NODE_IP6_LOOKUP_NEXT_REWRITE) < 0)
+			break;
+	*nb_routes = i;
+
+	return i == 0 ? -1 : 0;
+}
+
+static int
+test_lookup4_perf(void)
+{
+	struct rte_fib_conf conf;
+	struct test_route4 *routes;
+	unsigned int nb_lpm, i;
+	bool fib_created = false;
+	int ret = TEST_FAILED;
+	int rc;
+
+	routes = rte_malloc(NULL, sizeof(*routes) * TEST_LOOKUP_ROUTES4, 0);
+	lookup_perf.dst4 = rte_malloc(NULL,
+			sizeof(*lookup_perf.dst4) * TEST_LOOKUP_NB_ADDRS, 0);
+	if (routes == NULL || lookup_perf.dst4 == NULL) {
+		ret = TEST_SKIPPED;
+		goto out;
+	}
+	routes4_gen(routes, TEST_LOOKUP_ROUTES4);
+
+	memset(&conf, 0, sizeof(conf));
+	conf.type = RTE_FIB_DIR24_8;
+	conf.max_routes = TEST_LOOKUP_ROUTES4;
+	conf.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	conf.dir24_8.num_tbl8 = 1 << 16;
+	rc = rte_node_ip4_fib_create(rte_socket_id(), &conf);
+	if (rc < 0 && rc != -EEXIST) {
+		printf("Cannot create FIB, rc=%d, skipping test\n", rc);
+		ret = TEST_SKIPPED;
+		goto out;
+	}
+	fib_created = rc == 0;
+
+	nb_lpm = TEST_LOOKUP_ROUTES4;
+	if (lookup4_lpm_setup(routes, &nb_lpm) < 0) {
+		printf("Cannot add routes to ip4_lookup\n");
+		goto out;
+	}
+
+	for (i = 0; i < TEST_LOOKUP_ROUTES4; i++) {
+		if (i == nb_lpm) {
+			/* Same table for both nodes */
+			dst4_gen(routes, nb_lpm);
+			printf("IPv4 %u routes: ip4_lookup %"PRIu64" cycles/pkt, "
+			       "ip4_lookup_fib %"PRIu64" cycles/pkt\n", nb_lpm,
+			       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC4_LPM),
+			       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC4_FIB));
+		}
+		if (rte_node_ip4_fib_route_add(routes[i].ip, routes[i].depth,
+				TEST_LOOKUP_NH, RTE_NODE_IP4_LOOKUP_NEXT_REWRITE) < 0) {
+			printf("Cannot add route %u to ip4_lookup_fib\n", i);
+			goto out;
+		}
+	}
+
+	dst4_gen(routes, TEST_LOOKUP_ROUTES4);
+	printf("IPv4 %u routes: ip4_lookup_fib %"PRIu64" cycles/pkt\n",
+	       TEST_LOOKUP_ROUTES4,
+	       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC4_FIB));
+
+	if (rte_node_ip4_fib_route_delete(routes[0].ip, routes[0].depth) < 0) {
+		printf("Cannot delete route from ip4_lookup_fib\n");
+		goto out;
+	}
+
+	ret = TEST_SUCCESS;
+out:
+	if (fib_created)
+		rte_node_ip4_fib_destroy(rte_socket_id());
+	rte_free(lookup_perf.dst4);
+	rte_free(routes);
+	return ret;
+}
+
+static int
+test_lookup6_perf(void)
+{
+	struct rte_fib6_conf conf;
+	struct test_route6 *routes;
+	unsigned int nb_lpm, i;
+	bool fib_created = false;
+	int ret = TEST_FAILED;
+	int rc;
+
+	routes = rte_malloc(NULL, sizeof(*routes) * TEST_LOOKUP_ROUTES6, 0);
+	lookup_perf.dst6 = rte_malloc(NULL,
+			sizeof(*lookup_perf.dst6) * TEST_LOOKUP_NB_ADDRS, 0);
+	if (routes == NULL || lookup_perf.dst6 == NULL) {
+		ret = TEST_SKIPPED;
+		goto out;
+	}
+	routes6_gen(routes, TEST_LOOKUP_ROUTES6);
+
+	memset(&conf, 0, sizeof(conf));
+	conf.type = RTE_FIB6_TRIE;
+	conf.max_routes = TEST_LOOKUP_ROUTES6;
+	conf.trie.nh_sz = RTE_FIB6_TRIE_4B;
+	conf.trie.num_tbl8 = 1 << 15;
+	rc = rte_node_ip6_fib_create(rte_socket_id(), &conf);
+	if (rc < 0 && rc != -EEXIST) {
+		printf("Cannot create FIB6, rc=%d, skipping test\n", rc);
+		ret = TEST_SKIPPED;
+		goto out;
+	}
+	fib_created = rc == 0;
+
+	nb_lpm = TEST_LOOKUP_ROUTES6;
+	if (lookup6_lpm_setup(routes, &nb_lpm) < 0) {
+		printf("Cannot add routes to ip6_lookup\n");
+		goto out;
+	}
+
+	for (i = 0; i < TEST_LOOKUP_ROUTES6; i++) {
+		if (i == nb_lpm) {
+			dst6_gen(routes, nb_lpm);
+			printf("IPv6 %u routes: ip6_lookup %"PRIu64" cycles/pkt, "
+			       "ip6_lookup_fib %"PRIu64" cycles/pkt\n", nb_lpm,
+			       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC6_LPM),
+			       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC6_FIB));
+		}
+		if (rte_node_ip6_fib_route_add(&routes[i].ip, routes[i].depth,
+				TEST_LOOKUP_NH, RTE_NODE_IP6_LOOKUP_NEXT_REWRITE) < 0) {
+			printf("Cannot add route %u to ip6_lookup_fib\n", i);
+			goto out;
+		}
+	}
+
+	dst6_gen(routes, TEST_LOOKUP_ROUTES6);
+	printf("IPv6 %u routes: ip6_lookup_fib %"PRIu64" cycles/pkt\n",
+	       TEST_LOOKUP_ROUTES6,
+	       lookup_graph_measure("lookup_perf", TEST_LOOKUP_SRC6_FIB));
+
+	if (rte_node_ip6_fib_route_delete(&routes[0].ip, routes[0].depth) < 0) {
+		printf("Cannot delete route from ip6_lookup_fib\n");
+		goto out;
+	}
+
+	ret = TEST_SUCCESS;
+out:
+	if (fib_created)
+		rte_node_ip6_fib_destroy(rte_socket_id());
+	rte_free(lookup_perf.dst6);
+	rte_free(routes);
+	return ret;
+}
+
+static const struct {
+	const char *lookup;
+	rte_edge_t edge;
+	const char *rewrite;
+} lookup_nodes[] = {
+	{"ip4_lookup", RTE_NODE_IP4_LOOKUP_NEXT_REWRITE, "ip4_rewrite"},
+	{"ip4_lookup_fib", RTE_NODE_IP4_LOOKUP_NEXT_REWRITE, "ip4_rewrite"},
+	{"ip6_lookup", RTE_NODE_IP6_LOOKUP_NEXT_REWRITE, "ip6_rewrite"},
+	{"ip6_lookup_fib", RTE_NODE_IP6_LOOKUP_NEXT_REWRITE, "ip6_rewrite"},
+};
+
+static int
+test_node_lookup_perf(void)
+{
+	unsigned int i;
+	int ret;
+
+	lookup_perf.mp = rte_pktmbuf_pool_create("lookup_perf_pool",
+			TEST_LOOKUP_NB_MBUFS, 256, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+			rte_socket_id());
+	if (lookup_perf.mp == NULL) {
+		printf("Cannot create mbuf pool, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	for (i = 0; i < RTE_DIM(lookup_nodes); i++) {
+		if (lookup_rewrite_edge_set(lookup_nodes[i].lookup,
+				lookup_nodes[i].edge, "pkt_drop") < 0) {
+			printf("Cannot update %s edges\n", lookup_nodes[i].lookup);
+			ret = TEST_FAILED;
+			goto out;
+		}
+	}
+
+	ret = test_lookup4_perf();
+	if (ret == TEST_SUCCESS)
+		ret = test_lookup6_perf();
+
+out:
+	for (i = 0; i < RTE_DIM(lookup_nodes); i++)
+		lookup_rewrite_edge_set(lookup_nodes[i].lookup,
+				lookup_nodes[i].edge, lookup_nodes[i].rewrite);
+	rte_mempool_free(lookup_perf.mp);
+	return ret;
+}
+
+#endif /* !RTE_EXEC_ENV_WINDOWS */
+
+REGISTER_PERF_TEST(node_lookup_perf_autotest, test_node_lookup_perf);
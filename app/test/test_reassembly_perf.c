@@ -9,10 +9,13 @@
 #include <rte_hexdump.h>
 #include <rte_ip.h>
 #include <rte_ip_frag.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
 #include <rte_mbuf.h>
 #include <rte_mbuf_pool_ops.h>
 #include <rte_os_shim.h>
 #include <rte_random.h>
+#include <rte_stdatomic.h>
 #include <rte_udp.h>
 
 #include "test.h"
@@ -842,6 +845,337 @@ ipv6_reassembly_interleaved_flows_perf(int8_t nb_frags)
 	return TEST_SUCCESS;
 }
 
+#define BURST_FLOWS 16
+#define BURST_SIZE  RTE_IP_FRAG_DEATH_ROW_LEN
+
+/*
+ * Compare the per-fragment and burst reassembly APIs on the fragments of
+ * BURST_FLOWS flows interleaved, as received from many concurrent senders.
+ */
+static int
+reassembly_burst_perf(uint8_t ipv6, int8_t nb_frags, uint8_t burst)
+{
+	struct rte_mbuf *buf_arr[BURST_FLOWS * MAX_FRAGMENTS];
+	struct rte_mbuf *buf_out[BURST_FLOWS * MAX_FRAGMENTS];
+	struct rte_ip_frag_death_row death_row;
+	uint64_t total_cyc = 0;
+	uint64_t nb_processed = 0;
+	uint64_t tstamp;
+	uint32_t i, j, k, n, nb_out;
+	char frag_str[8];
+
+	death_row.cnt = 0;
+
+	for (i = 0; i + BURST_FLOWS <= flow_cnt; i += BURST_FLOWS) {
+		n = 0;
+		for (k = 0; k < MAX_FRAGMENTS; k++)
+			for (j = i; j < i + BURST_FLOWS; j++)
+				if (k < frag_per_flow[j])
+					buf_arr[n++] = mbufs[j][k];
+
+		nb_out = 0;
+		tstamp = rte_rdtsc_precise();
+		if (burst) {
+			for (k = 0; k < n; k += BURST_SIZE) {
+				uint16_t nb = RTE_MIN(n - k, (uint32_t)BURST_SIZE);
+
+				if (ipv6)
+					nb_out += rte_ipv6_frag_reassemble_burst(
+						frag_tbl, &death_row,
+						&buf_arr[k], nb, tstamp,
+						&buf_out[nb_out]);
+				else
+					nb_out += rte_ipv4_frag_reassemble_burst(
+						frag_tbl, &death_row,
+						&buf_arr[k], nb, tstamp,
+						&buf_out[nb_out]);
+			}
+		} else {
+			for (k = 0; k < n; k++) {
+				struct rte_mbuf *buf = buf_arr[k];
+
+				if (ipv6) {
+					struct rte_ipv6_hdr *ip_hdr =
+						rte_pktmbuf_mtod_offset(buf,
+						struct rte_ipv6_hdr *,
+						buf->l2_len);
+
+					buf = rte_ipv6_frag_reassemble_packet(
+						frag_tbl, &death_row, buf,
+						tstamp, ip_hdr,
+						rte_ipv6_frag_get_ipv6_fragment_header(
+							ip_hdr));
+				} else {
+					buf = rte_ipv4_frag_reassemble_packet(
+						frag_tbl, &death_row, buf,
+						tstamp, rte_pktmbuf_mtod_offset(
+						buf, struct rte_ipv4_hdr *,
+						buf->l2_len));
+				}
+
+				if (buf != NULL)
+					buf_out[nb_out++] = buf;
+			}
+		}
+		total_cyc += rte_rdtsc_precise() - tstamp;
+		nb_processed += n;
+
+		if (nb_out != BURST_FLOWS || death_row.cnt != 0)
+			return TEST_FAILED;
+
+		/* keep the reassembled packets to be freed at teardown */
+		for (j = 0; j < BURST_FLOWS; j++) {
+			memset(mbufs[i + j], 0,
+			       sizeof(struct rte_mbuf *) * MAX_FRAGMENTS);
+			mbufs[i + j][0] = buf_out[j];
+		}
+	}
+
+	if (nb_frags > 0)
+		snprintf(frag_str, sizeof(frag_str), "%d", nb_frags);
+	else
+		snprintf(frag_str, sizeof(frag_str), "RANDOM");
+
+	printf("| %-14s | %-14s | %-52" PRIu64 " |\n",
+	       burst ? "BURST" : "PER-FRAGMENT", frag_str,
+	       total_cyc / nb_processed);
+	printf("+================+================+"
+	       "======================================================+\n");
+
+	return TEST_SUCCESS;
+}
+
+static void
+reassembly_print_burst_banner(const char *proto_str)
+{
+	printf("+=============================================================="
+	       "=====================+\n");
+	printf("| %-32s| %-3s : %-10d%-5s : %-17d|\n", proto_str,
+	       "Interleaved Flows", BURST_FLOWS, "Burst", BURST_SIZE);
+	printf("+================+================+"
+	       "======================================================+\n");
+	printf("%-17s%-17s%-56s|\n", "| API", "| Fragments/Flow",
+	       "| Cycles/Fragment");
+	printf("+================+================+"
+	       "======================================================+\n");
+}
+
+static int
+reassembly_burst_test(uint8_t ipv6, int8_t nb_frags)
+{
+	uint8_t burst;
+	int rc;
+
+	for (burst = 0; burst <= 1; burst++) {
+		if (ipv6)
+			rc = nb_frags > 0 ?
+				ipv6_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags) :
+				ipv6_rand_frag_pkt_setup(FILL_MODE_LINEAR,
+							 MAX_FRAGMENTS);
+		else
+			rc = nb_frags > 0 ?
+				ipv4_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags) :
+				ipv4_rand_frag_pkt_setup(FILL_MODE_LINEAR,
+							 MAX_FRAGMENTS);
+		if (rc)
+			return rc;
+
+		rc = reassembly_burst_perf(ipv6, nb_frags, burst);
+
+		frag_pkt_teardown();
+
+		if (rc)
+			return rc;
+	}
+
+	return TEST_SUCCESS;
+}
+
+#define MT_MAX_LCORES 8
+
+/*
+ * Multi-lcore reassembly with a shared table: the fragments of each flow
+ * are spread over the lcores, as with RSS on the L4 ports.
+ */
+static struct rte_ip_frag_tbl *mt_frag_tbl;
+static struct rte_mbuf *mt_out[MAX_FLOWS];
+static RTE_ATOMIC(uint32_t) mt_nb_out;
+static uint64_t mt_cycles[MT_MAX_LCORES];
+static uint32_t mt_nb_lcores;
+static uint8_t mt_ipv6;
+
+static int
+mt_reassembly_worker(void *arg)
+{
+	struct rte_ip_frag_death_row death_row;
+	uint32_t idx = (uintptr_t)arg;
+	struct rte_mbuf *buf;
+	uint64_t tstamp;
+	uint32_t i, j, n;
+
+	death_row.cnt = 0;
+	tstamp = rte_rdtsc_precise();
+
+	for (i = 0; i < flow_cnt; i++) {
+		for (j = 0; j < frag_per_flow[i]; j++) {
+			if ((i + j) % mt_nb_lcores != idx)
+				continue;
+
+			buf = mbufs[i][j];
+			if (mt_ipv6) {
+				struct rte_ipv6_hdr *ip_hdr =
+					rte_pktmbuf_mtod_offset(buf,
+					struct rte_ipv6_hdr *, buf->l2_len);
+
+				buf = rte_ipv6_frag_reassemble_packet(
+					mt_frag_tbl, &death_row, buf, tstamp,
+					ip_hdr,
+					rte_ipv6_frag_get_ipv6_fragment_header(
+						ip_hdr));
+			} else {
+				buf = rte_ipv4_frag_reassemble_packet(
+					mt_frag_tbl, &death_row, buf, tstamp,
+					rte_pktmbuf_mtod_offset(buf,
+					struct rte_ipv4_hdr *, buf->l2_len));
+			}
+
+			if (buf != NULL) {
+				n = rte_atomic_fetch_add_explicit(&mt_nb_out, 1,
+					rte_memory_order_relaxed);
+				mt_out[n] = buf;
+			}
+		}
+	}
+
+	mt_cycles[idx] = rte_rdtsc_precise() - tstamp;
+
+	if (death_row.cnt != 0) {
+		rte_ip_frag_free_death_row(&death_row, 0);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+reassembly_print_mt_banner(const char *proto_str)
+{
+	printf("+=============================================================="
+	       "=====================+\n");
+	printf("| %-32s| %-47s|\n", proto_str, "Shared Table, Multiple Lcores");
+	printf("+================+================+"
+	       "======================================================+\n");
+	printf("%-17s%-17s%-56s|\n", "| Lcores", "| Fragments/Flow",
+	       "| Cycles/Fragment");
+	printf("+================+================+"
+	       "======================================================+\n");
+}
+
+static int
+mt_reassembly_perf(uint8_t ipv6, int8_t nb_frags, uint32_t nb_lcores)
+{
+	uint64_t max_ttl_cyc = (MAX_TTL_MS * rte_get_timer_hz()) / 1E3;
+	unsigned int lcores[MT_MAX_LCORES];
+	uint64_t max_cyc = 0, nb_processed = 0;
+	unsigned int lcore_id;
+	uint32_t nb_out;
+	char frag_str[8];
+	uint32_t i;
+	int rc = 0;
+
+	i = 0;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (i == nb_lcores - 1)
+			break;
+		lcores[++i] = lcore_id;
+	}
+	if (i != nb_lcores - 1)
+		return TEST_SKIPPED;
+
+	mt_frag_tbl = rte_ip_frag_table_create_mt(MAX_BKTS, MAX_ENTRIES_PER_BKT,
+		MAX_BKTS * MAX_ENTRIES_PER_BKT, max_ttl_cyc, rte_socket_id());
+	if (mt_frag_tbl == NULL)
+		return TEST_FAILED;
+
+	mt_nb_lcores = nb_lcores;
+	mt_ipv6 = ipv6;
+	rte_atomic_store_explicit(&mt_nb_out, 0, rte_memory_order_relaxed);
+
+	for (i = 1; i < nb_lcores; i++)
+		rte_eal_remote_launch(mt_reassembly_worker,
+				      (void *)(uintptr_t)i, lcores[i]);
+	rc |= mt_reassembly_worker((void *)(uintptr_t)0);
+	for (i = 1; i < nb_lcores; i++)
+		rc |= rte_eal_wait_lcore(lcores[i]);
+
+	rte_ip_frag_table_destroy(mt_frag_tbl);
+	mt_frag_tbl = NULL;
+
+	nb_out = rte_atomic_load_explicit(&mt_nb_out, rte_memory_order_relaxed);
+
+	/* keep the reassembled packets to be freed at teardown */
+	for (i = 0; i < flow_cnt; i++) {
+		nb_processed += frag_per_flow[i];
+		memset(mbufs[i], 0, sizeof(struct rte_mbuf *) * MAX_FRAGMENTS);
+		if (i < nb_out)
+			mbufs[i][0] = mt_out[i];
+	}
+
+	if (rc != 0 || nb_out != flow_cnt)
+		return TEST_FAILED;
+
+	for (i = 0; i < nb_lcores; i++)
+		max_cyc = RTE_MAX(max_cyc, mt_cycles[i]);
+
+	if (nb_frags > 0)
+		snprintf(frag_str, sizeof(frag_str), "%d", nb_frags);
+	else
+		snprintf(frag_str, sizeof(frag_str), "RANDOM");
+
+	printf("| %-14u | %-14s | %-52" PRIu64 " |\n", nb_lcores, frag_str,
+	       max_cyc / nb_processed);
+	printf("+================+================+"
+	       "======================================================+\n");
+
+	return TEST_SUCCESS;
+}
+
+static int
+mt_reassembly_test(uint8_t ipv6, int8_t nb_frags)
+{
+	uint32_t nb_lcores;
+	int rc;
+
+	for (nb_lcores = 1; nb_lcores <= MT_MAX_LCORES; nb_lcores *= 2) {
+		if (nb_lcores > rte_lcore_count())
+			break;
+
+		if (ipv6)
+			rc = nb_frags > 0 ?
+				ipv6_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags) :
+				ipv6_rand_frag_pkt_setup(FILL_MODE_LINEAR,
+							 MAX_FRAGMENTS);
+		else
+			rc = nb_frags > 0 ?
+				ipv4_frag_pkt_setup(FILL_MODE_LINEAR, nb_frags) :
+				ipv4_rand_frag_pkt_setup(FILL_MODE_LINEAR,
+							 MAX_FRAGMENTS);
+		if (rc)
+			return rc;
+
+		rc = mt_reassembly_perf(ipv6, nb_frags, nb_lcores);
+
+		frag_pkt_teardown();
+
+		if (rc == TEST_SKIPPED)
+			break;
+		if (rc)
+			return rc;
+	}
+
+	return TEST_SUCCESS;
+}
+
 static int
 ipv4_reassembly_test(int8_t nb_frags, uint8_t fill_order, uint32_t outstanding)
 {
@@ -938,6 +1272,22 @@ test_reassembly_perf(void)
 			return rc;
 	}
 	printf("\n");
+	/* Test per-fragment vs burst reassembly perf */
+	reassembly_print_burst_banner("IPV4");
+	for (i = 0; i < RTE_DIM(nb_fragments); i++) {
+		rc = reassembly_burst_test(0, nb_fragments[i]);
+		if (rc)
+			return rc;
+	}
+	printf("\n");
+	/* Test shared table reassembly perf on multiple lcores */
+	reassembly_print_mt_banner("IPV4");
+	for (i = 0; i < RTE_DIM(nb_fragments); i++) {
+		rc = mt_reassembly_test(0, nb_fragments[i]);
+		if (rc)
+			return rc;
+	}
+	printf("\n");
 	reassembly_print_banner("IPV6");
 	/* Test variable fragment count and ordering. */
 	for (i = 0; i < RTE_DIM(nb_fragments); i++) {
@@ -969,6 +1319,22 @@ test_reassembly_perf(void)
 		if (rc)
 			return rc;
 	}
+	printf("\n");
+	/* Test per-fragment vs burst reassembly perf */
+	reassembly_print_burst_banner("IPV6");
+	for (i = 0; i < RTE_DIM(nb_fragments); i++) {
+		rc = reassembly_burst_test(1, nb_fragments[i]);
+		if (rc)
+			return rc;
+	}
+	printf("\n");
+	/* Test shared table reassembly perf on multiple lcores */
+	reassembly_print_mt_banner("IPV6");
+	for (i = 0; i < RTE_DIM(nb_fragments); i++) {
+		rc = mt_reassembly_test(1, nb_fragments[i]);
+		if (rc)
+			return rc;
+	}
 	reassembly_test_teardown();
 
 	return TEST_SUCCESS;
@@ -489,6 +489,142 @@ test_reorder_set_seqn(void)
 	return ret;
 }
 
+static int
+test_reorder_flows(void)
+{
+#define FLOWS_NUM_BUFS 10u
+
+	struct rte_mempool *p = test_params->p;
+	struct rte_reorder_flows_param prm = {
+		.name = "test_flows",
+		.socket_id = rte_socket_id(),
+		.nb_flows = 4,
+		.window = 4,
+	};
+	struct rte_reorder_flows *rf = NULL;
+	struct rte_mbuf *bufs[FLOWS_NUM_BUFS];
+	struct rte_mbuf *robufs[FLOWS_NUM_BUFS];
+	/* flow 1 out of order, flow 3 missing seqn 1, late and duplicate */
+	const uint32_t flows[FLOWS_NUM_BUFS] = {1, 3, 1, 3, 1, 3, 3, 5, 3, 3};
+	const uint32_t seqns[FLOWS_NUM_BUFS] = {12, 0, 10, 2, 11, 4, 0, 0, 4, 3};
+	const unsigned int rejected[] = {6, 7, 8};
+	unsigned int i, cnt;
+	uint16_t nb_left;
+	int ret = 0;
+
+	for (i = 0; i < FLOWS_NUM_BUFS; i++)
+		bufs[i] = robufs[i] = NULL;
+
+	prm.window = 3;
+	rf = rte_reorder_flows_create(&prm);
+	TEST_ASSERT((rf == NULL) && (rte_errno == EINVAL),
+			"No error on create() with invalid window");
+	prm.window = 4;
+	prm.nb_flows = 0;
+	rf = rte_reorder_flows_create(&prm);
+	TEST_ASSERT((rf == NULL) && (rte_errno == EINVAL),
+			"No error on create() with no flow");
+	prm.nb_flows = 4;
+	rf = rte_reorder_flows_create(&prm);
+	TEST_ASSERT_NOT_NULL(rf, "Failed to create reorder flows");
+
+	for (i = 0; i < FLOWS_NUM_BUFS; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		if (bufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			ret = -1;
+			goto exit;
+		}
+		*rte_reorder_seqn(bufs[i]) = seqns[i];
+		bufs[i]->hash.usr = flows[i];
+	}
+
+	/*
+	 * Flow 1 starts at 12, 10 and 11 are too late.
+	 * Flow 3 seqn 4 pushes 0 out of the window, seqn 0 is too late,
+	 * flow 5 does not exist and seqn 4 is inserted twice.
+	 */
+	memcpy(robufs, bufs, sizeof(bufs));
+	nb_left = rte_reorder_flows_insert_burst(rf, robufs, NULL,
+			FLOWS_NUM_BUFS);
+	if (nb_left != 5) {
+		printf("%s:%d: %u mbufs left instead of 5\n",
+				__func__, __LINE__, nb_left);
+		ret = -1;
+		goto exit;
+	}
+	if (robufs[0] != bufs[2] || robufs[1] != bufs[4]) {
+		printf("%s:%d: Too late mbufs not left\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	for (i = 0; i < RTE_DIM(rejected); i++) {
+		if (robufs[2 + i] != bufs[rejected[i]]) {
+			printf("%s:%d: mbuf %u not left\n",
+					__func__, __LINE__, rejected[i]);
+			ret = -1;
+			goto exit;
+		}
+	}
+	bufs[0] = bufs[1] = bufs[3] = bufs[5] = bufs[9] = NULL;
+
+	/* flow 3 seqn 0 was pushed out, and seqn 1 is missing */
+	cnt = rte_reorder_flows_drain_burst(rf, robufs, FLOWS_NUM_BUFS);
+	if (cnt != 2) {
+		printf("%s:%d: %u mbufs drained instead of 2\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+	if (robufs[0]->hash.usr != 3 || *rte_reorder_seqn(robufs[0]) != 0 ||
+			robufs[1]->hash.usr != 1 || *rte_reorder_seqn(robufs[1]) != 12) {
+		printf("%s:%d: Wrong mbufs drained\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	rte_pktmbuf_free(robufs[1]);
+
+	/* fill the gap of flow 3 */
+	*rte_reorder_seqn(robufs[0]) = 1;
+	nb_left = rte_reorder_flows_insert_burst(rf, robufs, NULL, 1);
+	if (nb_left != 0) {
+		printf("%s:%d: Failed to insert missing mbuf\n",
+				__func__, __LINE__);
+		rte_pktmbuf_free(robufs[0]);
+		ret = -1;
+		goto exit;
+	}
+
+	cnt = rte_reorder_flows_drain_burst(rf, robufs, FLOWS_NUM_BUFS);
+	for (i = 0; i < cnt; i++) {
+		if (robufs[i]->hash.usr != 3 ||
+				*rte_reorder_seqn(robufs[i]) != i + 1)
+			ret = -1;
+		rte_pktmbuf_free(robufs[i]);
+	}
+	if (cnt != 4 || ret != 0) {
+		printf("%s:%d: Flow 3 not drained in order\n",
+				__func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+
+	cnt = rte_reorder_flows_drain_burst(rf, robufs, FLOWS_NUM_BUFS);
+	if (cnt != 0) {
+		printf("%s:%d: %u mbufs drained from empty flows\n",
+				__func__, __LINE__, cnt);
+		ret = -1;
+		goto exit;
+	}
+
+exit:
+	rte_reorder_flows_free(rf);
+	for (i = 0; i < FLOWS_NUM_BUFS; i++)
+		rte_pktmbuf_free(bufs[i]);
+
+	return ret;
+}
+
 static int
 test_setup(void)
 {
@@ -541,6 +677,7 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_drain),
 		TEST_CASE(test_reorder_drain_up_to_seqn),
 		TEST_CASE(test_reorder_set_seqn),
+		TEST_CASE(test_reorder_flows),
 		TEST_CASES_END()
 	}
 };
@@ -0,0 +1,167 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_random.h>
+#include <rte_reorder.h>
+
+#include "test.h"
+
+#define MAX_FLOWS 65536
+/* Packets of each flow in a round, received out of order */
+#define PKTS_PER_FLOW 4
+#define WINDOW 16
+#define BURST_SIZE 32U
+#define ROUNDS 16
+#define NB_MBUF (MAX_FLOWS * PKTS_PER_FLOW)
+
+static const uint32_t flow_nums[] = { 1024, 4096, 16384, MAX_FLOWS };
+/* Order in which the packets of a flow are received in a round */
+static const uint32_t seqn_order[PKTS_PER_FLOW] = { 0, 2, 1, 3 };
+
+static struct rte_mempool *pkt_pool;
+static struct rte_mbuf **pkts;
+static uint32_t *flow_order;
+
+static int
+test_reorder_perf_flows(uint32_t nb_flows)
+{
+	struct rte_reorder_flows_param prm = {
+		.name = "reorder_perf",
+		.socket_id = rte_socket_id(),
+		.nb_flows = nb_flows,
+		.window = WINDOW,
+	};
+	struct rte_mbuf *burst[BURST_SIZE], *out[BURST_SIZE];
+	const uint32_t nb_pkts = nb_flows * PKTS_PER_FLOW;
+	uint64_t start, cycles = 0, nb_drained = 0;
+	struct rte_reorder_flows *rf;
+	uint32_t round, seq, i, j, n, flow;
+	unsigned int nb_out;
+	uint16_t nb_left;
+
+	rf = rte_reorder_flows_create(&prm);
+	if (rf == NULL) {
+		printf("Failed to create reorder context for %u flows\n",
+				nb_flows);
+		return TEST_FAILED;
+	}
+
+	/* Shuffle the flows, so that consecutive packets hit random flows. */
+	for (i = 0; i < nb_flows; i++)
+		flow_order[i] = i;
+	for (i = nb_flows - 1; i > 0; i--) {
+		j = rte_rand_max(i + 1);
+		flow = flow_order[i];
+		flow_order[i] = flow_order[j];
+		flow_order[j] = flow;
+	}
+
+	for (round = 0; round < ROUNDS; round++) {
+		/*
+		 * Every flow gets one packet per pass, and the second packet
+		 * of each flow waits in its window until the third one.
+		 */
+		for (seq = 0; seq < PKTS_PER_FLOW; seq++) {
+			for (i = 0; i < nb_flows; i++) {
+				n = seq * nb_flows + i;
+				pkts[n]->hash.usr = flow_order[i];
+				*rte_reorder_seqn(pkts[n]) =
+					round * PKTS_PER_FLOW + seqn_order[seq];
+			}
+		}
+
+		start = rte_rdtsc_precise();
+		for (i = 0; i < nb_pkts; i += n) {
+			n = RTE_MIN(nb_pkts - i, BURST_SIZE);
+			memcpy(burst, &pkts[i], n * sizeof(burst[0]));
+			nb_left = rte_reorder_flows_insert_burst(rf, burst,
+					NULL, n);
+			if (nb_left != 0) {
+				printf("%u packets not inserted\n", nb_left);
+				goto fail;
+			}
+
+			do {
+				nb_out = rte_reorder_flows_drain_burst(rf, out,
+						BURST_SIZE);
+				nb_drained += nb_out;
+			} while (nb_out == BURST_SIZE);
+		}
+		cycles += rte_rdtsc_precise() - start;
+	}
+
+	if (nb_drained != (uint64_t)nb_pkts * ROUNDS) {
+		printf("%"PRIu64" packets drained instead of %"PRIu64"\n",
+				nb_drained, (uint64_t)nb_pkts * ROUNDS);
+		goto fail;
+	}
+
+	printf("%8u %14.1f %10.2f\n", nb_flows, (double)cycles / nb_drained,
+			(double)nb_drained * rte_get_tsc_hz() / cycles / 1e6);
+
+	rte_reorder_flows_free(rf);
+	return TEST_SUCCESS;
+
+fail:
+	/*
+	 * The packets still buffered in the context are also referenced by
+	 * the pkts array, which is freed by the caller: hold a reference on
+	 * them while the context frees its buffered packets.
+	 */
+	for (i = 0; i < nb_pkts; i++)
+		rte_mbuf_refcnt_update(pkts[i], 1);
+	rte_reorder_flows_free(rf);
+	for (i = 0; i < nb_pkts; i++)
+		rte_mbuf_refcnt_set(pkts[i], 1);
+	return TEST_FAILED;
+}
+
+static int
+test_reorder_perf(void)
+{
+	unsigned int i;
+	int ret = TEST_FAILED;
+
+	pkt_pool = rte_pktmbuf_pool_create("reorder_perf_pool", NB_MBUF, 0, 0,
+			0, SOCKET_ID_ANY);
+	pkts = rte_malloc(NULL, sizeof(*pkts) * NB_MBUF, 0);
+	flow_order = rte_malloc(NULL, sizeof(*flow_order) * MAX_FLOWS, 0);
+	if (pkt_pool == NULL || pkts == NULL || flow_order == NULL) {
+		printf("Failed to allocate test resources\n");
+		goto exit;
+	}
+	if (rte_pktmbuf_alloc_bulk(pkt_pool, pkts, NB_MBUF) != 0) {
+		printf("Failed to allocate mbufs\n");
+		goto exit;
+	}
+
+	printf("### rte_reorder_flows insert and drain performance ###\n");
+	printf("%u packets per flow and round, window of %u\n",
+			PKTS_PER_FLOW, WINDOW);
+	printf("   Flows  Cycles/packet       Mpps\n");
+
+	for (i = 0; i < RTE_DIM(flow_nums); i++) {
+		ret = test_reorder_perf_flows(flow_nums[i]);
+		if (ret != TEST_SUCCESS)
+			break;
+	}
+
+	rte_pktmbuf_free_bulk(pkts, NB_MBUF);
+exit:
+	rte_free(flow_order);
+	rte_free(pkts);
+	rte_mempool_free(pkt_pool);
+	return ret;
+}
+
+REGISTER_PERF_TEST(reorder_perf_autotest, test_reorder_perf);
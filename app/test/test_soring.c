@@ -408,6 +408,91 @@ test_soring_acquire_release(void)
 	return 0;
 }
 
+static int
+test_soring_acquire_slice(void)
+{
+	struct rte_soring *sor = NULL;
+	struct rte_soring_param prm;
+	struct rte_soring_stage_stats stats;
+	uint32_t objs[10];
+	uint32_t acquired_objs[10];
+	uint32_t acquired, ftoken, ftoken2, i;
+	size_t sz;
+	int rc;
+
+	memset(&prm, 0, sizeof(prm));
+	set_soring_init_param(&prm, "test_acquire_slice", sizeof(uint32_t),
+			20, 1, 0, RTE_RING_SYNC_MT, RTE_RING_SYNC_MT);
+	sz = rte_soring_get_memsize(&prm);
+	sor = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	RTE_TEST_ASSERT_NOT_NULL(sor, "couldn't allocate memory for soring");
+	rc = rte_soring_init(sor, &prm);
+	RTE_TEST_ASSERT_SUCCESS(rc, "failed to init soring");
+
+	for (i = 0; i < 10; i++)
+		objs[i] = i;
+
+	/* invalid stage */
+	RTE_TEST_ASSERT_FAIL(rte_soring_stage_slice_set(sor, 1, 4),
+			"slice set on invalid stage succeeded");
+	RTE_TEST_ASSERT_FAIL(rte_soring_stage_join(sor, 1),
+			"join on invalid stage succeeded");
+
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_slice_set(sor, 0, 4),
+			"failed to set slice");
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_join(sor, 0),
+			"failed to join stage");
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_join(sor, 0),
+			"failed to join stage");
+
+	SORING_TEST_ASSERT(rte_soring_enqueue_burst(sor, objs, 10, NULL), 10);
+
+	/* 2 threads: half of 10 elems, rounded up to the slice size */
+	acquired = rte_soring_acquire_slice(sor, acquired_objs, 0, 10,
+			&ftoken, NULL);
+	SORING_TEST_ASSERT(acquired, 8);
+	for (i = 0; i < acquired; i++)
+		SORING_TEST_ASSERT(acquired_objs[i], i);
+
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_stats_get(sor, 0, &stats),
+			"failed to get stage stats");
+	SORING_TEST_ASSERT(stats.nb_thread, 2);
+	SORING_TEST_ASSERT(stats.waiting, 2);
+	SORING_TEST_ASSERT(stats.inflight, 8);
+
+	/* the remaining elems */
+	acquired = rte_soring_acquire_slice(sor, acquired_objs, 0, 10,
+			&ftoken2, NULL);
+	SORING_TEST_ASSERT(acquired, 2);
+	SORING_TEST_ASSERT(acquired_objs[0], 8);
+
+	rte_soring_release(sor, NULL, 0, 8, ftoken);
+	rte_soring_release(sor, NULL, 0, 2, ftoken2);
+
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_stats_get(sor, 0, &stats),
+			"failed to get stage stats");
+	SORING_TEST_ASSERT(stats.waiting, 0);
+	SORING_TEST_ASSERT(stats.inflight, 0);
+	SORING_TEST_ASSERT(rte_soring_dequeue_burst(sor, objs, 10, NULL), 10);
+
+	/* single thread: no limit */
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_leave(sor, 0),
+			"failed to leave stage");
+	SORING_TEST_ASSERT(rte_soring_enqueue_burst(sor, objs, 10, NULL), 10);
+	acquired = rte_soring_acquire_slice(sor, acquired_objs, 0, 10,
+			&ftoken, NULL);
+	SORING_TEST_ASSERT(acquired, 10);
+	rte_soring_release(sor, NULL, 0, 10, ftoken);
+
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_stage_leave(sor, 0),
+			"failed to leave stage");
+	RTE_TEST_ASSERT_FAIL(rte_soring_stage_leave(sor, 0),
+			"leave on stage without thread succeeded");
+
+	rte_free(sor);
+	return 0;
+}
+
 static int
 test_soring(void)
 {
@@ -428,6 +513,10 @@ test_soring(void)
 	if (test_soring_acquire_release() < 0)
 		goto test_fail;
 
+	/* Sliced acquire and stage stats */
+	if (test_soring_acquire_slice() < 0)
+		goto test_fail;
+
 	/* Test large number of stages */
 	if (test_soring_stages() < 0)
 		goto test_fail;
@@ -0,0 +1,295 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_pause.h>
+#include <rte_soring.h>
+#include <rte_stdatomic.h>
+
+#include "test.h"
+
+/*
+ * Model of a 3 stages RX -> classify -> TX pipeline:
+ * one lcore enqueues objects (RX), classify lcores serve stage 0,
+ * TX lcores serve stage 1 and one lcore dequeues the finished objects.
+ */
+
+#define PERF_RING_SIZE		4096
+#define PERF_BURST		32
+#define PERF_SLICE		8
+#define PERF_CLASSIFY_CYCLES	200
+#define PERF_TX_CYCLES		100
+#define PERF_DURATION_MS	1000
+#define PERF_MIN_LCORES		8
+
+enum perf_role {
+	PERF_ROLE_RX,
+	PERF_ROLE_STAGE,
+	PERF_ROLE_DRAIN,
+};
+
+struct __rte_cache_aligned perf_lcore {
+	struct rte_soring *sor;
+	enum perf_role role;
+	uint32_t stage;
+	uint32_t obj_cycles;
+	bool slice;
+	uint64_t nb_obj;
+};
+
+static struct perf_lcore perf_lcores[RTE_MAX_LCORE];
+static RTE_ATOMIC(bool) perf_stop;
+
+static inline void
+perf_spin(uint32_t nb_obj, uint32_t obj_cycles)
+{
+	uint64_t end;
+
+	end = rte_rdtsc() + (uint64_t)nb_obj * obj_cycles;
+	while (rte_rdtsc() < end)
+		rte_pause();
+}
+
+static int
+perf_rx(struct perf_lcore *lc)
+{
+	uintptr_t objs[PERF_BURST];
+	uint32_t i, n;
+	uintptr_t seq = 0;
+
+	while (!rte_atomic_load_explicit(&perf_stop, rte_memory_order_relaxed)) {
+		for (i = 0; i != RTE_DIM(objs); i++)
+			objs[i] = seq++;
+		n = rte_soring_enqueue_burst(lc->sor, objs, RTE_DIM(objs), NULL);
+		seq -= RTE_DIM(objs) - n;
+		lc->nb_obj += n;
+		if (n == 0)
+			rte_pause();
+	}
+
+	return 0;
+}
+
+static int
+perf_stage(struct perf_lcore *lc)
+{
+	uintptr_t objs[PERF_BURST];
+	uint32_t ftoken, n;
+
+	if (lc->slice)
+		rte_soring_stage_join(lc->sor, lc->stage);
+
+	while (!rte_atomic_load_explicit(&perf_stop, rte_memory_order_relaxed)) {
+		if (lc->slice)
+			n = rte_soring_acquire_slice(lc->sor, objs, lc->stage,
+					RTE_DIM(objs), &ftoken, NULL);
+		else
+			n = rte_soring_acquire_burst(lc->sor, objs, lc->stage,
+					RTE_DIM(objs), &ftoken, NULL);
+		if (n == 0) {
+			rte_pause();
+			continue;
+		}
+		perf_spin(n, lc->obj_cycles);
+		rte_soring_release(lc->sor, NULL, lc->stage, n, ftoken);
+		lc->nb_obj += n;
+	}
+
+	if (lc->slice)
+		rte_soring_stage_leave(lc->sor, lc->stage);
+
+	return 0;
+}
+
+static int
+perf_drain(struct perf_lcore *lc)
+{
+	uintptr_t objs[PERF_BURST];
+	uint32_t n;
+
+	while (!rte_atomic_load_explicit(&perf_stop, rte_memory_order_relaxed)) {
+		n = rte_soring_dequeue_burst(lc->sor, objs, RTE_DIM(objs), NULL);
+		lc->nb_obj += n;
+		if (n == 0)
+			rte_pause();
+	}
+
+	return 0;
+}
+
+static int
+perf_worker(void *arg)
+{
+	struct perf_lcore *lc = arg;
+
+	switch (lc->role) {
+	case PERF_ROLE_RX:
+		return perf_rx(lc);
+	case PERF_ROLE_STAGE:
+		return perf_stage(lc);
+	case PERF_ROLE_DRAIN:
+		return perf_drain(lc);
+	}
+
+	return -EINVAL;
+}
+
+static void
+perf_stage_print(const char *name, uint32_t stage, uint64_t nb_obj[2])
+{
+	uint32_t lc;
+	uint64_t min = UINT64_MAX, max = 0;
+
+	RTE_LCORE_FOREACH_WORKER(lc) {
+		if (perf_lcores[lc].role != PERF_ROLE_STAGE ||
+				perf_lcores[lc].stage != stage)
+			continue;
+		min = RTE_MIN(min, perf_lcores[lc].nb_obj);
+		max = RTE_MAX(max, perf_lcores[lc].nb_obj);
+		nb_obj[stage] += perf_lcores[lc].nb_obj;
+	}
+
+	printf("  %s: %" PRIu64 " objs, per lcore min %" PRIu64
+		", max %" PRIu64 "\n", name, nb_obj[stage], min, max);
+}
+
+static int
+test_soring_perf_run(struct rte_soring *sor, bool slice)
+{
+	struct rte_soring_stage_stats stats[2];
+	uint64_t nb_obj[2] = {0, 0};
+	uint64_t start, cycles;
+	uint32_t i, lc, nb_worker, nb_classify;
+	unsigned int rx = 0, drain = 0;
+	int rc;
+
+	nb_worker = rte_lcore_count() - 1;
+	/* two thirds of the stage lcores classify, the others transmit */
+	nb_classify = (nb_worker - 2) * 2 / 3;
+
+	memset(perf_lcores, 0, sizeof(perf_lcores));
+	rte_atomic_store_explicit(&perf_stop, false, rte_memory_order_relaxed);
+
+	i = 0;
+	RTE_LCORE_FOREACH_WORKER(lc) {
+		perf_lcores[lc].sor = sor;
+		perf_lcores[lc].slice = slice;
+		if (i == 0) {
+			perf_lcores[lc].role = PERF_ROLE_RX;
+			rx = lc;
+		} else if (i == nb_worker - 1) {
+			perf_lcores[lc].role = PERF_ROLE_DRAIN;
+			drain = lc;
+		} else {
+			perf_lcores[lc].role = PERF_ROLE_STAGE;
+			perf_lcores[lc].stage = (i <= nb_classify) ? 0 : 1;
+			perf_lcores[lc].obj_cycles = (i <= nb_classify) ?
+				PERF_CLASSIFY_CYCLES : PERF_TX_CYCLES;
+		}
+		i++;
+	}
+
+	RTE_LCORE_FOREACH_WORKER(lc)
+		rte_eal_remote_launch(perf_worker, &perf_lcores[lc], lc);
+
+	start = rte_get_timer_cycles();
+	rte_delay_ms(PERF_DURATION_MS / 2);
+	for (i = 0; i != RTE_DIM(stats); i++)
+		rte_soring_stage_stats_get(sor, i, &stats[i]);
+	rte_delay_ms(PERF_DURATION_MS / 2);
+	rte_atomic_store_explicit(&perf_stop, true, rte_memory_order_relaxed);
+
+	rc = 0;
+	RTE_LCORE_FOREACH_WORKER(lc)
+		rc |= rte_eal_wait_lcore(lc);
+	cycles = rte_get_timer_cycles() - start;
+
+	printf("%s acquire, %u classify lcores, %u tx lcores\n",
+		slice ? "sliced" : "burst", nb_classify,
+		nb_worker - 2 - nb_classify);
+	perf_stage_print("classify", 0, nb_obj);
+	perf_stage_print("tx", 1, nb_obj);
+	for (i = 0; i != RTE_DIM(stats); i++)
+		printf("  stage %u: threads %u, waiting %u, inflight %u\n",
+			i, stats[i].nb_thread, stats[i].waiting,
+			stats[i].inflight);
+	printf("  rx %" PRIu64 " objs, dequeued %" PRIu64 " objs, %"
+		PRIu64 " objs/sec\n", perf_lcores[rx].nb_obj,
+		perf_lcores[drain].nb_obj,
+		perf_lcores[drain].nb_obj * rte_get_timer_hz() / cycles);
+
+	/* drain what is left for the next run */
+	while (rte_soring_count(sor) != 0) {
+		uintptr_t objs[PERF_BURST];
+		uint32_t ftoken, n;
+
+		for (i = 0; i != RTE_DIM(stats); i++) {
+			n = rte_soring_acquire_burst(sor, objs, i,
+					RTE_DIM(objs), &ftoken, NULL);
+			if (n != 0)
+				rte_soring_release(sor, NULL, i, n, ftoken);
+		}
+		rte_soring_dequeue_burst(sor, objs, RTE_DIM(objs), NULL);
+	}
+
+	return rc;
+}
+
+static int
+test_soring_perf(void)
+{
+	struct rte_soring_param prm;
+	struct rte_soring *sor;
+	size_t sz;
+	int rc;
+
+	if (rte_lcore_count() < PERF_MIN_LCORES) {
+		printf("Need at least %u lcores, skipping test\n",
+			PERF_MIN_LCORES);
+		return TEST_SKIPPED;
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	prm.name = "soring_perf";
+	prm.elems = PERF_RING_SIZE;
+	prm.elem_size = sizeof(uintptr_t);
+	prm.stages = 2;
+	prm.prod_synt = RTE_RING_SYNC_ST;
+	prm.cons_synt = RTE_RING_SYNC_ST;
+
+	sz = rte_soring_get_memsize(&prm);
+	sor = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (sor == NULL) {
+		printf("Failed to allocate soring\n");
+		return TEST_FAILED;
+	}
+
+	rc = rte_soring_init(sor, &prm);
+	if (rc != 0) {
+		printf("Failed to init soring\n");
+		goto out;
+	}
+
+	rc = test_soring_perf_run(sor, false);
+	if (rc != 0)
+		goto out;
+
+	rte_soring_stage_slice_set(sor, 0, PERF_SLICE);
+	rte_soring_stage_slice_set(sor, 1, PERF_SLICE);
+	rc = test_soring_perf_run(sor, true);
+
+out:
+	rte_free(sor);
+	return rc == 0 ? TEST_SUCCESS : TEST_FAILED;
+}
+
+REGISTER_PERF_TEST(soring_perf_autotest, test_soring_perf);
@@ -8,6 +8,7 @@
 #include <rte_malloc.h>
 #include <rte_random.h>
 #include <rte_stack.h>
+#include <rte_stack_zc.h>
 
 #include "test.h"
 
@@ -176,6 +177,87 @@ test_stack_basic(uint32_t flags)
 	return ret;
 }
 
+static int
+test_stack_zc(uint32_t flags)
+{
+	struct rte_stack_zc_data zcd;
+	struct rte_stack_lf_elem *e;
+	struct rte_stack *s;
+	void *obj_table[MAX_BULK];
+	unsigned int i;
+	int ret = -1;
+
+	if (!(flags & RTE_STACK_F_LF))
+		return 0;
+
+	s = rte_stack_create(__func__, MAX_BULK, rte_socket_id(), flags);
+	if (s == NULL) {
+		printf("[%s():%u] failed to create a stack\n",
+		       __func__, __LINE__);
+		return -1;
+	}
+
+	if (rte_stack_push_zc_start(s, MAX_BULK + 1, &zcd) != 0) {
+		printf("[%s():%u] Excess objects zc push succeeded\n",
+		       __func__, __LINE__);
+		goto fail_test;
+	}
+
+	if (rte_stack_push_zc_start(s, MAX_BULK, &zcd) != MAX_BULK) {
+		printf("[%s():%u] zc push start failed\n",
+		       __func__, __LINE__);
+		goto fail_test;
+	}
+
+	/* Write half of the reservation, the first element is the top */
+	RTE_STACK_ZC_FOREACH(&zcd, e, i)
+		e->data = (void *)(uintptr_t)(MAX_BULK / 2 - i);
+	rte_stack_push_zc_finish(s, &zcd, MAX_BULK / 2);
+
+	if (rte_stack_count(s) != MAX_BULK / 2 ||
+			rte_stack_free_count(s) != MAX_BULK / 2) {
+		printf("[%s():%u] stack count: %u (expected %u)\n",
+		       __func__, __LINE__, rte_stack_count(s), MAX_BULK / 2);
+		goto fail_test;
+	}
+
+	if (rte_stack_pop_zc_start(s, 2, &zcd) != 2) {
+		printf("[%s():%u] zc pop start failed\n",
+		       __func__, __LINE__);
+		goto fail_test;
+	}
+
+	RTE_STACK_ZC_FOREACH(&zcd, e, i) {
+		if (e->data != (void *)(uintptr_t)(MAX_BULK / 2 - i)) {
+			printf("[%s():%u] Incorrect value %p at index %u\n",
+			       __func__, __LINE__, e->data, i);
+			goto fail_test;
+		}
+	}
+	rte_stack_pop_zc_finish(s, &zcd);
+
+	/* Zero-copy and copy operations are interchangeable */
+	if (rte_stack_pop(s, obj_table, MAX_BULK / 2 - 2) != MAX_BULK / 2 - 2 ||
+			obj_table[0] != (void *)(uintptr_t)(MAX_BULK / 2 - 2)) {
+		printf("[%s():%u] pop after zc pop failed\n",
+		       __func__, __LINE__);
+		goto fail_test;
+	}
+
+	if (rte_stack_count(s) != 0 || rte_stack_free_count(s) != MAX_BULK) {
+		printf("[%s():%u] stack count: %u (expected 0)\n",
+		       __func__, __LINE__, rte_stack_count(s));
+		goto fail_test;
+	}
+
+	ret = 0;
+
+fail_test:
+	rte_stack_free(s);
+
+	return ret;
+}
+
 static int
 test_stack_name_reuse(uint32_t flags)
 {
@@ -351,6 +433,9 @@ __test_stack(uint32_t flags)
 	if (test_free_null() < 0)
 		return -1;
 
+	if (test_stack_zc(flags) < 0)
+		return -1;
+
 	if (test_stack_name_reuse(flags) < 0)
 		return -1;
 
@@ -379,5 +464,23 @@ test_lf_stack(void)
 #endif
 }
 
+static int
+test_lf_elim_stack(void)
+{
+#if defined(RTE_STACK_LF_SUPPORTED)
+	if (rte_stack_create(__func__, STACK_SIZE, rte_socket_id(),
+			     RTE_STACK_F_LF_ELIM) != NULL) {
+		printf("[%s():%u] elimination without lock-free succeeded\n",
+		       __func__, __LINE__);
+		return -1;
+	}
+
+	return __test_stack(RTE_STACK_F_LF | RTE_STACK_F_LF_ELIM);
+#else
+	return TEST_SKIPPED;
+#endif
+}
+
 REGISTER_FAST_TEST(stack_autotest, false, true, test_stack);
 REGISTER_FAST_TEST(stack_lf_autotest, false, true, test_lf_stack);
+REGISTER_FAST_TEST(stack_lf_elim_autotest, false, true, test_lf_elim_stack);
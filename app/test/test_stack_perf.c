@@ -8,14 +8,17 @@
 
 #include <rte_cycles.h>
 #include <rte_launch.h>
+#include <rte_mempool.h>
 #include <rte_pause.h>
 #include <rte_stack.h>
+#include <rte_stack_zc.h>
 
 #include "test.h"
 
 #define STACK_NAME "STACK_PERF"
 #define MAX_BURST 32
 #define STACK_SIZE (RTE_MAX_LCORE * MAX_BURST)
+#define MAX_SWEEP_LCORES 64u
 
 /*
  * Push/pop bulk sizes, marked volatile so they aren't treated as compile-time
@@ -25,6 +28,9 @@ static volatile unsigned int bulk_sizes[] = {8, MAX_BURST};
 
 static RTE_ATOMIC(uint32_t) lcore_barrier;
 
+/* Mempool used by bulk_get_put() */
+static struct rte_mempool *perf_mp;
+
 struct lcore_pair {
 	unsigned int c1;
 	unsigned int c2;
@@ -160,6 +166,34 @@ bulk_push_pop(void *p)
 	return 0;
 }
 
+/* Measure the average per-pointer cycle cost of mempool get and put */
+static int
+bulk_get_put(void *p)
+{
+	unsigned int iterations = 1000000;
+	struct thread_args *args = p;
+	void *objs[MAX_BURST];
+	unsigned int size, i;
+
+	size = args->sz;
+
+	rte_atomic_fetch_sub_explicit(&lcore_barrier, 1, rte_memory_order_relaxed);
+	rte_wait_until_equal_32((uint32_t *)(uintptr_t)&lcore_barrier, 0, rte_memory_order_relaxed);
+
+	uint64_t start = rte_rdtsc();
+
+	for (i = 0; i < iterations; i++) {
+		if (rte_mempool_get_bulk(perf_mp, objs, size) == 0)
+			rte_mempool_put_bulk(perf_mp, objs, size);
+	}
+
+	uint64_t end = rte_rdtsc();
+
+	args->avg = ((double)(end - start))/(iterations * size);
+
+	return 0;
+}
+
 /*
  * Run bulk_push_pop() simultaneously on pairs of cores, to measure stack
  * perf when between hyperthread siblings, cores on the same socket, and cores
@@ -244,6 +278,18 @@ run_on_n_cores(struct rte_stack *s, lcore_function_t fn, int n)
 	}
 }
 
+/* Run fn() simultaneously on 2, 4, ... lcores, up to MAX_SWEEP_LCORES. */
+static void
+run_on_n_cores_sweep(struct rte_stack *s, lcore_function_t fn)
+{
+	unsigned int n;
+
+	for (n = 2; n <= RTE_MIN(rte_lcore_count(), MAX_SWEEP_LCORES); n *= 2) {
+		printf("\n### Testing on %u lcores ###\n", n);
+		run_on_n_cores(s, fn, n);
+	}
+}
+
 /*
  * Measure the cycle cost of pushing and popping a single pointer on a single
  * lcore.
@@ -294,6 +340,44 @@ test_bulk_push_pop(struct rte_stack *s)
 	}
 }
 
+/*
+ * Measure the cycle cost of zero-copy bulk pushing and popping on a single
+ * lcore.
+ */
+static void
+test_bulk_push_pop_zc(struct rte_stack *s)
+{
+	unsigned int iterations = 8000000;
+	struct rte_stack_zc_data zcd;
+	struct rte_stack_lf_elem *e;
+	unsigned int sz, i, j;
+	void *obj = NULL;
+
+	for (sz = 0; sz < RTE_DIM(bulk_sizes); sz++) {
+		uint64_t start = rte_rdtsc();
+
+		for (i = 0; i < iterations; i++) {
+			rte_stack_push_zc_start(s, bulk_sizes[sz], &zcd);
+			RTE_STACK_ZC_FOREACH(&zcd, e, j)
+				e->data = obj;
+			rte_stack_push_zc_finish(s, &zcd, zcd.n);
+
+			rte_stack_pop_zc_start(s, bulk_sizes[sz], &zcd);
+			RTE_STACK_ZC_FOREACH(&zcd, e, j)
+				obj = e->data;
+			rte_stack_pop_zc_finish(s, &zcd);
+		}
+
+		uint64_t end = rte_rdtsc();
+
+		double avg = ((double)(end - start) /
+			      (iterations * bulk_sizes[sz]));
+
+		printf("Average cycles per object zero-copy push/pop (bulk size: %u): %.2F\n",
+		       bulk_sizes[sz], avg);
+	}
+}
+
 static int
 __test_stack_perf(uint32_t flags)
 {
@@ -318,6 +402,11 @@ __test_stack_perf(uint32_t flags)
 	printf("\n### Testing using a single lcore ###\n");
 	test_bulk_push_pop(s);
 
+	if (flags & RTE_STACK_F_LF) {
+		printf("\n### Testing zero-copy using a single lcore ###\n");
+		test_bulk_push_pop_zc(s);
+	}
+
 	if (get_two_hyperthreads(&cores) == 0) {
 		printf("\n### Testing using two hyperthreads ###\n");
 		run_on_core_pair(&cores, s, bulk_push_pop);
@@ -331,6 +420,8 @@ __test_stack_perf(uint32_t flags)
 		run_on_core_pair(&cores, s, bulk_push_pop);
 	}
 
+	run_on_n_cores_sweep(s, bulk_push_pop);
+
 	printf("\n### Testing on all %u lcores ###\n", rte_lcore_count());
 	run_on_n_cores(s, bulk_push_pop, rte_lcore_count());
 
@@ -354,5 +445,58 @@ test_lf_stack_perf(void)
 #endif
 }
 
+static int
+test_lf_elim_stack_perf(void)
+{
+#if defined(RTE_STACK_LF_SUPPORTED)
+	return __test_stack_perf(RTE_STACK_F_LF | RTE_STACK_F_LF_ELIM);
+#else
+	return TEST_SKIPPED;
+#endif
+}
+
+/*
+ * Compare the stack mempool drivers with the ring driver, without mempool
+ * cache so that all the lcores contend on the pool.
+ */
+static int
+test_stack_mempool_perf(void)
+{
+	const char * const ops[] = {
+		"ring_mp_mc", "stack", "lf_stack", "lf_stack_elim"
+	};
+	unsigned int i;
+
+	rte_atomic_store_explicit(&lcore_barrier, 0, rte_memory_order_relaxed);
+
+	for (i = 0; i < RTE_DIM(ops); i++) {
+		perf_mp = rte_mempool_create_empty(STACK_NAME, STACK_SIZE,
+						   sizeof(void *), 0, 0,
+						   rte_socket_id(), 0);
+		if (perf_mp == NULL) {
+			printf("[%s():%u] failed to create a mempool\n",
+			       __func__, __LINE__);
+			return -1;
+		}
+
+		if (rte_mempool_set_ops_byname(perf_mp, ops[i], NULL) < 0 ||
+		    rte_mempool_populate_default(perf_mp) < 0) {
+			printf("\n### Skipping %s mempool ###\n", ops[i]);
+			rte_mempool_free(perf_mp);
+			continue;
+		}
+
+		printf("\n### Testing %s mempool ###\n", ops[i]);
+		run_on_n_cores_sweep(NULL, bulk_get_put);
+
+		rte_mempool_free(perf_mp);
+	}
+
+	perf_mp = NULL;
+	return 0;
+}
+
 REGISTER_PERF_TEST(stack_perf_autotest, test_stack_perf);
 REGISTER_PERF_TEST(stack_lf_perf_autotest, test_lf_stack_perf);
+REGISTER_PERF_TEST(stack_lf_elim_perf_autotest, test_lf_elim_stack_perf);
+REGISTER_PERF_TEST(stack_mempool_perf_autotest, test_stack_mempool_perf);
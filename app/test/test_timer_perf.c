@@ -25,6 +25,13 @@ timer_cb(struct rte_timer *t __rte_unused, void *param __rte_unused)
 	outstanding_count--;
 }
 
+/* run the expired timers from rte_timer_alt_manage() */
+static void
+timer_run_cb(struct rte_timer *t)
+{
+	t->f(t, t->arg);
+}
+
 #define DELAY_SECONDS 1
 
 #ifdef RTE_EXEC_ENV_LINUX
@@ -34,15 +41,30 @@ timer_cb(struct rte_timer *t __rte_unused, void *param __rte_unused)
 #endif
 
 static int
-test_timer_perf(void)
+test_timer_perf_backend(enum rte_timer_backend backend, const char *name)
 {
+	struct rte_timer_data_conf conf = { .backend = backend };
 	unsigned iterations = 100;
 	unsigned i;
 	struct rte_timer *tms;
 	uint64_t start_tsc, end_tsc, delay_start;
 	unsigned lcore_id = rte_lcore_id();
+	uint32_t data_id;
+	int ret;
+
+	printf("### %s backend ###\n", name);
+
+	ret = rte_timer_data_alloc_conf(&data_id, &conf);
+	if (ret < 0) {
+		printf("Error: cannot allocate %s timer data: %d\n", name, ret);
+		return -1;
+	}
 
 	tms = rte_malloc(NULL, sizeof(*tms) * MAX_ITERATIONS, 0);
+	if (tms == NULL) {
+		rte_timer_data_dealloc(data_id);
+		return -1;
+	}
 
 	for (i = 0; i < MAX_ITERATIONS; i++)
 		rte_timer_init(&tms[i]);
@@ -56,8 +78,8 @@ test_timer_perf(void)
 		printf("Appending %u timers\n", iterations);
 		start_tsc = rte_rdtsc();
 		for (i = 0; i < iterations; i++)
-			rte_timer_reset(&tms[i], ticks, SINGLE, lcore_id,
-					timer_cb, NULL);
+			rte_timer_alt_reset(data_id, &tms[i], ticks, SINGLE,
+					lcore_id, timer_cb, NULL);
 		end_tsc = rte_rdtsc();
 		printf("Time for %u timers: %"PRIu64" (%"PRIu64"ms), ", iterations,
 				end_tsc-start_tsc, (end_tsc-start_tsc+ticks_per_ms/2)/(ticks_per_ms));
@@ -71,7 +93,7 @@ test_timer_perf(void)
 
 		start_tsc = rte_rdtsc();
 		while (outstanding_count)
-			rte_timer_manage();
+			rte_timer_alt_manage(data_id, NULL, 0, timer_run_cb);
 		end_tsc = rte_rdtsc();
 		printf("Time for %u callbacks: %"PRIu64" (%"PRIu64"ms), ", iterations,
 				end_tsc-start_tsc, (end_tsc-start_tsc+ticks_per_ms/2)/(ticks_per_ms));
@@ -82,8 +104,8 @@ test_timer_perf(void)
 		printf("Resetting %u timers\n", iterations);
 		start_tsc = rte_rdtsc();
 		for (i = 0; i < iterations; i++)
-			rte_timer_reset(&tms[i], rte_rand() % ticks, SINGLE, lcore_id,
-					timer_cb, NULL);
+			rte_timer_alt_reset(data_id, &tms[i], rte_rand() % ticks,
+					SINGLE, lcore_id, timer_cb, NULL);
 		end_tsc = rte_rdtsc();
 		printf("Time for %u timers: %"PRIu64" (%"PRIu64"ms), ", iterations,
 				end_tsc-start_tsc, (end_tsc-start_tsc+ticks_per_ms/2)/(ticks_per_ms));
@@ -96,9 +118,12 @@ test_timer_perf(void)
 		while (rte_get_timer_cycles() < delay_start + ticks)
 			do_delay();
 
-		rte_timer_manage();
+		rte_timer_alt_manage(data_id, NULL, 0, timer_run_cb);
 		if (outstanding_count != 0) {
 			printf("Error: outstanding callback count = %d\n", outstanding_count);
+			rte_timer_stop_all(data_id, &lcore_id, 1, NULL, NULL);
+			rte_timer_data_dealloc(data_id);
+			rte_free(tms);
 			return -1;
 		}
 
@@ -111,24 +136,36 @@ test_timer_perf(void)
 	/* measure time to poll an empty timer list */
 	start_tsc = rte_rdtsc();
 	for (i = 0; i < iterations; i++)
-		rte_timer_manage();
+		rte_timer_alt_manage(data_id, NULL, 0, timer_run_cb);
 	end_tsc = rte_rdtsc();
-	printf("\nTime per rte_timer_manage with zero timers: %"PRIu64" cycles\n",
+	printf("\nTime per rte_timer_alt_manage with zero timers: %"PRIu64" cycles\n",
 			(end_tsc - start_tsc + iterations/2) / iterations);
 
 	/* measure time to poll a timer list with timers, but without
 	 * calling any callbacks */
-	rte_timer_reset(&tms[0], ticks * 100, SINGLE, lcore_id,
+	rte_timer_alt_reset(data_id, &tms[0], ticks * 100, SINGLE, lcore_id,
 			timer_cb, NULL);
 	start_tsc = rte_rdtsc();
 	for (i = 0; i < iterations; i++)
-		rte_timer_manage();
+		rte_timer_alt_manage(data_id, NULL, 0, timer_run_cb);
 	end_tsc = rte_rdtsc();
-	printf("Time per rte_timer_manage with zero callbacks: %"PRIu64" cycles\n",
+	printf("Time per rte_timer_alt_manage with zero callbacks: %"PRIu64" cycles\n",
 			(end_tsc - start_tsc + iterations/2) / iterations);
 
+	rte_timer_alt_stop(data_id, &tms[0]);
+	rte_timer_data_dealloc(data_id);
 	rte_free(tms);
 	return 0;
 }
 
+static int
+test_timer_perf(void)
+{
+	if (test_timer_perf_backend(RTE_TIMER_BACKEND_SKIPLIST,
+			"skiplist") < 0)
+		return -1;
+	printf("\n");
+	return test_timer_perf_backend(RTE_TIMER_BACKEND_WHEEL, "wheel");
+}
+
 REGISTER_PERF_TEST(timer_perf_autotest, test_timer_perf);
@@ -3,10 +3,12 @@
  */
 
 #include <stdbool.h>
+#include <stdlib.h>
 
 #include <rte_cycles.h>
 #include <eventdev_pmd.h>
 #include <eventdev_pmd_vdev.h>
+#include <rte_kvargs.h>
 #include <rte_random.h>
 #include <rte_ring_elem.h>
 
@@ -14,6 +16,11 @@
 
 #define EVENTDEV_NAME_DSW_PMD event_dsw
 
+#define LLC_COST_ARG "llc_cost"
+#define NUMA_COST_ARG "numa_cost"
+#define LLC_CORES_ARG "llc_cores"
+#define NUMA_CORES_ARG "numa_cores"
+
 static int
 dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 	       const struct rte_event_port_conf *conf)
@@ -36,7 +43,8 @@ dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 		.dequeue_depth = conf->dequeue_depth,
 		.enqueue_depth = conf->enqueue_depth,
 		.new_event_threshold = conf->new_event_threshold,
-		.implicit_release = implicit_release
+		.implicit_release = implicit_release,
+		.topology = DSW_TOPOLOGY_UNKNOWN
 	};
 
 	snprintf(ring_name, sizeof(ring_name), "dsw%d_p%u", dev->data->dev_id,
@@ -438,15 +446,91 @@ static struct eventdev_ops dsw_evdev_ops = {
 	.xstats_get_by_name = dsw_xstats_get_by_name
 };
 
+static int
+dsw_parse_cost(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *cost = opaque;
+
+	*cost = atoi(value);
+	if (*cost < 0 || *cost > 100)
+		return -1;
+	return 0;
+}
+
+static int
+dsw_parse_cores(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *cores = opaque;
+
+	*cores = atoi(value);
+	if (*cores < 0 || *cores > RTE_MAX_LCORE)
+		return -1;
+	return 0;
+}
+
+static int
+dsw_parse_args(const char *name, const char *params, int *llc_cost,
+	       int *numa_cost, int *llc_cores, int *numa_cores)
+{
+	static const char *const args[] = {
+		LLC_COST_ARG,
+		NUMA_COST_ARG,
+		LLC_CORES_ARG,
+		NUMA_CORES_ARG,
+		NULL
+	};
+	struct rte_kvargs *kvlist;
+	int ret;
+
+	if (params == NULL || params[0] == '\0')
+		return 0;
+
+	kvlist = rte_kvargs_parse(params, args);
+	if (kvlist == NULL) {
+		RTE_LOG_LINE(ERR, EVENT_DSW,
+			     "%s: Invalid parameters '%s'", name, params);
+		return -EINVAL;
+	}
+
+	ret = rte_kvargs_process(kvlist, LLC_COST_ARG, dsw_parse_cost,
+				 llc_cost);
+	if (ret == 0)
+		ret = rte_kvargs_process(kvlist, NUMA_COST_ARG, dsw_parse_cost,
+					 numa_cost);
+	if (ret == 0)
+		ret = rte_kvargs_process(kvlist, LLC_CORES_ARG,
+					 dsw_parse_cores, llc_cores);
+	if (ret == 0)
+		ret = rte_kvargs_process(kvlist, NUMA_CORES_ARG,
+					 dsw_parse_cores, numa_cores);
+	if (ret != 0)
+		RTE_LOG_LINE(ERR, EVENT_DSW,
+			     "%s: Error parsing parameters '%s'", name, params);
+
+	rte_kvargs_free(kvlist);
+
+	return ret;
+}
+
 static int
 dsw_probe(struct rte_vdev_device *vdev)
 {
 	const char *name;
 	struct rte_eventdev *dev;
 	struct dsw_evdev *dsw;
+	int llc_cost = DSW_DEFAULT_LLC_COST;
+	int numa_cost = DSW_DEFAULT_NUMA_COST;
+	int llc_cores = 0;
+	int numa_cores = 0;
+	int ret;
 
 	name = rte_vdev_device_name(vdev);
 
+	ret = dsw_parse_args(name, rte_vdev_device_args(vdev), &llc_cost,
+			     &numa_cost, &llc_cores, &numa_cores);
+	if (ret != 0)
+		return ret;
+
 	dev = rte_event_pmd_vdev_init(name, sizeof(struct dsw_evdev),
 				      rte_socket_id(), vdev);
 	if (dev == NULL)
@@ -464,6 +548,10 @@ dsw_probe(struct rte_vdev_device *vdev)
 
 	dsw = dev->data->dev_private;
 	dsw->data = dev->data;
+	dsw->llc_cost = DSW_LOAD_FROM_PERCENT(llc_cost);
+	dsw->numa_cost = DSW_LOAD_FROM_PERCENT(numa_cost);
+	dsw->llc_cores = llc_cores;
+	dsw->numa_cores = numa_cores;
 
 	event_dev_probing_finish(dev);
 	return 0;
@@ -487,4 +575,7 @@ static struct rte_vdev_driver evdev_dsw_pmd_drv = {
 };
 
 RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_DSW_PMD, evdev_dsw_pmd_drv);
+RTE_PMD_REGISTER_PARAM_STRING(event_dsw, LLC_COST_ARG "=<int> "
+		NUMA_COST_ARG "=<int> " LLC_CORES_ARG "=<int> "
+		NUMA_CORES_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(event_dsw_logtype, NOTICE);
@@ -100,6 +100,25 @@
 
 #define DSW_MAX_EVENTS_RECORDED (128)
 
+/* Migrating a flow to a port used by an lcore in another last-level
+ * cache domain, or on another NUMA node, means the flow's state must
+ * be brought into the target core's caches, in the latter case across
+ * the socket interconnect. To have migration prefer targets close to
+ * the source port, such targets are charged a cost (in percent of the
+ * port load) that must be made up by a larger load imbalance, and
+ * that is deducted from the candidate's weight. The costs may be set
+ * with the llc_cost and numa_cost devargs. Unless the llc_cores (or
+ * numa_cores) devarg is given, all lcores of a NUMA node are assumed
+ * to share a last-level cache.
+ */
+#define DSW_DEFAULT_LLC_COST (2)
+#define DSW_DEFAULT_NUMA_COST (5)
+
+#define DSW_TOPOLOGY_UNKNOWN (UINT32_MAX)
+#define DSW_TOPOLOGY(socket_id, llc_id)			\
+	((((uint32_t)(socket_id)) << 16) | ((uint16_t)(llc_id)))
+#define DSW_TOPOLOGY_SOCKET(topology) ((topology) >> 16)
+
 #define DSW_MAX_FLOWS_PER_MIGRATION (8)
 
 /* Only one outstanding migration per port is allowed */
@@ -126,6 +145,13 @@ struct dsw_queue_flow {
 	uint16_t flow_hash;
 };
 
+enum dsw_topology_distance {
+	DSW_TOPOLOGY_LLC_LOCAL,
+	DSW_TOPOLOGY_NUMA_LOCAL,
+	DSW_TOPOLOGY_NUMA_REMOTE,
+	DSW_TOPOLOGY_DISTANCES
+};
+
 enum dsw_migration_state {
 	DSW_MIGRATION_STATE_IDLE,
 	DSW_MIGRATION_STATE_FINISH_PENDING,
@@ -177,6 +203,7 @@ struct __rte_cache_aligned dsw_port {
 	uint64_t emigration_start;
 	uint64_t emigrations;
 	uint64_t emigration_latency;
+	uint64_t emigrations_by_distance[DSW_TOPOLOGY_DISTANCES];
 
 	uint8_t emigration_target_port_ids[DSW_MAX_FLOWS_PER_MIGRATION];
 	struct dsw_queue_flow
@@ -232,6 +259,10 @@ struct __rte_cache_aligned dsw_port {
 
 	/* Estimate of current port load. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int16_t) load;
+	/* NUMA node and last-level cache domain of the lcore using
+	 * the port, refreshed together with the load estimate.
+	 */
+	RTE_ATOMIC(uint32_t) topology;
 	/* Estimate of flows currently migrating to this port. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) immigration_load;
 };
@@ -256,6 +287,12 @@ struct dsw_evdev {
 	uint8_t num_queues;
 	int32_t max_inflight;
 
+	/* Topology-aware migration configuration */
+	int16_t llc_cost;
+	int16_t numa_cost;
+	uint16_t llc_cores;
+	uint16_t numa_cores;
+
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) credits_on_loan;
 };
 
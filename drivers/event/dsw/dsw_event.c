@@ -154,6 +154,33 @@ dsw_port_load_close_period(struct dsw_port *port, uint64_t now)
 	return load;
 }
 
+static void
+dsw_port_topology_update(struct dsw_port *port)
+{
+	struct dsw_evdev *dsw = port->dsw;
+	unsigned int lcore_id = rte_lcore_id();
+	uint32_t topology = DSW_TOPOLOGY_UNKNOWN;
+
+	if (lcore_id != LCORE_ID_ANY) {
+		int cpu_id = rte_lcore_to_cpu_id(lcore_id);
+		unsigned int socket_id = rte_lcore_to_socket_id(lcore_id);
+		unsigned int llc_id;
+
+		if (dsw->numa_cores > 0 && cpu_id >= 0)
+			socket_id = cpu_id / dsw->numa_cores;
+
+		if (dsw->llc_cores > 0 && cpu_id >= 0)
+			llc_id = cpu_id / dsw->llc_cores;
+		else
+			llc_id = socket_id;
+
+		topology = DSW_TOPOLOGY(socket_id, llc_id);
+	}
+
+	rte_atomic_store_explicit(&port->topology, topology,
+				  rte_memory_order_relaxed);
+}
+
 static void
 dsw_port_load_update(struct dsw_port *port, uint64_t now)
 {
@@ -172,6 +199,11 @@ dsw_port_load_update(struct dsw_port *port, uint64_t now)
 	rte_atomic_store_explicit(&port->load, new_load,
 				  rte_memory_order_relaxed);
 
+	/* The lcore using the port may change at any time, so its
+	 * location is kept up to date along with its load.
+	 */
+	dsw_port_topology_update(port);
+
 	/* The load of the recently immigrated flows should hopefully
 	 * be reflected the load estimate by now.
 	 */
@@ -422,9 +454,49 @@ dsw_flow_load(uint16_t num_events, int16_t port_load)
 		DSW_MAX_EVENTS_RECORDED;
 }
 
+static enum dsw_topology_distance
+dsw_topology_distance(uint32_t topology_a, uint32_t topology_b)
+{
+	if (topology_a == DSW_TOPOLOGY_UNKNOWN ||
+	    topology_b == DSW_TOPOLOGY_UNKNOWN || topology_a == topology_b)
+		return DSW_TOPOLOGY_LLC_LOCAL;
+
+	if (DSW_TOPOLOGY_SOCKET(topology_a) == DSW_TOPOLOGY_SOCKET(topology_b))
+		return DSW_TOPOLOGY_NUMA_LOCAL;
+
+	return DSW_TOPOLOGY_NUMA_REMOTE;
+}
+
+static enum dsw_topology_distance
+dsw_port_distance(struct dsw_evdev *dsw, struct dsw_port *port,
+		  uint8_t other_port_id)
+{
+	uint32_t topology = rte_atomic_load_explicit(&port->topology,
+					rte_memory_order_relaxed);
+	uint32_t other_topology =
+		rte_atomic_load_explicit(&dsw->ports[other_port_id].topology,
+					 rte_memory_order_relaxed);
+
+	return dsw_topology_distance(topology, other_topology);
+}
+
+static int16_t
+dsw_migration_cost(struct dsw_evdev *dsw,
+		   enum dsw_topology_distance distance)
+{
+	switch (distance) {
+	case DSW_TOPOLOGY_NUMA_LOCAL:
+		return dsw->llc_cost;
+	case DSW_TOPOLOGY_NUMA_REMOTE:
+		return dsw->numa_cost;
+	default:
+		return 0;
+	}
+}
+
 static int16_t
 dsw_evaluate_migration(int16_t source_load, int16_t target_load,
-		       int16_t flow_load)
+		       int16_t flow_load, int16_t cost)
 {
 	int32_t res_target_load;
 	int32_t imbalance;
@@ -432,7 +504,10 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 	if (target_load > DSW_MAX_TARGET_LOAD_FOR_MIGRATION)
 		return -1;
 
-	imbalance = source_load - target_load;
+	/* A distant target must be that much less loaded to be
+	 * worth moving the flow, and its cached state, to.
+	 */
+	imbalance = source_load - target_load - cost;
 
 	if (imbalance < DSW_REBALANCE_THRESHOLD)
 		return -1;
@@ -448,9 +523,10 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 
 	/* The more idle the target will be, the better. This will
 	 * make migration prefer moving smaller flows, and flows to
-	 * lightly loaded ports.
+	 * lightly loaded ports. Among equally loaded targets, the
+	 * closest one wins.
 	 */
-	return DSW_MAX_LOAD - res_target_load;
+	return DSW_MAX_LOAD - res_target_load - cost;
 }
 
 static bool
@@ -494,6 +570,7 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 		flow_load = dsw_flow_load(burst->count, source_port_load);
 
 		for (port_id = 0; port_id < num_ports; port_id++) {
+			enum dsw_topology_distance distance;
 			int16_t weight;
 
 			if (port_id == source_port->id)
@@ -502,9 +579,14 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 			if (!dsw_is_serving_port(dsw, port_id, qf->queue_id))
 				continue;
 
+			distance = dsw_port_distance(dsw, source_port,
+						     port_id);
+
 			weight = dsw_evaluate_migration(source_port_load,
 							port_loads[port_id],
-							flow_load);
+							flow_load,
+							dsw_migration_cost(dsw,
+								distance));
 
 			if (weight > candidate_weight) {
 				candidate_qf = qf;
@@ -778,6 +860,9 @@ dsw_port_end_emigration(struct dsw_evdev *dsw, struct dsw_port *port,
 		DSW_LOG_DP_PORT_LINE(DEBUG, port->id, "Migration completed for "
 				"queue_id %d flow_hash %d.", queue_id,
 				flow_hash);
+
+		port->emigrations_by_distance[dsw_port_distance(dsw, port,
+					port->emigration_target_port_ids[i])]++;
 	}
 
 	finished = port->emigration_targets_len - left_qfs_len;
@@ -87,6 +87,19 @@ dsw_xstats_port_get_queue_dequeued(struct dsw_evdev *dsw, uint8_t port_id,
 DSW_GEN_PORT_ACCESS_FN(emigrations)
 DSW_GEN_PORT_ACCESS_FN(immigrations)
 
+#define DSW_GEN_PORT_DISTANCE_ACCESS_FN(_name, _distance)		\
+	static uint64_t							\
+	dsw_xstats_port_get_emigrations_ ## _name(struct dsw_evdev *dsw, \
+						  uint8_t port_id,	\
+						  uint8_t queue_id __rte_unused) \
+	{								\
+		return dsw->ports[port_id].emigrations_by_distance[_distance]; \
+	}
+
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(llc_local, DSW_TOPOLOGY_LLC_LOCAL)
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(numa_local, DSW_TOPOLOGY_NUMA_LOCAL)
+DSW_GEN_PORT_DISTANCE_ACCESS_FN(numa_remote, DSW_TOPOLOGY_NUMA_REMOTE)
+
 static uint64_t
 dsw_xstats_port_get_migration_latency(struct dsw_evdev *dsw, uint8_t port_id,
 				      uint8_t queue_id __rte_unused)
@@ -148,6 +161,12 @@ static struct dsw_xstats_port dsw_port_xstats[] = {
 	  true },
 	{ "port_%u_emigrations", dsw_xstats_port_get_emigrations,
 	  false },
+	{ "port_%u_emigrations_llc_local",
+	  dsw_xstats_port_get_emigrations_llc_local, false },
+	{ "port_%u_emigrations_numa_local",
+	  dsw_xstats_port_get_emigrations_numa_local, false },
+	{ "port_%u_emigrations_numa_remote",
+	  dsw_xstats_port_get_emigrations_numa_remote, false },
 	{ "port_%u_migration_latency", dsw_xstats_port_get_migration_latency,
 	  false },
 	{ "port_%u_immigrations", dsw_xstats_port_get_immigrations,
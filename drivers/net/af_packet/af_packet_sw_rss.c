@@ -0,0 +1,521 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_net.h>
+#include <rte_prefetch.h>
+#include <rte_ring.h>
+#include <rte_spinlock.h>
+#include <rte_thash.h>
+
+#include "af_packet_sw_rss.h"
+
+/* Number of packets polled from the source at a time */
+#define SW_RSS_BURST 64
+
+/* Prefetch distance when hashing a burst */
+#define SW_RSS_PREFETCH_OFFSET 4
+
+struct __rte_cache_aligned sw_rss_queue {
+	struct rte_ring *ring;
+	uint64_t packets;
+	uint64_t bytes;
+	uint64_t drops;
+	/* packets of the current burst, staged before the enqueue */
+	uint16_t nb_bufs;
+	struct rte_mbuf *bufs[SW_RSS_BURST];
+};
+
+struct sw_rss {
+	char name[RTE_RING_NAMESIZE];
+	/* held by the lcore polling the source, and by the updates */
+	rte_spinlock_t lock;
+	uint16_t nb_queues;
+	bool gfni;
+	uint64_t rss_hf;
+	uint8_t key[SW_RSS_KEY_SIZE];
+	/* key converted for rte_softrss_be() */
+	uint32_t key_be[SW_RSS_KEY_SIZE / sizeof(uint32_t)];
+	/* key converted for rte_thash_gfni() */
+	uint64_t mtrx[SW_RSS_KEY_SIZE];
+	uint16_t reta[SW_RSS_RETA_SIZE];
+	uint64_t polls;
+	uint64_t packets;
+	uint64_t cycles;
+	struct sw_rss_queue queues[];
+};
+
+/* default Toeplitz key, the one of many NICs */
+static const uint8_t sw_rss_default_key[SW_RSS_KEY_SIZE] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa,
+};
+
+static const char * const sw_rss_xstats_names[SW_RSS_NB_XSTATS] = {
+	"sw_rss_polls",
+	"sw_rss_packets",
+	"sw_rss_cycles",
+	"sw_rss_drops",
+};
+
+static void
+sw_rss_set_key(struct sw_rss *rss, const uint8_t *key)
+{
+	memcpy(rss->key, key, sizeof(rss->key));
+	rte_convert_rss_key((const uint32_t *)rss->key, rss->key_be,
+		sizeof(rss->key));
+	if (rss->gfni)
+		rte_thash_complete_matrix(rss->mtrx, rss->key, sizeof(rss->key));
+}
+
+static void
+sw_rss_ring_free(struct rte_ring *r)
+{
+	struct rte_mbuf *pkts[SW_RSS_BURST];
+	unsigned int n;
+
+	if (r == NULL)
+		return;
+
+	while ((n = rte_ring_dequeue_burst(r, (void **)pkts, RTE_DIM(pkts),
+			NULL)) != 0)
+		rte_pktmbuf_free_bulk(pkts, n);
+	rte_ring_free(r);
+}
+
+struct sw_rss *
+sw_rss_create(const char *name, uint16_t nb_queues, int socket_id)
+{
+	struct sw_rss *rss;
+	unsigned int i;
+
+	if (name == NULL || nb_queues == 0 ||
+			nb_queues > SW_RSS_MAX_QUEUES) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	rss = rte_zmalloc_socket("af_packet_sw_rss", sizeof(*rss) +
+		nb_queues * sizeof(rss->queues[0]), RTE_CACHE_LINE_SIZE,
+		socket_id);
+	if (rss == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(rss->name, name, sizeof(rss->name));
+	rte_spinlock_init(&rss->lock);
+	rss->nb_queues = nb_queues;
+	rss->gfni = rte_thash_gfni_supported() != 0;
+	sw_rss_set_key(rss, sw_rss_default_key);
+	for (i = 0; i < RTE_DIM(rss->reta); i++)
+		rss->reta[i] = i % nb_queues;
+
+	return rss;
+}
+
+void
+sw_rss_free(struct sw_rss *rss)
+{
+	unsigned int i;
+
+	if (rss == NULL)
+		return;
+
+	for (i = 0; i < rss->nb_queues; i++)
+		sw_rss_ring_free(rss->queues[i].ring);
+	rte_free(rss);
+}
+
+int
+sw_rss_queue_setup(struct sw_rss *rss, uint16_t queue_id,
+	uint16_t nb_desc, int socket_id)
+{
+	char ring_name[RTE_RING_NAMESIZE];
+	struct sw_rss_queue *q;
+	struct rte_ring *r;
+	int ret;
+
+	if (queue_id >= rss->nb_queues || nb_desc == 0)
+		return -EINVAL;
+	q = &rss->queues[queue_id];
+
+	sw_rss_ring_free(q->ring);
+	q->ring = NULL;
+
+	ret = snprintf(ring_name, sizeof(ring_name), "swrss_%s_%u",
+		rss->name, queue_id);
+	if (ret < 0 || ret >= (int)sizeof(ring_name))
+		return -ENAMETOOLONG;
+
+	r = rte_ring_create(ring_name, nb_desc, socket_id,
+		RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (r == NULL)
+		return -rte_errno;
+	q->ring = r;
+
+	return 0;
+}
+
+int
+sw_rss_hash_update(struct sw_rss *rss,
+	const struct rte_eth_rss_conf *rss_conf)
+{
+	if ((rss_conf->rss_hf & ~SW_RSS_OFFLOADS) != 0)
+		return -ENOTSUP;
+	if (rss_conf->algorithm != RTE_ETH_HASH_FUNCTION_DEFAULT &&
+			rss_conf->algorithm != RTE_ETH_HASH_FUNCTION_TOEPLITZ)
+		return -ENOTSUP;
+	if (rss_conf->rss_key != NULL &&
+			rss_conf->rss_key_len != SW_RSS_KEY_SIZE)
+		return -EINVAL;
+
+	rte_spinlock_lock(&rss->lock);
+	rss->rss_hf = rss_conf->rss_hf;
+	if (rss_conf->rss_key != NULL)
+		sw_rss_set_key(rss, rss_conf->rss_key);
+	rte_spinlock_unlock(&rss->lock);
+
+	return 0;
+}
+
+int
+sw_rss_hash_conf_get(struct sw_rss *rss,
+	struct rte_eth_rss_conf *rss_conf)
+{
+	rte_spinlock_lock(&rss->lock);
+	rss_conf->rss_hf = rss->rss_hf;
+	if (rss_conf->rss_key != NULL)
+		memcpy(rss_conf->rss_key, rss->key, sizeof(rss->key));
+	rte_spinlock_unlock(&rss->lock);
+	rss_conf->rss_key_len = SW_RSS_KEY_SIZE;
+	rss_conf->algorithm = RTE_ETH_HASH_FUNCTION_TOEPLITZ;
+
+	return 0;
+}
+
+int
+sw_rss_reta_update(struct sw_rss *rss,
+	const struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size)
+{
+	unsigned int i, idx, shift;
+
+	if (reta_size != SW_RSS_RETA_SIZE)
+		return -EINVAL;
+
+	for (i = 0; i < reta_size; i++) {
+		idx = i / RTE_ETH_RETA_GROUP_SIZE;
+		shift = i % RTE_ETH_RETA_GROUP_SIZE;
+		if ((reta_conf[idx].mask & RTE_BIT64(shift)) != 0 &&
+				reta_conf[idx].reta[shift] >= rss->nb_queues)
+			return -EINVAL;
+	}
+
+	rte_spinlock_lock(&rss->lock);
+	for (i = 0; i < reta_size; i++) {
+		idx = i / RTE_ETH_RETA_GROUP_SIZE;
+		shift = i % RTE_ETH_RETA_GROUP_SIZE;
+		if ((reta_conf[idx].mask & RTE_BIT64(shift)) != 0)
+			rss->reta[i] = reta_conf[idx].reta[shift];
+	}
+	rte_spinlock_unlock(&rss->lock);
+
+	return 0;
+}
+
+int
+sw_rss_reta_query(struct sw_rss *rss,
+	struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size)
+{
+	unsigned int i, idx, shift;
+
+	if (reta_size != SW_RSS_RETA_SIZE)
+		return -EINVAL;
+
+	for (i = 0; i < reta_size; i++) {
+		idx = i / RTE_ETH_RETA_GROUP_SIZE;
+		shift = i % RTE_ETH_RETA_GROUP_SIZE;
+		if ((reta_conf[idx].mask & RTE_BIT64(shift)) != 0)
+			reta_conf[idx].reta[shift] = rss->reta[i];
+	}
+
+	return 0;
+}
+
+/* compute the Toeplitz hash of a tuple of len 32-bit words */
+static inline uint32_t
+sw_rss_toeplitz(const struct sw_rss *rss, union rte_thash_tuple *tuple,
+	uint32_t len)
+{
+	uint32_t be[RTE_THASH_V6_L4_LEN];
+	uint32_t i;
+
+	if (rss->gfni) {
+		/* the GFNI implementation hashes the tuple in network order */
+		for (i = 0; i < len; i++)
+			be[i] = rte_cpu_to_be_32(((uint32_t *)tuple)[i]);
+		return rte_thash_gfni(rss->mtrx, (const uint8_t *)be,
+			len * sizeof(uint32_t));
+	}
+
+	return rte_softrss_be((uint32_t *)tuple, len,
+		(const uint8_t *)rss->key_be);
+}
+
+/*
+ * Compute the RSS hash of a packet, following the hash types enabled,
+ * as a NIC does: the L4 ports are hashed for TCP and UDP, only the
+ * addresses for the other packets, including the fragments.
+ */
+static uint32_t
+sw_rss_hash(const struct sw_rss *rss, const struct rte_mbuf *m)
+{
+	struct rte_net_hdr_lens hdr_lens;
+	union rte_thash_tuple tuple;
+	struct rte_ipv4_hdr ipv4_copy;
+	struct rte_ipv6_hdr ipv6_copy;
+	const struct rte_ipv4_hdr *ipv4;
+	const struct rte_ipv6_hdr *ipv6;
+	const rte_be16_t *ports;
+	rte_be16_t ports_copy[2];
+	uint64_t l3_hf, l4_hf;
+	uint32_t ptype, l4;
+	uint32_t len, l4_len;
+	uint16_t *sport, *dport;
+
+	ptype = rte_net_get_ptype(m, &hdr_lens, RTE_PTYPE_L2_MASK |
+		RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK);
+	l4 = ptype & RTE_PTYPE_L4_MASK;
+
+	if (RTE_ETH_IS_IPV4_HDR(ptype)) {
+		ipv4 = rte_pktmbuf_read(m, hdr_lens.l2_len, sizeof(*ipv4),
+			&ipv4_copy);
+		if (unlikely(ipv4 == NULL))
+			return 0;
+		tuple.v4.src_addr = rte_be_to_cpu_32(ipv4->src_addr);
+		tuple.v4.dst_addr = rte_be_to_cpu_32(ipv4->dst_addr);
+		sport = &tuple.v4.sport;
+		dport = &tuple.v4.dport;
+		len = RTE_THASH_V4_L3_LEN;
+		l4_len = RTE_THASH_V4_L4_LEN;
+		if (l4 == RTE_PTYPE_L4_TCP) {
+			l3_hf = RTE_ETH_RSS_IPV4;
+			l4_hf = RTE_ETH_RSS_NONFRAG_IPV4_TCP;
+		} else if (l4 == RTE_PTYPE_L4_UDP) {
+			l3_hf = RTE_ETH_RSS_IPV4;
+			l4_hf = RTE_ETH_RSS_NONFRAG_IPV4_UDP;
+		} else if (l4 == RTE_PTYPE_L4_FRAG) {
+			l3_hf = RTE_ETH_RSS_IPV4 | RTE_ETH_RSS_FRAG_IPV4;
+			l4_hf = 0;
+		} else {
+			l3_hf = RTE_ETH_RSS_IPV4 | RTE_ETH_RSS_NONFRAG_IPV4_OTHER;
+			l4_hf = 0;
+		}
+	} else if (RTE_ETH_IS_IPV6_HDR(ptype)) {
+		ipv6 = rte_pktmbuf_read(m, hdr_lens.l2_len, sizeof(*ipv6),
+			&ipv6_copy);
+		if (unlikely(ipv6 == NULL))
+			return 0;
+		rte_thash_load_v6_addrs(ipv6, &tuple);
+		sport = &tuple.v6.sport;
+		dport = &tuple.v6.dport;
+		len = RTE_THASH_V6_L3_LEN;
+		l4_len = RTE_THASH_V6_L4_LEN;
+		if (l4 == RTE_PTYPE_L4_TCP) {
+			l3_hf = RTE_ETH_RSS_IPV6;
+			l4_hf = RTE_ETH_RSS_NONFRAG_IPV6_TCP;
+		} else if (l4 == RTE_PTYPE_L4_UDP) {
+			l3_hf = RTE_ETH_RSS_IPV6;
+			l4_hf = RTE_ETH_RSS_NONFRAG_IPV6_UDP;
+		} else if (l4 == RTE_PTYPE_L4_FRAG) {
+			l3_hf = RTE_ETH_RSS_IPV6 | RTE_ETH_RSS_FRAG_IPV6;
+			l4_hf = 0;
+		} else {
+			l3_hf = RTE_ETH_RSS_IPV6 | RTE_ETH_RSS_NONFRAG_IPV6_OTHER;
+			l4_hf = 0;
+		}
+	} else {
+		return 0;
+	}
+
+	if ((rss->rss_hf & l4_hf) != 0) {
+		ports = rte_pktmbuf_read(m, hdr_lens.l2_len + hdr_lens.l3_len,
+			sizeof(ports_copy), ports_copy);
+		if (unlikely(ports == NULL))
+			return 0;
+		*sport = rte_be_to_cpu_16(ports[0]);
+		*dport = rte_be_to_cpu_16(ports[1]);
+		len = l4_len;
+	} else if ((rss->rss_hf & l3_hf) == 0) {
+		return 0;
+	}
+
+	return sw_rss_toeplitz(rss, &tuple, len);
+}
+
+/* poll the source and spread the packets into the queue rings */
+static void
+sw_rss_dispatch(struct sw_rss *rss, sw_rss_poll_t poll,
+	void *poll_arg)
+{
+	struct rte_mbuf *pkts[SW_RSS_BURST];
+	struct sw_rss_queue *q;
+	uint64_t start, bytes;
+	uint16_t nb_pkts, i, j, n;
+	uint32_t hash;
+
+	rss->polls++;
+	nb_pkts = poll(poll_arg, pkts, SW_RSS_BURST);
+	if (nb_pkts == 0)
+		return;
+
+	start = rte_rdtsc();
+
+	for (i = 0; i < RTE_MIN(nb_pkts, SW_RSS_PREFETCH_OFFSET); i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (i + SW_RSS_PREFETCH_OFFSET < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(
+				pkts[i + SW_RSS_PREFETCH_OFFSET], void *));
+
+		hash = 0;
+		if (rss->rss_hf != 0) {
+			hash = sw_rss_hash(rss, pkts[i]);
+			pkts[i]->hash.rss = hash;
+			pkts[i]->ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+		}
+
+		q = &rss->queues[rss->reta[hash % SW_RSS_RETA_SIZE]];
+		q->bufs[q->nb_bufs++] = pkts[i];
+	}
+
+	for (i = 0; i < rss->nb_queues; i++) {
+		q = &rss->queues[i];
+		if (q->nb_bufs == 0)
+			continue;
+
+		/* the packets cannot be read once enqueued */
+		bytes = 0;
+		for (j = 0; j < q->nb_bufs; j++)
+			bytes += rte_pktmbuf_pkt_len(q->bufs[j]);
+
+		n = 0;
+		if (likely(q->ring != NULL))
+			n = rte_ring_sp_enqueue_burst(q->ring,
+				(void **)q->bufs, q->nb_bufs, NULL);
+		if (unlikely(n < q->nb_bufs)) {
+			for (j = n; j < q->nb_bufs; j++)
+				bytes -= rte_pktmbuf_pkt_len(q->bufs[j]);
+			q->drops += q->nb_bufs - n;
+			rte_pktmbuf_free_bulk(&q->bufs[n], q->nb_bufs - n);
+		}
+
+		q->packets += n;
+		q->bytes += bytes;
+		q->nb_bufs = 0;
+	}
+
+	rss->packets += nb_pkts;
+	rss->cycles += rte_rdtsc() - start;
+}
+
+uint16_t
+sw_rss_rx(struct sw_rss *rss, uint16_t queue_id,
+	struct rte_mbuf **pkts, uint16_t nb_pkts,
+	sw_rss_poll_t poll, void *poll_arg)
+{
+	struct rte_ring *r = rss->queues[queue_id].ring;
+
+	if (rte_spinlock_trylock(&rss->lock)) {
+		sw_rss_dispatch(rss, poll, poll_arg);
+		rte_spinlock_unlock(&rss->lock);
+	}
+
+	if (unlikely(r == NULL))
+		return 0;
+
+	return rte_ring_sc_dequeue_burst(r, (void **)pkts, nb_pkts, NULL);
+}
+
+void
+sw_rss_stats_get(struct sw_rss *rss,
+	struct rte_eth_stats *stats)
+{
+	unsigned int i;
+
+	for (i = 0; i < rss->nb_queues; i++) {
+		stats->imissed += rss->queues[i].drops;
+		if (i < RTE_ETHDEV_QUEUE_STAT_CNTRS) {
+			stats->q_ipackets[i] = rss->queues[i].packets;
+			stats->q_ibytes[i] = rss->queues[i].bytes;
+		}
+	}
+}
+
+void
+sw_rss_stats_reset(struct sw_rss *rss)
+{
+	unsigned int i;
+
+	rss->polls = 0;
+	rss->packets = 0;
+	rss->cycles = 0;
+	for (i = 0; i < rss->nb_queues; i++) {
+		rss->queues[i].packets = 0;
+		rss->queues[i].bytes = 0;
+		rss->queues[i].drops = 0;
+	}
+}
+
+int
+sw_rss_xstats_get_names(struct sw_rss *rss __rte_unused,
+	struct rte_eth_xstat_name *xstats_names, unsigned int size)
+{
+	unsigned int i;
+
+	if (xstats_names != NULL && size >= SW_RSS_NB_XSTATS) {
+		for (i = 0; i < SW_RSS_NB_XSTATS; i++)
+			strlcpy(xstats_names[i].name, sw_rss_xstats_names[i],
+				sizeof(xstats_names[i].name));
+	}
+
+	return SW_RSS_NB_XSTATS;
+}
+
+int
+sw_rss_xstats_get(struct sw_rss *rss,
+	struct rte_eth_xstat *xstats, unsigned int n, uint64_t id_base)
+{
+	uint64_t values[SW_RSS_NB_XSTATS];
+	unsigned int i;
+
+	if (xstats == NULL || n < SW_RSS_NB_XSTATS)
+		return SW_RSS_NB_XSTATS;
+
+	values[0] = rss->polls;
+	values[1] = rss->packets;
+	values[2] = rss->cycles;
+	values[3] = 0;
+	for (i = 0; i < rss->nb_queues; i++)
+		values[3] += rss->queues[i].drops;
+
+	for (i = 0; i < SW_RSS_NB_XSTATS; i++) {
+		xstats[i].id = id_base + i;
+		xstats[i].value = values[i];
+	}
+
+	return SW_RSS_NB_XSTATS;
+}
@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef AF_PACKET_SW_RSS_H
+#define AF_PACKET_SW_RSS_H
+
+/**
+ * @file
+ *
+ * Software RSS of the af_packet driver.
+ *
+ * A single socket of the driver can feed several Rx queues. The packets
+ * polled from the socket are hashed with the Toeplitz function of the RSS
+ * configuration, and spread through the redirection table into one ring
+ * per Rx queue.
+ *
+ * The Rx burst of each queue is done with sw_rss_rx():
+ * the lcore calling it polls the source if no other lcore is doing it,
+ * then dequeues the packets of its queue. The source is only polled by
+ * one lcore at a time, and each queue must be polled by a single lcore,
+ * as for any Rx queue.
+ */
+
+#include <stdint.h>
+
+#include <rte_ethdev.h>
+#include <rte_mbuf.h>
+
+/** Maximum number of Rx queues fed by the software RSS. */
+#define SW_RSS_MAX_QUEUES 64
+
+/** Size of the Toeplitz key of the software RSS. */
+#define SW_RSS_KEY_SIZE 40
+
+/** Size of the redirection table of the software RSS. */
+#define SW_RSS_RETA_SIZE RTE_ETH_RSS_RETA_SIZE_128
+
+/** RSS hash types supported by the software RSS. */
+#define SW_RSS_OFFLOADS ( \
+	RTE_ETH_RSS_IPV4 | \
+	RTE_ETH_RSS_FRAG_IPV4 | \
+	RTE_ETH_RSS_NONFRAG_IPV4_TCP | \
+	RTE_ETH_RSS_NONFRAG_IPV4_UDP | \
+	RTE_ETH_RSS_NONFRAG_IPV4_OTHER | \
+	RTE_ETH_RSS_IPV6 | \
+	RTE_ETH_RSS_FRAG_IPV6 | \
+	RTE_ETH_RSS_NONFRAG_IPV6_TCP | \
+	RTE_ETH_RSS_NONFRAG_IPV6_UDP | \
+	RTE_ETH_RSS_NONFRAG_IPV6_OTHER)
+
+/** Number of extended statistics of the software RSS. */
+#define SW_RSS_NB_XSTATS 4
+
+struct sw_rss;
+
+/**
+ * Function polling the packets from the source of the driver.
+ */
+typedef uint16_t (*sw_rss_poll_t)(void *arg, struct rte_mbuf **pkts,
+	uint16_t nb_pkts);
+
+/**
+ * Create a software RSS context.
+ *
+ * The hash is disabled until sw_rss_hash_update() is called,
+ * and the redirection table spreads the entries over all the queues.
+ *
+ * @param name
+ *   The name of the device, used to name the queue rings.
+ * @param nb_queues
+ *   The number of Rx queues, up to SW_RSS_MAX_QUEUES.
+ * @param socket_id
+ *   The NUMA socket of the context.
+ * @return
+ *   The context, or NULL with rte_errno set.
+ */
+struct sw_rss *sw_rss_create(const char *name,
+	uint16_t nb_queues, int socket_id);
+
+/**
+ * Free a software RSS context and the packets left in its queues.
+ *
+ * @param rss
+ *   The context, can be NULL.
+ */
+void sw_rss_free(struct sw_rss *rss);
+
+/**
+ * Set up the ring of an Rx queue, freeing the previous one.
+ *
+ * @param rss
+ *   The context.
+ * @param queue_id
+ *   The Rx queue.
+ * @param nb_desc
+ *   The number of packets the queue can hold.
+ * @param socket_id
+ *   The NUMA socket of the ring.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+int sw_rss_queue_setup(struct sw_rss *rss, uint16_t queue_id,
+	uint16_t nb_desc, int socket_id);
+
+/**
+ * Update the hash types and the key, see rte_eth_dev_rss_hash_update().
+ *
+ * A NULL key keeps the current one.
+ */
+int sw_rss_hash_update(struct sw_rss *rss,
+	const struct rte_eth_rss_conf *rss_conf);
+
+/**
+ * Get the hash configuration, see rte_eth_dev_rss_hash_conf_get().
+ */
+int sw_rss_hash_conf_get(struct sw_rss *rss,
+	struct rte_eth_rss_conf *rss_conf);
+
+/**
+ * Update the redirection table, see rte_eth_dev_rss_reta_update().
+ */
+int sw_rss_reta_update(struct sw_rss *rss,
+	const struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size);
+
+/**
+ * Query the redirection table, see rte_eth_dev_rss_reta_query().
+ */
+int sw_rss_reta_query(struct sw_rss *rss,
+	struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size);
+
+/**
+ * Receive the packets of an Rx queue, polling the source first if no
+ * other lcore is polling it. The packets polled get their RSS hash set
+ * with RTE_MBUF_F_RX_RSS_HASH, and are dropped if their queue is full.
+ *
+ * @param rss
+ *   The context.
+ * @param queue_id
+ *   The Rx queue.
+ * @param pkts
+ *   The array to store the received packets.
+ * @param nb_pkts
+ *   The maximum number of packets to receive.
+ * @param poll
+ *   The function polling the source.
+ * @param poll_arg
+ *   The argument of the poll function.
+ * @return
+ *   The number of packets received.
+ */
+uint16_t sw_rss_rx(struct sw_rss *rss, uint16_t queue_id,
+	struct rte_mbuf **pkts, uint16_t nb_pkts,
+	sw_rss_poll_t poll, void *poll_arg);
+
+/**
+ * Fill the per-queue Rx statistics, and add the packets dropped because
+ * their queue was full to imissed.
+ */
+void sw_rss_stats_get(struct sw_rss *rss,
+	struct rte_eth_stats *stats);
+
+/**
+ * Reset the statistics.
+ */
+void sw_rss_stats_reset(struct sw_rss *rss);
+
+/**
+ * Get the names of the SW_RSS_NB_XSTATS extended statistics:
+ * the number of polls of the source, the number of packets dispatched,
+ * the TSC cycles spent hashing and dispatching them, and the number of
+ * packets dropped.
+ *
+ * @return
+ *   SW_RSS_NB_XSTATS.
+ */
+int sw_rss_xstats_get_names(struct sw_rss *rss,
+	struct rte_eth_xstat_name *xstats_names, unsigned int size);
+
+/**
+ * Get the extended statistics, with ids starting from id_base.
+ *
+ * @return
+ *   SW_RSS_NB_XSTATS.
+ */
+int sw_rss_xstats_get(struct sw_rss *rss,
+	struct rte_eth_xstat *xstats, unsigned int n, uint64_t id_base);
+
+#endif /* AF_PACKET_SW_RSS_H */
@@ -9,6 +9,7 @@
 #include <rte_common.h>
 #include <rte_string_fns.h>
 #include <rte_mbuf.h>
+#include <rte_net.h>
 #include <ethdev_driver.h>
 #include <ethdev_vdev.h>
 #include <rte_malloc.h>
@@ -30,6 +31,8 @@
 #include <unistd.h>
 #include <poll.h>
 
+#include "af_packet_sw_rss.h"
+
 #define ETH_AF_PACKET_IFACE_ARG		"iface"
 #define ETH_AF_PACKET_NUM_Q_ARG		"qpairs"
 #define ETH_AF_PACKET_BLOCKSIZE_ARG	"blocksz"
@@ -41,6 +44,11 @@
 #define DFLT_FRAME_SIZE		(1 << 11)
 #define DFLT_FRAME_COUNT	(1 << 9)
 
+/* Tx checksums computed in software with rte_net_cksum_burst() */
+#define AF_PACKET_TX_CKSUM_OFFLOADS	(RTE_ETH_TX_OFFLOAD_IPV4_CKSUM | \
+					 RTE_ETH_TX_OFFLOAD_UDP_CKSUM | \
+					 RTE_ETH_TX_OFFLOAD_TCP_CKSUM)
+
 static uint64_t timestamp_dynflag;
 static int timestamp_dynfield_offset = -1;
 
@@ -56,6 +64,7 @@ struct __rte_cache_aligned pkt_rx_queue {
 	uint16_t in_port;
 	uint8_t vlan_strip;
 	uint8_t timestamp_offloading;
+	uint32_t ptype_layers;
 
 	volatile unsigned long rx_pkts;
 	volatile unsigned long rx_bytes;
@@ -71,12 +80,20 @@ struct __rte_cache_aligned pkt_tx_queue {
 	uint8_t *map;
 	unsigned int framecount;
 	unsigned int framenum;
+	uint8_t sw_cksum;
 
 	volatile unsigned long tx_pkts;
 	volatile unsigned long err_pkts;
 	volatile unsigned long tx_bytes;
 };
 
+/* Rx queue fed by the software RSS from the socket of the queue 0 */
+struct sw_rss_rx_queue {
+	struct sw_rss *rss;
+	struct pkt_rx_queue *src;
+	uint16_t queue_id;
+};
+
 struct pmd_internals {
 	unsigned nb_queues;
 
@@ -90,6 +107,12 @@ struct pmd_internals {
 	struct pkt_tx_queue *tx_queue;
 	uint8_t vlan_strip;
 	uint8_t timestamp_offloading;
+	/* Layers parsed in software to fill the packet type, 0 to disable */
+	uint32_t ptype_layers;
+	/* Software RSS, when more Rx queues than sockets are configured */
+	struct sw_rss *sw_rss;
+	struct sw_rss_rx_queue *sw_rss_rxq;
+	uint16_t sw_rss_nb_rxq;
 };
 
 static const char *valid_arguments[] = {
@@ -190,11 +213,26 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		num_rx_bytes += mbuf->pkt_len;
 	}
 	pkt_q->framenum = framenum;
+	if (pkt_q->ptype_layers != 0)
+		rte_net_get_ptype_burst(bufs, num_rx, pkt_q->ptype_layers);
 	pkt_q->rx_pkts += num_rx;
 	pkt_q->rx_bytes += num_rx_bytes;
 	return num_rx;
 }
 
+/*
+ * Receive on a queue fed by the software RSS: the lcore polling the
+ * socket spreads the packets into the rings of all the queues.
+ */
+static uint16_t
+eth_af_packet_rx_sw_rss(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct sw_rss_rx_queue *rxq = queue;
+
+	return sw_rss_rx(rxq->rss, rxq->queue_id, bufs, nb_pkts,
+		eth_af_packet_rx, rxq->src);
+}
+
 /*
  * Check if there is an available frame in the ring
  */
@@ -239,6 +277,15 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	pfd.events = POLLOUT;
 	pfd.revents = 0;
 
+	/*
+	 * Compute the checksums requested by the Tx offload flags,
+	 * a packet for which it is not possible is sent as is.
+	 */
+	if (pkt_q->sw_cksum) {
+		for (i = 0; i < nb_pkts; i++)
+			i += rte_net_cksum_burst(&bufs[i], nb_pkts - i);
+	}
+
 	framecount = pkt_q->framecount;
 	framenum = pkt_q->framenum;
 	ppd = (struct tpacket2_hdr *) pkt_q->rd[framenum].iov_base;
@@ -353,6 +400,10 @@ eth_dev_start(struct rte_eth_dev *dev)
 		dev->data->rx_queue_state[i] = RTE_ETH_QUEUE_STATE_STARTED;
 		dev->data->tx_queue_state[i] = RTE_ETH_QUEUE_STATE_STARTED;
 	}
+	if (internals->sw_rss != NULL) {
+		for (i = 0; i < dev->data->nb_rx_queues; i++)
+			dev->data->rx_queue_state[i] = RTE_ETH_QUEUE_STATE_STARTED;
+	}
 	return 0;
 }
 
@@ -369,19 +420,109 @@ eth_dev_stop(struct rte_eth_dev *dev)
 		dev->data->rx_queue_state[i] = RTE_ETH_QUEUE_STATE_STOPPED;
 		dev->data->tx_queue_state[i] = RTE_ETH_QUEUE_STATE_STOPPED;
 	}
+	if (internals->sw_rss != NULL) {
+		for (i = 0; i < dev->data->nb_rx_queues; i++)
+			dev->data->rx_queue_state[i] = RTE_ETH_QUEUE_STATE_STOPPED;
+	}
 	dev->data->dev_link.link_status = RTE_ETH_LINK_DOWN;
 	return 0;
 }
 
+static void
+eth_sw_rss_free(struct rte_eth_dev *dev)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	uint16_t q;
+
+	/* the Rx queues must not point to the freed queues anymore */
+	for (q = 0; q < dev->data->nb_rx_queues; q++) {
+		struct sw_rss_rx_queue *rxq = dev->data->rx_queues[q];
+
+		if (rxq >= internals->sw_rss_rxq &&
+				rxq < internals->sw_rss_rxq + internals->sw_rss_nb_rxq)
+			dev->data->rx_queues[q] = NULL;
+	}
+
+	sw_rss_free(internals->sw_rss);
+	internals->sw_rss = NULL;
+	rte_free(internals->sw_rss_rxq);
+	internals->sw_rss_rxq = NULL;
+	internals->sw_rss_nb_rxq = 0;
+}
+
+/*
+ * Spread the packets of the single socket into more Rx queues
+ * with the software RSS.
+ */
+static int
+eth_sw_rss_configure(struct rte_eth_dev *dev)
+{
+	struct rte_eth_conf *dev_conf = &dev->data->dev_conf;
+	struct pmd_internals *internals = dev->data->dev_private;
+	uint16_t nb_rx_queues = dev->data->nb_rx_queues;
+	uint16_t q;
+	int ret;
+
+	eth_sw_rss_free(dev);
+
+	if ((dev_conf->rxmode.mq_mode & RTE_ETH_MQ_RX_RSS_FLAG) == 0) {
+		PMD_LOG(ERR, "%s: RSS mode required for %u Rx queues",
+			dev->device->name, nb_rx_queues);
+		return -EINVAL;
+	}
+
+	internals->sw_rss = sw_rss_create(dev->device->name,
+		nb_rx_queues, dev->device->numa_node);
+	if (internals->sw_rss == NULL) {
+		PMD_LOG(ERR, "%s: cannot create software RSS",
+			dev->device->name);
+		return -rte_errno;
+	}
+
+	internals->sw_rss_rxq = rte_zmalloc_socket(dev->device->name,
+		nb_rx_queues * sizeof(internals->sw_rss_rxq[0]), 0,
+		dev->device->numa_node);
+	if (internals->sw_rss_rxq == NULL) {
+		eth_sw_rss_free(dev);
+		return -ENOMEM;
+	}
+	internals->sw_rss_nb_rxq = nb_rx_queues;
+	for (q = 0; q < nb_rx_queues; q++) {
+		internals->sw_rss_rxq[q].rss = internals->sw_rss;
+		internals->sw_rss_rxq[q].src = &internals->rx_queue[0];
+		internals->sw_rss_rxq[q].queue_id = q;
+	}
+
+	ret = sw_rss_hash_update(internals->sw_rss,
+		&dev_conf->rx_adv_conf.rss_conf);
+	if (ret != 0) {
+		eth_sw_rss_free(dev);
+		return ret;
+	}
+
+	return 0;
+}
+
 static int
 eth_dev_configure(struct rte_eth_dev *dev __rte_unused)
 {
 	struct rte_eth_conf *dev_conf = &dev->data->dev_conf;
 	const struct rte_eth_rxmode *rxmode = &dev_conf->rxmode;
 	struct pmd_internals *internals = dev->data->dev_private;
+	int ret;
 
 	internals->vlan_strip = !!(rxmode->offloads & RTE_ETH_RX_OFFLOAD_VLAN_STRIP);
 	internals->timestamp_offloading = !!(rxmode->offloads & RTE_ETH_RX_OFFLOAD_TIMESTAMP);
+
+	if (dev->data->nb_rx_queues > internals->nb_queues) {
+		ret = eth_sw_rss_configure(dev);
+		if (ret != 0)
+			return ret;
+		dev->rx_pkt_burst = eth_af_packet_rx_sw_rss;
+	} else {
+		eth_sw_rss_free(dev);
+		dev->rx_pkt_burst = eth_af_packet_rx;
+	}
 	return 0;
 }
 
@@ -394,10 +535,19 @@ eth_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	dev_info->max_mac_addrs = 1;
 	dev_info->max_rx_pktlen = RTE_ETHER_MAX_LEN;
 	dev_info->max_rx_queues = (uint16_t)internals->nb_queues;
+	/* a single socket can feed more Rx queues with the software RSS */
+	if (internals->nb_queues == 1) {
+		dev_info->max_rx_queues = SW_RSS_MAX_QUEUES;
+		dev_info->flow_type_rss_offloads = SW_RSS_OFFLOADS;
+		dev_info->hash_key_size = SW_RSS_KEY_SIZE;
+		dev_info->reta_size = SW_RSS_RETA_SIZE;
+		dev_info->rss_algo_capa = RTE_ETH_HASH_ALGO_CAPA_MASK(DEFAULT) |
+			RTE_ETH_HASH_ALGO_CAPA_MASK(TOEPLITZ);
+	}
 	dev_info->max_tx_queues = (uint16_t)internals->nb_queues;
 	dev_info->min_rx_bufsize = 0;
 	dev_info->tx_offload_capa = RTE_ETH_TX_OFFLOAD_MULTI_SEGS |
-		RTE_ETH_TX_OFFLOAD_VLAN_INSERT;
+		RTE_ETH_TX_OFFLOAD_VLAN_INSERT | AF_PACKET_TX_CKSUM_OFFLOADS;
 	dev_info->rx_offload_capa = RTE_ETH_RX_OFFLOAD_VLAN_STRIP |
 		RTE_ETH_RX_OFFLOAD_TIMESTAMP;
 
@@ -463,6 +613,10 @@ eth_stats_get(struct rte_eth_dev *dev, struct rte_eth_stats *stats)
 	stats->opackets = tx_total;
 	stats->oerrors = tx_err_total;
 	stats->obytes = tx_bytes_total;
+
+	/* per-queue counters of the queues fed by the software RSS */
+	if (internal->sw_rss != NULL)
+		sw_rss_stats_get(internal->sw_rss, stats);
 	return 0;
 }
 
@@ -486,9 +640,86 @@ eth_stats_reset(struct rte_eth_dev *dev)
 		internal->tx_queue[i].tx_bytes = 0;
 	}
 
+	if (internal->sw_rss != NULL)
+		sw_rss_stats_reset(internal->sw_rss);
+
 	return 0;
 }
 
+static int
+eth_xstats_get_names(struct rte_eth_dev *dev,
+		struct rte_eth_xstat_name *xstats_names, unsigned int size)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return 0;
+
+	return sw_rss_xstats_get_names(internals->sw_rss,
+		xstats_names, size);
+}
+
+static int
+eth_xstats_get(struct rte_eth_dev *dev, struct rte_eth_xstat *xstats,
+		unsigned int n)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return 0;
+
+	return sw_rss_xstats_get(internals->sw_rss, xstats, n, 0);
+}
+
+static int
+eth_rss_hash_update(struct rte_eth_dev *dev, struct rte_eth_rss_conf *rss_conf)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return -ENOTSUP;
+
+	return sw_rss_hash_update(internals->sw_rss, rss_conf);
+}
+
+static int
+eth_rss_hash_conf_get(struct rte_eth_dev *dev,
+		struct rte_eth_rss_conf *rss_conf)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return -ENOTSUP;
+
+	return sw_rss_hash_conf_get(internals->sw_rss, rss_conf);
+}
+
+static int
+eth_rss_reta_update(struct rte_eth_dev *dev,
+		struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return -ENOTSUP;
+
+	return sw_rss_reta_update(internals->sw_rss, reta_conf,
+		reta_size);
+}
+
+static int
+eth_rss_reta_query(struct rte_eth_dev *dev,
+		struct rte_eth_rss_reta_entry64 *reta_conf, uint16_t reta_size)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+
+	if (internals->sw_rss == NULL)
+		return -ENOTSUP;
+
+	return sw_rss_reta_query(internals->sw_rss, reta_conf,
+		reta_size);
+}
+
 static int
 eth_dev_close(struct rte_eth_dev *dev)
 {
@@ -525,6 +756,7 @@ eth_dev_close(struct rte_eth_dev *dev)
 		rte_free(internals->rx_queue[q].rd);
 		rte_free(internals->tx_queue[q].rd);
 	}
+	eth_sw_rss_free(dev);
 	free(internals->if_name);
 	rte_free(internals->rx_queue);
 	rte_free(internals->tx_queue);
@@ -554,18 +786,43 @@ eth_link_update(struct rte_eth_dev *dev,
 	return 0;
 }
 
+static int
+eth_sw_rss_rx_queue_setup(struct rte_eth_dev *dev, uint16_t rx_queue_id,
+		uint16_t nb_rx_desc, unsigned int socket_id)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	int ret;
+
+	ret = sw_rss_queue_setup(internals->sw_rss, rx_queue_id,
+		nb_rx_desc, socket_id);
+	if (ret != 0) {
+		PMD_LOG(ERR, "%s: cannot set up Rx queue %u",
+			dev->device->name, rx_queue_id);
+		return ret;
+	}
+
+	dev->data->rx_queues[rx_queue_id] = &internals->sw_rss_rxq[rx_queue_id];
+	return 0;
+}
+
 static int
 eth_rx_queue_setup(struct rte_eth_dev *dev,
                    uint16_t rx_queue_id,
-                   uint16_t nb_rx_desc __rte_unused,
-                   unsigned int socket_id __rte_unused,
+                   uint16_t nb_rx_desc,
+                   unsigned int socket_id,
                    const struct rte_eth_rxconf *rx_conf __rte_unused,
                    struct rte_mempool *mb_pool)
 {
 	struct pmd_internals *internals = dev->data->dev_private;
-	struct pkt_rx_queue *pkt_q = &internals->rx_queue[rx_queue_id];
+	struct pkt_rx_queue *pkt_q;
 	unsigned int buf_size, data_size;
 
+	/* only the queue 0 of the software RSS has a socket */
+	if (internals->sw_rss != NULL && rx_queue_id != 0)
+		return eth_sw_rss_rx_queue_setup(dev, rx_queue_id,
+			nb_rx_desc, socket_id);
+
+	pkt_q = &internals->rx_queue[rx_queue_id];
 	pkt_q->mb_pool = mb_pool;
 
 	/* Now get the space available for data in the mbuf */
@@ -585,6 +842,11 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pkt_q->in_port = dev->data->port_id;
 	pkt_q->vlan_strip = internals->vlan_strip;
 	pkt_q->timestamp_offloading = internals->timestamp_offloading;
+	pkt_q->ptype_layers = internals->ptype_layers;
+
+	if (internals->sw_rss != NULL)
+		return eth_sw_rss_rx_queue_setup(dev, rx_queue_id,
+			nb_rx_desc, socket_id);
 
 	return 0;
 }
@@ -594,12 +856,14 @@ eth_tx_queue_setup(struct rte_eth_dev *dev,
                    uint16_t tx_queue_id,
                    uint16_t nb_tx_desc __rte_unused,
                    unsigned int socket_id __rte_unused,
-                   const struct rte_eth_txconf *tx_conf __rte_unused)
+                   const struct rte_eth_txconf *tx_conf)
 {
 
 	struct pmd_internals *internals = dev->data->dev_private;
+	struct pkt_tx_queue *pkt_q = &internals->tx_queue[tx_queue_id];
 
-	dev->data->tx_queues[tx_queue_id] = &internals->tx_queue[tx_queue_id];
+	pkt_q->sw_cksum = !!(tx_conf->offloads & AF_PACKET_TX_CKSUM_OFFLOADS);
+	dev->data->tx_queues[tx_queue_id] = pkt_q;
 	return 0;
 }
 
@@ -699,6 +963,64 @@ eth_dev_promiscuous_disable(struct rte_eth_dev *dev)
 	return eth_dev_change_flags(internals->if_name, 0, ~IFF_PROMISC);
 }
 
+static const uint32_t *
+eth_dev_supported_ptypes_get(struct rte_eth_dev *dev __rte_unused,
+		size_t *no_of_elements)
+{
+	static const uint32_t ptypes[] = {
+		RTE_PTYPE_L2_ETHER,
+		RTE_PTYPE_L2_ETHER_VLAN,
+		RTE_PTYPE_L2_ETHER_QINQ,
+		RTE_PTYPE_L3_IPV4,
+		RTE_PTYPE_L3_IPV4_EXT,
+		RTE_PTYPE_L3_IPV6,
+		RTE_PTYPE_L3_IPV6_EXT,
+		RTE_PTYPE_L4_FRAG,
+		RTE_PTYPE_L4_UDP,
+		RTE_PTYPE_L4_TCP,
+		RTE_PTYPE_L4_SCTP,
+		RTE_PTYPE_TUNNEL_IP,
+		RTE_PTYPE_TUNNEL_GRE,
+		RTE_PTYPE_TUNNEL_NVGRE,
+		RTE_PTYPE_TUNNEL_VXLAN,
+		RTE_PTYPE_TUNNEL_VXLAN_GPE,
+		RTE_PTYPE_TUNNEL_GENEVE,
+		RTE_PTYPE_TUNNEL_GTPC,
+		RTE_PTYPE_TUNNEL_GTPU,
+		RTE_PTYPE_INNER_L2_ETHER,
+		RTE_PTYPE_INNER_L2_ETHER_VLAN,
+		RTE_PTYPE_INNER_L2_ETHER_QINQ,
+		RTE_PTYPE_INNER_L3_IPV4,
+		RTE_PTYPE_INNER_L3_IPV4_EXT,
+		RTE_PTYPE_INNER_L3_IPV6,
+		RTE_PTYPE_INNER_L3_IPV6_EXT,
+		RTE_PTYPE_INNER_L4_FRAG,
+		RTE_PTYPE_INNER_L4_UDP,
+		RTE_PTYPE_INNER_L4_TCP,
+		RTE_PTYPE_INNER_L4_SCTP,
+	};
+
+	*no_of_elements = RTE_DIM(ptypes);
+	return ptypes;
+}
+
+/*
+ * The packet types are parsed in software, so this is only done for the
+ * layers requested with rte_eth_dev_set_ptypes().
+ */
+static int
+eth_dev_ptypes_set(struct rte_eth_dev *dev, uint32_t ptype_mask)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	unsigned int q;
+
+	internals->ptype_layers = ptype_mask;
+	for (q = 0; q < internals->nb_queues; q++)
+		internals->rx_queue[q].ptype_layers = ptype_mask;
+
+	return 0;
+}
+
 static const struct eth_dev_ops ops = {
 	.dev_start = eth_dev_start,
 	.dev_stop = eth_dev_stop,
@@ -714,6 +1036,14 @@ static const struct eth_dev_ops ops = {
 	.link_update = eth_link_update,
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
+	.xstats_get = eth_xstats_get,
+	.xstats_get_names = eth_xstats_get_names,
+	.rss_hash_update = eth_rss_hash_update,
+	.rss_hash_conf_get = eth_rss_hash_conf_get,
+	.reta_update = eth_rss_reta_update,
+	.reta_query = eth_rss_reta_query,
+	.dev_supported_ptypes_get = eth_dev_supported_ptypes_get,
+	.dev_ptypes_set = eth_dev_ptypes_set,
 };
 
 /*
@@ -17,6 +17,7 @@
 #include <rte_version.h>
 #include <rte_mbuf.h>
 #include <rte_ether.h>
+#include <rte_net.h>
 #include <ethdev_driver.h>
 #include <ethdev_vdev.h>
 #include <rte_malloc.h>
@@ -498,6 +499,8 @@ eth_memif_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		rte_atomic_store_explicit(&ring->head, head, rte_memory_order_release);
 	}
 
+	if (mq->ptype_layers != 0)
+		rte_net_get_ptype_burst(bufs, n_rx_pkts, mq->ptype_layers);
 	mq->n_pkts += n_rx_pkts;
 	return n_rx_pkts;
 }
@@ -631,6 +634,8 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	 */
 	rte_atomic_store_explicit(&ring->head, head, rte_memory_order_release);
 
+	if (mq->ptype_layers != 0)
+		rte_net_get_ptype_burst(bufs, n_rx_pkts, mq->ptype_layers);
 	mq->n_pkts += n_rx_pkts;
 
 	return n_rx_pkts;
@@ -1530,6 +1535,7 @@ memif_rx_queue_setup(struct rte_eth_dev *dev,
 
 	mq->mempool = mb_pool;
 	mq->in_port = dev->data->port_id;
+	mq->ptype_layers = pmd->ptype_layers;
 	dev->data->rx_queues[qid] = mq;
 
 	return 0;
@@ -1643,6 +1649,68 @@ memif_stats_reset(struct rte_eth_dev *dev)
 	return 0;
 }
 
+static const uint32_t *
+memif_dev_supported_ptypes_get(struct rte_eth_dev *dev __rte_unused,
+		size_t *no_of_elements)
+{
+	static const uint32_t ptypes[] = {
+		RTE_PTYPE_L2_ETHER,
+		RTE_PTYPE_L2_ETHER_VLAN,
+		RTE_PTYPE_L2_ETHER_QINQ,
+		RTE_PTYPE_L3_IPV4,
+		RTE_PTYPE_L3_IPV4_EXT,
+		RTE_PTYPE_L3_IPV6,
+		RTE_PTYPE_L3_IPV6_EXT,
+		RTE_PTYPE_L4_FRAG,
+		RTE_PTYPE_L4_UDP,
+		RTE_PTYPE_L4_TCP,
+		RTE_PTYPE_L4_SCTP,
+		RTE_PTYPE_TUNNEL_IP,
+		RTE_PTYPE_TUNNEL_GRE,
+		RTE_PTYPE_TUNNEL_NVGRE,
+		RTE_PTYPE_TUNNEL_VXLAN,
+		RTE_PTYPE_TUNNEL_VXLAN_GPE,
+		RTE_PTYPE_TUNNEL_GENEVE,
+		RTE_PTYPE_TUNNEL_GTPC,
+		RTE_PTYPE_TUNNEL_GTPU,
+		RTE_PTYPE_INNER_L2_ETHER,
+		RTE_PTYPE_INNER_L2_ETHER_VLAN,
+		RTE_PTYPE_INNER_L2_ETHER_QINQ,
+		RTE_PTYPE_INNER_L3_IPV4,
+		RTE_PTYPE_INNER_L3_IPV4_EXT,
+		RTE_PTYPE_INNER_L3_IPV6,
+		RTE_PTYPE_INNER_L3_IPV6_EXT,
+		RTE_PTYPE_INNER_L4_FRAG,
+		RTE_PTYPE_INNER_L4_UDP,
+		RTE_PTYPE_INNER_L4_TCP,
+		RTE_PTYPE_INNER_L4_SCTP,
+	};
+
+	*no_of_elements = RTE_DIM(ptypes);
+	return ptypes;
+}
+
+/*
+ * The packet types are parsed in software, so this is only done for the
+ * layers requested with rte_eth_dev_set_ptypes().
+ */
+static int
+memif_dev_ptypes_set(struct rte_eth_dev *dev, uint32_t ptype_mask)
+{
+	struct pmd_internals *pmd = dev->data->dev_private;
+	struct memif_queue *mq;
+	uint16_t i;
+
+	pmd->ptype_layers = ptype_mask;
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		mq = dev->data->rx_queues[i];
+		if (mq != NULL)
+			mq->ptype_layers = ptype_mask;
+	}
+
+	return 0;
+}
+
 static const struct eth_dev_ops ops = {
 	.dev_start = memif_dev_start,
 	.dev_stop = memif_dev_stop,
@@ -1656,6 +1724,8 @@ static const struct eth_dev_ops ops = {
 	.link_update = memif_link_update,
 	.stats_get = memif_stats_get,
 	.stats_reset = memif_stats_reset,
+	.dev_supported_ptypes_get = memif_dev_supported_ptypes_get,
+	.dev_ptypes_set = memif_dev_ptypes_set,
 };
 
 static int
@@ -54,6 +54,7 @@ struct memif_queue {
 	memif_region_index_t region;		/**< shared memory region index */
 
 	uint16_t in_port;			/**< port id */
+	uint32_t ptype_layers;			/**< layers parsed for ptype */
 
 	memif_region_offset_t ring_offset;
 	/**< ring offset from start of shm region (ring - memif_region.addr) */
@@ -115,6 +116,8 @@ struct pmd_internals {
 		uint8_t num_s2c_rings;		/**< number of server to client rings */
 		uint16_t pkt_buffer_size;	/**< buffer size */
 	} run;
+
+	uint32_t ptype_layers;			/**< layers parsed for ptype */
 	/**< Parameters used in active connection */
 
 	char local_disc_string[ETH_MEMIF_DISC_STRING_SIZE];
@@ -369,7 +369,7 @@ tap_verify_csum(struct rte_mbuf *mbuf)
 			return;
 	} else {
 		/* - RTE_PTYPE_L3_IPV4_EXT_UNKNOWN cannot happen because
-		 *   mbuf->packet_type is filled by rte_net_get_ptype() which
+		 *   mbuf->packet_type is filled by rte_net_get_ptype_burst() which
 		 *   never returns this value.
 		 * - IPv6 extensions are not supported.
 		 */
@@ -431,7 +431,7 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
 	struct rx_queue *rxq = queue;
 	struct pmd_process_private *process_private;
-	uint16_t num_rx;
+	uint16_t num_rx, i;
 	unsigned long num_rx_bytes = 0;
 	uint32_t trigger = tap_trigger;
 
@@ -502,16 +502,18 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			data_off = 0;
 		}
 		seg->next = NULL;
-		mbuf->packet_type = rte_net_get_ptype(mbuf, NULL,
-						      RTE_PTYPE_ALL_MASK);
-		if (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM)
-			tap_verify_csum(mbuf);
 
 		/* account for the receive frame */
 		bufs[num_rx++] = mbuf;
 		num_rx_bytes += mbuf->pkt_len;
 	}
 end:
+	rte_net_get_ptype_burst(bufs, num_rx, RTE_PTYPE_ALL_MASK);
+	if (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM) {
+		for (i = 0; i < num_rx; i++)
+			tap_verify_csum(bufs[i]);
+	}
+
 	rxq->stats.ipackets += num_rx;
 	rxq->stats.ibytes += num_rx_bytes;
 
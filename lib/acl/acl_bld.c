@@ -1633,6 +1633,11 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 	if (rc != 0)
 		return rc;
 
+	/* incremental context is rebuilt by rte_acl_incr_*() only */
+	if (rte_atomic_load_explicit(&ctx->incr,
+			rte_memory_order_relaxed) != NULL)
+		return -EBUSY;
+
 	acl_build_reset(ctx);
 
 	if (cfg->max_size == 0) {
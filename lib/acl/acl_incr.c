@@ -0,0 +1,598 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdlib.h>
+
+#include <rte_acl.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_string_fns.h>
+
+#include "acl.h"
+#include "acl_log.h"
+
+/*
+ * Incremental update mode.
+ *
+ * The rules of the context are split into a main trie and a small delta
+ * trie, which receives the added rules. Both are regular ACL contexts,
+ * built by rte_acl_build(), whose rule userdata is replaced by an index
+ * into a table of the original userdata and priority. That lets the
+ * classify path pick the highest priority match of the two tries.
+ *
+ * The readers see a generation: a pair of main and delta tries published
+ * with a single pointer store. An update builds the new tries aside,
+ * publishes a new generation and retires the old one through RCU QSBR.
+ *
+ * The rules of the context (ctx->rules) stay the master copy: the main
+ * trie rules first, followed by the num_delta rules of the delta trie.
+ */
+
+#define ACL_INCR_DQ_SIZE_DEF		64
+#define ACL_INCR_DQ_RECLAIM_MAX		16
+
+/* Number of results of a classify call on the delta trie. */
+#define ACL_INCR_RESULTS_MAX		512
+
+struct acl_incr_rule_info {
+	uint32_t userdata;
+	int32_t priority;
+};
+
+struct acl_incr_trie {
+	/* context built with rules from the master copy */
+	struct rte_acl_ctx ctx;
+	/* original userdata and priority of rule i at index i - 1 */
+	struct acl_incr_rule_info info[];
+};
+
+struct acl_incr_gen {
+	struct acl_incr_trie *main;
+	struct acl_incr_trie *delta;
+};
+
+/* Resources of a replaced generation waiting for the readers. */
+struct acl_incr_retired {
+	struct acl_incr_gen *gen;
+	struct acl_incr_trie *main;
+	struct acl_incr_trie *delta;
+	void *mem;
+};
+
+struct acl_incr {
+	RTE_ATOMIC(struct acl_incr_gen *) gen;
+	struct rte_acl_ctx *ctx;
+	struct rte_rcu_qsbr *v;
+	enum rte_acl_qsbr_mode mode;
+	struct rte_rcu_qsbr_dq *dq;
+	uint32_t max_delta;
+	uint32_t num_delta;
+};
+
+static void
+acl_incr_trie_free(struct acl_incr_trie *trie)
+{
+	if (trie != NULL) {
+		rte_free(trie->ctx.mem);
+		rte_free(trie);
+	}
+}
+
+static int
+acl_incr_userdata_cmp(const void *a, const void *b)
+{
+	uint32_t ua = *(const uint32_t *)a;
+	uint32_t ub = *(const uint32_t *)b;
+
+	return (ua > ub) - (ua < ub);
+}
+
+static int
+acl_incr_deleted(const uint32_t *del, uint32_t num_del, uint32_t userdata)
+{
+	return num_del != 0 && bsearch(&userdata, del, num_del,
+		sizeof(del[0]), acl_incr_userdata_cmp) != NULL;
+}
+
+static inline struct rte_acl_rule *
+acl_incr_rule(const struct rte_acl_ctx *ctx, uint32_t idx)
+{
+	return (struct rte_acl_rule *)((uintptr_t)ctx->rules +
+		(uintptr_t)idx * ctx->rule_sz);
+}
+
+/*
+ * Build a trie from num master rules starting at first,
+ * skipping the rules whose userdata is in the sorted del array.
+ * No trie is needed when no rule is left.
+ */
+static int
+acl_incr_trie_build(const struct rte_acl_ctx *ctx, uint32_t first,
+	uint32_t num, const uint32_t *del, uint32_t num_del,
+	struct acl_incr_trie **ptrie)
+{
+	const struct rte_acl_rule *rs;
+	struct acl_incr_trie *trie;
+	struct rte_acl_rule *rd;
+	uint32_t i, n;
+	size_t sz;
+	int32_t rc;
+
+	*ptrie = NULL;
+	if (num == 0)
+		return 0;
+
+	sz = sizeof(*trie) + num * sizeof(trie->info[0]) +
+		(size_t)num * ctx->rule_sz;
+	trie = rte_zmalloc_socket(ctx->name, sz, RTE_CACHE_LINE_SIZE,
+		ctx->socket_id);
+	if (trie == NULL) {
+		ACL_LOG(ERR, "allocation of %zu bytes on socket %d for %s failed",
+			sz, ctx->socket_id, ctx->name);
+		return -ENOMEM;
+	}
+
+	strlcpy(trie->ctx.name, ctx->name, sizeof(trie->ctx.name));
+	trie->ctx.socket_id = ctx->socket_id;
+	trie->ctx.alg = ctx->alg;
+	trie->ctx.rule_sz = ctx->rule_sz;
+	trie->ctx.rules = &trie->info[num];
+
+	n = 0;
+	for (i = 0; i != num; i++) {
+		rs = acl_incr_rule(ctx, first + i);
+		if (acl_incr_deleted(del, num_del, rs->data.userdata))
+			continue;
+
+		rd = acl_incr_rule(&trie->ctx, n);
+		memcpy(rd, rs, ctx->rule_sz);
+		trie->info[n].userdata = rs->data.userdata;
+		trie->info[n].priority = rs->data.priority;
+		rd->data.userdata = ++n;
+	}
+
+	if (n == 0) {
+		rte_free(trie);
+		return 0;
+	}
+
+	trie->ctx.max_rules = n;
+	trie->ctx.num_rules = n;
+
+	rc = rte_acl_build(&trie->ctx, &ctx->config);
+	if (rc != 0) {
+		ACL_LOG(ERR, "ACL context: %s, build of %u rules failed: %d",
+			ctx->name, n, rc);
+		acl_incr_trie_free(trie);
+		return rc;
+	}
+
+	*ptrie = trie;
+	return 0;
+}
+
+static void
+acl_incr_retired_free(struct acl_incr_retired *r)
+{
+	rte_free(r->gen);
+	acl_incr_trie_free(r->main);
+	acl_incr_trie_free(r->delta);
+	rte_free(r->mem);
+}
+
+static void
+acl_incr_rcu_qsbr_free_resource(void *p, void *e, unsigned int n)
+{
+	struct acl_incr_retired *r = e;
+	unsigned int i;
+
+	RTE_SET_USED(p);
+	for (i = 0; i != n; i++)
+		acl_incr_retired_free(&r[i]);
+}
+
+/*
+ * Free the resources once no reader can access them.
+ */
+static void
+acl_incr_retire(struct acl_incr *incr, struct acl_incr_retired *r)
+{
+	if (incr->v == NULL) {
+		acl_incr_retired_free(r);
+		return;
+	}
+
+	if (incr->mode == RTE_ACL_QSBR_MODE_DQ &&
+			rte_rcu_qsbr_dq_enqueue(incr->dq, r) == 0)
+		return;
+
+	/* blocking mode or full defer queue: wait for the readers */
+	rte_rcu_qsbr_synchronize(incr->v, RTE_QSBR_THRID_INVALID);
+	acl_incr_retired_free(r);
+}
+
+/*
+ * Make a new generation visible to the readers and retire the tries
+ * of the current one it does not use.
+ */
+static int
+acl_incr_publish(struct acl_incr *incr, struct acl_incr_trie *main,
+	struct acl_incr_trie *delta)
+{
+	struct acl_incr_gen *gen, *old;
+	struct acl_incr_retired r;
+
+	gen = rte_malloc_socket(NULL, sizeof(*gen), 0, incr->ctx->socket_id);
+	if (gen == NULL)
+		return -ENOMEM;
+
+	gen->main = main;
+	gen->delta = delta;
+
+	old = rte_atomic_load_explicit(&incr->gen, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&incr->gen, gen, rte_memory_order_release);
+
+	if (old != NULL) {
+		memset(&r, 0, sizeof(r));
+		r.gen = old;
+		if (old->main != main)
+			r.main = old->main;
+		if (old->delta != delta)
+			r.delta = old->delta;
+		acl_incr_retire(incr, &r);
+	}
+
+	return 0;
+}
+
+/*
+ * Rebuild the main trie from the first num master rules, minus the
+ * deleted ones, with an empty delta trie.
+ */
+static int
+acl_incr_merge(struct acl_incr *incr, uint32_t num, const uint32_t *del,
+	uint32_t num_del)
+{
+	struct acl_incr_trie *main;
+	int32_t rc;
+
+	rc = acl_incr_trie_build(incr->ctx, 0, num, del, num_del, &main);
+	if (rc != 0)
+		return rc;
+
+	rc = acl_incr_publish(incr, main, NULL);
+	if (rc != 0) {
+		acl_incr_trie_free(main);
+		return rc;
+	}
+
+	incr->num_delta = 0;
+	return 0;
+}
+
+/*
+ * Rebuild the delta trie from the last num master rules out of total,
+ * minus the deleted ones.
+ */
+static int
+acl_incr_delta_update(struct acl_incr *incr, uint32_t total, uint32_t num,
+	const uint32_t *del, uint32_t num_del)
+{
+	struct acl_incr_trie *delta;
+	struct acl_incr_gen *gen;
+	int32_t rc;
+
+	rc = acl_incr_trie_build(incr->ctx, total - num, num, del, num_del,
+		&delta);
+	if (rc != 0)
+		return rc;
+
+	gen = rte_atomic_load_explicit(&incr->gen, rte_memory_order_relaxed);
+	rc = acl_incr_publish(incr, gen->main, delta);
+	if (rc != 0) {
+		acl_incr_trie_free(delta);
+		return rc;
+	}
+
+	incr->num_delta = num;
+	return 0;
+}
+
+/*
+ * Resolve the trie results into userdata: results holds the main trie
+ * matches, tmp the delta trie ones for the same input.
+ */
+static inline void
+acl_incr_resolve(const struct acl_incr_gen *gen, uint32_t *results,
+	const uint32_t *tmp, uint32_t num)
+{
+	const struct acl_incr_rule_info *mi, *di;
+	uint32_t i, rm, rd;
+
+	for (i = 0; i != num; i++) {
+		rm = results[i];
+		rd = (tmp != NULL) ? tmp[i] : 0;
+		if (rd != 0) {
+			di = &gen->delta->info[rd - 1];
+			mi = (rm != 0) ? &gen->main->info[rm - 1] : NULL;
+			if (mi == NULL || di->priority >= mi->priority) {
+				results[i] = di->userdata;
+				continue;
+			}
+		}
+		if (rm != 0)
+			results[i] = gen->main->info[rm - 1].userdata;
+	}
+}
+
+int
+acl_incr_classify(const struct acl_incr *incr, rte_acl_classify_t fn,
+	const uint8_t **data, uint32_t *results, uint32_t num,
+	uint32_t categories)
+{
+	const struct acl_incr_gen *gen;
+	uint32_t tmp[ACL_INCR_RESULTS_MAX];
+	uint32_t i, n, step;
+	int32_t rc;
+
+	gen = rte_atomic_load_explicit(&incr->gen, rte_memory_order_acquire);
+
+	if (gen->main == NULL)
+		memset(results, 0, sizeof(results[0]) * num * categories);
+	else {
+		rc = fn(&gen->main->ctx, data, results, num, categories);
+		if (rc != 0)
+			return rc;
+	}
+
+	if (gen->delta == NULL) {
+		if (gen->main != NULL)
+			acl_incr_resolve(gen, results, NULL, num * categories);
+		return 0;
+	}
+
+	step = ACL_INCR_RESULTS_MAX / categories;
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, step);
+		rc = fn(&gen->delta->ctx, data + i, tmp, n, categories);
+		if (rc != 0)
+			return rc;
+		acl_incr_resolve(gen, results + i * categories, tmp,
+			n * categories);
+	}
+
+	return 0;
+}
+
+void
+acl_incr_free(struct acl_incr *incr)
+{
+	struct acl_incr_gen *gen;
+
+	if (incr == NULL)
+		return;
+
+	if (incr->dq != NULL)
+		rte_rcu_qsbr_dq_delete(incr->dq);
+
+	gen = rte_atomic_load_explicit(&incr->gen, rte_memory_order_relaxed);
+	acl_incr_trie_free(gen->main);
+	acl_incr_trie_free(gen->delta);
+	rte_free(gen);
+	rte_free(incr);
+}
+
+void
+acl_incr_dump(const struct acl_incr *incr)
+{
+	if (incr == NULL)
+		return;
+	printf("  incr_main_rules=%"PRIu32"\n",
+		incr->ctx->num_rules - incr->num_delta);
+	printf("  incr_delta_rules=%"PRIu32"\n", incr->num_delta);
+	printf("  incr_max_delta_rules=%"PRIu32"\n", incr->max_delta);
+}
+
+static struct acl_incr *
+acl_incr_get(const struct rte_acl_ctx *ctx)
+{
+	if (ctx == NULL)
+		return NULL;
+	return rte_atomic_load_explicit(&ctx->incr, rte_memory_order_relaxed);
+}
+
+int
+rte_acl_incr_enable(struct rte_acl_ctx *ctx,
+	const struct rte_acl_incr_config *cfg)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	struct acl_incr_trie *main;
+	struct acl_incr_retired r;
+	struct acl_incr *incr;
+	int32_t rc;
+
+	if (ctx == NULL || cfg == NULL ||
+			(cfg->v != NULL && cfg->mode != RTE_ACL_QSBR_MODE_DQ &&
+			cfg->mode != RTE_ACL_QSBR_MODE_SYNC))
+		return -EINVAL;
+
+	if (acl_incr_get(ctx) != NULL)
+		return -EEXIST;
+
+	/* the build config of the tries is the one of the context */
+	if (ctx->trans_table == NULL)
+		return -EINVAL;
+
+	incr = rte_zmalloc_socket(ctx->name, sizeof(*incr), RTE_CACHE_LINE_SIZE,
+		ctx->socket_id);
+	if (incr == NULL)
+		return -ENOMEM;
+
+	incr->ctx = ctx;
+	incr->v = cfg->v;
+	incr->mode = cfg->mode;
+	incr->max_delta = (cfg->max_delta_rules != 0) ?
+		cfg->max_delta_rules : RTE_ACL_INCR_DELTA_RULES_DEF;
+
+	if (cfg->v != NULL && cfg->mode == RTE_ACL_QSBR_MODE_DQ) {
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name), "ACL_RCU_%s",
+			ctx->name);
+		params.name = rcu_dq_name;
+		params.size = (cfg->dq_size != 0) ?
+			cfg->dq_size : ACL_INCR_DQ_SIZE_DEF;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = (cfg->reclaim_max != 0) ?
+			cfg->reclaim_max : ACL_INCR_DQ_RECLAIM_MAX;
+		params.esize = sizeof(struct acl_incr_retired);
+		params.free_fn = acl_incr_rcu_qsbr_free_resource;
+		params.p = incr;
+		params.v = cfg->v;
+		incr->dq = rte_rcu_qsbr_dq_create(&params);
+		if (incr->dq == NULL) {
+			ACL_LOG(ERR, "ACL context: %s, defer queue creation failed",
+				ctx->name);
+			rte_free(incr);
+			return -rte_errno;
+		}
+	}
+
+	rc = acl_incr_trie_build(ctx, 0, ctx->num_rules, NULL, 0, &main);
+	if (rc == 0) {
+		rc = acl_incr_publish(incr, main, NULL);
+		if (rc != 0)
+			acl_incr_trie_free(main);
+	}
+	if (rc != 0) {
+		if (incr->dq != NULL)
+			rte_rcu_qsbr_dq_delete(incr->dq);
+		rte_free(incr);
+		return rc;
+	}
+
+	rte_atomic_store_explicit(&ctx->incr, incr, rte_memory_order_release);
+
+	/* readers may still classify with the run-time of the context */
+	memset(&r, 0, sizeof(r));
+	r.mem = ctx->mem;
+	ctx->mem = NULL;
+	acl_incr_retire(incr, &r);
+
+	return 0;
+}
+
+int
+rte_acl_incr_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	struct acl_incr *incr;
+	uint32_t total;
+	int32_t rc;
+
+	incr = acl_incr_get(ctx);
+	if (incr == NULL || rules == NULL)
+		return -EINVAL;
+
+	if (num == 0)
+		return 0;
+
+	if (num > ctx->max_rules - ctx->num_rules)
+		return -ENOMEM;
+
+	rc = acl_check_rules(ctx, rules, num);
+	if (rc != 0)
+		return rc;
+
+	/* the master copy is only extended once the build succeeded */
+	memcpy(acl_incr_rule(ctx, ctx->num_rules), rules,
+		(size_t)num * ctx->rule_sz);
+	total = ctx->num_rules + num;
+
+	if (incr->num_delta + num > incr->max_delta)
+		rc = acl_incr_merge(incr, total, NULL, 0);
+	else
+		rc = acl_incr_delta_update(incr, total, incr->num_delta + num,
+			NULL, 0);
+	if (rc != 0)
+		return rc;
+
+	ctx->num_rules = total;
+	return 0;
+}
+
+int
+rte_acl_incr_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num)
+{
+	uint32_t i, n, num_main, main_del, delta_del;
+	const struct rte_acl_rule *rv;
+	struct acl_incr *incr;
+	uint32_t *del;
+	int32_t rc;
+
+	incr = acl_incr_get(ctx);
+	if (incr == NULL || userdata == NULL || num == 0)
+		return -EINVAL;
+
+	del = rte_malloc(NULL, num * sizeof(del[0]), 0);
+	if (del == NULL)
+		return -ENOMEM;
+	memcpy(del, userdata, num * sizeof(del[0]));
+	qsort(del, num, sizeof(del[0]), acl_incr_userdata_cmp);
+
+	num_main = ctx->num_rules - incr->num_delta;
+	main_del = 0;
+	delta_del = 0;
+	for (i = 0; i != ctx->num_rules; i++) {
+		rv = acl_incr_rule(ctx, i);
+		if (acl_incr_deleted(del, num, rv->data.userdata)) {
+			if (i < num_main)
+				main_del++;
+			else
+				delta_del++;
+		}
+	}
+
+	if (main_del != 0)
+		rc = acl_incr_merge(incr, ctx->num_rules, del, num);
+	else if (delta_del != 0)
+		rc = acl_incr_delta_update(incr, ctx->num_rules,
+			incr->num_delta, del, num);
+	else
+		rc = -ENOENT;
+
+	if (rc == 0) {
+		/* remove the deleted rules from the master copy */
+		for (i = 0, n = 0; i != ctx->num_rules; i++) {
+			rv = acl_incr_rule(ctx, i);
+			if (acl_incr_deleted(del, num, rv->data.userdata))
+				continue;
+			if (n != i)
+				memcpy(acl_incr_rule(ctx, n), rv, ctx->rule_sz);
+			n++;
+		}
+		ctx->num_rules = n;
+		if (main_del == 0)
+			incr->num_delta -= delta_del;
+	}
+
+	rte_free(del);
+	return rc;
+}
+
+int
+rte_acl_incr_merge(struct rte_acl_ctx *ctx)
+{
+	struct acl_incr *incr;
+
+	incr = acl_incr_get(ctx);
+	if (incr == NULL)
+		return -EINVAL;
+
+	if (incr->num_delta == 0)
+		return 0;
+
+	return acl_incr_merge(incr, ctx->num_rules, NULL, 0);
+}
@@ -290,10 +290,17 @@ rte_acl_classify_alg(const struct rte_acl_ctx *ctx, const uint8_t **data,
 	uint32_t *results, uint32_t num, uint32_t categories,
 	enum rte_acl_classify_alg alg)
 {
+	const struct acl_incr *incr;
+
 	if (categories != 1 &&
 			((RTE_ACL_RESULTS_MULTIPLIER - 1) & categories) != 0)
 		return -EINVAL;
 
+	incr = rte_atomic_load_explicit(&ctx->incr, rte_memory_order_acquire);
+	if (incr != NULL)
+		return acl_incr_classify(incr, classify_fns[alg], data, results,
+			num, categories);
+
 	return classify_fns[alg](ctx, data, results, num, categories);
 }
 
@@ -356,6 +363,8 @@ rte_acl_free(struct rte_acl_ctx *ctx)
 
 	rte_mcfg_tailq_write_unlock();
 
+	acl_incr_free(rte_atomic_load_explicit(&ctx->incr,
+		rte_memory_order_relaxed));
 	rte_free(ctx->mem);
 	rte_free(ctx);
 	rte_free(te);
@@ -458,16 +467,13 @@ acl_check_rule(const struct rte_acl_rule_data *rd)
 }
 
 int
-rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
-	uint32_t num)
+acl_check_rules(const struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num)
 {
 	const struct rte_acl_rule *rv;
 	uint32_t i;
 	int32_t rc;
 
-	if (ctx == NULL || rules == NULL || 0 == ctx->rule_sz)
-		return -EINVAL;
-
 	for (i = 0; i != num; i++) {
 		rv = (const struct rte_acl_rule *)
 			((uintptr_t)rules + i * ctx->rule_sz);
@@ -479,6 +485,27 @@ rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
 		}
 	}
 
+	return 0;
+}
+
+int
+rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
+	uint32_t num)
+{
+	int32_t rc;
+
+	if (ctx == NULL || rules == NULL || 0 == ctx->rule_sz)
+		return -EINVAL;
+
+	/* rules of an incremental context go through rte_acl_incr_*() */
+	if (rte_atomic_load_explicit(&ctx->incr,
+			rte_memory_order_relaxed) != NULL)
+		return -EBUSY;
+
+	rc = acl_check_rules(ctx, rules, num);
+	if (rc != 0)
+		return rc;
+
 	return acl_add_rules(ctx, rules, num);
 }
 
@@ -489,7 +516,8 @@ rte_acl_add_rules(struct rte_acl_ctx *ctx, const struct rte_acl_rule *rules,
 void
 rte_acl_reset_rules(struct rte_acl_ctx *ctx)
 {
-	if (ctx != NULL)
+	if (ctx != NULL && rte_atomic_load_explicit(&ctx->incr,
+			rte_memory_order_relaxed) == NULL)
 		ctx->num_rules = 0;
 }
 
@@ -522,6 +550,8 @@ rte_acl_dump(const struct rte_acl_ctx *ctx)
 	printf("  num_rules=%"PRIu32"\n", ctx->num_rules);
 	printf("  num_categories=%"PRIu32"\n", ctx->num_categories);
 	printf("  num_tries=%"PRIu32"\n", ctx->num_tries);
+	acl_incr_dump(rte_atomic_load_explicit(&ctx->incr,
+		rte_memory_order_relaxed));
 }
 
 /*
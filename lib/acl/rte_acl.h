@@ -13,6 +13,7 @@
 
 #include <rte_common.h>
 #include <rte_acl_osdep.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -191,6 +192,7 @@ rte_acl_find_existing(const char *name);
  * @return
  *   - -ENOMEM if there is no space in the ACL context for these rules.
  *   - -EINVAL if the parameters are invalid.
+ *   - -EBUSY if the context is in incremental mode.
  *   - Zero if operation completed successfully.
  */
 int
@@ -219,6 +221,7 @@ rte_acl_reset_rules(struct rte_acl_ctx *ctx);
  * @return
  *   - -ENOMEM if couldn't allocate enough memory.
  *   - -EINVAL if the parameters are invalid.
+ *   - -EBUSY if the context is in incremental mode.
  *   - Negative error code if operation failed.
  *   - Zero if operation completed successfully.
  */
@@ -359,6 +362,151 @@ rte_acl_dump(const struct rte_acl_ctx *ctx);
 void
 rte_acl_list_dump(void);
 
+/** Default maximum number of rules in the delta trie. */
+#define RTE_ACL_INCR_DELTA_RULES_DEF	256
+
+/** RCU reclamation modes of an ACL context in incremental mode. */
+enum rte_acl_qsbr_mode {
+	/** Create defer queue for reclaim. */
+	RTE_ACL_QSBR_MODE_DQ = 0,
+	/** Use blocking mode reclaim. No defer queue created. */
+	RTE_ACL_QSBR_MODE_SYNC
+};
+
+/** ACL incremental update configuration. */
+struct rte_acl_incr_config {
+	/**
+	 * RCU QSBR variable the classifying threads report their quiescent
+	 * states to. If NULL, the replaced run-time structures are freed
+	 * immediately, so the updates must not run concurrently with
+	 * classification.
+	 */
+	struct rte_rcu_qsbr *v;
+	/** Mode of RCU QSBR. '0' for default: create defer queue. */
+	enum rte_acl_qsbr_mode mode;
+	uint32_t dq_size;	/**< RCU defer queue size, 0 for default. */
+	uint32_t reclaim_thd;	/**< Threshold to trigger auto reclaim. */
+	uint32_t reclaim_max;	/**< Max entries to reclaim in one go. */
+	/**
+	 * Maximum number of rules in the delta trie, above which the
+	 * delta is merged into the main trie.
+	 * 0 for default: RTE_ACL_INCR_DELTA_RULES_DEF.
+	 */
+	uint32_t max_delta_rules;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Switch a built ACL context to incremental update mode.
+ *
+ * In that mode the rules of the context are kept in two tries:
+ * the main trie and a small delta trie, which receives the rules added
+ * with rte_acl_incr_add_rules(). rte_acl_classify() searches both and
+ * returns, for each category, the match with the highest priority
+ * (the delta rule wins on equal priorities).
+ * Every update builds new run-time structures aside and publishes them
+ * atomically, so the classifying threads are never blocked. The replaced
+ * structures are reclaimed once all the readers registered in the
+ * RCU QSBR variable went through a quiescent state.
+ *
+ * Once enabled, rte_acl_add_rules() and rte_acl_build() fail with -EBUSY,
+ * and rte_acl_reset_rules() and rte_acl_reset() do nothing for the context.
+ * The update functions are not multi-thread safe with respect to each other.
+ *
+ * @param ctx
+ *   ACL context, built with rte_acl_build().
+ * @param cfg
+ *   Incremental update configuration.
+ * @return
+ *   - -EINVAL if the parameters are invalid or the context is not built.
+ *   - -EEXIST if the context is already in incremental mode.
+ *   - -ENOMEM if memory allocation failed.
+ *   - Negative error code if the build of the main trie failed.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_enable(struct rte_acl_ctx *ctx,
+	const struct rte_acl_incr_config *cfg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add rules to an ACL context in incremental mode.
+ * Only the delta trie is rebuilt, unless it would exceed its maximum
+ * number of rules, in which case all the rules are merged into a new
+ * main trie.
+ *
+ * @param ctx
+ *   ACL context in incremental mode.
+ * @param rules
+ *   Array of rules to add, in the same format as for rte_acl_add_rules().
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -ENOMEM if there is no space in the ACL context for these rules,
+ *     or if memory allocation failed.
+ *   - -EINVAL if the parameters are invalid.
+ *   - Negative error code if the build failed, the context is unchanged.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_add_rules(struct rte_acl_ctx *ctx,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete rules from an ACL context in incremental mode.
+ * All the rules with one of the given userdata values are deleted.
+ * Deleting rules of the delta trie only rebuilds the delta trie,
+ * deleting rules of the main trie merges all the rules into a new
+ * main trie.
+ *
+ * @param ctx
+ *   ACL context in incremental mode.
+ * @param userdata
+ *   Array of userdata values of the rules to delete.
+ * @param num
+ *   Number of elements in the userdata array.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOENT if no rule matches the given userdata values.
+ *   - -ENOMEM if memory allocation failed.
+ *   - Negative error code if the build failed, the context is unchanged.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_del_rules(struct rte_acl_ctx *ctx, const uint32_t *userdata,
+	uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Merge the delta trie of an ACL context in incremental mode into
+ * a new main trie. It is meant to be called from a control thread
+ * when the update rate is low, to keep the classify cost of the delta
+ * trie away from the data path.
+ *
+ * @param ctx
+ *   ACL context in incremental mode.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOMEM if memory allocation failed.
+ *   - Negative error code if the build failed, the context is unchanged.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_merge(struct rte_acl_ctx *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,23 +7,29 @@
 
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_lcore.h>
 #include <rte_random.h>
 #include <rte_service_component.h>
+#include <rte_spinlock.h>
 
 #include "eventdev_pmd.h"
 
 #include <rte_dispatcher.h>
 
 #define EVD_MAX_PORTS_PER_LCORE 4
-#define EVD_MAX_HANDLERS 32
+#define EVD_MAX_HANDLERS RTE_DISPATCHER_MAX_HANDLERS
 #define EVD_MAX_FINALIZERS 16
 #define EVD_AVG_PRIO_INTERVAL 2000
 #define EVD_SERVICE_NAME "dispatcher"
+/* Minimum difference of lcore load, in percent, to move a port */
+#define EVD_REBALANCE_MIN_LOAD_DIFF 25
 
 struct rte_dispatcher_lcore_port {
 	uint8_t port_id;
 	uint16_t batch_size;
+	uint16_t min_batch_size;
+	uint16_t cur_batch_size;
 	uint64_t timeout;
 };
 
@@ -42,12 +48,16 @@ struct rte_dispatcher_finalizer {
 };
 
 struct __rte_cache_aligned rte_dispatcher_lcore {
+	rte_spinlock_t lock; /* Protects the ports against runtime (un)bind */
 	uint8_t num_ports;
 	uint16_t num_handlers;
 	int32_t prio_count;
 	struct rte_dispatcher_lcore_port ports[EVD_MAX_PORTS_PER_LCORE];
 	struct rte_dispatcher_handler handlers[EVD_MAX_HANDLERS];
 	struct rte_dispatcher_stats stats;
+	/* Stats at the last rebalance, only used by the control thread */
+	uint64_t last_poll_count;
+	uint64_t last_full_batch_count;
 	RTE_CACHE_GUARD;
 };
 
@@ -124,6 +134,9 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	uint16_t drop_count = 0;
 	uint16_t dispatch_count;
 	uint16_t dispatched = 0;
+	uint64_t start, now, end;
+
+	start = rte_rdtsc();
 
 	for (i = 0; i < num_events; i++) {
 		struct rte_event *event = &events[i];
@@ -142,6 +155,8 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 
 	dispatch_count = num_events - drop_count;
 
+	now = rte_rdtsc();
+
 	for (i = 0; i < lcore->num_handlers &&
 		 dispatched < dispatch_count; i++) {
 		struct rte_dispatcher_handler *handler =
@@ -154,6 +169,11 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 		handler->process_fun(dispatcher->event_dev_id, port->port_id,
 				     bursts[i], len, handler->process_data);
 
+		end = rte_rdtsc();
+		lcore->stats.handlers[handler->id].ev_count += len;
+		lcore->stats.handlers[handler->id].cycles += end - now;
+		now = end;
+
 		dispatched += len;
 
 		/*
@@ -175,6 +195,24 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 					port->port_id,
 					finalizer->finalize_data);
 	}
+
+	lcore->stats.busy_cycles += rte_rdtsc() - start;
+}
+
+/*
+ * Adapt the batch size to the depth of the event port queue: a full batch
+ * shows a backlog, so the batch size is doubled, while a batch less than
+ * half full halves it, to keep the atomic flows held by the port short.
+ */
+static __rte_always_inline void
+evd_port_adapt_batch_size(struct rte_dispatcher_lcore_port *port, uint16_t n)
+{
+	if (n == port->cur_batch_size)
+		port->cur_batch_size = RTE_MIN(port->cur_batch_size * 2,
+					       port->batch_size);
+	else if (n < port->cur_batch_size / 2)
+		port->cur_batch_size = RTE_MAX(port->cur_batch_size / 2,
+					       port->min_batch_size);
 }
 
 static __rte_always_inline uint16_t
@@ -182,7 +220,7 @@ evd_port_dequeue(struct rte_dispatcher *dispatcher,
 	struct rte_dispatcher_lcore *lcore,
 	struct rte_dispatcher_lcore_port *port)
 {
-	uint16_t batch_size = port->batch_size;
+	uint16_t batch_size = port->cur_batch_size;
 	struct rte_event events[batch_size];
 	uint16_t n;
 
@@ -192,8 +230,13 @@ evd_port_dequeue(struct rte_dispatcher *dispatcher,
 	if (likely(n > 0))
 		evd_dispatch_events(dispatcher, lcore, port, events, n);
 
+	if (n == batch_size)
+		lcore->stats.ev_full_batch_count++;
 	lcore->stats.poll_count++;
 
+	if (port->min_batch_size != port->batch_size)
+		evd_port_adapt_batch_size(port, n);
+
 	return n;
 }
 
@@ -223,8 +266,14 @@ evd_process(void *userdata)
 		&dispatcher->lcores[lcore_id];
 	uint64_t event_count;
 
+	/* The ports of this lcore are being changed by a control thread */
+	if (unlikely(!rte_spinlock_trylock(&lcore->lock)))
+		return -EAGAIN;
+
 	event_count = evd_lcore_process(dispatcher, lcore);
 
+	rte_spinlock_unlock(&lcore->lock);
+
 	if (unlikely(event_count == 0))
 		return -EAGAIN;
 
@@ -271,6 +320,7 @@ rte_dispatcher_create(uint8_t event_dev_id)
 {
 	int socket_id;
 	struct rte_dispatcher *dispatcher;
+	unsigned int lcore_id;
 	int rc;
 
 	socket_id = rte_event_dev_socket_id(event_dev_id);
@@ -290,6 +340,9 @@ rte_dispatcher_create(uint8_t event_dev_id)
 		.socket_id = socket_id
 	};
 
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		rte_spinlock_init(&dispatcher->lcores[lcore_id].lock);
+
 	rc = evd_service_register(dispatcher);
 	if (rc < 0) {
 		rte_free(dispatcher);
@@ -340,46 +393,31 @@ lcore_port_index(struct rte_dispatcher_lcore *lcore,
 	return -1;
 }
 
-int
-rte_dispatcher_bind_port_to_lcore(struct rte_dispatcher *dispatcher,
-	uint8_t event_port_id, uint16_t batch_size, uint64_t timeout,
-	unsigned int lcore_id)
+static int
+evd_lcore_add_port(struct rte_dispatcher_lcore *lcore,
+	const struct rte_dispatcher_lcore_port *port)
 {
-	struct rte_dispatcher_lcore *lcore;
-	struct rte_dispatcher_lcore_port *port;
-
-	lcore =	&dispatcher->lcores[lcore_id];
-
 	if (lcore->num_ports == EVD_MAX_PORTS_PER_LCORE)
 		return -ENOMEM;
 
-	if (lcore_port_index(lcore, event_port_id) >= 0)
+	if (lcore_port_index(lcore, port->port_id) >= 0)
 		return -EEXIST;
 
-	port = &lcore->ports[lcore->num_ports];
-
-	*port = (struct rte_dispatcher_lcore_port) {
-		.port_id = event_port_id,
-		.batch_size = batch_size,
-		.timeout = timeout
-	};
+	lcore->ports[lcore->num_ports] = *port;
 
 	lcore->num_ports++;
 
 	return 0;
 }
 
-int
-rte_dispatcher_unbind_port_from_lcore(struct rte_dispatcher *dispatcher,
-	uint8_t event_port_id, unsigned int lcore_id)
+static int
+evd_lcore_remove_port(struct rte_dispatcher_lcore *lcore,
+	uint8_t event_port_id, struct rte_dispatcher_lcore_port *removed)
 {
-	struct rte_dispatcher_lcore *lcore;
 	int port_idx;
 	struct rte_dispatcher_lcore_port *port;
 	struct rte_dispatcher_lcore_port *last;
 
-	lcore =	&dispatcher->lcores[lcore_id];
-
 	port_idx = lcore_port_index(lcore, event_port_id);
 
 	if (port_idx < 0)
@@ -388,6 +426,9 @@ rte_dispatcher_unbind_port_from_lcore(struct rte_dispatcher *dispatcher,
 	port = &lcore->ports[port_idx];
 	last = &lcore->ports[lcore->num_ports - 1];
 
+	if (removed != NULL)
+		*removed = *port;
+
 	if (port != last)
 		*port = *last;
 
@@ -396,6 +437,259 @@ rte_dispatcher_unbind_port_from_lcore(struct rte_dispatcher *dispatcher,
 	return 0;
 }
 
+int
+rte_dispatcher_bind_port_to_lcore(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, uint16_t batch_size, uint64_t timeout,
+	unsigned int lcore_id)
+{
+	struct rte_dispatcher_lcore *lcore;
+	struct rte_dispatcher_lcore_port port = {
+		.port_id = event_port_id,
+		.batch_size = batch_size,
+		.min_batch_size = batch_size,
+		.cur_batch_size = batch_size,
+		.timeout = timeout
+	};
+	int rc;
+
+	lcore =	&dispatcher->lcores[lcore_id];
+
+	rte_spinlock_lock(&lcore->lock);
+	rc = evd_lcore_add_port(lcore, &port);
+	rte_spinlock_unlock(&lcore->lock);
+
+	return rc;
+}
+
+int
+rte_dispatcher_unbind_port_from_lcore(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, unsigned int lcore_id)
+{
+	struct rte_dispatcher_lcore *lcore;
+	int rc;
+
+	lcore =	&dispatcher->lcores[lcore_id];
+
+	rte_spinlock_lock(&lcore->lock);
+	rc = evd_lcore_remove_port(lcore, event_port_id, NULL);
+	rte_spinlock_unlock(&lcore->lock);
+
+	return rc;
+}
+
+static int
+evd_move_port(struct rte_dispatcher *dispatcher, uint8_t event_port_id,
+	unsigned int from_lcore_id, unsigned int to_lcore_id)
+{
+	struct rte_dispatcher_lcore *from = &dispatcher->lcores[from_lcore_id];
+	struct rte_dispatcher_lcore *to = &dispatcher->lcores[to_lcore_id];
+	struct rte_dispatcher_lcore *first, *second;
+	struct rte_dispatcher_lcore_port port;
+	int rc;
+
+	if (from_lcore_id == to_lcore_id)
+		return lcore_port_index(from, event_port_id) < 0 ? -ENOENT : 0;
+
+	/* Lock in lcore id order, to not deadlock with another move */
+	first = from_lcore_id < to_lcore_id ? from : to;
+	second = from_lcore_id < to_lcore_id ? to : from;
+
+	rte_spinlock_lock(&first->lock);
+	rte_spinlock_lock(&second->lock);
+
+	if (to->num_ports == EVD_MAX_PORTS_PER_LCORE)
+		rc = -ENOMEM;
+	else if (lcore_port_index(to, event_port_id) >= 0)
+		rc = -EEXIST;
+	else
+		rc = evd_lcore_remove_port(from, event_port_id, &port);
+
+	if (rc == 0) {
+		port.cur_batch_size = port.batch_size;
+		evd_lcore_add_port(to, &port);
+	}
+
+	rte_spinlock_unlock(&second->lock);
+	rte_spinlock_unlock(&first->lock);
+
+	return rc;
+}
+
+int
+rte_dispatcher_move_port(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, unsigned int from_lcore_id,
+	unsigned int to_lcore_id)
+{
+	if (from_lcore_id >= RTE_MAX_LCORE || to_lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	return evd_move_port(dispatcher, event_port_id, from_lcore_id,
+			     to_lcore_id);
+}
+
+int
+rte_dispatcher_port_batch_size_adapt(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, uint16_t min_batch_size, unsigned int lcore_id)
+{
+	struct rte_dispatcher_lcore *lcore;
+	struct rte_dispatcher_lcore_port *port;
+	int port_idx;
+	int rc = 0;
+
+	if (lcore_id >= RTE_MAX_LCORE || min_batch_size == 0)
+		return -EINVAL;
+
+	lcore =	&dispatcher->lcores[lcore_id];
+
+	rte_spinlock_lock(&lcore->lock);
+
+	port_idx = lcore_port_index(lcore, event_port_id);
+
+	if (port_idx < 0) {
+		rc = -ENOENT;
+	} else {
+		port = &lcore->ports[port_idx];
+
+		if (min_batch_size > port->batch_size) {
+			rc = -EINVAL;
+		} else {
+			port->min_batch_size = min_batch_size;
+			port->cur_batch_size = port->batch_size;
+		}
+	}
+
+	rte_spinlock_unlock(&lcore->lock);
+
+	return rc;
+}
+
+/*
+ * Load of a lcore since the last rebalance, in percent of the polls
+ * which dequeued a full batch, i.e. found a backlog in the event port.
+ */
+static unsigned int
+evd_lcore_load(struct rte_dispatcher_lcore *lcore)
+{
+	uint64_t polls = lcore->stats.poll_count;
+	uint64_t full = lcore->stats.ev_full_batch_count;
+
+	/* The stats may have been reset since the last rebalance */
+	if (polls >= lcore->last_poll_count &&
+	    full >= lcore->last_full_batch_count) {
+		polls -= lcore->last_poll_count;
+		full -= lcore->last_full_batch_count;
+	}
+
+	if (polls == 0)
+		return 0;
+
+	return full * 100 / polls;
+}
+
+int
+rte_dispatcher_rebalance(struct rte_dispatcher *dispatcher)
+{
+	unsigned int load[RTE_MAX_LCORE];
+	bool mapped[RTE_MAX_LCORE];
+	unsigned int lcore_id, min_id, max_id;
+	unsigned int num_mapped = 0;
+	int num_moved = 0;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct rte_dispatcher_lcore *lcore =
+			&dispatcher->lcores[lcore_id];
+
+		mapped[lcore_id] = rte_service_map_lcore_get(
+			dispatcher->service_id, lcore_id) == 1;
+		num_mapped += mapped[lcore_id];
+
+		load[lcore_id] = evd_lcore_load(lcore);
+		lcore->last_poll_count = lcore->stats.poll_count;
+		lcore->last_full_batch_count = lcore->stats.ev_full_batch_count;
+	}
+
+	if (num_mapped == 0)
+		return -ENOENT;
+
+	/*
+	 * The ports of a lcore the service is no longer mapped to are
+	 * moved to the least loaded lcores, to scale down.
+	 */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct rte_dispatcher_lcore *lcore =
+			&dispatcher->lcores[lcore_id];
+
+		if (mapped[lcore_id])
+			continue;
+
+		while (lcore->num_ports > 0) {
+			unsigned int to_id = RTE_MAX_LCORE;
+			unsigned int i;
+
+			for (i = 0; i < RTE_MAX_LCORE; i++)
+				if (mapped[i] && dispatcher->lcores[i].num_ports <
+				    EVD_MAX_PORTS_PER_LCORE &&
+				    (to_id == RTE_MAX_LCORE || load[i] < load[to_id] ||
+				     (load[i] == load[to_id] &&
+				      dispatcher->lcores[i].num_ports <
+				      dispatcher->lcores[to_id].num_ports)))
+					to_id = i;
+
+			if (to_id == RTE_MAX_LCORE)
+				return num_moved > 0 ? num_moved : -ENOMEM;
+
+			if (evd_move_port(dispatcher, lcore->ports[0].port_id,
+					  lcore_id, to_id) != 0)
+				break;
+
+			num_moved++;
+		}
+	}
+
+	/*
+	 * Move one port from the most to the least loaded lcore,
+	 * to scale up to a newly mapped lcore or to even out the load.
+	 */
+	min_id = RTE_MAX_LCORE;
+	max_id = RTE_MAX_LCORE;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		struct rte_dispatcher_lcore *lcore =
+			&dispatcher->lcores[lcore_id];
+
+		if (!mapped[lcore_id])
+			continue;
+
+		if (lcore->num_ports < EVD_MAX_PORTS_PER_LCORE &&
+		    (min_id == RTE_MAX_LCORE || load[lcore_id] < load[min_id] ||
+		     (load[lcore_id] == load[min_id] &&
+		      lcore->num_ports < dispatcher->lcores[min_id].num_ports)))
+			min_id = lcore_id;
+
+		if (lcore->num_ports > 1 &&
+		    (max_id == RTE_MAX_LCORE || load[lcore_id] > load[max_id]))
+			max_id = lcore_id;
+	}
+
+	if (min_id == RTE_MAX_LCORE || max_id == RTE_MAX_LCORE ||
+	    min_id == max_id)
+		return num_moved;
+
+	/* An lcore without port gets one from the lcore with the most ports */
+	if (dispatcher->lcores[min_id].num_ports == 0 ||
+	    load[max_id] >= load[min_id] + EVD_REBALANCE_MIN_LOAD_DIFF) {
+		struct rte_dispatcher_lcore *max_lcore =
+			&dispatcher->lcores[max_id];
+
+		if (evd_move_port(dispatcher,
+				  max_lcore->ports[max_lcore->num_ports - 1].port_id,
+				  max_id, min_id) == 0)
+			num_moved++;
+	}
+
+	return num_moved;
+}
+
 static struct rte_dispatcher_handler *
 evd_lcore_get_handler_by_id(struct rte_dispatcher_lcore *lcore, int handler_id)
 {
@@ -659,10 +953,19 @@ static void
 evd_aggregate_stats(struct rte_dispatcher_stats *result,
 	const struct rte_dispatcher_stats *part)
 {
+	int i;
+
 	result->poll_count += part->poll_count;
 	result->ev_batch_count += part->ev_batch_count;
 	result->ev_dispatch_count += part->ev_dispatch_count;
 	result->ev_drop_count += part->ev_drop_count;
+	result->ev_full_batch_count += part->ev_full_batch_count;
+	result->busy_cycles += part->busy_cycles;
+
+	for (i = 0; i < RTE_DISPATCHER_MAX_HANDLERS; i++) {
+		result->handlers[i].ev_count += part->handlers[i].ev_count;
+		result->handlers[i].cycles += part->handlers[i].cycles;
+	}
 }
 
 void
@@ -681,6 +984,18 @@ rte_dispatcher_stats_get(const struct rte_dispatcher *dispatcher,
 	}
 }
 
+int
+rte_dispatcher_lcore_stats_get(const struct rte_dispatcher *dispatcher,
+	unsigned int lcore_id, struct rte_dispatcher_stats *stats)
+{
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	*stats = dispatcher->lcores[lcore_id].stats;
+
+	return 0;
+}
+
 void
 rte_dispatcher_stats_reset(struct rte_dispatcher *dispatcher)
 {
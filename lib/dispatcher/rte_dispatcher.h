@@ -102,6 +102,19 @@ typedef void (*rte_dispatcher_process_t)(uint8_t event_dev_id,
 typedef void (*rte_dispatcher_finalize_t)(uint8_t event_dev_id,
 	uint8_t event_port_id, void *cb_data);
 
+/** Maximum number of handlers registered to a dispatcher. */
+#define RTE_DISPATCHER_MAX_HANDLERS 32
+
+/**
+ * Dispatcher handler statistics
+ */
+struct rte_dispatcher_handler_stats {
+	/** Number of events delivered to the handler. */
+	uint64_t ev_count;
+	/** TSC cycles spent in the handler process callback. */
+	uint64_t cycles;
+};
+
 /**
  * Dispatcher statistics
  */
@@ -114,6 +127,15 @@ struct rte_dispatcher_stats {
 	uint64_t ev_dispatch_count;
 	/** Number of events dropped because no handler was found. */
 	uint64_t ev_drop_count;
+	/**
+	 * Number of dequeue calls which returned a full batch, which
+	 * indicates a backlog in the event port.
+	 */
+	uint64_t ev_full_batch_count;
+	/** TSC cycles spent dispatching the non-empty event batches. */
+	uint64_t busy_cycles;
+	/** Per handler statistics, indexed by handler identifier. */
+	struct rte_dispatcher_handler_stats handlers[RTE_DISPATCHER_MAX_HANDLERS];
 };
 
 /**
@@ -173,7 +195,7 @@ rte_dispatcher_service_id_get(const struct rte_dispatcher *dispatcher);
  * no-operation.
  *
  * This function may be called by any thread (including unregistered
- * non-EAL threads), but not while the dispatcher is running on lcore
+ * non-EAL threads), including while the dispatcher is running on lcore
  * specified by @c lcore_id.
  *
  * @param dispatcher
@@ -209,8 +231,9 @@ rte_dispatcher_bind_port_to_lcore(struct rte_dispatcher *dispatcher,
  * Unbind an event device port from a specific lcore.
  *
  * This function may be called by any thread (including unregistered
- * non-EAL threads), but not while the dispatcher is running on
- * lcore specified by @c lcore_id.
+ * non-EAL threads), including while the dispatcher is running on
+ * lcore specified by @c lcore_id. Upon return, the port is no longer
+ * used by that lcore.
  *
  * @param dispatcher
  *  The dispatcher instance.
@@ -230,6 +253,107 @@ int
 rte_dispatcher_unbind_port_from_lcore(struct rte_dispatcher *dispatcher,
 	uint8_t event_port_id, unsigned int lcore_id);
 
+/**
+ * Move an event device port from one lcore to another.
+ *
+ * The port keeps the batch size and timeout it was bound with.
+ *
+ * This function may be called by any thread (including unregistered
+ * non-EAL threads), including while the dispatcher is running on
+ * the lcores.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @param event_port_id
+ *  The event device port identifier.
+ *
+ * @param from_lcore_id
+ *  The lcore which is using this event port.
+ *
+ * @param to_lcore_id
+ *  The lcore which will use this event port.
+ *
+ * @return
+ *  - 0: Success
+ *  - -ENOENT: Event port id not bound to @c from_lcore_id.
+ *  - -ENOMEM: No more port can be bound to @c to_lcore_id.
+ *  - -EEXIST: Event port id already bound to @c to_lcore_id.
+ *  - -EINVAL: Invalid arguments.
+ */
+__rte_experimental
+int
+rte_dispatcher_move_port(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, unsigned int from_lcore_id,
+	unsigned int to_lcore_id);
+
+/**
+ * Enable the adaptive batch size of an event device port.
+ *
+ * The batch size used in rte_event_dequeue_burst() is doubled, up to
+ * the batch size given to rte_dispatcher_bind_port_to_lcore(), when a
+ * full batch is dequeued, and halved, down to @c min_batch_size, when
+ * a batch is less than half full. Small batches shorten the time the
+ * port holds atomic flows when the load is low, while full batches
+ * amortize the dequeue cost when there is a backlog.
+ *
+ * This function may be called by any thread (including unregistered
+ * non-EAL threads), including while the dispatcher is running on
+ * lcore specified by @c lcore_id.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @param event_port_id
+ *  The event device port identifier.
+ *
+ * @param min_batch_size
+ *  The minimum batch size. A value equal to the bound batch size
+ *  disables the adaptive batch size.
+ *
+ * @param lcore_id
+ *  The lcore which is using this event port.
+ *
+ * @return
+ *  - 0: Success
+ *  - -ENOENT: Event port id not bound to this @c lcore_id.
+ *  - -EINVAL: Invalid arguments.
+ */
+__rte_experimental
+int
+rte_dispatcher_port_batch_size_adapt(struct rte_dispatcher *dispatcher,
+	uint8_t event_port_id, uint16_t min_batch_size, unsigned int lcore_id);
+
+/**
+ * Rebalance the event device ports among the dispatcher lcores.
+ *
+ * The load of a lcore is the ratio of dequeue calls which returned a
+ * full batch since the previous rebalance, which reflects the depth of
+ * the event port queues.
+ *
+ * The ports bound to lcores to which the dispatcher service is no
+ * longer mapped are moved to the least loaded mapped lcores. Then one
+ * port is moved from the most loaded lcore with several ports to the
+ * least loaded one, if the load difference is significant or if the
+ * least loaded lcore has no port.
+ *
+ * Scaling up is done by mapping the service to a new lcore, and
+ * scaling down by unmapping it from a lcore, before calling this
+ * function, which may be called periodically by a control thread,
+ * while the dispatcher is running.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @return
+ *  - >= 0: The number of ports moved.
+ *  - -ENOENT: The dispatcher service is not mapped to any lcore.
+ *  - -ENOMEM: The mapped lcores cannot take the ports of unmapped lcores.
+ */
+__rte_experimental
+int
+rte_dispatcher_rebalance(struct rte_dispatcher *dispatcher);
+
 /**
  * Register an event handler.
  *
@@ -435,6 +559,28 @@ void
 rte_dispatcher_stats_get(const struct rte_dispatcher *dispatcher,
 	struct rte_dispatcher_stats *stats);
 
+/**
+ * Retrieve the statistics of a dispatcher instance for one lcore.
+ *
+ * This function is MT safe and may be called by any thread
+ * (including unregistered non-EAL threads).
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ * @param lcore_id
+ *  The lcore identifier.
+ * @param[out] stats
+ *   A pointer to a structure to fill with statistics.
+ *
+ * @return
+ *  - 0: Success
+ *  - -EINVAL: Invalid @c lcore_id.
+ */
+__rte_experimental
+int
+rte_dispatcher_lcore_stats_get(const struct rte_dispatcher *dispatcher,
+	unsigned int lcore_id, struct rte_dispatcher_stats *stats);
+
 /**
  * Reset statistics for a dispatcher instance.
  *
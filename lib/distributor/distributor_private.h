@@ -103,9 +103,24 @@ struct rte_distributor_single {
 enum rte_distributor_match_function {
 	RTE_DIST_MATCH_SCALAR = 0,
 	RTE_DIST_MATCH_VECTOR,
+	RTE_DIST_MATCH_AVX512,
 	RTE_DIST_NUM_MATCH_FNS
 };
 
+/*
+ * Persistent flow table, indexed by the 16-bit flow tag, which keeps
+ * the worker of a flow while the flow has no packet in flight.
+ */
+#define RTE_DIST_FLOW_TABLE_SIZE (UINT16_MAX + 1)
+/* The flow table time unit is 2^RTE_DIST_FLOW_TIME_SHIFT TSC cycles */
+#define RTE_DIST_FLOW_TIME_SHIFT 10
+
+struct rte_distributor_flow {
+	uint32_t last_seen; /**< Time of the last packet of the flow */
+	uint8_t worker;     /**< Worker id + 1, 0 if none */
+	uint8_t gen;        /**< Worker generation when the flow was pinned */
+};
+
 /**
  * Buffer structure used to pass the pointer data between cores. This is cache
  * line aligned, but to improve performance and prevent adjacent cache-line
@@ -156,6 +171,13 @@ struct rte_distributor {
 
 	uint8_t active[RTE_DISTRIB_MAX_WORKERS];
 	uint8_t activesum;
+
+	struct rte_distributor_flow *flows;
+		/**< Persistent flow table, NULL if flow affinity is disabled */
+	uint32_t flow_aging; /**< Flow idle time before unpinning */
+	uint32_t flow_now;   /**< Time of the current process call */
+	uint8_t worker_gen[RTE_DISTRIB_MAX_WORKERS];
+		/**< Incremented when a worker leaves, to unpin its flows */
 };
 
 void
@@ -168,4 +190,9 @@ find_match_vec(struct rte_distributor *d,
 			uint16_t *data_ptr,
 			uint16_t *output_ptr);
 
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr);
+
 #endif /* _DIST_PRIV_H_ */
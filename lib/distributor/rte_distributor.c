@@ -8,7 +8,9 @@
 #include <sys/queue.h>
 #include <string.h>
 #include <rte_mbuf.h>
+#include <rte_cpuflags.h>
 #include <rte_cycles.h>
+#include <rte_malloc.h>
 #include <rte_memzone.h>
 #include <rte_errno.h>
 #include <rte_string_fns.h>
@@ -368,6 +370,9 @@ handle_returns(struct rte_distributor *d, unsigned int wkr)
 		 * otherwise (RETURN_BUF), set it to not active.
 		 */
 		d->activesum -= d->active[wkr];
+		/* A leaving worker unpins its flows from the flow table */
+		if (d->active[wkr] && !(buf->retptr64[0] & RTE_DISTRIB_GET_BUF))
+			d->worker_gen[wkr]++;
 		d->active[wkr] = !!(buf->retptr64[0] & RTE_DISTRIB_GET_BUF);
 		d->activesum += d->active[wkr];
 
@@ -437,6 +442,35 @@ release(struct rte_distributor *d, unsigned int wkr)
 
 }
 
+/*
+ * Return the worker a flow is pinned to in the flow table,
+ * or -1 if the entry is empty, aged out or the worker left.
+ */
+static inline int
+flow_worker_lookup(const struct rte_distributor *d, uint16_t tag)
+{
+	const struct rte_distributor_flow *f = &d->flows[tag];
+	unsigned int w;
+
+	if (f->worker == 0)
+		return -1;
+	w = f->worker - 1;
+	if (f->gen != d->worker_gen[w] || !d->active[w] ||
+			d->flow_now - f->last_seen > d->flow_aging)
+		return -1;
+
+	return w;
+}
+
+static inline void
+flow_pin(struct rte_distributor *d, uint16_t tag, unsigned int wkr)
+{
+	struct rte_distributor_flow *f = &d->flows[tag];
+
+	f->last_seen = d->flow_now;
+	f->worker = wkr + 1;
+	f->gen = d->worker_gen[wkr];
+}
 
 /* process a set of packets to distribute them to workers */
 int
@@ -449,7 +483,8 @@ rte_distributor_process(struct rte_distributor *d,
 	int64_t next_value = 0;
 	uint16_t new_tag = 0;
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t flows[RTE_DIST_BURST_SIZE];
-	unsigned int i, j, w, wid, matching_required;
+	unsigned int i, j, w, wid, tw, matching_required;
+	int fw;
 
 	if (d->alg_type == RTE_DIST_ALG_SINGLE) {
 		/* Call the old API */
@@ -477,6 +512,9 @@ rte_distributor_process(struct rte_distributor *d,
 	if (unlikely(!d->activesum))
 		return 0;
 
+	if (d->flows != NULL)
+		d->flow_now = (uint32_t)(rte_rdtsc() >> RTE_DIST_FLOW_TIME_SHIFT);
+
 	while (next_idx < num_mbufs) {
 		alignas(128) uint16_t matches[RTE_DIST_BURST_SIZE];
 		unsigned int pkts;
@@ -508,6 +546,12 @@ rte_distributor_process(struct rte_distributor *d,
 					find_match_vec(d, &flows[0],
 						&matches[0]);
 					break;
+#ifdef CC_DISTRIBUTOR_AVX512_SUPPORT
+				case RTE_DIST_MATCH_AVX512:
+					find_match_avx512(d, &flows[0],
+						&matches[0]);
+					break;
+#endif
 				default:
 					find_match_scalar(d, &flows[0],
 						&matches[0]);
@@ -559,17 +603,29 @@ rte_distributor_process(struct rte_distributor *d,
 				bl->tags[idx] = new_tag;
 				bl->pkts[idx] = next_value;
 
+				if (d->flows != NULL)
+					flow_pin(d, new_tag, matches[j]-1);
+
 			} else {
 				struct rte_distributor_backlog *bl;
 
-				while (unlikely(!d->active[wkr]))
-					wkr = (wkr + 1) % d->num_workers;
-				bl = &d->backlog[wkr];
+				/* Prefer the worker of the flow table */
+				fw = -1;
+				if (d->flows != NULL)
+					fw = flow_worker_lookup(d, new_tag);
+				if (fw >= 0)
+					tw = fw;
+				else {
+					while (unlikely(!d->active[wkr]))
+						wkr = (wkr + 1) % d->num_workers;
+					tw = wkr;
+				}
+				bl = &d->backlog[tw];
 
 				if (unlikely(bl->count ==
 						RTE_DIST_BURST_SIZE)) {
-					release(d, wkr);
-					if (!d->active[wkr]) {
+					release(d, tw);
+					if (!d->active[tw]) {
 						j--;
 						next_idx--;
 						matching_required = 1;
@@ -582,6 +638,8 @@ rte_distributor_process(struct rte_distributor *d,
 
 				bl->tags[idx] = new_tag;
 				bl->pkts[idx] = next_value;
+				if (d->flows != NULL)
+					flow_pin(d, new_tag, tw);
 				/*
 				 * Now that we've just added an unpinned flow
 				 * to a worker, we need to ensure that all
@@ -590,7 +648,7 @@ rte_distributor_process(struct rte_distributor *d,
 				 */
 				for (w = j; w < pkts; w++)
 					if (flows[w] == new_tag)
-						matches[w] = wkr+1;
+						matches[w] = tw+1;
 			}
 		}
 		wkr = (wkr + 1) % d->num_workers;
@@ -766,6 +824,12 @@ rte_distributor_create(const char *name,
 	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128)
 		d->dist_match_fn = RTE_DIST_MATCH_VECTOR;
 #endif
+#ifdef CC_DISTRIBUTOR_AVX512_SUPPORT
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) > 0 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW) > 0)
+		d->dist_match_fn = RTE_DIST_MATCH_AVX512;
+#endif
 
 	/*
 	 * Set up the backlog tags so they're pointing at the second cache
@@ -777,6 +841,9 @@ rte_distributor_create(const char *name,
 	memset(d->active, 0, sizeof(d->active));
 	d->activesum = 0;
 
+	d->flows = NULL;
+	memset(d->worker_gen, 0, sizeof(d->worker_gen));
+
 	dist_burst_list = RTE_TAILQ_CAST(rte_dist_burst_tailq.head,
 					  rte_dist_burst_list);
 
@@ -787,3 +854,53 @@ rte_distributor_create(const char *name,
 
 	return d;
 }
+
+int
+rte_distributor_flow_affinity_enable(struct rte_distributor *d,
+		uint32_t aging_us)
+{
+	uint64_t aging;
+
+	if (d->alg_type != RTE_DIST_ALG_BURST)
+		return -ENOTSUP;
+
+	aging = ((uint64_t)aging_us * rte_get_tsc_hz() / US_PER_S) >>
+			RTE_DIST_FLOW_TIME_SHIFT;
+	d->flow_aging = (uint32_t)RTE_MIN(aging, (uint64_t)UINT32_MAX);
+
+	if (d->flows != NULL)
+		return 0;
+
+	d->flows = rte_zmalloc_socket(d->name,
+			RTE_DIST_FLOW_TABLE_SIZE * sizeof(d->flows[0]),
+			RTE_CACHE_LINE_SIZE, rte_socket_id());
+	if (d->flows == NULL)
+		return -ENOMEM;
+
+	return 0;
+}
+
+int
+rte_distributor_flow_affinity_disable(struct rte_distributor *d)
+{
+	if (d->alg_type != RTE_DIST_ALG_BURST)
+		return -ENOTSUP;
+
+	rte_free(d->flows);
+	d->flows = NULL;
+
+	return 0;
+}
+
+int
+rte_distributor_flow_worker_get(struct rte_distributor *d, uint32_t tag)
+{
+	int w;
+
+	if (d->alg_type != RTE_DIST_ALG_BURST || d->flows == NULL)
+		return -ENOTSUP;
+
+	w = flow_worker_lookup(d, (uint16_t)tag | 1);
+
+	return w < 0 ? -ENOENT : w;
+}
@@ -13,6 +13,10 @@
  * one-at-a-time to workers, with dynamic load balancing.
  */
 
+#include <stdint.h>
+
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -132,6 +136,80 @@ rte_distributor_flush(struct rte_distributor *d);
 void
 rte_distributor_clear_returns(struct rte_distributor *d);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable the flow affinity of a burst distributor.
+ *
+ * A flow which has no packet in flight or in backlog is normally assigned
+ * to the next worker in a round-robin manner. With flow affinity, the
+ * distributor keeps the worker of each flow in a table, and sends the next
+ * packets of the flow to the same worker, as long as the flow is not idle
+ * for more than *aging_us* microseconds and the worker is still active.
+ *
+ * When a worker leaves with rte_distributor_return_pkt(), its flows are
+ * unpinned and migrate to the other workers, after its in-flight and
+ * backlog packets, so the packet order of a flow is kept.
+ *
+ * The flow table is indexed by the 16 low bits of the mbuf tag.
+ *
+ * This should only be called on the same lcore as rte_distributor_process()
+ *
+ * @param d
+ *   The distributor instance to be used
+ * @param aging_us
+ *   The idle time in microseconds after which a flow is unpinned.
+ *   If the flow affinity is already enabled, only the aging is updated.
+ * @return
+ *   - 0 on success
+ *   - -ENOTSUP if the distributor does not use RTE_DIST_ALG_BURST
+ *   - -ENOMEM if the flow table cannot be allocated
+ */
+__rte_experimental
+int
+rte_distributor_flow_affinity_enable(struct rte_distributor *d,
+		uint32_t aging_us);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Disable the flow affinity of a burst distributor and free the flow table.
+ *
+ * This should only be called on the same lcore as rte_distributor_process()
+ *
+ * @param d
+ *   The distributor instance to be used
+ * @return
+ *   - 0 on success
+ *   - -ENOTSUP if the distributor does not use RTE_DIST_ALG_BURST
+ */
+__rte_experimental
+int
+rte_distributor_flow_affinity_disable(struct rte_distributor *d);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the worker a flow is pinned to in the flow affinity table.
+ *
+ * This should only be called on the same lcore as rte_distributor_process()
+ *
+ * @param d
+ *   The distributor instance to be used
+ * @param tag
+ *   The flow tag, as set in the hash.usr field of the mbufs
+ * @return
+ *   - The worker id on success
+ *   - -ENOENT if the flow is not pinned
+ *   - -ENOTSUP if the flow affinity is not enabled
+ */
+__rte_experimental
+int
+rte_distributor_flow_worker_get(struct rte_distributor *d, uint32_t tag);
+
 /*  *** APIS to be called on the worker lcores ***  */
 /*
  * The following APIs are the public APIs which are designed for use on
@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <rte_mbuf.h>
+#include <rte_vect.h>
+#include "distributor_private.h"
+
+void
+find_match_avx512(struct rte_distributor *d,
+			uint16_t *data_ptr,
+			uint16_t *output_ptr)
+{
+	__m512i incoming_fids[RTE_DIST_BURST_SIZE];
+	__m512i worker_fids;
+	__mmask32 mask;
+	uint16_t i, j;
+
+	/*
+	 * Function overview:
+	 * 1. Broadcast each incoming flow id into a zmm reg
+	 * 2. Loop through the worker ID's, two at a time
+	 *  2a. Load the inflights and backlog of two workers into a zmm reg,
+	 *      as the backlog tags are the second half of in_flight_tags
+	 *  2b. Compare each incoming flow id to the 32 tags
+	 *  2c. Add any matches to the output
+	 */
+
+	for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+		incoming_fids[j] = _mm512_set1_epi16(data_ptr[j]);
+		output_ptr[j] = 0;
+	}
+
+	for (i = 0; i < d->num_workers; i += 2) {
+		worker_fids = _mm512_loadu_si512(&d->in_flight_tags[i]);
+
+		for (j = 0; j < RTE_DIST_BURST_SIZE; j++) {
+			mask = _mm512_cmpeq_epi16_mask(worker_fids,
+					incoming_fids[j]);
+			/* Low half is worker i, high half is worker i + 1 */
+			if (mask & UINT16_MAX)
+				output_ptr[j] = i + 1;
+			if ((mask >> 16) && i + 1U < d->num_workers)
+				output_ptr[j] = i + 2;
+		}
+	}
+
+	/*
+	 * At this stage, the output contains 8 16-bit values, with
+	 * each non-zero value containing the worker ID on which the
+	 * corresponding flow is pinned to.
+	 */
+}
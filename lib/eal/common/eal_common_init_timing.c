@@ -0,0 +1,86 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_telemetry.h>
+
+#include "eal_private.h"
+
+#define NS_PER_SEC 1000000000
+
+static const char * const init_phase_names[EAL_INIT_PHASE_MAX] = {
+	[EAL_INIT_PHASE_TOTAL] = "total",
+	[EAL_INIT_PHASE_CONFIG] = "config",
+	[EAL_INIT_PHASE_HUGEPAGE_INFO] = "hugepage_info",
+	[EAL_INIT_PHASE_MEMORY] = "memory",
+	[EAL_INIT_PHASE_HUGEPAGE_ALLOC] = "hugepage_alloc",
+	[EAL_INIT_PHASE_HUGEPAGE_POPULATE] = "hugepage_populate",
+	[EAL_INIT_PHASE_MALLOC_HEAP] = "malloc_heap",
+	[EAL_INIT_PHASE_DEVICE_PROBE] = "device_probe",
+};
+
+/* start time and accumulated duration of each phase, in nanoseconds */
+static uint64_t init_phase_start[EAL_INIT_PHASE_MAX];
+static uint64_t init_phase_ns[EAL_INIT_PHASE_MAX];
+
+static uint64_t
+init_timing_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * NS_PER_SEC + ts.tv_nsec;
+}
+
+void
+eal_init_timing_start(enum eal_init_phase phase)
+{
+	init_phase_start[phase] = init_timing_now();
+}
+
+void
+eal_init_timing_stop(enum eal_init_phase phase)
+{
+	init_phase_ns[phase] += init_timing_now() - init_phase_start[phase];
+}
+
+void
+eal_init_timing_dump(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < EAL_INIT_PHASE_MAX; i++)
+		EAL_LOG(DEBUG, "Init phase %s: %"PRIu64" us",
+			init_phase_names[i], init_phase_ns[i] / 1000);
+}
+
+#ifndef RTE_EXEC_ENV_WINDOWS
+#define EAL_INIT_TIMINGS_REQ "/eal/init_timings"
+
+static int
+handle_eal_init_timings_request(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	unsigned int i;
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < EAL_INIT_PHASE_MAX; i++)
+		rte_tel_data_add_dict_uint(d, init_phase_names[i],
+			init_phase_ns[i]);
+
+	return 0;
+}
+
+RTE_INIT(init_timing_telemetry)
+{
+	rte_telemetry_register_cmd(EAL_INIT_TIMINGS_REQ,
+			handle_eal_init_timings_request,
+			"Returns the duration in ns of the EAL init phases. Takes no parameters");
+}
+#endif
@@ -1094,11 +1094,13 @@ rte_eal_memory_init(void)
 	if (eal_memalloc_init() < 0)
 		goto fail;
 
+	eal_init_timing_start(EAL_INIT_PHASE_HUGEPAGE_ALLOC);
 	retval = rte_eal_process_type() == RTE_PROC_PRIMARY ?
 			rte_eal_hugepage_init() :
 			rte_eal_hugepage_attach();
 	if (retval < 0)
 		goto fail;
+	eal_init_timing_stop(EAL_INIT_PHASE_HUGEPAGE_ALLOC);
 
 	if (internal_conf->no_shconf == 0 && rte_eal_memdevice_init() < 0)
 		goto fail;
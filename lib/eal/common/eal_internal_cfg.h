@@ -102,6 +102,8 @@ struct internal_config {
 	struct simd_bitwidth max_simd_bitwidth;
 	/**< max simd bitwidth path to use */
 	size_t huge_worker_stack_size; /**< worker thread stack size */
+	/** threads per NUMA node populating the hugepages at init, 0 for none */
+	unsigned int huge_init_threads;
 };
 
 void eal_reset_internal_config(struct internal_config *internal_cfg);
@@ -431,6 +431,44 @@ int rte_eal_hugepage_attach(void);
  */
 int rte_eal_memory_detach(void);
 
+/**
+ * Phases of the EAL initialization, timed for telemetry.
+ * Some phases are part of others.
+ */
+enum eal_init_phase {
+	EAL_INIT_PHASE_TOTAL, /**< whole initialization */
+	EAL_INIT_PHASE_CONFIG, /**< arguments, lcores, buses scan */
+	EAL_INIT_PHASE_HUGEPAGE_INFO, /**< hugepage sizes and directories */
+	EAL_INIT_PHASE_MEMORY, /**< memory map, includes the next two */
+	EAL_INIT_PHASE_HUGEPAGE_ALLOC, /**< hugepages preallocation */
+	EAL_INIT_PHASE_HUGEPAGE_POPULATE, /**< parallel page population */
+	EAL_INIT_PHASE_MALLOC_HEAP, /**< malloc heaps */
+	EAL_INIT_PHASE_DEVICE_PROBE, /**< buses probe */
+	EAL_INIT_PHASE_MAX
+};
+
+/**
+ * Start timing a phase of the initialization.
+ *
+ * This function is private to the EAL.
+ */
+void eal_init_timing_start(enum eal_init_phase phase);
+
+/**
+ * Stop timing a phase of the initialization.
+ * The durations of a phase timed several times are added.
+ *
+ * This function is private to the EAL.
+ */
+void eal_init_timing_stop(enum eal_init_phase phase);
+
+/**
+ * Log the durations of the phases of the initialization.
+ *
+ * This function is private to the EAL.
+ */
+void eal_init_timing_dump(void);
+
 /**
  * Find a bus capable of identifying a device.
  *
@@ -458,6 +458,9 @@ eal_usage(const char *prgname)
 	       "                      Allocate worker thread stacks from hugepage memory.\n"
 	       "                      Size is in units of kbytes and defaults to system\n"
 	       "                      thread stack size if not specified.\n"
+	       "  --"OPT_HUGE_INIT_THREADS"=<n>\n"
+	       "                      Populate the hugepages preallocated at init\n"
+	       "                      with n threads per NUMA node.\n"
 	       "\n");
 	/* Allow the application to print its usage message too if hook is set */
 	if (hook) {
@@ -584,6 +587,23 @@ eal_parse_huge_worker_stack(const char *arg)
 	return 0;
 }
 
+static int
+eal_parse_huge_init_threads(const char *arg)
+{
+	struct internal_config *cfg = eal_get_internal_configuration();
+	unsigned long threads;
+	char *end;
+
+	errno = 0;
+	threads = strtoul(arg, &end, 10);
+	if (errno || end == NULL || *end != '\0' || threads == 0 ||
+			threads > RTE_MAX_LCORE)
+		return -1;
+
+	cfg->huge_init_threads = threads;
+	return 0;
+}
+
 /* Parse the argument given in the command line of the application */
 static int
 eal_parse_args(int argc, char **argv)
@@ -731,6 +751,16 @@ eal_parse_args(int argc, char **argv)
 			}
 			break;
 
+		case OPT_HUGE_INIT_THREADS_NUM:
+			if (eal_parse_huge_init_threads(optarg) < 0) {
+				EAL_LOG(ERR, "invalid parameter for --"
+					OPT_HUGE_INIT_THREADS);
+				eal_usage(prgname);
+				ret = -1;
+				goto out;
+			}
+			break;
+
 		default:
 			if (opt < OPT_LONG_MIN_NUM && isprint(opt)) {
 				EAL_LOG(ERR, "Option %c is not supported "
@@ -927,6 +957,9 @@ rte_eal_init(int argc, char **argv)
 	struct internal_config *internal_conf =
 		eal_get_internal_configuration();
 
+	eal_init_timing_start(EAL_INIT_PHASE_TOTAL);
+	eal_init_timing_start(EAL_INIT_PHASE_CONFIG);
+
 	/* setup log as early as possible */
 	if (eal_parse_log_options(argc, argv) < 0) {
 		rte_eal_init_alert("invalid log arguments.");
@@ -1081,7 +1114,10 @@ rte_eal_init(int argc, char **argv)
 	EAL_LOG(INFO, "Selected IOVA mode '%s'",
 		rte_eal_iova_mode() == RTE_IOVA_PA ? "PA" : "VA");
 
+	eal_init_timing_stop(EAL_INIT_PHASE_CONFIG);
+
 	if (internal_conf->no_hugetlbfs == 0) {
+		eal_init_timing_start(EAL_INIT_PHASE_HUGEPAGE_INFO);
 		/* rte_config isn't initialized yet */
 		ret = internal_conf->process_type == RTE_PROC_PRIMARY ?
 				eal_hugepage_info_init() :
@@ -1092,6 +1128,7 @@ rte_eal_init(int argc, char **argv)
 			rte_atomic_store_explicit(&run_once, 0, rte_memory_order_relaxed);
 			return -1;
 		}
+		eal_init_timing_stop(EAL_INIT_PHASE_HUGEPAGE_INFO);
 	}
 
 	if (internal_conf->memory == 0 && internal_conf->force_sockets == 0) {
@@ -1130,16 +1167,19 @@ rte_eal_init(int argc, char **argv)
 
 	rte_mcfg_mem_read_lock();
 
+	eal_init_timing_start(EAL_INIT_PHASE_MEMORY);
 	if (rte_eal_memory_init() < 0) {
 		rte_mcfg_mem_read_unlock();
 		rte_eal_init_alert("Cannot init memory");
 		rte_errno = ENOMEM;
 		return -1;
 	}
+	eal_init_timing_stop(EAL_INIT_PHASE_MEMORY);
 
 	/* the directories are locked during eal_hugepage_info_init */
 	eal_hugedirs_unlock();
 
+	eal_init_timing_start(EAL_INIT_PHASE_MALLOC_HEAP);
 	if (rte_eal_malloc_heap_init() < 0) {
 		rte_mcfg_mem_read_unlock();
 		rte_eal_init_alert("Cannot init malloc heap");
@@ -1154,6 +1194,7 @@ rte_eal_init(int argc, char **argv)
 		rte_errno = ENODEV;
 		return -1;
 	}
+	eal_init_timing_stop(EAL_INIT_PHASE_MALLOC_HEAP);
 
 	/* register multi-process action callbacks for hotplug after memory init */
 	if (eal_mp_dev_hotplug_init() < 0) {
@@ -1236,11 +1277,13 @@ rte_eal_init(int argc, char **argv)
 	}
 
 	/* Probe all the buses and devices/drivers on them */
+	eal_init_timing_start(EAL_INIT_PHASE_DEVICE_PROBE);
 	if (rte_bus_probe()) {
 		rte_eal_init_alert("Cannot probe devices");
 		rte_errno = ENOTSUP;
 		return -1;
 	}
+	eal_init_timing_stop(EAL_INIT_PHASE_DEVICE_PROBE);
 
 	/* initialize default service/lcore mappings and start running. Ignore
 	 * -ENOTSUP, as it indicates no service coremask passed to EAL.
@@ -1274,6 +1317,9 @@ rte_eal_init(int argc, char **argv)
 
 	eal_mcfg_complete();
 
+	eal_init_timing_stop(EAL_INIT_PHASE_TOTAL);
+	eal_init_timing_dump();
+
 	return fctret;
 }
 
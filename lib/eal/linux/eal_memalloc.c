@@ -31,12 +31,16 @@
 #include <rte_log.h>
 #include <rte_eal.h>
 #include <rte_memory.h>
+#include <rte_per_lcore.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
 
 #include "eal_filesystem.h"
 #include "eal_internal_cfg.h"
 #include "eal_memalloc.h"
 #include "eal_memcfg.h"
 #include "eal_private.h"
+#include "eal_thread.h"
 
 const int anonymous_hugepages_supported =
 #ifdef MAP_HUGE_SHIFT
@@ -97,11 +101,12 @@ static struct {
 /** local copy of a memory map, used to synchronize memory hotplug in MP */
 static struct rte_memseg_list local_memsegs[RTE_MAX_MEMSEG_LISTS];
 
-static sigjmp_buf huge_jmpenv;
+/* per thread, as pages may be populated by several threads at init */
+static RTE_DEFINE_PER_LCORE(sigjmp_buf, huge_jmpenv);
 
 static void huge_sigbus_handler(int signo __rte_unused)
 {
-	siglongjmp(huge_jmpenv, 1);
+	siglongjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 /* Put setjmp into a wrap method to avoid compiling error. Any non-volatile,
@@ -110,11 +115,13 @@ static void huge_sigbus_handler(int signo __rte_unused)
  */
 static int huge_wrap_sigsetjmp(void)
 {
-	return sigsetjmp(huge_jmpenv, 1);
+	return sigsetjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 static struct sigaction huge_action_old;
 static int huge_need_recover;
+/* the handler is registered once for all the threads populating pages */
+static bool huge_sigbus_shared;
 
 static void
 huge_register_sigbus(void)
@@ -122,6 +129,9 @@ huge_register_sigbus(void)
 	sigset_t mask;
 	struct sigaction action;
 
+	if (huge_sigbus_shared)
+		return;
+
 	sigemptyset(&mask);
 	sigaddset(&mask, SIGBUS);
 	action.sa_flags = 0;
@@ -134,6 +144,9 @@ huge_register_sigbus(void)
 static void
 huge_recover_sigbus(void)
 {
+	if (huge_sigbus_shared)
+		return;
+
 	if (huge_need_recover) {
 		sigaction(SIGBUS, &huge_action_old, NULL);
 		huge_need_recover = 0;
@@ -809,7 +822,193 @@ struct alloc_walk_param {
 	unsigned int n_segs;
 	int socket;
 	bool exact;
+	bool parallel;
 };
+
+/* pages of a memseg list allocated in parallel */
+struct alloc_par_param {
+	struct alloc_walk_param *wa;
+	struct rte_memseg_list *msl;
+	unsigned int msl_idx;
+	int start_idx;
+	unsigned int need;
+	RTE_ATOMIC(unsigned int) next;
+	RTE_ATOMIC(bool) failed;
+	int *ret; /* result of each page, -1 if not attempted */
+};
+
+static uint32_t
+alloc_seg_par_thread(void *arg)
+{
+	struct alloc_par_param *pp = arg;
+	struct alloc_walk_param *wa = pp->wa;
+	size_t page_sz = (size_t)pp->msl->page_sz;
+	struct rte_memseg *cur;
+	unsigned int i;
+	int idx;
+#ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
+	bool have_numa = false;
+	int oldpolicy;
+	struct bitmask *oldmask;
+
+	/* the memory policy is per thread */
+	if (check_numa()) {
+		oldmask = numa_allocate_nodemask();
+		prepare_numa(&oldpolicy, oldmask, wa->socket);
+		have_numa = true;
+	}
+#endif
+
+	while (!rte_atomic_load_explicit(&pp->failed,
+			rte_memory_order_relaxed)) {
+		i = rte_atomic_fetch_add_explicit(&pp->next, 1,
+				rte_memory_order_relaxed);
+		if (i >= pp->need)
+			break;
+
+		idx = pp->start_idx + i;
+		cur = rte_fbarray_get(&pp->msl->memseg_arr, idx);
+		pp->ret[i] = alloc_seg(cur,
+				RTE_PTR_ADD(pp->msl->base_va, idx * page_sz),
+				wa->socket, wa->hi, pp->msl_idx, idx);
+		if (pp->ret[i] != 0) {
+			rte_atomic_store_explicit(&pp->failed, true,
+					rte_memory_order_relaxed);
+			break;
+		}
+
+		/* new pages are cleared by the kernel, reused ones are dirty */
+		if ((cur->flags & RTE_MEMSEG_FLAG_DIRTY) != 0) {
+			memset(cur->addr, 0, cur->len);
+			cur->flags &= ~RTE_MEMSEG_FLAG_DIRTY;
+		}
+	}
+
+#ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
+	if (have_numa)
+		restore_numa(&oldpolicy, oldmask);
+#endif
+	return 0;
+}
+
+/*
+ * Allocate pages of a memseg list with threads running on the NUMA node
+ * of the list, so that the page faults and the zeroing of the dirty pages
+ * are done in parallel, on the node owning the memory. The list bookkeeping
+ * is done afterwards by the calling thread.
+ *
+ * Return the number of pages allocated, or -1 if an exact number was
+ * requested and could not be allocated.
+ */
+static int
+alloc_seg_parallel(struct alloc_walk_param *wa, struct rte_memseg_list *msl,
+		unsigned int msl_idx, int start_idx, unsigned int need)
+{
+	struct alloc_par_param pp;
+	struct rte_memseg *cur;
+	rte_thread_attr_t attr;
+	rte_thread_t *threads;
+	rte_cpuset_t cpuset;
+	unsigned int n_threads, n_started, n_ok, i, cpu;
+	const struct internal_config *internal_conf =
+		eal_get_internal_configuration();
+
+	memset(&pp, 0, sizeof(pp));
+	pp.wa = wa;
+	pp.msl = msl;
+	pp.msl_idx = msl_idx;
+	pp.start_idx = start_idx;
+	pp.need = need;
+
+	n_threads = RTE_MIN(internal_conf->huge_init_threads, need);
+	threads = malloc(sizeof(*threads) * n_threads);
+	pp.ret = malloc(sizeof(*pp.ret) * need);
+	if (threads == NULL || pp.ret == NULL) {
+		EAL_LOG(ERR, "%s(): cannot allocate thread parameters",
+			__func__);
+		free(threads);
+		free(pp.ret);
+		if (wa->exact && wa->ms)
+			memset(wa->ms, 0, sizeof(*wa->ms) * wa->n_segs);
+		return wa->exact ? -1 : 0;
+	}
+	for (i = 0; i < need; i++)
+		pp.ret[i] = -1;
+
+	/* run on the CPUs of the node, if it has any */
+	CPU_ZERO(&cpuset);
+	for (cpu = 0; cpu < RTE_MAX_LCORE; cpu++) {
+		if (eal_cpu_detected(cpu) &&
+				eal_cpu_socket_id(cpu) == (unsigned int)wa->socket)
+			CPU_SET(cpu, &cpuset);
+	}
+	rte_thread_attr_init(&attr);
+	if (CPU_COUNT(&cpuset) != 0)
+		rte_thread_attr_set_affinity(&attr, &cpuset);
+
+	EAL_LOG(DEBUG, "Allocating %u pages of size %zuM on socket %i with %u threads",
+		need, (size_t)msl->page_sz >> 20, wa->socket, n_threads);
+
+	eal_init_timing_start(EAL_INIT_PHASE_HUGEPAGE_POPULATE);
+
+	/* SIGBUS is delivered to the faulting thread, with its own jump buffer */
+	huge_register_sigbus();
+	huge_sigbus_shared = true;
+
+	for (n_started = 0; n_started < n_threads; n_started++) {
+		if (rte_thread_create(&threads[n_started], &attr,
+				alloc_seg_par_thread, &pp) != 0)
+			break;
+	}
+	/* make sure all the pages are processed */
+	if (n_started == 0)
+		alloc_seg_par_thread(&pp);
+	for (i = 0; i < n_started; i++)
+		rte_thread_join(threads[i], NULL);
+
+	huge_sigbus_shared = false;
+	huge_recover_sigbus();
+
+	eal_init_timing_stop(EAL_INIT_PHASE_HUGEPAGE_POPULATE);
+
+	for (n_ok = 0; n_ok < need && pp.ret[n_ok] == 0; n_ok++)
+		;
+	if (n_ok < need) {
+		EAL_LOG(DEBUG, "attempted to allocate %u segments, but only %u were allocated",
+			need, n_ok);
+
+		/* keep the contiguous pages, if an exact number is not needed */
+		if (wa->exact)
+			n_ok = 0;
+		for (i = n_ok; i < need; i++) {
+			if (pp.ret[i] != 0)
+				continue;
+			cur = rte_fbarray_get(&msl->memseg_arr, start_idx + i);
+			/* free_seg may attempt to create a file, which may fail */
+			if (free_seg(cur, wa->hi, msl_idx, start_idx + i))
+				EAL_LOG(DEBUG, "Cannot free page");
+		}
+	}
+
+	for (i = 0; i < n_ok; i++) {
+		cur = rte_fbarray_get(&msl->memseg_arr, start_idx + i);
+		if (wa->ms)
+			wa->ms[i] = cur;
+		rte_fbarray_set_used(&msl->memseg_arr, start_idx + i);
+	}
+
+	free(threads);
+	free(pp.ret);
+
+	if (wa->exact && n_ok < need) {
+		/* clear the list */
+		if (wa->ms)
+			memset(wa->ms, 0, sizeof(*wa->ms) * wa->n_segs);
+		return -1;
+	}
+	return n_ok;
+}
+
 static int
 alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 {
@@ -817,7 +1016,7 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 	struct alloc_walk_param *wa = arg;
 	struct rte_memseg_list *cur_msl;
 	size_t page_sz;
-	int cur_idx, start_idx, j, dir_fd = -1;
+	int cur_idx, start_idx, j, ret, dir_fd = -1;
 	unsigned int msl_idx, need, i;
 	const struct internal_config *internal_conf =
 		eal_get_internal_configuration();
@@ -886,6 +1085,17 @@ alloc_seg_walk(const struct rte_memseg_list *msl, void *arg)
 		}
 	}
 
+	if (wa->parallel && need > 1) {
+		ret = alloc_seg_parallel(wa, cur_msl, msl_idx, start_idx, need);
+		if (ret < 0) {
+			if (dir_fd >= 0)
+				close(dir_fd);
+			return -1;
+		}
+		i = ret;
+		goto out;
+	}
+
 	for (i = 0; i < need; i++, cur_idx++) {
 		struct rte_memseg *cur;
 		void *map_addr;
@@ -1057,6 +1267,9 @@ eal_memalloc_alloc_seg_bulk(struct rte_memseg **ms, int n_segs, size_t page_sz,
 	wa.page_sz = page_sz;
 	wa.socket = socket;
 	wa.segs_allocated = 0;
+	/* the pages preallocated at init can be populated in parallel */
+	wa.parallel = internal_conf->huge_init_threads != 0 &&
+			!internal_conf->init_complete;
 
 	/* memalloc is locked, so it's safe to use thread-unsafe version */
 	ret = rte_memseg_list_walk_thread_unsafe(alloc_seg_walk, &wa);
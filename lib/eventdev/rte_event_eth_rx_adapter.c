@@ -39,6 +39,11 @@
 
 #define RXA_NB_RX_WORK_DEFAULT 128
 
+/* Smallest Rx burst size used by an adaptive queue */
+#define RXA_ADAPTIVE_MIN_BURST	4
+/* Maximum number of polls skipped after an empty poll of an adaptive queue */
+#define RXA_ADAPTIVE_MAX_BACKOFF	64
+
 #define ETH_RX_ADAPTER_SERVICE_NAME_LEN	32
 #define ETH_RX_ADAPTER_MEM_NAME_LEN	32
 
@@ -86,6 +91,17 @@ struct __rte_cache_aligned eth_rx_vector_data {
 
 TAILQ_HEAD(eth_rx_vector_data_list, eth_rx_vector_data);
 
+/* Adaptive polling state of a Rx queue */
+struct eth_rx_adaptive_data {
+	/* Current Rx burst size */
+	uint16_t burst;
+	/* Polls left to skip before the queue is polled again */
+	uint16_t skip;
+	/* Polls skipped after an empty poll, doubles on each empty poll */
+	uint16_t backoff;
+	struct rte_event_eth_rx_adapter_queue_adaptive_stats stats;
+};
+
 /* Instance per adapter */
 struct eth_event_enqueue_buffer {
 	/* Count of events in this buffer */
@@ -245,10 +261,12 @@ struct eth_rx_queue_info {
 	int queue_enabled;	/* True if added */
 	int intr_enabled;
 	uint8_t ena_vector;
+	uint8_t ena_adaptive;	/* Tune burst size and polling frequency */
 	uint16_t wt;		/* Polling weight */
 	uint32_t flow_id_mask;	/* Set to ~0 if app provides flow id else 0 */
 	uint64_t event;
 	struct eth_rx_vector_data vector_data;
+	struct eth_rx_adaptive_data adaptive_data;
 	struct eth_event_enqueue_buffer *event_buf;
 	/* use adapter stats struct for queue level stats,
 	 * as same stats need to be updated for adapter and queue
@@ -1029,7 +1047,7 @@ rxa_pkt_buf_available(struct eth_event_enqueue_buffer *buf)
 /* Enqueue packets from  <port, q>  to event buffer */
 static inline uint32_t
 rxa_eth_rx(struct event_eth_rx_adapter *rx_adapter, uint16_t port_id,
-	   uint16_t queue_id, uint32_t rx_count, uint32_t max_rx,
+	   uint16_t queue_id, uint16_t burst, uint32_t rx_count, uint32_t max_rx,
 	   int *rxq_empty, struct eth_event_enqueue_buffer *buf,
 	   struct rte_event_eth_rx_adapter_stats *stats)
 {
@@ -1049,7 +1067,7 @@ rxa_eth_rx(struct event_eth_rx_adapter *rx_adapter, uint16_t port_id,
 				rxa_flush_event_buffer(rx_adapter, buf, stats);
 
 		stats->rx_poll_count++;
-		n = rte_eth_rx_burst(port_id, queue_id, mbufs, BATCH_SIZE);
+		n = rte_eth_rx_burst(port_id, queue_id, mbufs, burst);
 		if (unlikely(!n)) {
 			if (rxq_empty)
 				*rxq_empty = 1;
@@ -1267,8 +1285,8 @@ rxa_intr_ring_dequeue(struct event_eth_rx_adapter *rx_adapter)
 
 				if (!rxa_intr_queue(dev_info, i))
 					continue;
-				n = rxa_eth_rx(rx_adapter, port, i, nb_rx,
-					rx_adapter->max_nb_rx,
+				n = rxa_eth_rx(rx_adapter, port, i, BATCH_SIZE,
+					nb_rx, rx_adapter->max_nb_rx,
 					&rxq_empty, buf, stats);
 				nb_rx += n;
 
@@ -1288,8 +1306,8 @@ rxa_intr_ring_dequeue(struct event_eth_rx_adapter *rx_adapter)
 						RTE_MAX_RXTX_INTR_VEC_ID - 1 :
 						0;
 		} else {
-			n = rxa_eth_rx(rx_adapter, port, queue, nb_rx,
-				rx_adapter->max_nb_rx,
+			n = rxa_eth_rx(rx_adapter, port, queue, BATCH_SIZE,
+				nb_rx, rx_adapter->max_nb_rx,
 				&rxq_empty, buf, stats);
 			rx_adapter->qd_valid = !rxq_empty;
 			nb_rx += n;
@@ -1307,6 +1325,67 @@ rxa_intr_ring_dequeue(struct event_eth_rx_adapter *rx_adapter)
 	return work;
 }
 
+/*
+ * Polls an adaptive Rx queue and tunes its burst size and polling frequency.
+ *
+ * An empty queue is skipped for an exponentially growing number of polls, up to
+ * RXA_ADAPTIVE_MAX_BACKOFF, and its burst size shrinks. The burst size doubles
+ * up to BATCH_SIZE while the queue still holds packets after a poll, and halves
+ * when the event device back pressures the adapter so that the back pressure
+ * is relayed to the Rx queue.
+ */
+static inline uint32_t
+rxa_adaptive_eth_rx(struct event_eth_rx_adapter *rx_adapter,
+		    struct eth_rx_adaptive_data *ad, uint16_t port_id,
+		    uint16_t queue_id, uint32_t rx_count, uint32_t max_rx,
+		    struct eth_event_enqueue_buffer *buf,
+		    struct rte_event_eth_rx_adapter_stats *stats)
+{
+	struct rte_event_eth_rx_adapter_queue_adaptive_stats *ad_stats;
+	uint64_t poll_count;
+	uint64_t enq_retry;
+	uint64_t start;
+	uint32_t nb_rx;
+	int rxq_empty;
+
+	ad_stats = &ad->stats;
+	if (ad->skip) {
+		ad->skip--;
+		ad_stats->rx_skip_count++;
+		return 0;
+	}
+
+	poll_count = stats->rx_poll_count;
+	enq_retry = stats->rx_enq_retry;
+	start = rte_rdtsc();
+	nb_rx = rxa_eth_rx(rx_adapter, port_id, queue_id, ad->burst, rx_count,
+			   max_rx, &rxq_empty, buf, stats);
+	ad_stats->rx_cycles += rte_rdtsc() - start;
+	ad_stats->rx_poll_count += stats->rx_poll_count - poll_count;
+	ad_stats->rx_packets += nb_rx;
+
+	if (stats->rx_enq_retry != enq_retry) {
+		ad_stats->rx_backpressure_count++;
+		ad->burst = RTE_MAX(ad->burst >> 1, RXA_ADAPTIVE_MIN_BURST);
+		ad->skip = 1;
+	} else if (nb_rx == 0 && rxq_empty) {
+		ad_stats->rx_empty_poll_count++;
+		ad->backoff = RTE_MIN(ad->backoff ? ad->backoff << 1 : 1,
+				      RXA_ADAPTIVE_MAX_BACKOFF);
+		ad->skip = ad->backoff;
+		ad->burst = RTE_MAX(ad->burst >> 1, RXA_ADAPTIVE_MIN_BURST);
+	} else if (nb_rx) {
+		ad->backoff = 0;
+		if (!rxq_empty)
+			ad->burst = RTE_MIN(ad->burst << 1, BATCH_SIZE);
+		else if (nb_rx < (uint32_t)(ad->burst >> 1))
+			ad->burst = RTE_MAX(ad->burst >> 1,
+					    RXA_ADAPTIVE_MIN_BURST);
+	}
+
+	return nb_rx;
+}
+
 /*
  * Polls receive queues added to the event adapter and enqueues received
  * packets to the event device.
@@ -1339,6 +1418,7 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 		unsigned int poll_idx = rx_adapter->wrr_sched[wrr_pos];
 		uint16_t qid = rx_adapter->eth_rx_poll[poll_idx].eth_rx_qid;
 		uint16_t d = rx_adapter->eth_rx_poll[poll_idx].eth_dev_id;
+		struct eth_rx_queue_info *queue_info;
 
 		buf = rxa_event_buf_get(rx_adapter, d, qid, &stats);
 
@@ -1362,8 +1442,14 @@ rxa_poll(struct event_eth_rx_adapter *rx_adapter)
 			}
 		}
 
-		nb_rx += rxa_eth_rx(rx_adapter, d, qid, nb_rx, max_nb_rx,
-				NULL, buf, stats);
+		queue_info = &rx_adapter->eth_devices[d].rx_queue[qid];
+		if (queue_info->ena_adaptive)
+			nb_rx += rxa_adaptive_eth_rx(rx_adapter,
+					&queue_info->adaptive_data, d, qid,
+					nb_rx, max_nb_rx, buf, stats);
+		else
+			nb_rx += rxa_eth_rx(rx_adapter, d, qid, BATCH_SIZE,
+					nb_rx, max_nb_rx, NULL, buf, stats);
 		if (nb_rx > max_nb_rx) {
 			rx_adapter->wrr_pos =
 				    (wrr_pos + 1) % rx_adapter->wrr_len;
@@ -2103,6 +2189,12 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 	} else
 		qi_ev->flow_id = 0;
 
+	queue_info->ena_adaptive = !!(conf->rx_queue_flags &
+				      RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE);
+	memset(&queue_info->adaptive_data, 0,
+	       sizeof(queue_info->adaptive_data));
+	queue_info->adaptive_data.burst = BATCH_SIZE;
+
 	if (conf->rx_queue_flags &
 	    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) {
 		queue_info->ena_vector = 1;
@@ -3144,6 +3236,13 @@ rte_event_eth_rx_adapter_stop(uint8_t id)
 	return rxa_ctrl(id, 0);
 }
 
+static inline void
+rxa_queue_adaptive_stats_reset(struct eth_rx_queue_info *queue_info)
+{
+	memset(&queue_info->adaptive_data.stats, 0,
+	       sizeof(queue_info->adaptive_data.stats));
+}
+
 static inline void
 rxa_queue_stats_reset(struct eth_rx_queue_info *queue_info)
 {
@@ -3151,6 +3250,7 @@ rxa_queue_stats_reset(struct eth_rx_queue_info *queue_info)
 
 	q_stats = queue_info->stats;
 	memset(q_stats, 0, sizeof(*q_stats));
+	rxa_queue_adaptive_stats_reset(queue_info);
 }
 
 int
@@ -3291,6 +3391,55 @@ rte_event_eth_rx_adapter_queue_stats_get(uint8_t id,
 	return 0;
 }
 
+int
+rte_event_eth_rx_adapter_queue_adaptive_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_queue_adaptive_stats *stats)
+{
+	struct event_eth_rx_adapter *rx_adapter;
+	struct eth_device_info *dev_info;
+	struct eth_rx_queue_info *queue_info;
+
+	if (rxa_memzone_lookup())
+		return -ENOMEM;
+
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(eth_dev_id, -EINVAL);
+
+	rx_adapter = rxa_id_to_adapter(id);
+	if (rx_adapter == NULL || stats == NULL)
+		return -EINVAL;
+
+	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
+		RTE_EDEV_LOG_ERR("Invalid rx queue_id %" PRIu16, rx_queue_id);
+		return -EINVAL;
+	}
+
+	dev_info = &rx_adapter->eth_devices[eth_dev_id];
+	if (dev_info->rx_queue == NULL ||
+	    !dev_info->rx_queue[rx_queue_id].queue_enabled) {
+		RTE_EDEV_LOG_ERR("Rx queue %u not added", rx_queue_id);
+		return -EINVAL;
+	}
+
+	if (dev_info->internal_event_port)
+		return -ENOTSUP;
+
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+	if (!queue_info->ena_adaptive) {
+		RTE_EDEV_LOG_ERR("Rx queue %u not in adaptive mode",
+				 rx_queue_id);
+		return -EINVAL;
+	}
+
+	*stats = queue_info->adaptive_data.stats;
+	stats->rx_burst_size = queue_info->adaptive_data.burst;
+	stats->rx_poll_backoff = queue_info->adaptive_data.backoff;
+
+	return 0;
+}
+
 int
 rte_event_eth_rx_adapter_stats_reset(uint8_t id)
 {
@@ -3316,14 +3465,17 @@ rte_event_eth_rx_adapter_stats_reset(uint8_t id)
 	RTE_ETH_FOREACH_DEV(i) {
 		dev_info = &rx_adapter->eth_devices[i];
 
-		if (rx_adapter->use_queue_event_buf  && dev_info->rx_queue) {
+		if (dev_info->rx_queue) {
 
 			for (j = 0; j < dev_info->dev->data->nb_rx_queues;
 						j++) {
 				queue_info = &dev_info->rx_queue[j];
 				if (!queue_info->queue_enabled)
 					continue;
-				rxa_queue_stats_reset(queue_info);
+				if (rx_adapter->use_queue_event_buf)
+					rxa_queue_stats_reset(queue_info);
+				else
+					rxa_queue_adaptive_stats_reset(queue_info);
 			}
 		}
 
@@ -3361,9 +3513,6 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 	if (rx_adapter == NULL)
 		return -EINVAL;
 
-	if (!rx_adapter->use_queue_event_buf)
-		return -EINVAL;
-
 	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
 		RTE_EDEV_LOG_ERR("Invalid rx queue_id %" PRIu16, rx_queue_id);
 		return -EINVAL;
@@ -3377,11 +3526,20 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 		return -EINVAL;
 	}
 
-	if (dev_info->internal_event_port == 0) {
-		queue_info = &dev_info->rx_queue[rx_queue_id];
-		rxa_queue_stats_reset(queue_info);
+	queue_info = &dev_info->rx_queue[rx_queue_id];
+
+	/* Without queue event buffers, only the adaptive stats are per queue */
+	if (!rx_adapter->use_queue_event_buf) {
+		if (dev_info->internal_event_port != 0 ||
+		    !queue_info->ena_adaptive)
+			return -EINVAL;
+		rxa_queue_adaptive_stats_reset(queue_info);
+		return 0;
 	}
 
+	if (dev_info->internal_event_port == 0)
+		rxa_queue_stats_reset(queue_info);
+
 	dev = &rte_eventdevs[rx_adapter->eventdev_id];
 	if (dev->dev_ops->eth_rx_adapter_queue_stats_reset != NULL) {
 		return dev->dev_ops->eth_rx_adapter_queue_stats_reset(dev,
@@ -3534,6 +3692,9 @@ rte_event_eth_rx_adapter_queue_conf_get(uint8_t id,
 	if (queue_info->flow_id_mask != 0)
 		queue_conf->rx_queue_flags |=
 			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_FLOW_ID_VALID;
+	if (queue_info->ena_adaptive)
+		queue_conf->rx_queue_flags |=
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE;
 	queue_conf->servicing_weight = queue_info->wt;
 
 	queue_conf->ev.event = queue_info->event;
@@ -3940,6 +4101,82 @@ handle_rxa_get_queue_stats(const char *cmd __rte_unused,
 	return ret;
 }
 
+static int
+handle_rxa_get_queue_adaptive_stats(const char *cmd __rte_unused,
+				    const char *params,
+				    struct rte_tel_data *d)
+{
+	uint8_t rx_adapter_id;
+	uint16_t rx_queue_id;
+	int eth_dev_id, ret = -1;
+	char *token, *l_params;
+	struct rte_event_eth_rx_adapter_queue_adaptive_stats a_stats;
+
+	if (params == NULL || strlen(params) == 0 || !isdigit(*params))
+		return -1;
+
+	/* Get Rx adapter ID from parameter string */
+	l_params = strdup(params);
+	if (l_params == NULL)
+		return -ENOMEM;
+	token = strtok(l_params, ",");
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+	rx_adapter_id = strtoul(token, NULL, 10);
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_GOTO_ERR_RET(rx_adapter_id, -EINVAL);
+
+	token = strtok(NULL, ",");
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+
+	/* Get device ID from parameter string */
+	eth_dev_id = strtoul(token, NULL, 10);
+	RTE_EVENT_ETH_RX_ADAPTER_PORTID_VALID_OR_GOTO_ERR_RET(eth_dev_id, -EINVAL);
+
+	token = strtok(NULL, ",");
+	RTE_EVENT_ETH_RX_ADAPTER_TOKEN_VALID_OR_GOTO_ERR_RET(token, -1);
+
+	/* Get Rx queue ID from parameter string */
+	rx_queue_id = strtoul(token, NULL, 10);
+	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
+		RTE_EDEV_LOG_ERR("Invalid rx queue_id %u", rx_queue_id);
+		ret = -EINVAL;
+		goto error;
+	}
+
+	token = strtok(NULL, "\0");
+	if (token != NULL)
+		RTE_EDEV_LOG_ERR("Extra parameters passed to eventdev"
+				 " telemetry command, ignoring");
+	/* Parsing parameter finished */
+	free(l_params);
+
+	if (rte_event_eth_rx_adapter_queue_adaptive_stats_get(rx_adapter_id,
+							      eth_dev_id,
+							      rx_queue_id,
+							      &a_stats)) {
+		RTE_EDEV_LOG_ERR("Failed to get Rx adapter queue adaptive stats");
+		return -1;
+	}
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "rx_adapter_id", rx_adapter_id);
+	rte_tel_data_add_dict_uint(d, "eth_dev_id", eth_dev_id);
+	rte_tel_data_add_dict_uint(d, "rx_queue_id", rx_queue_id);
+	RXA_ADD_DICT(a_stats, rx_poll_count);
+	RXA_ADD_DICT(a_stats, rx_empty_poll_count);
+	RXA_ADD_DICT(a_stats, rx_skip_count);
+	RXA_ADD_DICT(a_stats, rx_backpressure_count);
+	RXA_ADD_DICT(a_stats, rx_packets);
+	RXA_ADD_DICT(a_stats, rx_cycles);
+	RXA_ADD_DICT(a_stats, rx_burst_size);
+	RXA_ADD_DICT(a_stats, rx_poll_backoff);
+
+	return 0;
+
+error:
+	free(l_params);
+	return ret;
+}
+
 static int
 handle_rxa_queue_stats_reset(const char *cmd __rte_unused,
 			     const char *params,
@@ -4085,6 +4322,10 @@ RTE_INIT(rxa_init_telemetry)
 		handle_rxa_queue_stats_reset,
 		"Reset Rx queue stats. Parameter: rxa_id, dev_id, queue_id");
 
+	rte_telemetry_register_cmd("/eventdev/rxa_queue_adaptive_stats",
+		handle_rxa_get_queue_adaptive_stats,
+		"Returns Rx queue adaptive polling stats. Parameter: rxa_id, dev_id, queue_id");
+
 	rte_telemetry_register_cmd("/eventdev/rxa_rxq_instance_get",
 		handle_rxa_instance_get,
 		"Returns Rx adapter instance id. Parameter: dev_id, queue_id");
@@ -38,6 +38,7 @@
  *  - rte_event_eth_rx_adapter_queue_conf_get()
  *  - rte_event_eth_rx_adapter_queue_stats_get()
  *  - rte_event_eth_rx_adapter_queue_stats_reset()
+ *  - rte_event_eth_rx_adapter_queue_adaptive_stats_get()
  *  - rte_event_eth_rx_adapter_event_port_get()
  *  - rte_event_eth_rx_adapter_instance_get()
  *  - rte_event_eth_rx_adapter_runtime_params_get()
@@ -109,6 +110,15 @@ extern "C" {
 /**< This flag indicates that mbufs arriving on the queue need to be vectorized
  * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
  */
+#define RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE	0x4
+/**< This flag indicates that the adapter service tunes the Rx burst size and
+ * the polling frequency of the queue from its measured occupancy and from the
+ * event device back pressure. Idle queues are polled less often and busy
+ * queues are drained with larger bursts. The flag has no effect on interrupt
+ * mode queues and on adapters using an internal event port.
+ * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
+ * @see rte_event_eth_rx_adapter_queue_adaptive_stats_get()
+ */
 
 /**
  * Adapter configuration structure that the adapter configuration callback
@@ -232,6 +242,32 @@ struct rte_event_eth_rx_adapter_queue_stats {
 	/**< Received packet dropped count */
 };
 
+/**
+ * A structure used to retrieve the adaptive polling statistics of an Rx queue.
+ *
+ * @see RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE
+ */
+struct rte_event_eth_rx_adapter_queue_adaptive_stats {
+	uint64_t rx_poll_count;
+	/**< Receive queue poll count */
+	uint64_t rx_empty_poll_count;
+	/**< Number of times the queue was found empty */
+	uint64_t rx_skip_count;
+	/**< Number of polls skipped because the queue was idle */
+	uint64_t rx_backpressure_count;
+	/**< Number of times the event device back pressured the queue */
+	uint64_t rx_packets;
+	/**< Received packet count */
+	uint64_t rx_cycles;
+	/**< TSC cycles spent receiving from the queue and enqueuing its events,
+	 * rx_cycles / rx_packets gives the cost of a packet.
+	 */
+	uint16_t rx_burst_size;
+	/**< Current Rx burst size */
+	uint16_t rx_poll_backoff;
+	/**< Current number of polls skipped after an empty poll */
+};
+
 /**
  * A structure used to retrieve statistics for an eth rx adapter instance.
  */
@@ -773,9 +809,47 @@ rte_event_eth_rx_adapter_queue_stats_get(uint8_t id,
 		uint16_t rx_queue_id,
 		struct rte_event_eth_rx_adapter_queue_stats *stats);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Retrieve the adaptive polling statistics of an Rx queue added with the
+ * RTE_EVENT_ETH_RX_ADAPTER_QUEUE_ADAPTIVE flag. The statistics are cleared by
+ * rte_event_eth_rx_adapter_stats_reset() and
+ * rte_event_eth_rx_adapter_queue_stats_reset().
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param eth_dev_id
+ *  Port identifier of Ethernet device.
+ *
+ * @param rx_queue_id
+ *  Ethernet device receive queue index.
+ *
+ * @param[out] stats
+ *  Pointer to struct rte_event_eth_rx_adapter_queue_adaptive_stats
+ *
+ * @return
+ *  - 0: Success, queue adaptive stats retrieved.
+ *  - -EINVAL: Invalid parameters or the queue is not in adaptive mode.
+ *  - -ENOTSUP: The adapter uses an internal event port.
+ */
+__rte_experimental
+int
+rte_event_eth_rx_adapter_queue_adaptive_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_queue_adaptive_stats *stats);
+
 /**
  * Reset Rx queue statistics.
  *
+ * The adaptive polling statistics of the queue are reset too, see
+ * rte_event_eth_rx_adapter_queue_adaptive_stats_get(). When the adapter
+ * does not use per-queue event buffers, only an adaptive queue has
+ * statistics to reset.
+ *
  * @param id
  *  Adapter identifier.
  *
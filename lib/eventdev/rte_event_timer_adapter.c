@@ -10,12 +10,14 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <math.h>
+#include <sys/queue.h>
 
 #include <rte_memzone.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_common.h>
+#include <rte_ring.h>
 #include <rte_timer.h>
 #include <rte_service_component.h>
 #include <rte_telemetry.h>
@@ -607,6 +609,66 @@ event_buffer_flush(struct event_buffer *bufp, uint8_t dev_id, uint8_t port_id,
 	bufp->tail = bufp->tail + *nb_events_flushed + *nb_events_inv;
 }
 
+/*
+ * Timer wheel of the software event timer adapter.
+ *
+ * Each lcore arming timers has its own wheel, of SWTIM_WHEEL_LEVELS levels of
+ * SWTIM_WHEEL_SLOTS slots each, in adapter ticks. The arming lcore enqueues
+ * the timers to the ring of its wheel, the service owns the wheels: it
+ * inserts the timers in the slots and advances the wheels. The rings are as
+ * large as the timer pool, so arming fails only when the pool is exhausted.
+ * A cancelled timer is marked in its state, and sent to the service through
+ * the cancel ring to be unlinked and freed.
+ */
+#define SWTIM_WHEEL_LEVELS 4
+#define SWTIM_WHEEL_BITS 6
+#define SWTIM_WHEEL_SLOTS (1 << SWTIM_WHEEL_BITS)
+#define SWTIM_WHEEL_MASK (SWTIM_WHEEL_SLOTS - 1)
+#define SWTIM_WHEEL_SPAN (1ULL << (SWTIM_WHEEL_LEVELS * SWTIM_WHEEL_BITS))
+#define SWTIM_WHEEL_DEQ_SZ 64
+
+/* Timer state, the upper bits are a generation number of the timer object */
+#define SWTIM_WHEEL_ARMED 0
+#define SWTIM_WHEEL_RUNNING 1
+#define SWTIM_WHEEL_CANCELED 2
+#define SWTIM_WHEEL_STATE_MASK 3
+#define SWTIM_WHEEL_GEN_SHIFT 2
+
+/* Location of a timer, only accessed by the service */
+enum swtim_wheel_loc {
+	SWTIM_WHEEL_PENDING, /* in the ring of a wheel */
+	SWTIM_WHEEL_LINKED,  /* in a slot of a wheel */
+	SWTIM_WHEEL_DROPPED, /* cancelled, waiting for the cancel ring */
+};
+
+struct swtim_wheel;
+
+struct swtim_wheel_tim {
+	LIST_ENTRY(swtim_wheel_tim) next;
+	struct rte_event_timer *evtim;
+	struct swtim_wheel *wheel;
+	/* Expiry tick */
+	uint64_t expire;
+	/* Period in ticks, 0 for a single shot timer */
+	uint64_t period;
+	RTE_ATOMIC(uint64_t) state;
+	enum swtim_wheel_loc loc;
+	/* The timer was dequeued from the cancel ring */
+	bool cancelled;
+};
+
+LIST_HEAD(swtim_wheel_slot, swtim_wheel_tim);
+
+struct __rte_cache_aligned swtim_wheel {
+	/* Timers armed by the lcore */
+	struct rte_ring *ring;
+	/* Last processed tick */
+	uint64_t cur;
+	/* Number of timers in the slots */
+	uint64_t nb_tims;
+	struct swtim_wheel_slot slots[SWTIM_WHEEL_LEVELS][SWTIM_WHEEL_SLOTS];
+};
+
 /*
  * Software event timer adapter implementation
  */
@@ -643,6 +705,18 @@ struct swtim {
 	struct rte_timer *expired_timers[EXP_TIM_BUF_SZ];
 	/* The number of timers that can be returned to a mempool */
 	size_t n_expired_timers;
+	/* Timer wheels, if RTE_EVENT_TIMER_ADAPTER_F_WHEEL is set */
+	struct swtim_wheel *wheels[RTE_MAX_LCORE];
+	/* Cancelled timers of the wheels */
+	struct rte_ring *cancel_ring;
+	/* Adapter tick duration and its inverse, for the wheels */
+	uint64_t tick_cycles;
+	struct rte_reciprocal_u64 tick_inverse;
+	/* Last tick processed by the wheels */
+	uint64_t wheel_tick;
+	/* Wheel timers which can be returned to the mempool */
+	struct swtim_wheel_tim *free_wtims[EXP_TIM_BUF_SZ];
+	size_t n_free_wtims;
 };
 
 static inline struct swtim *
@@ -838,6 +912,280 @@ check_destination_event_queue(struct rte_event_timer *evtim,
 	return -1;
 }
 
+static inline bool
+swtim_use_wheel(const struct rte_event_timer_adapter *adapter)
+{
+	return adapter->data->conf.flags & RTE_EVENT_TIMER_ADAPTER_F_WHEEL;
+}
+
+static inline uint64_t
+swtim_wheel_now(struct swtim *sw)
+{
+	return rte_reciprocal_divide_u64(rte_get_timer_cycles(),
+					 &sw->tick_inverse);
+}
+
+static inline void
+swtim_wheel_free(struct swtim *sw, struct swtim_wheel_tim *wt)
+{
+	if (unlikely(sw->n_free_wtims == EXP_TIM_BUF_SZ)) {
+		rte_mempool_put_bulk(sw->tim_pool, (void **)sw->free_wtims,
+				     sw->n_free_wtims);
+		sw->n_free_wtims = 0;
+	}
+	sw->free_wtims[sw->n_free_wtims++] = wt;
+}
+
+/* A cancelled timer is freed once seen by both the wheel and the cancel ring */
+static inline void
+swtim_wheel_drop(struct swtim *sw, struct swtim_wheel_tim *wt)
+{
+	if (wt->cancelled)
+		swtim_wheel_free(sw, wt);
+	else
+		wt->loc = SWTIM_WHEEL_DROPPED;
+}
+
+/* Link a timer expiring after the current tick in the slot of its level */
+static inline void
+swtim_wheel_link(struct swtim_wheel *w, struct swtim_wheel_tim *wt)
+{
+	uint64_t expire = wt->expire;
+	uint64_t delta = expire - w->cur;
+	unsigned int level;
+
+	for (level = 0; level != SWTIM_WHEEL_LEVELS - 1; level++)
+		if (delta < 1ULL << ((level + 1) * SWTIM_WHEEL_BITS))
+			break;
+
+	/* Beyond the wheel span, cascaded again from the last slot */
+	if (delta >= SWTIM_WHEEL_SPAN)
+		expire = w->cur + SWTIM_WHEEL_SPAN - 1;
+
+	LIST_INSERT_HEAD(&w->slots[level][(expire >> (level *
+			 SWTIM_WHEEL_BITS)) & SWTIM_WHEEL_MASK], wt, next);
+	wt->loc = SWTIM_WHEEL_LINKED;
+	w->nb_tims++;
+}
+
+static void
+swtim_wheel_expire(const struct rte_event_timer_adapter *adapter,
+		   struct swtim_wheel *w, struct swtim_wheel_tim *wt);
+
+/* Link a timer, or expire it if its tick is reached */
+static inline void
+swtim_wheel_add(const struct rte_event_timer_adapter *adapter,
+		struct swtim_wheel *w, struct swtim_wheel_tim *wt)
+{
+	if (wt->expire <= w->cur)
+		swtim_wheel_expire(adapter, w, wt);
+	else
+		swtim_wheel_link(w, wt);
+}
+
+static void
+swtim_wheel_expire(const struct rte_event_timer_adapter *adapter,
+		   struct swtim_wheel *w, struct swtim_wheel_tim *wt)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	struct rte_event_timer *evtim = wt->evtim;
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+	uint64_t gen, state;
+
+	state = rte_atomic_load_explicit(&wt->state, rte_memory_order_relaxed);
+	gen = state & ~(uint64_t)SWTIM_WHEEL_STATE_MASK;
+
+	/* The timer is cancelled, or being cancelled */
+	if ((state & SWTIM_WHEEL_STATE_MASK) != SWTIM_WHEEL_ARMED ||
+	    !rte_atomic_compare_exchange_strong_explicit(&wt->state, &state,
+			gen | SWTIM_WHEEL_RUNNING, rte_memory_order_acquire,
+			rte_memory_order_relaxed)) {
+		swtim_wheel_drop(sw, wt);
+		return;
+	}
+
+	if (event_buffer_add(&sw->buffer, &evtim->ev) < 0) {
+		if (wt->period == 0) {
+			/* Buffer full, expire it again on the next tick */
+			wt->expire = w->cur + 1;
+			sw->stats.evtim_retry_count++;
+		} else {
+			wt->expire = RTE_MAX(wt->expire + wt->period,
+					     w->cur + 1);
+			sw->stats.evtim_drop_count++;
+		}
+		rte_atomic_store_explicit(&wt->state, gen | SWTIM_WHEEL_ARMED,
+					  rte_memory_order_release);
+		swtim_wheel_link(w, wt);
+		return;
+	}
+
+	sw->stats.evtim_exp_count++;
+
+	if (wt->period == 0) {
+		rte_atomic_store_explicit(&evtim->state,
+					  RTE_EVENT_TIMER_NOT_ARMED,
+					  rte_memory_order_release);
+		swtim_wheel_free(sw, wt);
+	} else {
+		wt->expire = RTE_MAX(wt->expire + wt->period, w->cur + 1);
+		rte_atomic_store_explicit(&wt->state, gen | SWTIM_WHEEL_ARMED,
+					  rte_memory_order_release);
+		swtim_wheel_link(w, wt);
+	}
+
+	if (event_buffer_batch_ready(&sw->buffer)) {
+		event_buffer_flush(&sw->buffer,
+				   adapter->data->event_dev_id,
+				   adapter->data->event_port_id,
+				   &nb_evs_flushed,
+				   &nb_evs_invalid);
+
+		sw->stats.ev_enq_count += nb_evs_flushed;
+		sw->stats.ev_inv_count += nb_evs_invalid;
+	}
+}
+
+/* Move the timers of a slot, to lower levels or to the expiry */
+static inline void
+swtim_wheel_slot_run(const struct rte_event_timer_adapter *adapter,
+		     struct swtim_wheel *w, struct swtim_wheel_slot *slot)
+{
+	struct swtim_wheel_tim *wt;
+
+	while ((wt = LIST_FIRST(slot)) != NULL) {
+		LIST_REMOVE(wt, next);
+		w->nb_tims--;
+		swtim_wheel_add(adapter, w, wt);
+	}
+}
+
+static void
+swtim_wheel_advance(const struct rte_event_timer_adapter *adapter,
+		    struct swtim_wheel *w, uint64_t now)
+{
+	unsigned int level, l;
+	uint64_t t;
+
+	while (w->cur < now) {
+		/* Nothing to expire, jump to the current tick */
+		if (w->nb_tims == 0) {
+			w->cur = now;
+			break;
+		}
+
+		t = ++w->cur;
+
+		/* Cascade the upper levels starting a new round, highest first */
+		for (level = 1; level != SWTIM_WHEEL_LEVELS; level++)
+			if (t & ((1ULL << (level * SWTIM_WHEEL_BITS)) - 1))
+				break;
+		for (l = level - 1; l != 0; l--)
+			swtim_wheel_slot_run(adapter, w, &w->slots[l][(t >>
+				(l * SWTIM_WHEEL_BITS)) & SWTIM_WHEEL_MASK]);
+
+		swtim_wheel_slot_run(adapter, w,
+				     &w->slots[0][t & SWTIM_WHEEL_MASK]);
+	}
+}
+
+/* Insert the timers armed by an lcore in its wheel */
+static void
+swtim_wheel_dequeue(const struct rte_event_timer_adapter *adapter,
+		    struct swtim_wheel *w)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	struct swtim_wheel_tim *wts[SWTIM_WHEEL_DEQ_SZ];
+	unsigned int i, n;
+	uint64_t state;
+
+	do {
+		n = rte_ring_dequeue_burst(w->ring, (void **)wts,
+					   SWTIM_WHEEL_DEQ_SZ, NULL);
+		for (i = 0; i < n; i++) {
+			state = rte_atomic_load_explicit(&wts[i]->state,
+					rte_memory_order_relaxed);
+			if ((state & SWTIM_WHEEL_STATE_MASK) ==
+					SWTIM_WHEEL_CANCELED)
+				swtim_wheel_drop(sw, wts[i]);
+			else
+				swtim_wheel_add(adapter, w, wts[i]);
+		}
+	} while (n == SWTIM_WHEEL_DEQ_SZ);
+}
+
+/* Unlink and free the cancelled timers */
+static void
+swtim_wheel_cancel_dequeue(struct swtim *sw)
+{
+	struct swtim_wheel_tim *wts[SWTIM_WHEEL_DEQ_SZ];
+	struct swtim_wheel_tim *wt;
+	unsigned int i, n;
+
+	do {
+		n = rte_ring_dequeue_burst(sw->cancel_ring, (void **)wts,
+					   SWTIM_WHEEL_DEQ_SZ, NULL);
+		for (i = 0; i < n; i++) {
+			wt = wts[i];
+			switch (wt->loc) {
+			case SWTIM_WHEEL_LINKED:
+				LIST_REMOVE(wt, next);
+				wt->wheel->nb_tims--;
+				swtim_wheel_free(sw, wt);
+				break;
+			case SWTIM_WHEEL_DROPPED:
+				swtim_wheel_free(sw, wt);
+				break;
+			case SWTIM_WHEEL_PENDING:
+				wt->cancelled = true;
+				break;
+			}
+		}
+	} while (n == SWTIM_WHEEL_DEQ_SZ);
+}
+
+static void
+swtim_wheel_manage(const struct rte_event_timer_adapter *adapter)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	struct swtim_wheel *w;
+	unsigned int lcore_id;
+	int i, n_lcores;
+	uint64_t now;
+
+	now = swtim_wheel_now(sw);
+
+	swtim_wheel_cancel_dequeue(sw);
+
+	n_lcores = rte_atomic_load_explicit(&sw->n_poll_lcores,
+					    rte_memory_order_relaxed);
+	for (i = 0; i < n_lcores; i++) {
+		lcore_id = rte_atomic_load_explicit(&sw->poll_lcores[i],
+						    rte_memory_order_relaxed);
+		w = sw->wheels[lcore_id];
+		if (w == NULL)
+			continue;
+
+		/* Insert relatively to the current tick if the wheel is empty */
+		if (w->nb_tims == 0 && w->cur < now)
+			w->cur = now;
+
+		swtim_wheel_dequeue(adapter, w);
+		swtim_wheel_advance(adapter, w, now);
+	}
+
+	if (now > sw->wheel_tick) {
+		sw->stats.adapter_tick_count += now - sw->wheel_tick;
+		sw->wheel_tick = now;
+	}
+
+	/* Return expired timer objects back to mempool */
+	rte_mempool_put_bulk(sw->tim_pool, (void **)sw->free_wtims,
+			     sw->n_free_wtims);
+	sw->n_free_wtims = 0;
+}
+
 static int
 swtim_service_func(void *arg)
 {
@@ -847,7 +1195,9 @@ swtim_service_func(void *arg)
 	uint16_t nb_evs_invalid = 0;
 	const uint64_t prior_enq_count = sw->stats.ev_enq_count;
 
-	if (swtim_did_tick(sw)) {
+	if (swtim_use_wheel(adapter)) {
+		swtim_wheel_manage(adapter);
+	} else if (swtim_did_tick(sw)) {
 		rte_timer_alt_manage(sw->timer_data_id,
 				     (unsigned int *)(uintptr_t)sw->poll_lcores,
 				     sw->n_poll_lcores,
@@ -906,6 +1256,83 @@ compute_msg_mempool_cache_size(uint64_t nb_requested, uint64_t nb_actual)
 	return cache_size;
 }
 
+static void
+swtim_wheel_uninit(struct swtim *sw)
+{
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (sw->wheels[lcore_id] == NULL)
+			continue;
+		rte_ring_free(sw->wheels[lcore_id]->ring);
+		rte_free(sw->wheels[lcore_id]);
+		sw->wheels[lcore_id] = NULL;
+	}
+
+	rte_ring_free(sw->cancel_ring);
+	sw->cancel_ring = NULL;
+}
+
+static int
+swtim_wheel_init(struct rte_event_timer_adapter *adapter)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	char name[RTE_RING_NAMESIZE];
+	struct swtim_wheel *w;
+	unsigned int lcore_id, flags, l, i;
+	uint64_t ring_sz;
+
+	sw->tick_cycles = RTE_MAX((uint64_t)(sw->timer_tick_ns *
+			((double)rte_get_timer_hz() / NSECPERSEC)), 1ULL);
+	sw->tick_inverse = rte_reciprocal_value_u64(sw->tick_cycles);
+	sw->wheel_tick = swtim_wheel_now(sw);
+
+	/* As large as the timer pool, so the rings are never full */
+	ring_sz = rte_align64pow2(adapter->data->conf.nb_timers);
+
+	snprintf(name, sizeof(name), "swtim_cancel_%"PRIu8, adapter->data->id);
+	sw->cancel_ring = rte_ring_create(name, ring_sz,
+			adapter->data->socket_id, RING_F_SC_DEQ);
+	if (sw->cancel_ring == NULL)
+		return -1;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		/* The last wheel is shared with the non-EAL threads */
+		if (!rte_lcore_is_enabled(lcore_id) &&
+		    rte_lcore_has_role(lcore_id, ROLE_SERVICE) != 1 &&
+		    lcore_id != RTE_MAX_LCORE - 1)
+			continue;
+
+		w = rte_zmalloc_socket("swtim_wheel", sizeof(*w),
+				       RTE_CACHE_LINE_SIZE,
+				       adapter->data->socket_id);
+		if (w == NULL)
+			goto free_wheels;
+		sw->wheels[lcore_id] = w;
+
+		flags = RING_F_SC_DEQ;
+		if (lcore_id != RTE_MAX_LCORE - 1)
+			flags |= RING_F_SP_ENQ;
+		snprintf(name, sizeof(name), "swtim_%"PRIu8"_%u",
+			 adapter->data->id, lcore_id);
+		w->ring = rte_ring_create(name, ring_sz,
+					  adapter->data->socket_id, flags);
+		if (w->ring == NULL)
+			goto free_wheels;
+
+		for (l = 0; l < SWTIM_WHEEL_LEVELS; l++)
+			for (i = 0; i < SWTIM_WHEEL_SLOTS; i++)
+				LIST_INIT(&w->slots[l][i]);
+		w->cur = sw->wheel_tick;
+	}
+
+	return 0;
+
+free_wheels:
+	swtim_wheel_uninit(sw);
+	return -1;
+}
+
 static int
 swtim_init(struct rte_event_timer_adapter *adapter)
 {
@@ -945,7 +1372,10 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 				adapter->data->conf.nb_timers, nb_timers);
 	flags = 0; /* pool is multi-producer, multi-consumer */
 	sw->tim_pool = rte_mempool_create(pool_name, pool_size,
-			sizeof(struct rte_timer), cache_size, 0, NULL, NULL,
+			swtim_use_wheel(adapter) ?
+				sizeof(struct swtim_wheel_tim) :
+				sizeof(struct rte_timer),
+			cache_size, 0, NULL, NULL,
 			NULL, NULL, adapter->data->socket_id, flags);
 	if (sw->tim_pool == NULL) {
 		EVTIM_LOG_ERR("failed to create timer object mempool");
@@ -957,6 +1387,15 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	for (i = 0; i < RTE_MAX_LCORE; i++)
 		sw->in_use[i].v = 0;
 
+	if (swtim_use_wheel(adapter)) {
+		if (swtim_wheel_init(adapter) < 0) {
+			EVTIM_LOG_ERR("failed to allocate timer wheels");
+			rte_errno = ENOMEM;
+			goto free_mempool;
+		}
+		goto init_buffer;
+	}
+
 	/* Initialize the timer subsystem and allocate timer data instance */
 	ret = rte_timer_subsystem_init();
 	if (ret < 0) {
@@ -974,6 +1413,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 		goto free_mempool;
 	}
 
+init_buffer:
 	/* Initialize timer event buffer */
 	event_buffer_init(&sw->buffer);
 
@@ -994,7 +1434,7 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 			      ret);
 
 		rte_errno = ENOSPC;
-		goto free_mempool;
+		goto free_wheels;
 	}
 
 	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
@@ -1004,6 +1444,8 @@ swtim_init(struct rte_event_timer_adapter *adapter)
 	adapter->data->service_inited = 1;
 
 	return 0;
+free_wheels:
+	swtim_wheel_uninit(sw);
 free_mempool:
 	rte_mempool_free(sw->tim_pool);
 free_alloc:
@@ -1022,23 +1464,62 @@ swtim_free_tim(struct rte_timer *tim, void *arg)
 /* Traverse the list of outstanding timers and put them back in the mempool
  * before freeing the adapter to avoid leaking the memory.
  */
+static void
+swtim_wheel_free_all(struct swtim *sw)
+{
+	struct swtim_wheel_tim *wt;
+	struct swtim_wheel *w;
+	unsigned int lcore_id, l, i;
+
+	swtim_wheel_cancel_dequeue(sw);
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		w = sw->wheels[lcore_id];
+		if (w == NULL)
+			continue;
+
+		while (rte_ring_dequeue(w->ring, (void **)&wt) == 0)
+			swtim_wheel_free(sw, wt);
+
+		for (l = 0; l < SWTIM_WHEEL_LEVELS; l++) {
+			for (i = 0; i < SWTIM_WHEEL_SLOTS; i++) {
+				while ((wt = LIST_FIRST(&w->slots[l][i]))) {
+					LIST_REMOVE(wt, next);
+					swtim_wheel_free(sw, wt);
+				}
+			}
+		}
+		w->nb_tims = 0;
+	}
+
+	rte_mempool_put_bulk(sw->tim_pool, (void **)sw->free_wtims,
+			     sw->n_free_wtims);
+	sw->n_free_wtims = 0;
+}
+
 static int
 swtim_uninit(struct rte_event_timer_adapter *adapter)
 {
 	int ret;
 	struct swtim *sw = swtim_pmd_priv(adapter);
 
-	/* Free outstanding timers */
-	rte_timer_stop_all(sw->timer_data_id,
-			   (unsigned int *)(uintptr_t)sw->poll_lcores,
-			   sw->n_poll_lcores,
-			   swtim_free_tim,
-			   sw);
-
-	ret = rte_timer_data_dealloc(sw->timer_data_id);
-	if (ret < 0) {
-		EVTIM_LOG_ERR("failed to deallocate timer data instance");
-		return ret;
+	if (swtim_use_wheel(adapter)) {
+		/* Free outstanding timers */
+		swtim_wheel_free_all(sw);
+		swtim_wheel_uninit(sw);
+	} else {
+		/* Free outstanding timers */
+		rte_timer_stop_all(sw->timer_data_id,
+				   (unsigned int *)(uintptr_t)sw->poll_lcores,
+				   sw->n_poll_lcores,
+				   swtim_free_tim,
+				   sw);
+
+		ret = rte_timer_data_dealloc(sw->timer_data_id);
+		if (ret < 0) {
+			EVTIM_LOG_ERR("failed to deallocate timer data instance");
+			return ret;
+		}
 	}
 
 	ret = rte_service_component_unregister(sw->service_id);
@@ -1149,6 +1630,16 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 	if (n_state != RTE_EVENT_TIMER_ARMED)
 		return -EINVAL;
 
+	if (swtim_use_wheel(adapter)) {
+		struct swtim_wheel_tim *wt;
+		uint64_t now;
+
+		wt = (struct swtim_wheel_tim *)(uintptr_t)evtim->impl_opaque[0];
+		now = swtim_wheel_now(swtim_pmd_priv(adapter));
+		*ticks_remaining = wt->expire > now ? wt->expire - now : 0;
+		return 0;
+	}
+
 	opaque = evtim->impl_opaque[0];
 	tim = (struct rte_timer *)(uintptr_t)opaque;
 
@@ -1168,6 +1659,188 @@ swtim_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
 	return 0;
 }
 
+/* If this is the first time we're arming an event timer on this lcore,
+ * mark this lcore as "in use"; this will cause the service
+ * function to process the timer list that corresponds to this lcore.
+ * The atomic compare-and-swap operation can prevent the race condition
+ * on in_use flag between multiple non-EAL threads.
+ */
+static inline void
+swtim_poll_lcore_add(struct swtim *sw, uint32_t lcore_id)
+{
+	/* Timer list for this lcore is not in use. */
+	uint16_t exp_state = 0;
+	int n_lcores;
+
+	if (unlikely(rte_atomic_compare_exchange_strong_explicit(&sw->in_use[lcore_id].v,
+			&exp_state, 1,
+			rte_memory_order_relaxed, rte_memory_order_relaxed))) {
+		EVTIM_LOG_DBG("Adding lcore id = %u to list of lcores to poll",
+			      lcore_id);
+		n_lcores = rte_atomic_fetch_add_explicit(&sw->n_poll_lcores, 1,
+					     rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&sw->poll_lcores[n_lcores], lcore_id,
+				rte_memory_order_relaxed);
+	}
+}
+
+/* Arm timers in the wheel of the lcore: the timers are checked and sent in
+ * bulk to the service through the ring of the wheel.
+ */
+static uint16_t
+swtim_wheel_arm_burst(const struct rte_event_timer_adapter *adapter,
+		      struct rte_event_timer **evtims,
+		      uint16_t nb_evtims)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	uint32_t lcore_id = rte_lcore_id();
+	struct swtim_wheel_tim *wt, *wts[nb_evtims];
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel *w;
+	uint64_t now, gen;
+	unsigned int i, n;
+	bool periodic;
+
+	/* Non-EAL threads share the wheel of the highest lcore */
+	if (lcore_id == LCORE_ID_ANY || sw->wheels[lcore_id] == NULL)
+		lcore_id = RTE_MAX_LCORE - 1;
+	w = sw->wheels[lcore_id];
+
+	swtim_poll_lcore_add(sw, lcore_id);
+
+	if (rte_mempool_get_bulk(sw->tim_pool, (void **)wts, nb_evtims) < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	periodic = get_timer_type(adapter) == PERIODICAL;
+	now = swtim_wheel_now(sw);
+
+	for (i = 0; i < nb_evtims; i++) {
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtims[i],
+							   adapter) < 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(evtims[i]->timeout_ticks * sw->timer_tick_ns >
+			     sw->max_tmo_ns)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(evtims[i]->timeout_ticks == 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		/* A new generation of the object, for the cancellation */
+		wt = wts[i];
+		gen = (rte_atomic_load_explicit(&wt->state,
+				rte_memory_order_relaxed) >>
+				SWTIM_WHEEL_GEN_SHIFT) + 1;
+		rte_atomic_store_explicit(&wt->state,
+				gen << SWTIM_WHEEL_GEN_SHIFT | SWTIM_WHEEL_ARMED,
+				rte_memory_order_relaxed);
+		wt->evtim = evtims[i];
+		wt->wheel = w;
+		/* Expire on the tick boundary following the timeout */
+		wt->expire = now + evtims[i]->timeout_ticks + 1;
+		wt->period = periodic ? evtims[i]->timeout_ticks : 0;
+		wt->loc = SWTIM_WHEEL_PENDING;
+		wt->cancelled = false;
+
+		evtims[i]->impl_opaque[0] = (uintptr_t)wt;
+		evtims[i]->impl_opaque[1] = gen;
+	}
+
+	n = rte_ring_enqueue_burst(w->ring, (void **)wts, i, NULL);
+	if (unlikely(n < i))
+		rte_errno = ENOSPC;
+
+	/* The timers are published as armed, so they can be cancelled, only
+	 * once the service owns them; they expire two ticks later at least.
+	 * RELEASE ordering guarantees the adapter specific value changes
+	 * observed before the update of state.
+	 */
+	for (i = 0; i < n; i++)
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				rte_memory_order_release);
+
+	if (n < nb_evtims)
+		rte_mempool_put_bulk(sw->tim_pool, (void **)&wts[n],
+				     nb_evtims - n);
+
+	return n;
+}
+
+/* Mark the timers cancelled, the service unlinks and frees them */
+static uint16_t
+swtim_wheel_cancel_burst(const struct rte_event_timer_adapter *adapter,
+			 struct rte_event_timer **evtims,
+			 uint16_t nb_evtims)
+{
+	struct swtim *sw = swtim_pmd_priv(adapter);
+	enum rte_event_timer_state n_state;
+	struct swtim_wheel_tim *wt;
+	uint64_t gen, state;
+	int i;
+
+	for (i = 0; i < nb_evtims; i++) {
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		wt = (struct swtim_wheel_tim *)(uintptr_t)evtims[i]->impl_opaque[0];
+		gen = evtims[i]->impl_opaque[1] << SWTIM_WHEEL_GEN_SHIFT;
+		RTE_ASSERT(wt != NULL);
+
+		/* Fails if the timer is expiring, or the object was reused */
+		state = gen | SWTIM_WHEEL_ARMED;
+		if (!rte_atomic_compare_exchange_strong_explicit(&wt->state,
+				&state, gen | SWTIM_WHEEL_CANCELED,
+				rte_memory_order_relaxed,
+				rte_memory_order_relaxed)) {
+			rte_errno = EAGAIN;
+			break;
+		}
+
+		while (rte_ring_enqueue(sw->cancel_ring, wt) != 0)
+			rte_pause();
+
+		/* The RELEASE ordering here pairs with atomic ordering
+		 * to make sure the state update data observed between
+		 * threads.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				rte_memory_order_release);
+	}
+
+	return i;
+}
+
 static uint16_t
 __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 		struct rte_event_timer **evtims,
@@ -1178,9 +1851,6 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 	uint32_t lcore_id = rte_lcore_id();
 	struct rte_timer *tim, *tims[nb_evtims];
 	uint64_t cycles;
-	int n_lcores;
-	/* Timer list for this lcore is not in use. */
-	uint16_t exp_state = 0;
 	enum rte_event_timer_state n_state;
 	enum rte_timer_type type = SINGLE;
 
@@ -1192,28 +1862,16 @@ __swtim_arm_burst(const struct rte_event_timer_adapter *adapter,
 	}
 #endif
 
+	if (swtim_use_wheel(adapter))
+		return swtim_wheel_arm_burst(adapter, evtims, nb_evtims);
+
 	/* Adjust lcore_id if non-EAL thread. Arbitrarily pick the timer list of
 	 * the highest lcore to insert such timers into
 	 */
 	if (lcore_id == LCORE_ID_ANY)
 		lcore_id = RTE_MAX_LCORE - 1;
 
-	/* If this is the first time we're arming an event timer on this lcore,
-	 * mark this lcore as "in use"; this will cause the service
-	 * function to process the timer list that corresponds to this lcore.
-	 * The atomic compare-and-swap operation can prevent the race condition
-	 * on in_use flag between multiple non-EAL threads.
-	 */
-	if (unlikely(rte_atomic_compare_exchange_strong_explicit(&sw->in_use[lcore_id].v,
-			&exp_state, 1,
-			rte_memory_order_relaxed, rte_memory_order_relaxed))) {
-		EVTIM_LOG_DBG("Adding lcore id = %u to list of lcores to poll",
-			      lcore_id);
-		n_lcores = rte_atomic_fetch_add_explicit(&sw->n_poll_lcores, 1,
-					     rte_memory_order_relaxed);
-		rte_atomic_store_explicit(&sw->poll_lcores[n_lcores], lcore_id,
-				rte_memory_order_relaxed);
-	}
+	swtim_poll_lcore_add(sw, lcore_id);
 
 	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims,
 				   nb_evtims);
@@ -1318,6 +1976,9 @@ swtim_cancel_burst(const struct rte_event_timer_adapter *adapter,
 	}
 #endif
 
+	if (swtim_use_wheel(adapter))
+		return swtim_wheel_cancel_burst(adapter, evtims, nb_evtims);
+
 	for (i = 0; i < nb_evtims; i++) {
 		/* Don't modify the event timer state in these cases */
 		/* ACQUIRE ordering guarantees the access of implementation
@@ -157,6 +157,19 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_WHEEL	(1ULL << 3)
+/**< Flag to use a hierarchical timer wheel instead of the timer library in
+ * the software event timer adapter; ignored by the hardware adapters.
+ * Each lcore arms the timers in its own wheel in constant time,
+ * the service expires the timers of all the wheels tick by tick.
+ * A cancelled timer object is returned to the timer pool by the service.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this flag may change without prior notice.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
@@ -19,6 +19,7 @@
 
 static struct graph_head graph_list = STAILQ_HEAD_INITIALIZER(graph_list);
 static rte_spinlock_t graph_lock = RTE_SPINLOCK_INITIALIZER;
+static bool graph_hist_enable;
 
 /* Private functions */
 static struct graph *
@@ -79,6 +80,20 @@ graph_spinlock_get(void)
 	return &graph_lock;
 }
 
+bool
+graph_hist_is_enable(void)
+{
+	return graph_hist_enable;
+}
+
+void
+rte_graph_node_hist_enable(bool enable)
+{
+	graph_spinlock_lock();
+	graph_hist_enable = enable;
+	graph_spinlock_unlock();
+}
+
 void
 graph_spinlock_lock(void)
 {
@@ -499,6 +514,10 @@ rte_graph_destroy(rte_graph_t id)
 			if (rte_graph_worker_model_get(graph->graph) ==
 			    RTE_GRAPH_MODEL_MCORE_DISPATCH)
 				graph_sched_wq_destroy(graph);
+			/* Destroy the deque of published streams if has */
+			if (rte_graph_worker_model_get(graph->graph) ==
+			    RTE_GRAPH_MODEL_WORK_STEAL)
+				graph_steal_deque_destroy(graph);
 
 			/* Call fini() of the all the nodes in the graph */
 			graph_node_fini(graph);
@@ -577,6 +596,11 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 	    graph_sched_wq_create(graph, parent_graph, prm))
 		goto graph_mem_destroy;
 
+	/* Create the graph deque of published streams */
+	if (rte_graph_worker_model_get(graph->graph) == RTE_GRAPH_MODEL_WORK_STEAL &&
+	    graph_steal_deque_create(graph, parent_graph, prm))
+		goto graph_mem_destroy;
+
 	/* Call init() of the all the nodes in the graph */
 	if (graph_node_init(graph))
 		goto graph_mem_destroy;
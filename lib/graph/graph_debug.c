@@ -68,6 +68,10 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 	fprintf(f, "  fence=0x%" PRIx64 "\n", g->fence);
 	fprintf(f, "  nodes_start=0x%" PRIx32 "\n", g->nodes_start);
 	fprintf(f, "  cir_start=%p\n", g->cir_start);
+	if (g->pcap_enable) {
+		fprintf(f, "  nb_pkt_captured=%" PRIu64 "\n", g->nb_pkt_captured);
+		fprintf(f, "  nb_pkt_dropped=%" PRIu64 "\n", g->nb_pkt_dropped);
+	}
 
 	rte_graph_foreach_node(count, off, g, n) {
 		if (!all && n->idx == 0)
@@ -88,6 +92,13 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 				n->dispatch.total_sched_objs);
 			fprintf(f, "       total_sched_fail=%" PRId64 "\n",
 				n->dispatch.total_sched_fail);
+			fprintf(f, "       total_sched_stall=%" PRId64 "\n",
+				n->dispatch.total_sched_stall);
+		} else if (rte_graph_worker_model_get(g) == RTE_GRAPH_MODEL_WORK_STEAL) {
+			fprintf(f, "       total_publish_objs=%" PRId64 "\n",
+				n->steal.total_publish_objs);
+			fprintf(f, "       total_steal_objs=%" PRId64 "\n",
+				n->steal.total_steal_objs);
 		}
 		fprintf(f, "       total_calls=%" PRId64 "\n", n->total_calls);
 		for (i = 0; i < n->nb_edges; i++)
@@ -0,0 +1,300 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
+
+#include "graph_private.h"
+#include "rte_graph_feature_arc.h"
+
+STAILQ_HEAD(feature_arc_head, rte_graph_feature_arc);
+
+static struct feature_arc_head feature_arc_list =
+	STAILQ_HEAD_INITIALIZER(feature_arc_list);
+
+/* Get the edge between two nodes, add it if it does not exist */
+static rte_edge_t
+feature_arc_edge_get(rte_node_t from, rte_node_t to)
+{
+	const char *name = rte_node_id_to_name(to);
+	rte_edge_t i, nb_edges;
+	char **next_nodes;
+
+	nb_edges = rte_node_edge_count(from);
+	if (nb_edges == RTE_EDGE_ID_INVALID || name == NULL)
+		return RTE_EDGE_ID_INVALID;
+
+	if (nb_edges > 0) {
+		next_nodes = malloc(nb_edges * sizeof(char *));
+		if (next_nodes == NULL)
+			return RTE_EDGE_ID_INVALID;
+
+		rte_node_edge_get(from, next_nodes);
+		for (i = 0; i < nb_edges; i++)
+			if (strncmp(next_nodes[i], name, RTE_NODE_NAMESIZE) == 0)
+				break;
+		free(next_nodes);
+
+		if (i < nb_edges)
+			return i;
+	}
+
+	if (rte_node_edge_update(from, RTE_EDGE_ID_INVALID, &name, 1) == 0)
+		return RTE_EDGE_ID_INVALID;
+
+	return nb_edges;
+}
+
+static struct rte_graph_feature_arc *
+feature_arc_from_name(const char *name)
+{
+	struct rte_graph_feature_arc *arc;
+
+	STAILQ_FOREACH(arc, &feature_arc_list, next)
+		if (strncmp(arc->name, name, RTE_GRAPH_FEATURE_ARC_NAMELEN) == 0)
+			return arc;
+
+	return NULL;
+}
+
+/* Check if a created graph contains the start node of the arc */
+static bool
+feature_arc_in_use(const struct rte_graph_feature_arc *arc)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	struct graph_node *graph_node;
+	struct graph *graph;
+	bool in_use = false;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next) {
+		STAILQ_FOREACH(graph_node, &graph->node_list, next) {
+			if (graph_node->node->id == arc->start_node) {
+				in_use = true;
+				goto unlock;
+			}
+		}
+	}
+unlock:
+	graph_spinlock_unlock();
+
+	return in_use;
+}
+
+struct rte_graph_feature_arc *
+rte_graph_feature_arc_create(const char *name, const char *start_node,
+			     const char *end_node, uint16_t max_indexes,
+			     int socket_id)
+{
+	struct rte_graph_feature_arc *arc;
+	rte_node_t start, end;
+	rte_edge_t edge;
+
+	if (name == NULL || start_node == NULL || end_node == NULL || max_indexes == 0)
+		SET_ERR_JMP(EINVAL, fail, "Invalid feature arc param");
+
+	start = rte_node_from_name(start_node);
+	end = rte_node_from_name(end_node);
+	if (start == RTE_NODE_ID_INVALID || end == RTE_NODE_ID_INVALID)
+		SET_ERR_JMP(EINVAL, fail, "Invalid node in feature arc %s", name);
+
+	if (rte_graph_feature_arc_lookup(name) != NULL)
+		SET_ERR_JMP(EEXIST, fail, "Found duplicate feature arc %s", name);
+
+	edge = feature_arc_edge_get(start, end);
+	if (edge == RTE_EDGE_ID_INVALID)
+		SET_ERR_JMP(EINVAL, fail, "Failed to add edge %s->%s", start_node,
+			    end_node);
+
+	arc = rte_zmalloc_socket(name, sizeof(*arc), RTE_CACHE_LINE_SIZE, socket_id);
+	if (arc == NULL)
+		SET_ERR_JMP(ENOMEM, fail, "Failed to allocate feature arc %s", name);
+
+	arc->enabled = rte_zmalloc_socket(name, max_indexes * sizeof(arc->enabled[0]),
+					  RTE_CACHE_LINE_SIZE, socket_id);
+	arc->data = rte_zmalloc_socket(name, (size_t)max_indexes *
+				       RTE_GRAPH_FEATURE_MAX_PER_ARC * sizeof(arc->data[0]),
+				       RTE_CACHE_LINE_SIZE, socket_id);
+	if (arc->enabled == NULL || arc->data == NULL)
+		SET_ERR_JMP(ENOMEM, free_arc, "Failed to allocate feature arc %s", name);
+
+	rte_strscpy(arc->name, name, RTE_GRAPH_FEATURE_ARC_NAMELEN);
+	arc->max_indexes = max_indexes;
+	arc->start_node = start;
+	arc->end_node = end;
+	arc->end_edge = edge;
+
+	graph_spinlock_lock();
+	STAILQ_INSERT_TAIL(&feature_arc_list, arc, next);
+	graph_spinlock_unlock();
+
+	return arc;
+
+free_arc:
+	rte_free(arc->data);
+	rte_free(arc->enabled);
+	rte_free(arc);
+fail:
+	return NULL;
+}
+
+struct rte_graph_feature_arc *
+rte_graph_feature_arc_lookup(const char *name)
+{
+	struct rte_graph_feature_arc *arc;
+
+	if (name == NULL)
+		return NULL;
+
+	graph_spinlock_lock();
+	arc = feature_arc_from_name(name);
+	graph_spinlock_unlock();
+
+	return arc;
+}
+
+int
+rte_graph_feature_arc_destroy(struct rte_graph_feature_arc *arc)
+{
+	if (arc == NULL)
+		return -EINVAL;
+
+	if (rte_graph_feature_arc_has_any(arc))
+		return -EBUSY;
+
+	graph_spinlock_lock();
+	STAILQ_REMOVE(&feature_arc_list, arc, rte_graph_feature_arc, next);
+	graph_spinlock_unlock();
+
+	rte_free(arc->data);
+	rte_free(arc->enabled);
+	rte_free(arc);
+
+	return 0;
+}
+
+uint8_t
+rte_graph_feature_lookup(const struct rte_graph_feature_arc *arc, const char *feature)
+{
+	rte_node_t id;
+	uint8_t i;
+
+	if (arc == NULL || feature == NULL)
+		return RTE_GRAPH_FEATURE_INVALID;
+
+	id = rte_node_from_name(feature);
+	for (i = 0; i < arc->nb_features; i++)
+		if (arc->features[i] == id)
+			return i;
+
+	return RTE_GRAPH_FEATURE_INVALID;
+}
+
+int
+rte_graph_feature_add(struct rte_graph_feature_arc *arc, const char *feature)
+{
+	rte_edge_t edges[RTE_GRAPH_FEATURE_MAX_PER_ARC + 1];
+	rte_node_t id;
+	uint8_t f, i;
+
+	if (arc == NULL || feature == NULL)
+		return -EINVAL;
+
+	id = rte_node_from_name(feature);
+	if (id == RTE_NODE_ID_INVALID || id == arc->start_node || id == arc->end_node)
+		return -EINVAL;
+
+	if (rte_graph_feature_lookup(arc, feature) != RTE_GRAPH_FEATURE_INVALID)
+		return -EEXIST;
+
+	/* The graphs already created would miss the edges to the feature */
+	if (feature_arc_in_use(arc))
+		return -EBUSY;
+
+	f = arc->nb_features;
+	if (f == RTE_GRAPH_FEATURE_MAX_PER_ARC)
+		return -ENOSPC;
+
+	/* Edges to the new feature from the start node and the previous features */
+	edges[f] = feature_arc_edge_get(arc->start_node, id);
+	for (i = 0; i < f; i++)
+		edges[i] = feature_arc_edge_get(arc->features[i], id);
+	for (i = 0; i <= f; i++)
+		if (edges[i] == RTE_EDGE_ID_INVALID)
+			return -EIO;
+
+	edges[RTE_GRAPH_FEATURE_MAX_PER_ARC] = feature_arc_edge_get(id, arc->end_node);
+	if (edges[RTE_GRAPH_FEATURE_MAX_PER_ARC] == RTE_EDGE_ID_INVALID)
+		return -EIO;
+
+	arc->start_edge[f] = edges[f];
+	for (i = 0; i < f; i++)
+		arc->edge[i][f] = edges[i];
+	arc->edge[f][RTE_GRAPH_FEATURE_MAX_PER_ARC] = edges[RTE_GRAPH_FEATURE_MAX_PER_ARC];
+	arc->features[f] = id;
+	arc->nb_features = f + 1;
+
+	return 0;
+}
+
+int
+rte_graph_feature_enable(struct rte_graph_feature_arc *arc, uint16_t index,
+			 const char *feature, uint32_t data)
+{
+	uint64_t bit, old;
+	uint8_t f;
+
+	if (arc == NULL || index >= arc->max_indexes)
+		return -EINVAL;
+
+	f = rte_graph_feature_lookup(arc, feature);
+	if (f == RTE_GRAPH_FEATURE_INVALID)
+		return -ENOENT;
+
+	bit = RTE_BIT64(f);
+	if (rte_atomic_load_explicit(&arc->enabled[index], rte_memory_order_relaxed) & bit)
+		return -EALREADY;
+
+	/* Data is visible to the workers before the feature */
+	arc->data[index * RTE_GRAPH_FEATURE_MAX_PER_ARC + f] = data;
+	old = rte_atomic_fetch_or_explicit(&arc->enabled[index], bit,
+					   rte_memory_order_release);
+	if (!(old & bit))
+		rte_atomic_fetch_add_explicit(&arc->nb_enabled, 1,
+					      rte_memory_order_relaxed);
+
+	return 0;
+}
+
+int
+rte_graph_feature_disable(struct rte_graph_feature_arc *arc, uint16_t index,
+			  const char *feature, struct rte_rcu_qsbr *qsbr)
+{
+	uint64_t bit, old;
+	uint8_t f;
+
+	if (arc == NULL || index >= arc->max_indexes)
+		return -EINVAL;
+
+	f = rte_graph_feature_lookup(arc, feature);
+	if (f == RTE_GRAPH_FEATURE_INVALID)
+		return -ENOENT;
+
+	bit = RTE_BIT64(f);
+	old = rte_atomic_fetch_and_explicit(&arc->enabled[index], ~bit,
+					    rte_memory_order_release);
+	if (!(old & bit))
+		return -EALREADY;
+
+	rte_atomic_fetch_sub_explicit(&arc->nb_enabled, 1, rte_memory_order_relaxed);
+
+	/* Wait for the objects in flight through the feature */
+	if (qsbr != NULL)
+		rte_rcu_qsbr_synchronize(qsbr, RTE_QSBR_THRID_INVALID);
+
+	return 0;
+}
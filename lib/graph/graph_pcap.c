@@ -5,11 +5,17 @@
 #include <errno.h>
 #include <pwd.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
+#include <rte_bpf.h>
 #include <rte_ethdev.h>
 #include <rte_mbuf.h>
 #include <rte_pcapng.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_ring.h>
+#include <rte_spinlock.h>
+#include <rte_thread.h>
 
 #include "rte_graph_worker.h"
 
@@ -19,12 +25,35 @@
 #define GRAPH_PCAP_NUM_PACKETS	1024
 #define GRAPH_PCAP_PKT_POOL	"graph_pcap_pkt_pool"
 #define GRAPH_PCAP_FILE_NAME	"dpdk_graph_pcap_capture_XXXXXX.pcapng"
+#define GRAPH_PCAP_RING_SIZE	1024
+#define GRAPH_PCAP_POOL_SIZE	8191
+#define GRAPH_PCAP_POOL_CACHE	RTE_GRAPH_BURST_SIZE
+#define GRAPH_PCAP_WRITER_SLEEP_US	100
 
 /* For multi-process, packets are captured in separate files. */
 static rte_pcapng_t *pcapng_fd;
 static bool pcap_enable;
+static RTE_ATOMIC(uint32_t) pcap_sample_rate;
+
+/* Capture filter, published to the workers as a whole */
+struct graph_pcap_filter {
+	struct rte_bpf *bpf;
+	struct rte_bpf_jit jit;
+};
+static RTE_ATOMIC(struct graph_pcap_filter *) pcap_filter;
 struct rte_mempool *pkt_mp;
 
+/* Rings of the graphs capturing packets, drained by the writer thread */
+static rte_spinlock_t pcap_lock = RTE_SPINLOCK_INITIALIZER;
+static struct rte_ring **pcap_rings;
+static unsigned int pcap_nb_rings;
+static unsigned int pcap_next_ring;
+/* Number of graphs sharing the pcap file, mempool and writer thread */
+static unsigned int pcap_refcnt;
+static rte_thread_t pcap_writer_tid;
+static bool pcap_writer_started;
+static RTE_ATOMIC(bool) pcap_writer_quit;
+
 void
 graph_pcap_enable(bool val)
 {
@@ -37,15 +66,125 @@ graph_pcap_is_enable(void)
 	return pcap_enable;
 }
 
+/*
+ * Write a batch of captured packets to the pcapng file, visiting the
+ * rings of the graphs round-robin. The packets are taken from the rings
+ * under the lock, so the rings can be removed meanwhile, and written
+ * without it.
+ */
+static unsigned int
+graph_pcap_write(void)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	unsigned int i, n = 0;
+
+	rte_spinlock_lock(&pcap_lock);
+	for (i = 0; i < pcap_nb_rings && n < RTE_DIM(mbufs); i++) {
+		pcap_next_ring = (pcap_next_ring + 1) % pcap_nb_rings;
+		n += rte_ring_sc_dequeue_burst(pcap_rings[pcap_next_ring],
+					       (void **)&mbufs[n],
+					       RTE_DIM(mbufs) - n, NULL);
+	}
+	rte_spinlock_unlock(&pcap_lock);
+
+	if (n == 0)
+		return 0;
+
+	rte_pcapng_write_packets(pcapng_fd, mbufs, n);
+	rte_pktmbuf_free_bulk(mbufs, n);
+
+	return n;
+}
+
+static uint32_t
+graph_pcap_writer(void *arg)
+{
+	RTE_SET_USED(arg);
+
+	while (!rte_atomic_load_explicit(&pcap_writer_quit, rte_memory_order_relaxed))
+		if (graph_pcap_write() == 0)
+			rte_delay_us_sleep(GRAPH_PCAP_WRITER_SLEEP_US);
+
+	return 0;
+}
+
+static int
+graph_pcap_writer_start(void)
+{
+	rte_atomic_store_explicit(&pcap_writer_quit, false, rte_memory_order_relaxed);
+	if (rte_thread_create_internal_control(&pcap_writer_tid, "graph-pcap",
+					       graph_pcap_writer, NULL) != 0) {
+		graph_err("Cannot create graph pcap writer thread.");
+		return -1;
+	}
+	pcap_writer_started = true;
+
+	return 0;
+}
+
+static void
+graph_pcap_writer_stop(void)
+{
+	if (!pcap_writer_started)
+		return;
+
+	rte_atomic_store_explicit(&pcap_writer_quit, true, rte_memory_order_relaxed);
+	rte_thread_join(pcap_writer_tid, NULL);
+	pcap_writer_started = false;
+}
+
+static void
+graph_pcap_ring_free(struct rte_graph *graph)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	unsigned int i, n;
+
+	if (graph->pcap_ring == NULL)
+		return;
+
+	/* Hide the ring from the writer */
+	rte_spinlock_lock(&pcap_lock);
+	for (i = 0; i < pcap_nb_rings; i++) {
+		if (pcap_rings[i] == graph->pcap_ring) {
+			pcap_rings[i] = pcap_rings[--pcap_nb_rings];
+			break;
+		}
+	}
+	rte_spinlock_unlock(&pcap_lock);
+
+	/* Packets not written yet are lost */
+	do {
+		n = rte_ring_sc_dequeue_burst(graph->pcap_ring, (void **)mbufs,
+					      RTE_DIM(mbufs), NULL);
+		rte_pktmbuf_free_bulk(mbufs, n);
+	} while (n != 0);
+
+	rte_ring_free(graph->pcap_ring);
+	graph->pcap_ring = NULL;
+}
+
 void
 graph_pcap_exit(struct rte_graph *graph)
 {
-	if (rte_eal_process_type() == RTE_PROC_PRIMARY)
-		rte_mempool_free(pkt_mp);
+	/* A graph with a ring holds a reference on the shared resources */
+	if (graph->pcap_ring != NULL && rte_eal_process_type() == RTE_PROC_PRIMARY) {
+		graph_pcap_ring_free(graph);
+		pcap_refcnt--;
+	}
 
-	if (pcapng_fd) {
-		rte_pcapng_close(pcapng_fd);
-		pcapng_fd = NULL;
+	/* The last graph stops the writer before freeing what it uses */
+	if (pcap_refcnt == 0) {
+		graph_pcap_writer_stop();
+
+		if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
+			rte_mempool_free(pkt_mp);
+			pkt_mp = NULL;
+		}
+
+		if (pcapng_fd) {
+			rte_pcapng_close(pcapng_fd);
+			pcapng_fd = NULL;
+		}
 	}
 
 	/* Disable pcap. */
@@ -144,9 +283,9 @@ graph_pcap_mp_init(void)
 	if (pkt_mp)
 		goto done;
 
-	/* Make a pool for cloned packets */
+	/* Make a pool for cloned packets, in flight in the writer rings */
 	pkt_mp = rte_pktmbuf_pool_create_by_ops(GRAPH_PCAP_PKT_POOL,
-			IOV_MAX + RTE_GRAPH_BURST_SIZE,	0, 0,
+			GRAPH_PCAP_POOL_SIZE, GRAPH_PCAP_POOL_CACHE, 0,
 			rte_pcapng_mbuf_size(RTE_MBUF_DEFAULT_BUF_SIZE),
 			SOCKET_ID_ANY, "ring_mp_mc");
 	if (pkt_mp == NULL) {
@@ -158,6 +297,39 @@ graph_pcap_mp_init(void)
 	return 0;
 }
 
+static int
+graph_pcap_ring_create(struct rte_graph *graph)
+{
+	char name[RTE_RING_NAMESIZE];
+	struct rte_ring **rings;
+
+	snprintf(name, sizeof(name), "graph_pcap_%u", graph->id);
+	/* Filled by the graph worker, drained by the pcap writer */
+	graph->pcap_ring = rte_ring_create(name, GRAPH_PCAP_RING_SIZE, graph->socket,
+					   RING_F_SP_ENQ | RING_F_SC_DEQ);
+	if (graph->pcap_ring == NULL) {
+		graph_err("Cannot create ring for graph %s pcap capture.", graph->name);
+		return -1;
+	}
+
+	/* Show the ring to the writer */
+	rte_spinlock_lock(&pcap_lock);
+	rings = realloc(pcap_rings, sizeof(*rings) * (pcap_nb_rings + 1));
+	if (rings != NULL) {
+		pcap_rings = rings;
+		pcap_rings[pcap_nb_rings++] = graph->pcap_ring;
+	}
+	rte_spinlock_unlock(&pcap_lock);
+	if (rings == NULL) {
+		graph_err("Cannot add graph %s pcap ring.", graph->name);
+		rte_ring_free(graph->pcap_ring);
+		graph->pcap_ring = NULL;
+		return -1;
+	}
+
+	return 0;
+}
+
 int
 graph_pcap_init(struct graph *graph)
 {
@@ -169,6 +341,13 @@ graph_pcap_init(struct graph *graph)
 	if (graph_pcap_mp_init() < 0)
 		goto error;
 
+	if (graph_pcap_ring_create(graph_data) < 0)
+		goto error;
+
+	/* The first graph starts the writer */
+	if (pcap_refcnt++ == 0 && graph_pcap_writer_start() < 0)
+		goto error;
+
 	/* User configured number of packets to capture. */
 	if (graph->num_pkt_to_capture)
 		graph_data->nb_pkt_to_capture = graph->num_pkt_to_capture;
@@ -188,47 +367,141 @@ graph_pcap_init(struct graph *graph)
 	return -1;
 }
 
+/* Select the objects to capture, return their number */
+static uint16_t
+graph_pcap_filter(struct rte_graph *graph, void **objs, uint16_t nb_objs,
+		  struct rte_mbuf **mbufs)
+{
+	const uint32_t rate = rte_atomic_load_explicit(&pcap_sample_rate,
+						      rte_memory_order_relaxed);
+	uint64_t rc[RTE_GRAPH_BURST_SIZE];
+	struct graph_pcap_filter *filter;
+	uint16_t i, n = 0;
+
+	if (rate <= 1) {
+		n = nb_objs;
+		memcpy(mbufs, objs, n * sizeof(void *));
+	} else {
+		/* Sample one out of rate objects over the graph */
+		for (i = 0; i < nb_objs; i++) {
+			if (++graph->pcap_sample_cnt < rate)
+				continue;
+			graph->pcap_sample_cnt = 0;
+			mbufs[n++] = objs[i];
+		}
+	}
+
+	if (n == 0)
+		return n;
+
+	filter = rte_atomic_load_explicit(&pcap_filter, rte_memory_order_acquire);
+	if (filter == NULL)
+		return n;
+
+	if (filter->jit.func != NULL) {
+		for (i = 0; i < n; i++)
+			rc[i] = filter->jit.func(mbufs[i]);
+	} else {
+		rte_bpf_exec_burst(filter->bpf, (void **)mbufs, rc, n);
+	}
+
+	for (i = 0, nb_objs = n, n = 0; i < nb_objs; i++)
+		if (rc[i] != 0)
+			mbufs[n++] = mbufs[i];
+
+	return n;
+}
+
 uint16_t
 graph_pcap_dispatch(struct rte_graph *graph,
 			      struct rte_node *node, void **objs,
 			      uint16_t nb_objs)
 {
-	struct rte_mbuf *mbuf_clones[RTE_GRAPH_BURST_SIZE];
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
 	char buffer[GRAPH_PCAP_BUF_SZ];
-	uint64_t i, num_packets;
-	struct rte_mbuf *mbuf;
-	ssize_t len;
+	uint64_t num_packets;
+	unsigned int i, n;
 
 	if (!nb_objs || (graph->nb_pkt_captured >= graph->nb_pkt_to_capture))
 		goto done;
 
-	num_packets = graph->nb_pkt_to_capture - graph->nb_pkt_captured;
 	/* nb_objs will never be greater than RTE_GRAPH_BURST_SIZE */
-	if (num_packets > nb_objs)
-		num_packets = nb_objs;
+	n = graph_pcap_filter(graph, objs, nb_objs, mbufs);
+	if (n == 0)
+		goto done;
+
+	num_packets = graph->nb_pkt_to_capture - graph->nb_pkt_captured;
+	if (num_packets < n)
+		n = num_packets;
 
 	snprintf(buffer, GRAPH_PCAP_BUF_SZ, "%s: %s", graph->name, node->name);
 
-	for (i = 0; i < num_packets; i++) {
+	/* Copies are written to the capture file by the pcap writer */
+	for (i = 0; i < n; i++) {
 		struct rte_mbuf *mc;
-		mbuf = (struct rte_mbuf *)objs[i];
 
-		mc = rte_pcapng_copy(mbuf->port, 0, mbuf, pkt_mp, mbuf->pkt_len,
-				     0, buffer);
+		mc = rte_pcapng_copy(mbufs[i]->port, 0, mbufs[i], pkt_mp,
+				     mbufs[i]->pkt_len, 0, buffer);
 		if (mc == NULL)
 			break;
 
-		mbuf_clones[i] = mc;
+		mbufs[i] = mc;
 	}
 
-	/* write it to capture file */
-	len = rte_pcapng_write_packets(pcapng_fd, mbuf_clones, i);
-	rte_pktmbuf_free_bulk(mbuf_clones, i);
-	if (len <= 0)
-		goto done;
+	n = rte_ring_sp_enqueue_burst(graph->pcap_ring, (void **)mbufs, i, NULL);
+	if (n < i) {
+		rte_pktmbuf_free_bulk(&mbufs[n], i - n);
+		graph->nb_pkt_dropped += i - n;
+	}
 
-	graph->nb_pkt_captured += i;
+	graph->nb_pkt_captured += n;
 
 done:
 	return node->original_process(graph, node, objs, nb_objs);
 }
+
+int
+rte_graph_pcap_sample_rate_set(uint32_t rate)
+{
+	rte_atomic_store_explicit(&pcap_sample_rate, rate, rte_memory_order_relaxed);
+
+	return 0;
+}
+
+int
+rte_graph_pcap_filter_set(const struct rte_bpf_prm *prm, struct rte_rcu_qsbr *qsbr)
+{
+	struct graph_pcap_filter *filter = NULL, *old;
+
+	if (prm != NULL) {
+		/* The filter runs on the captured mbuf */
+		if (prm->prog_arg.type != RTE_BPF_ARG_PTR_MBUF)
+			return -ENOTSUP;
+
+		filter = calloc(1, sizeof(*filter));
+		if (filter == NULL)
+			return -ENOMEM;
+
+		filter->bpf = rte_bpf_load(prm);
+		if (filter->bpf == NULL) {
+			free(filter);
+			return -rte_errno;
+		}
+
+		rte_bpf_get_jit(filter->bpf, &filter->jit);
+	}
+
+	old = rte_atomic_exchange_explicit(&pcap_filter, filter,
+					   rte_memory_order_acq_rel);
+	if (old == NULL)
+		return 0;
+
+	/* Wait for the workers to stop using the previous filter */
+	if (qsbr != NULL)
+		rte_rcu_qsbr_synchronize(qsbr, RTE_QSBR_THRID_INVALID);
+
+	rte_bpf_destroy(old->bpf);
+	free(old);
+
+	return 0;
+}
@@ -95,10 +95,11 @@ void graph_pcap_exit(struct rte_graph *graph);
 /**
  * @internal
  *
- * Capture mbuf metadata and node metadata to a pcap file.
+ * Capture mbuf metadata and node metadata for the pcap writer.
  *
  * When graph pcap trace enabled, this function is invoked prior to each node
- * and mbuf, node metadata is parsed and captured in a pcap file.
+ * and mbuf, node metadata of the sampled and filtered mbufs is copied to the
+ * graph pcap ring, which is written to a pcap file by the pcap writer.
  *
  * @param graph
  *   Pointer to the graph object.
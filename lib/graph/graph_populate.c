@@ -49,6 +49,14 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz += sizeof(uint64_t) * graph_node->node->xstats->nb_xstats;
 	}
 
+	graph->hist_start = 0;
+	if (graph_hist_is_enable()) {
+		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+		graph->hist_start = sz;
+		/* For 0..N node objects with histograms */
+		sz += sizeof(struct rte_node_hist) * graph->node_count;
+	}
+
 	graph->mem_sz = sz;
 	return sz;
 }
@@ -74,6 +82,7 @@ static void
 graph_nodes_populate(struct graph *_graph)
 {
 	rte_graph_off_t xstat_off = _graph->xstats_start;
+	rte_graph_off_t hist_off = _graph->hist_start;
 	rte_graph_off_t off = _graph->nodes_start;
 	struct rte_graph *graph = _graph->graph;
 	struct graph_node *graph_node;
@@ -81,9 +90,17 @@ graph_nodes_populate(struct graph *_graph)
 	const char *parent;
 	rte_node_t pid;
 
+	if (hist_off != 0)
+		memset(RTE_PTR_ADD(graph, hist_off), 0,
+		       sizeof(struct rte_node_hist) * _graph->node_count);
+
 	STAILQ_FOREACH(graph_node, &_graph->node_list, next) {
 		struct rte_node *node = RTE_PTR_ADD(graph, off);
 		memset(node, 0, sizeof(*node));
+		if (hist_off != 0) {
+			node->hist_off = hist_off - off;
+			hist_off += sizeof(struct rte_node_hist);
+		}
 		node->fence = RTE_GRAPH_FENCE;
 		node->off = off;
 		if (graph_pcap_is_enable()) {
@@ -100,6 +117,10 @@ graph_nodes_populate(struct graph *_graph)
 		node->id = graph_node->node->id;
 		node->parent_id = pid;
 		node->dispatch.lcore_id = graph_node->node->lcore_id;
+		node->dispatch.backpressure = graph_node->node->dispatch_backpressure;
+		node->dispatch.coalesce_objs = graph_node->node->dispatch_coalesce_objs;
+		node->dispatch.coalesce_cycles = graph_node->node->dispatch_coalesce_cycles;
+		node->steal.ordered = graph_node->node->steal_ordered;
 		nb_edges = graph_node->node->nb_edges;
 		node->nb_edges = nb_edges;
 		off += sizeof(struct rte_node);
@@ -55,6 +55,14 @@ struct node {
 	uint64_t flags;		      /**< Node configuration flag. */
 	unsigned int lcore_id;
 	/**< Node runs on the Lcore ID used for mcore dispatch model. */
+	bool dispatch_backpressure;
+	/**< Node waits for credits of the lcore, used for mcore dispatch model. */
+	uint16_t dispatch_coalesce_objs;
+	/**< Node objs held before scheduling, used for mcore dispatch model. */
+	uint64_t dispatch_coalesce_cycles;
+	/**< Node objs max hold time, used for mcore dispatch model. */
+	bool steal_ordered;
+	/**< Node streams are not published, used for work steal model. */
 	rte_node_process_t process;   /**< Node process function. */
 	rte_node_init_t init;         /**< Node init function. */
 	rte_node_fini_t fini;	      /**< Node fini function. */
@@ -77,6 +85,19 @@ struct __rte_cache_aligned graph_mcore_dispatch_wq_node {
 	void *objs[RTE_GRAPH_BURST_SIZE];
 };
 
+/**
+ * @internal
+ *
+ * Structure that holds a node stream published for stealing.
+ * Used for work steal model.
+ */
+struct __rte_cache_aligned graph_work_steal_batch {
+	struct rte_mempool *mp;
+	rte_graph_off_t node_off;
+	uint16_t nb_objs;
+	void *objs[RTE_GRAPH_BURST_SIZE];
+};
+
 /**
  * @internal
  *
@@ -105,6 +126,8 @@ struct graph {
 	/**< Node memory start offset in graph reel. */
 	rte_graph_off_t xstats_start;
 	/**< Node xstats memory start offset in graph reel. */
+	rte_graph_off_t hist_start;
+	/**< Node histograms memory start offset in graph reel, 0 if disabled. */
 	rte_node_t src_node_count;
 	/**< Number of source nodes in a graph. */
 	struct rte_graph *graph;
@@ -215,6 +238,16 @@ rte_spinlock_t *
 graph_spinlock_get(void);
 
 /* Lock functions */
+/**
+ * @internal
+ *
+ * Check if the node histograms are added to the new graphs.
+ *
+ * @return
+ *   True if the histograms are enabled.
+ */
+bool graph_hist_is_enable(void);
+
 /**
  * @internal
  *
@@ -448,4 +481,35 @@ int graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
  */
 void graph_sched_wq_destroy(struct graph *_graph);
 
+/**
+ * @internal
+ *
+ * Create the graph deque of published streams for work steal model,
+ * and add the graph to the steal group of its parent graph.
+ * All cloned graphs attached to the parent graph MUST be destroyed together.
+ *
+ * @param _graph
+ *   The graph object
+ * @param _parent_graph
+ *   The parent graph object which holds the steal group head.
+ * @param prm
+ *   Graph parameter, includes model-specific parameters in this graph.
+ *
+ * @return
+ *   - 0: Success.
+ *   - <0: Graph deque related error.
+ */
+int graph_steal_deque_create(struct graph *_graph, struct graph *_parent_graph,
+			     struct rte_graph_param *prm);
+
+/**
+ * @internal
+ *
+ * Destroy the graph deque of published streams for work steal model.
+ *
+ * @param _graph
+ *   The graph object
+ */
+void graph_steal_deque_destroy(struct graph *_graph);
+
 #endif /* _RTE_GRAPH_PRIVATE_H_ */
@@ -9,6 +9,7 @@
 #include <rte_common.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
+#include <rte_telemetry.h>
 
 #include "graph_private.h"
 
@@ -34,19 +35,27 @@ struct __rte_cache_aligned rte_graph_cluster_stats {
 	uint32_t cluster_node_size; /* Size of struct cluster_node */
 	rte_node_t max_nodes;
 	int socket_id;
-	bool dispatch;
+	uint8_t model;
 	void *cookie;
 	size_t sz;
+	rte_graph_t nb_graphs;
+	struct rte_graph **graphs; /* Graphs of the cluster, for pcap counters */
 
 	struct cluster_node clusters[];
 };
 
-#define boarder_model_dispatch()                                                              \
+#define boarder_model()                                                              \
 	fprintf(f, "+-------------------------------+---------------+--------" \
 		   "-------+---------------+---------------+---------------+" \
 		   "---------------+---------------+-" \
 		   "----------+\n")
 
+#define boarder_dispatch()                                                           \
+	fprintf(f, "+-------------------------------+---------------+--------" \
+		   "-------+---------------+---------------+---------------+" \
+		   "---------------+---------------+---------------+-" \
+		   "----------+\n")
+
 #define boarder()                                                              \
 	fprintf(f, "+-------------------------------+---------------+--------" \
 		   "-------+---------------+---------------+---------------+-" \
@@ -65,26 +74,40 @@ print_banner_default(FILE *f)
 static inline void
 print_banner_dispatch(FILE *f)
 {
-	boarder_model_dispatch();
+	boarder_dispatch();
+	fprintf(f, "%-32s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s\n",
+		"|Node", "|calls",
+		"|objs", "|sched objs", "|sched fail", "|sched stall",
+		"|realloc_count", "|objs/call", "|objs/sec(10E6)",
+		"|cycles/call|");
+	boarder_dispatch();
+}
+
+static inline void
+print_banner_work_steal(FILE *f)
+{
+	boarder_model();
 	fprintf(f, "%-32s%-16s%-16s%-16s%-16s%-16s%-16s%-16s%-16s\n",
 		"|Node", "|calls",
-		"|objs", "|sched objs", "|sched fail",
+		"|objs", "|publish objs", "|steal objs",
 		"|realloc_count", "|objs/call", "|objs/sec(10E6)",
 		"|cycles/call|");
-	boarder_model_dispatch();
+	boarder_model();
 }
 
 static inline void
-print_banner(FILE *f, bool dispatch)
+print_banner(FILE *f, uint8_t model)
 {
-	if (dispatch)
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
 		print_banner_dispatch(f);
+	else if (model == RTE_GRAPH_MODEL_WORK_STEAL)
+		print_banner_work_steal(f);
 	else
 		print_banner_default(f);
 }
 
 static inline void
-print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
 {
 	double objs_per_call, objs_per_sec, cycles_per_call, ts_per_hz;
 	const uint64_t prev_calls = stat->prev_calls;
@@ -104,13 +127,22 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 	objs_per_sec = ts_per_hz ? (objs - prev_objs) / ts_per_hz : 0;
 	objs_per_sec /= 1000000;
 
-	if (dispatch) {
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 		fprintf(f,
 			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
-			"|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
 			"|%-15.3f|%-15.6f|%-11.4f|\n",
 			stat->name, calls, objs, stat->dispatch.sched_objs,
-			stat->dispatch.sched_fail, stat->realloc_count, objs_per_call,
+			stat->dispatch.sched_fail, stat->sched_stall,
+			stat->realloc_count, objs_per_call,
+			objs_per_sec, cycles_per_call);
+	} else if (model == RTE_GRAPH_MODEL_WORK_STEAL) {
+		fprintf(f,
+			"|%-31s|%-15" PRIu64 "|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15" PRIu64 "|%-15" PRIu64
+			"|%-15.3f|%-15.6f|%-11.4f|\n",
+			stat->name, calls, objs, stat->steal.publish_objs,
+			stat->steal.steal_objs, stat->realloc_count, objs_per_call,
 			objs_per_sec, cycles_per_call);
 	} else {
 		fprintf(f,
@@ -122,11 +154,11 @@ print_node(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispat
 }
 
 static inline void
-print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, uint8_t model)
 {
 	int i;
 
-	if (dispatch) {
+	if (model != RTE_GRAPH_MODEL_RTC) {
 		for (i = 0; i < stat->xstat_cntrs; i++)
 			fprintf(f,
 				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
@@ -140,22 +172,45 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+static inline void
+print_hist(FILE *f, const struct rte_graph_cluster_node_stats *stat)
+{
+	fprintf(f, "|\t%-24s|p50 %-11" PRIu64 "|p99 %-11" PRIu64 "|p99.9 %-9" PRIu64 "|\n",
+		"cycles/call",
+		rte_graph_node_hist_percentile(stat->hist_cycles,
+					       RTE_GRAPH_HIST_CYCLES_BUCKETS, 50),
+		rte_graph_node_hist_percentile(stat->hist_cycles,
+					       RTE_GRAPH_HIST_CYCLES_BUCKETS, 99),
+		rte_graph_node_hist_percentile(stat->hist_cycles,
+					       RTE_GRAPH_HIST_CYCLES_BUCKETS, 99.9));
+	fprintf(f, "|\t%-24s|p50 %-11" PRIu64 "|p99 %-11" PRIu64 "|p99.9 %-9" PRIu64 "|\n",
+		"objs/call",
+		rte_graph_node_hist_percentile(stat->hist_objs,
+					       RTE_GRAPH_HIST_OBJS_BUCKETS, 50),
+		rte_graph_node_hist_percentile(stat->hist_objs,
+					       RTE_GRAPH_HIST_OBJS_BUCKETS, 99),
+		rte_graph_node_hist_percentile(stat->hist_objs,
+					       RTE_GRAPH_HIST_OBJS_BUCKETS, 99.9));
+}
+
 static int
-graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
+graph_cluster_stats_cb(uint8_t model, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
 {
 	FILE *f = cookie;
 
 	if (unlikely(is_first))
-		print_banner(f, dispatch);
+		print_banner(f, model);
 	if (stat->objs) {
-		print_node(f, stat, dispatch);
+		print_node(f, stat, model);
 		if (stat->xstat_cntrs)
-			print_xstat(f, stat, dispatch);
+			print_xstat(f, stat, model);
+		if (stat->hist_cycles != NULL)
+			print_hist(f, stat);
 	}
 	if (unlikely(is_last)) {
-		if (dispatch)
-			boarder_model_dispatch();
+		if (model != RTE_GRAPH_MODEL_RTC)
+			boarder_model();
 		else
 			boarder();
 	}
@@ -163,18 +218,41 @@ graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 	return 0;
 };
 
+static void
+print_pcap(FILE *f, struct rte_graph **graphs, rte_graph_t nb_graphs)
+{
+	rte_graph_t i;
+
+	for (i = 0; i < nb_graphs; i++) {
+		if (!graphs[i]->pcap_enable)
+			continue;
+		fprintf(f, "Graph %s pcap: captured %" PRIu64 ", dropped %" PRIu64 "\n",
+			graphs[i]->name, graphs[i]->nb_pkt_captured,
+			graphs[i]->nb_pkt_dropped);
+	}
+}
+
 static int
 graph_cluster_stats_cb_rtc(bool is_first, bool is_last, void *cookie,
 			   const struct rte_graph_cluster_node_stats *stat)
 {
-	return graph_cluster_stats_cb(false, is_first, is_last, cookie, stat);
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_RTC, is_first, is_last, cookie, stat);
 };
 
 static int
 graph_cluster_stats_cb_dispatch(bool is_first, bool is_last, void *cookie,
 				const struct rte_graph_cluster_node_stats *stat)
 {
-	return graph_cluster_stats_cb(true, is_first, is_last, cookie, stat);
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_MCORE_DISPATCH, is_first, is_last,
+				      cookie, stat);
+};
+
+static int
+graph_cluster_stats_cb_work_steal(bool is_first, bool is_last, void *cookie,
+				  const struct rte_graph_cluster_node_stats *stat)
+{
+	return graph_cluster_stats_cb(RTE_GRAPH_MODEL_WORK_STEAL, is_first, is_last,
+				      cookie, stat);
 };
 
 static struct rte_graph_cluster_stats *
@@ -193,6 +271,8 @@ stats_mem_init(struct cluster *cluster,
 		const struct rte_graph *graph = cluster->graphs[0]->graph;
 		if (graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
 			fn = graph_cluster_stats_cb_dispatch;
+		else if (graph->model == RTE_GRAPH_MODEL_WORK_STEAL)
+			fn = graph_cluster_stats_cb_work_steal;
 		else
 			fn = graph_cluster_stats_cb_rtc;
 	}
@@ -294,6 +374,23 @@ stats_mem_populate(struct rte_graph_cluster_stats **stats_in,
 		}
 	}
 
+	if (node->hist_off != 0) {
+		cluster->stat.hist_cycles = rte_zmalloc_socket(NULL,
+			sizeof(uint64_t) * RTE_GRAPH_HIST_CYCLES_BUCKETS,
+			RTE_CACHE_LINE_SIZE, stats->socket_id);
+		cluster->stat.hist_objs = rte_zmalloc_socket(NULL,
+			sizeof(uint64_t) * RTE_GRAPH_HIST_OBJS_BUCKETS,
+			RTE_CACHE_LINE_SIZE, stats->socket_id);
+		if (cluster->stat.hist_cycles == NULL || cluster->stat.hist_objs == NULL) {
+			rte_free(cluster->stat.hist_cycles);
+			rte_free(cluster->stat.hist_objs);
+			rte_free(cluster->stat.xstat_count);
+			rte_free(cluster->stat.xstat_desc);
+			SET_ERR_JMP(ENOMEM, free, "Failed to allocate memory node %s graph %s",
+				    graph_node->node->name, graph->name);
+		}
+	}
+
 	stats->sz += stats->cluster_node_size;
 	stats->max_nodes++;
 	*stats_in = stats;
@@ -418,8 +515,8 @@ rte_graph_cluster_stats_create(const struct rte_graph_cluster_stats_param *prm)
 			if (stats_mem_populate(&stats, graph_fp, graph_node))
 				goto realloc_fail;
 		}
-		if (graph->graph->model == RTE_GRAPH_MODEL_MCORE_DISPATCH)
-			stats->dispatch = true;
+		if (graph->graph->model != RTE_GRAPH_MODEL_RTC)
+			stats->model = graph->graph->model;
 	}
 
 	/* Finally copy to hugepage memory to avoid pressure on rte_realloc */
@@ -429,6 +526,18 @@ rte_graph_cluster_stats_create(const struct rte_graph_cluster_stats_param *prm)
 	else
 		SET_ERR_JMP(ENOMEM, realloc_fail, "rte_malloc failed");
 
+	/* Keep the graphs to report their pcap counters */
+	rc->graphs = rte_malloc_socket(NULL, sizeof(*rc->graphs) * cluster.nb_graphs,
+				       0, stats->socket_id);
+	if (rc->graphs == NULL) {
+		rte_free(rc);
+		rc = NULL;
+		SET_ERR_JMP(ENOMEM, realloc_fail, "rte_malloc failed");
+	}
+	for (i = 0; i < cluster.nb_graphs; i++)
+		rc->graphs[i] = cluster.graphs[i]->graph;
+	rc->nb_graphs = cluster.nb_graphs;
+
 realloc_fail:
 	stats_mem_fini(stats);
 bad_pattern:
@@ -450,30 +559,52 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 			rte_free(cluster->stat.xstat_count);
 			rte_free(cluster->stat.xstat_desc);
 		}
+		rte_free(cluster->stat.hist_cycles);
+		rte_free(cluster->stat.hist_objs);
 
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
+	rte_free(stat->graphs);
 	return rte_free(stat);
 }
 
 static inline void
-cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
+cluster_node_arregate_stats(struct cluster_node *cluster, uint8_t model)
 {
 	uint64_t calls = 0, cycles = 0, objs = 0, realloc_count = 0;
 	struct rte_graph_cluster_node_stats *stat = &cluster->stat;
-	uint64_t sched_objs = 0, sched_fail = 0;
+	uint64_t sched_objs = 0, sched_fail = 0, sched_stall = 0;
+	uint64_t publish_objs = 0, steal_objs = 0;
+	struct rte_node_hist *hist;
 	struct rte_node *node;
 	rte_node_t count;
 	uint64_t *xstat;
+	uint16_t b;
 	uint8_t i;
 
 	memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	if (stat->hist_cycles != NULL) {
+		memset(stat->hist_cycles, 0, sizeof(uint64_t) * RTE_GRAPH_HIST_CYCLES_BUCKETS);
+		memset(stat->hist_objs, 0, sizeof(uint64_t) * RTE_GRAPH_HIST_OBJS_BUCKETS);
+	}
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
-		if (dispatch) {
+		if (stat->hist_cycles != NULL && node->hist_off != 0) {
+			hist = RTE_PTR_ADD(node, node->hist_off);
+			for (b = 0; b < RTE_GRAPH_HIST_CYCLES_BUCKETS; b++)
+				stat->hist_cycles[b] += hist->cycles[b];
+			for (b = 0; b < RTE_GRAPH_HIST_OBJS_BUCKETS; b++)
+				stat->hist_objs[b] += hist->objs[b];
+		}
+
+		if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
+			sched_stall += node->dispatch.total_sched_stall;
+		} else if (model == RTE_GRAPH_MODEL_WORK_STEAL) {
+			publish_objs += node->steal.total_publish_objs;
+			steal_objs += node->steal.total_steal_objs;
 		}
 
 		calls += node->total_calls;
@@ -492,9 +623,13 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	stat->objs = objs;
 	stat->cycles = cycles;
 
-	if (dispatch) {
+	if (model == RTE_GRAPH_MODEL_MCORE_DISPATCH) {
 		stat->dispatch.sched_objs = sched_objs;
 		stat->dispatch.sched_fail = sched_fail;
+		stat->sched_stall = sched_stall;
+	} else if (model == RTE_GRAPH_MODEL_WORK_STEAL) {
+		stat->steal.publish_objs = publish_objs;
+		stat->steal.steal_objs = steal_objs;
 	}
 
 	stat->ts = rte_get_timer_cycles();
@@ -522,7 +657,7 @@ rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat, bool skip_cb)
 	cluster = stat->clusters;
 
 	for (count = 0; count < stat->max_nodes; count++) {
-		cluster_node_arregate_stats(cluster, stat->dispatch);
+		cluster_node_arregate_stats(cluster, stat->model);
 		if (!skip_cb)
 			rc = stat->fn(!count, (count == stat->max_nodes - 1),
 				      stat->cookie, &cluster->stat);
@@ -531,6 +666,12 @@ rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat, bool skip_cb)
 			break;
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
+
+	/* The default callbacks print to a file, complete with pcap counters */
+	if (!skip_cb && (stat->fn == graph_cluster_stats_cb_rtc ||
+			 stat->fn == graph_cluster_stats_cb_dispatch ||
+			 stat->fn == graph_cluster_stats_cb_work_steal))
+		print_pcap(stat->cookie, stat->graphs, stat->nb_graphs);
 }
 
 void
@@ -556,6 +697,148 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->realloc_count = 0;
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
+		if (node->hist_cycles != NULL) {
+			memset(node->hist_cycles, 0,
+			       sizeof(uint64_t) * RTE_GRAPH_HIST_CYCLES_BUCKETS);
+			memset(node->hist_objs, 0,
+			       sizeof(uint64_t) * RTE_GRAPH_HIST_OBJS_BUCKETS);
+		}
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 }
+
+/* Highest value of a histogram bucket */
+static uint64_t
+graph_hist_bucket_max(uint16_t bucket, uint16_t nb_buckets)
+{
+	const uint64_t sub = 1 << RTE_GRAPH_HIST_SUB_BITS;
+	unsigned int shift;
+
+	if (bucket == nb_buckets - 1)
+		return UINT64_MAX;
+	if (bucket < sub)
+		return bucket;
+
+	/* Lowest value of the next bucket minus one */
+	bucket++;
+	shift = (bucket >> RTE_GRAPH_HIST_SUB_BITS) - 1;
+	return ((sub + (bucket & (sub - 1))) << shift) - 1;
+}
+
+uint64_t
+rte_graph_node_hist_percentile(const uint64_t *hist, uint16_t nb_buckets,
+			       double percentile)
+{
+	uint64_t total = 0, sum = 0, rank;
+	double pos;
+	uint16_t i;
+
+	if (hist == NULL || nb_buckets == 0)
+		return 0;
+
+	for (i = 0; i < nb_buckets; i++)
+		total += hist[i];
+	if (total == 0)
+		return 0;
+
+	/* Rank of the value in the sorted calls, starting from 1 */
+	percentile = RTE_MIN(RTE_MAX(percentile, 0.0), 100.0);
+	pos = total * percentile / 100;
+	rank = (uint64_t)pos;
+	if (rank < pos || rank == 0)
+		rank++;
+	for (i = 0; i < nb_buckets; i++) {
+		sum += hist[i];
+		if (sum >= rank)
+			break;
+	}
+
+	return graph_hist_bucket_max(RTE_MIN(i, nb_buckets - 1), nb_buckets);
+}
+
+static int
+graph_handle_list(const char *cmd __rte_unused, const char *params __rte_unused,
+		  struct rte_tel_data *d)
+{
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_list_head_get(), next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+static int
+graph_handle_node_hist(const char *cmd __rte_unused, const char *params,
+		       struct rte_tel_data *d)
+{
+	struct rte_tel_data *node_data;
+	struct rte_node_hist *hist;
+	struct graph *graph;
+	struct rte_node *node;
+	rte_graph_off_t off;
+	rte_node_t count;
+	int rc = -EINVAL;
+
+	if (params == NULL || strlen(params) == 0)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_list_head_get(), next)
+		if (strncmp(graph->name, params, RTE_GRAPH_NAMESIZE) == 0)
+			break;
+	if (graph == NULL)
+		goto unlock;
+
+	rte_graph_foreach_node(count, off, graph->graph, node) {
+		if (node->hist_off == 0)
+			continue;
+		hist = RTE_PTR_ADD(node, node->hist_off);
+
+		node_data = rte_tel_data_alloc();
+		if (node_data == NULL) {
+			rc = -ENOMEM;
+			goto unlock;
+		}
+		rte_tel_data_start_dict(node_data);
+		rte_tel_data_add_dict_uint(node_data, "cycles_p50",
+			rte_graph_node_hist_percentile(hist->cycles,
+						       RTE_GRAPH_HIST_CYCLES_BUCKETS, 50));
+		rte_tel_data_add_dict_uint(node_data, "cycles_p99",
+			rte_graph_node_hist_percentile(hist->cycles,
+						       RTE_GRAPH_HIST_CYCLES_BUCKETS, 99));
+		rte_tel_data_add_dict_uint(node_data, "cycles_p99_9",
+			rte_graph_node_hist_percentile(hist->cycles,
+						       RTE_GRAPH_HIST_CYCLES_BUCKETS, 99.9));
+		rte_tel_data_add_dict_uint(node_data, "objs_p50",
+			rte_graph_node_hist_percentile(hist->objs,
+						       RTE_GRAPH_HIST_OBJS_BUCKETS, 50));
+		rte_tel_data_add_dict_uint(node_data, "objs_p99",
+			rte_graph_node_hist_percentile(hist->objs,
+						       RTE_GRAPH_HIST_OBJS_BUCKETS, 99));
+		rte_tel_data_add_dict_uint(node_data, "objs_p99_9",
+			rte_graph_node_hist_percentile(hist->objs,
+						       RTE_GRAPH_HIST_OBJS_BUCKETS, 99.9));
+		if (rte_tel_data_add_dict_container(d, node->name, node_data, 0) != 0)
+			rte_tel_data_free(node_data);
+	}
+	rc = 0;
+
+unlock:
+	graph_spinlock_unlock();
+	return rc;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/list", graph_handle_list,
+				   "Returns list of graph names.");
+	rte_telemetry_register_cmd("/graph/node_hist", graph_handle_node_hist,
+				   "Returns the node histograms percentiles of a graph. Parameters: graph_name");
+}
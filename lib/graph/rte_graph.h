@@ -22,6 +22,7 @@
 #include <stdio.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -36,6 +37,12 @@ extern "C" {
 #define RTE_EDGE_ID_INVALID UINT16_MAX   /**< Invalid edge id. */
 #define RTE_GRAPH_ID_INVALID UINT16_MAX  /**< Invalid graph id. */
 #define RTE_GRAPH_FENCE 0xdeadbeef12345678ULL /**< Graph fence data. */
+#define RTE_GRAPH_HIST_SUB_BITS 3
+/**< Node histogram buckets per power of two in log2, 12.5% precision. */
+#define RTE_GRAPH_HIST_CYCLES_BUCKETS 320
+/**< Number of buckets of cycles per call histogram, up to 2^40 cycles. */
+#define RTE_GRAPH_HIST_OBJS_BUCKETS 112
+/**< Number of buckets of objs per call histogram, up to 2^16 objs. */
 
 typedef uint32_t rte_graph_off_t;  /**< Graph offset type. */
 typedef uint32_t rte_node_t;       /**< Node id type. */
@@ -70,6 +77,8 @@ struct rte_node;  /**< Node object */
 struct rte_graph; /**< Graph object */
 struct rte_graph_cluster_stats;      /**< Stats for Cluster of graphs */
 struct rte_graph_cluster_node_stats; /**< Node stats within cluster of graphs */
+struct rte_bpf_prm;                  /**< BPF load parameters */
+struct rte_rcu_qsbr;                 /**< QSBR variable of the workers */
 
 /**
  * Node process function.
@@ -172,6 +181,10 @@ struct rte_graph_param {
 			uint32_t wq_size_max; /**< Maximum size of workqueue for dispatch model. */
 			uint32_t mp_capacity; /**< Capacity of memory pool for dispatch model. */
 		} dispatch;
+		struct {
+			uint32_t deque_size_max; /**< Maximum size of deque for work steal model. */
+			uint16_t batch_size; /**< Number of objs per published stream. */
+		} steal;
 	};
 };
 
@@ -219,6 +232,12 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 			uint64_t sched_fail;
 			/**< Previous number of failed schedule objs for dispatch model. */
 		} dispatch;
+		struct {
+			uint64_t publish_objs;
+			/**< Previous number of published objs for work steal model. */
+			uint64_t steal_objs;
+			/**< Previous number of stolen objs for work steal model. */
+		} steal;
 	};
 
 	uint64_t realloc_count; /**< Realloc count. */
@@ -230,6 +249,13 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 	rte_node_t id;	/**< Node identifier of stats. */
 	uint64_t hz;	/**< Cycles per seconds. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
+
+	uint64_t *hist_cycles;
+	/**< Cycles per call histogram, NULL if histograms are disabled. */
+	uint64_t *hist_objs;
+	/**< Objs per call histogram, NULL if histograms are disabled. */
+	uint64_t sched_stall;
+	/**< Number of objs waiting for credits for dispatch model. */
 };
 
 /**
@@ -237,6 +263,12 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
  *
  * Create memory reel, detect loops and find isolated nodes.
  *
+ * When pcap trace is enabled in the parameters, the graph workers only
+ * enqueue the captured packets to a ring of the graph, the capture file is
+ * written by a control thread of the library. The packets the ring cannot
+ * take are counted as dropped, see rte_graph_obj_dump() and the cluster
+ * stats.
+ *
  * @param name
  *   Unique name for this graph.
  * @param prm
@@ -465,6 +497,83 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
  */
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable the per node histograms of cycles per call and objs per call.
+ *
+ * The histograms are allocated in the memory of the graphs created or cloned
+ * after this call, and updated by the graph walk when the stats feature
+ * is enabled (RTE_LIBRTE_GRAPH_STATS).
+ *
+ * @param enable
+ *   True to add the histograms to the next graphs, false otherwise.
+ */
+__rte_experimental
+void rte_graph_node_hist_enable(bool enable);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get a percentile of a node histogram.
+ *
+ * @param hist
+ *   Histogram from struct rte_graph_cluster_node_stats.
+ * @param nb_buckets
+ *   Number of buckets of the histogram.
+ * @param percentile
+ *   Percentile to get, between 0 and 100 (e.g. 99.9).
+ *
+ * @return
+ *   Highest value of the bucket holding the percentile, 0 if the histogram
+ *   is empty.
+ */
+__rte_experimental
+uint64_t rte_graph_node_hist_percentile(const uint64_t *hist, uint16_t nb_buckets,
+					double percentile);
+
+/**
+ * Set the pcap trace sampling rate.
+ *
+ * Only one packet out of the given number of packets reaching the nodes
+ * of a graph is captured. The sampling applies before the pcap filter.
+ *
+ * @param rate
+ *   Sampling rate, 0 or 1 to capture all the packets.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_pcap_sample_rate_set(uint32_t rate);
+
+/**
+ * Set the pcap trace filter.
+ *
+ * The BPF program is run on the worker for each sampled packet,
+ * only the packets for which it returns non-zero are captured.
+ *
+ * The new filter is published atomically to the workers. The previous
+ * filter is released once all the workers registered to the given QSBR
+ * variable went through a quiescent state. Without QSBR variable, the
+ * function must not be called while the graphs are walked.
+ *
+ * @param prm
+ *   BPF load parameters, the program argument must be of type
+ *   RTE_BPF_ARG_PTR_MBUF, e.g. as returned by rte_bpf_convert().
+ *   NULL to remove the filter.
+ * @param qsbr
+ *   QSBR variable of the graph workers, NULL if no graph is walked.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_pcap_filter_set(const struct rte_bpf_prm *prm,
+			      struct rte_rcu_qsbr *qsbr);
+
 /**
  * Structure defines the number of xstats a given node has and each xstat
  * description.
@@ -0,0 +1,320 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_GRAPH_FEATURE_ARC_H_
+#define _RTE_GRAPH_FEATURE_ARC_H_
+
+/**
+ * @file rte_graph_feature_arc.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * Graph feature arc APIs.
+ *
+ * A feature arc is an ordered sequence of feature nodes inserted between
+ * two fixed nodes of a graph, the start node and the end node.
+ * By default, the start node sends the objects to the end node.
+ * Each feature of the arc can be enabled or disabled at runtime for each
+ * index of the arc, typically an interface, without recreating the graphs.
+ * An object of a given index goes through the enabled features of that index
+ * in the order the features were added to the arc, then to the end node.
+ *
+ * The features must be added to the arc before creating the graphs which
+ * contain the start node, so that the graphs have the edges to the features.
+ *
+ * In fast path, the start node calls rte_graph_feature_arc_first() and each
+ * feature node calls rte_graph_feature_arc_next() to get the next edge
+ * of an object. When no feature is enabled on the arc, the start node can
+ * skip the per object lookup with rte_graph_feature_arc_has_any().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/queue.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_stdatomic.h>
+
+#include "rte_graph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_GRAPH_FEATURE_ARC_NAMELEN RTE_NODE_NAMESIZE
+/**< Max length of feature arc name. */
+#define RTE_GRAPH_FEATURE_MAX_PER_ARC 64
+/**< Max number of features in an arc. */
+#define RTE_GRAPH_FEATURE_INVALID UINT8_MAX
+/**< Invalid feature id, the object goes to the end node. */
+
+struct rte_rcu_qsbr;
+
+/**
+ * Feature arc object.
+ *
+ * The fast path area is read by the workers, the rest of the object
+ * must be updated with the feature arc APIs only.
+ */
+struct __rte_cache_aligned rte_graph_feature_arc {
+	/* Fast path area. */
+	RTE_ATOMIC(uint32_t) nb_enabled;
+	/**< Number of enabled features over all the indexes. */
+	uint16_t max_indexes;  /**< Number of indexes of the arc. */
+	uint8_t nb_features;   /**< Number of features in the arc. */
+	rte_edge_t end_edge;   /**< Edge from start node to end node. */
+	RTE_ATOMIC(uint64_t) *enabled; /**< Bitmask of enabled features per index. */
+	uint32_t *data;        /**< Feature data per index. */
+	rte_edge_t start_edge[RTE_GRAPH_FEATURE_MAX_PER_ARC];
+	/**< Edge from start node to each feature. */
+	rte_edge_t edge[RTE_GRAPH_FEATURE_MAX_PER_ARC][RTE_GRAPH_FEATURE_MAX_PER_ARC + 1];
+	/**< Edge from a feature to the next features, the last one is to the end node. */
+
+	/* Slow path area. */
+	STAILQ_ENTRY(rte_graph_feature_arc) next; /**< Next arc in the list. */
+	char name[RTE_GRAPH_FEATURE_ARC_NAMELEN]; /**< Name of the arc. */
+	rte_node_t start_node; /**< Start node id. */
+	rte_node_t end_node;   /**< End node id. */
+	rte_node_t features[RTE_GRAPH_FEATURE_MAX_PER_ARC]; /**< Feature node ids. */
+};
+
+/**
+ * Create a feature arc between two nodes.
+ *
+ * The edge from the start node to the end node is added if it does not exist.
+ *
+ * @param name
+ *   Name of the feature arc.
+ * @param start_node
+ *   Name of the node which sends the objects to the arc.
+ * @param end_node
+ *   Name of the node which receives the objects at the end of the arc.
+ * @param max_indexes
+ *   Number of indexes (e.g. interfaces) for which features can be enabled.
+ * @param socket_id
+ *   Socket id where memory is allocated.
+ *
+ * @return
+ *   Valid feature arc on success, NULL otherwise and rte_errno is set.
+ */
+__rte_experimental
+struct rte_graph_feature_arc *
+rte_graph_feature_arc_create(const char *name, const char *start_node,
+			     const char *end_node, uint16_t max_indexes,
+			     int socket_id);
+
+/**
+ * Lookup a feature arc by name.
+ *
+ * @param name
+ *   Name of the feature arc.
+ *
+ * @return
+ *   Valid feature arc on success, NULL otherwise.
+ */
+__rte_experimental
+struct rte_graph_feature_arc *rte_graph_feature_arc_lookup(const char *name);
+
+/**
+ * Destroy a feature arc.
+ *
+ * The edges added to the nodes are kept.
+ *
+ * @param arc
+ *   Feature arc object.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_feature_arc_destroy(struct rte_graph_feature_arc *arc);
+
+/**
+ * Add a feature node at the end of the feature arc.
+ *
+ * The edges from the start node and from the features already in the arc
+ * to the new feature, and from the new feature to the end node, are added.
+ * The features run in the order they are added.
+ * The features cannot be added once a graph containing the start node
+ * of the arc is created.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param feature
+ *   Name of the feature node.
+ *
+ * @return
+ *   0 on success, -EBUSY if a graph containing the start node exists,
+ *   error otherwise.
+ */
+__rte_experimental
+int rte_graph_feature_add(struct rte_graph_feature_arc *arc, const char *feature);
+
+/**
+ * Get the id of a feature in the arc.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param feature
+ *   Name of the feature node.
+ *
+ * @return
+ *   Feature id on success, RTE_GRAPH_FEATURE_INVALID otherwise.
+ */
+__rte_experimental
+uint8_t rte_graph_feature_lookup(const struct rte_graph_feature_arc *arc,
+				 const char *feature);
+
+/**
+ * Enable a feature for an index of the arc.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param index
+ *   Index of the arc.
+ * @param feature
+ *   Name of the feature node.
+ * @param data
+ *   Feature data for the index, see rte_graph_feature_data_get().
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_feature_enable(struct rte_graph_feature_arc *arc, uint16_t index,
+			     const char *feature, uint32_t data);
+
+/**
+ * Disable a feature for an index of the arc.
+ *
+ * When a QSBR variable is given, the function returns once all the workers
+ * registered to it went through a quiescent state, so no object of the index
+ * is in the feature anymore and the feature resources can be released.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param index
+ *   Index of the arc.
+ * @param feature
+ *   Name of the feature node.
+ * @param qsbr
+ *   QSBR variable of the graph workers, NULL to return without waiting.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_feature_disable(struct rte_graph_feature_arc *arc, uint16_t index,
+			      const char *feature, struct rte_rcu_qsbr *qsbr);
+
+/**
+ * Check if any feature is enabled on the arc.
+ *
+ * @param arc
+ *   Feature arc object.
+ *
+ * @return
+ *   True if at least one feature is enabled for an index of the arc.
+ */
+__rte_experimental
+static __rte_always_inline bool
+rte_graph_feature_arc_has_any(const struct rte_graph_feature_arc *arc)
+{
+	return rte_atomic_load_explicit(&arc->nb_enabled, rte_memory_order_relaxed) != 0;
+}
+
+/**
+ * Get the edge from the start node for an object of the given index.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param index
+ *   Index of the object.
+ * @param[out] feature
+ *   Id of the first enabled feature, RTE_GRAPH_FEATURE_INVALID if none.
+ *
+ * @return
+ *   Edge to the first enabled feature, or to the end node.
+ */
+__rte_experimental
+static __rte_always_inline rte_edge_t
+rte_graph_feature_arc_first(const struct rte_graph_feature_arc *arc, uint16_t index,
+			    uint8_t *feature)
+{
+	uint64_t mask;
+
+	mask = rte_atomic_load_explicit(&arc->enabled[index], rte_memory_order_acquire);
+	if (likely(mask == 0)) {
+		*feature = RTE_GRAPH_FEATURE_INVALID;
+		return arc->end_edge;
+	}
+
+	*feature = rte_ctz64(mask);
+	return arc->start_edge[*feature];
+}
+
+/**
+ * Get the edge from a feature node for an object of the given index.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param index
+ *   Index of the object.
+ * @param feature
+ *   Id of the current feature.
+ * @param[out] next
+ *   Id of the next enabled feature, RTE_GRAPH_FEATURE_INVALID if none.
+ *
+ * @return
+ *   Edge to the next enabled feature, or to the end node.
+ */
+__rte_experimental
+static __rte_always_inline rte_edge_t
+rte_graph_feature_arc_next(const struct rte_graph_feature_arc *arc, uint16_t index,
+			   uint8_t feature, uint8_t *next)
+{
+	uint64_t mask;
+
+	mask = rte_atomic_load_explicit(&arc->enabled[index], rte_memory_order_acquire);
+	/* Only the features after the current one */
+	mask &= ~((UINT64_C(2) << feature) - 1);
+	if (mask == 0) {
+		*next = RTE_GRAPH_FEATURE_INVALID;
+		return arc->edge[feature][RTE_GRAPH_FEATURE_MAX_PER_ARC];
+	}
+
+	*next = rte_ctz64(mask);
+	return arc->edge[feature][*next];
+}
+
+/**
+ * Get the data of a feature for an index.
+ *
+ * @param arc
+ *   Feature arc object.
+ * @param index
+ *   Index of the object.
+ * @param feature
+ *   Id of the feature.
+ *
+ * @return
+ *   Data given when enabling the feature.
+ */
+__rte_experimental
+static __rte_always_inline uint32_t
+rte_graph_feature_data_get(const struct rte_graph_feature_arc *arc, uint16_t index,
+			   uint8_t feature)
+{
+	return arc->data[index * RTE_GRAPH_FEATURE_MAX_PER_ARC + feature];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_GRAPH_FEATURE_ARC_H_ */
@@ -2,6 +2,8 @@
  * Copyright(C) 2023 Intel Corporation
  */
 
+#include <rte_malloc.h>
+
 #include "graph_private.h"
 #include "rte_graph_model_mcore_dispatch.h"
 
@@ -41,6 +43,15 @@ graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
 		SET_ERR_JMP(EIO, fail_mp,
 			    "Failed to allocate graph WQ schedule entry");
 
+	graph->dispatch.deferred = rte_malloc_socket(graph->name,
+						     graph->nb_nodes * sizeof(rte_graph_off_t),
+						     0, graph->socket);
+	if (graph->dispatch.deferred == NULL)
+		SET_ERR_JMP(ENOMEM, fail_deferred,
+			    "Failed to allocate graph deferred nodes");
+	graph->dispatch.nb_deferred = 0;
+	graph->dispatch.stall = false;
+
 	graph->dispatch.lcore_id = _graph->lcore_id;
 
 	if (parent_graph->dispatch.rq == NULL) {
@@ -53,6 +64,9 @@ graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
 
 	return 0;
 
+fail_deferred:
+	rte_mempool_free(graph->dispatch.mp);
+	graph->dispatch.mp = NULL;
 fail_mp:
 	rte_ring_free(graph->dispatch.wq);
 	graph->dispatch.wq = NULL;
@@ -73,6 +87,9 @@ graph_sched_wq_destroy(struct graph *_graph)
 
 	rte_mempool_free(graph->dispatch.mp);
 	graph->dispatch.mp = NULL;
+
+	rte_free(graph->dispatch.deferred);
+	graph->dispatch.deferred = NULL;
 }
 
 static __rte_always_inline bool
@@ -108,23 +125,70 @@ __graph_sched_node_enqueue(struct rte_node *node, struct rte_graph *graph)
 		memmove(&node->objs[0], &node->objs[off],
 			node->idx * sizeof(void *));
 
-	node->dispatch.total_sched_fail += node->idx;
-
 	return false;
 }
 
+/* Keep the node objs, the node is scheduled again on the next walk */
+static __rte_always_inline void
+__graph_sched_node_defer(struct rte_node *node, struct rte_graph *graph)
+{
+	graph->dispatch.deferred[graph->dispatch.nb_deferred++] = node->off;
+}
+
+/* Hold the node objs until enough of them are there or for too long */
+static __rte_always_inline bool
+__graph_sched_node_hold(struct rte_node *node)
+{
+	uint64_t now;
+
+	if (node->idx >= node->dispatch.coalesce_objs)
+		return false;
+
+	now = rte_rdtsc();
+	if (node->dispatch.hold_tsc == 0)
+		node->dispatch.hold_tsc = now;
+
+	return now - node->dispatch.hold_tsc < node->dispatch.coalesce_cycles;
+}
+
 bool __rte_noinline
 __rte_graph_mcore_dispatch_sched_node_enqueue(struct rte_node *node,
 					      struct rte_graph_rq_head *rq)
 {
+	/* The node is in the memory of the graph walking it */
+	struct rte_graph *src = RTE_PTR_SUB(node, node->off);
 	const unsigned int lcore_id = node->dispatch.lcore_id;
 	struct rte_graph *graph;
 
+	if (node->dispatch.coalesce_objs != 0 && src->dispatch.deferred != NULL) {
+		if (__graph_sched_node_hold(node)) {
+			__graph_sched_node_defer(node, src);
+			return true;
+		}
+		node->dispatch.hold_tsc = 0;
+	}
+
 	SLIST_FOREACH(graph, rq, next)
 		if (graph->dispatch.lcore_id == lcore_id)
 			break;
 
-	return graph != NULL ? __graph_sched_node_enqueue(node, graph) : false;
+	if (graph == NULL)
+		return false;
+
+	if (__graph_sched_node_enqueue(node, graph))
+		return true;
+
+	/* No more credits, i.e. free work queue entries, on the lcore */
+	if (node->dispatch.backpressure && src->dispatch.deferred != NULL) {
+		node->dispatch.total_sched_stall += node->idx;
+		src->dispatch.stall = true;
+		__graph_sched_node_defer(node, src);
+		return true;
+	}
+
+	node->dispatch.total_sched_fail += node->idx;
+
+	return false;
 }
 
 void
@@ -189,3 +253,53 @@ rte_graph_model_mcore_dispatch_node_lcore_affinity_set(const char *name, unsigne
 
 	return ret;
 }
+
+int
+rte_graph_model_mcore_dispatch_node_backpressure_set(const char *name, bool enable)
+{
+	struct node *node;
+	int ret = -EINVAL;
+
+	if (name == NULL)
+		return ret;
+
+	graph_spinlock_lock();
+
+	STAILQ_FOREACH(node, node_list_head_get(), next) {
+		if (strncmp(node->name, name, RTE_NODE_NAMESIZE) == 0) {
+			node->dispatch_backpressure = enable;
+			ret = 0;
+			break;
+		}
+	}
+
+	graph_spinlock_unlock();
+
+	return ret;
+}
+
+int
+rte_graph_model_mcore_dispatch_node_coalesce_set(const char *name, uint16_t nb_objs,
+						 uint64_t cycles)
+{
+	struct node *node;
+	int ret = -EINVAL;
+
+	if (name == NULL)
+		return ret;
+
+	graph_spinlock_lock();
+
+	STAILQ_FOREACH(node, node_list_head_get(), next) {
+		if (strncmp(node->name, name, RTE_NODE_NAMESIZE) == 0) {
+			node->dispatch_coalesce_objs = nb_objs;
+			node->dispatch_coalesce_cycles = cycles;
+			ret = 0;
+			break;
+		}
+	}
+
+	graph_spinlock_unlock();
+
+	return ret;
+}
@@ -76,6 +76,56 @@ void __rte_graph_mcore_dispatch_sched_wq_process(struct rte_graph *graph);
 int rte_graph_model_mcore_dispatch_node_lcore_affinity_set(const char *name,
 							   unsigned int lcore_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the backpressure of the node used for mcore dispatch model.
+ *
+ * The entries of the work queue of a graph are the credits of the graphs
+ * scheduling streams to it. By default, when the lcore of the node has
+ * no credit left, the node runs on the current lcore and the objects are
+ * counted as sched fail. With backpressure, the objects stay in the node,
+ * counted as sched stall, and are scheduled again on the next walk, while
+ * the source nodes of the current graph are not run.
+ *
+ * @param name
+ *   Valid node name. In the case of the cloned node, the name will be
+ * "parent node name" + "-" + name.
+ * @param enable
+ *   Enable or disable backpressure.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_model_mcore_dispatch_node_backpressure_set(const char *name, bool enable);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the coalescing of the node streams used for mcore dispatch model.
+ *
+ * The objects of the node are held on the current lcore until there are
+ * at least nb_objs of them or the first one was held for cycles,
+ * then scheduled together to the lcore of the node.
+ *
+ * @param name
+ *   Valid node name. In the case of the cloned node, the name will be
+ * "parent node name" + "-" + name.
+ * @param nb_objs
+ *   Number of objects to schedule at once, 0 to disable coalescing.
+ * @param cycles
+ *   Max number of TSC cycles to hold objects.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_model_mcore_dispatch_node_coalesce_set(const char *name, uint16_t nb_objs,
+						     uint64_t cycles);
+
 /**
  * Perform graph walk on the circular buffer and invoke the process function
  * of the nodes and collect the stats.
@@ -90,12 +140,24 @@ rte_graph_walk_mcore_dispatch(struct rte_graph *graph)
 {
 	const rte_graph_off_t *cir_start = graph->cir_start;
 	const rte_node_t mask = graph->cir_mask;
+	const bool stall = graph->dispatch.stall;
 	uint32_t head = graph->head;
 	struct rte_node *node;
+	uint32_t i;
 
 	if (graph->dispatch.wq != NULL)
 		__rte_graph_mcore_dispatch_sched_wq_process(graph);
 
+	/* Schedule again the nodes held or waiting for credits */
+	if (unlikely(graph->dispatch.nb_deferred != 0)) {
+		for (i = 0; i < graph->dispatch.nb_deferred; i++) {
+			node = RTE_PTR_ADD(graph, graph->dispatch.deferred[i]);
+			__rte_node_enqueue_tail_update(graph, node);
+		}
+		graph->dispatch.nb_deferred = 0;
+		graph->dispatch.stall = false;
+	}
+
 	while (likely(head != graph->tail)) {
 		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
 
@@ -103,6 +165,10 @@ rte_graph_walk_mcore_dispatch(struct rte_graph *graph)
 		if ((int32_t)head < 1 && node->dispatch.lcore_id != graph->dispatch.lcore_id)
 			continue;
 
+		/* skip the src nodes while a node waits for credits */
+		if ((int32_t)head < 1 && unlikely(stall))
+			continue;
+
 		/* Schedule the node until all task/objs are done */
 		if (node->dispatch.lcore_id != RTE_MAX_LCORE &&
 		    graph->dispatch.lcore_id != node->dispatch.lcore_id &&
@@ -0,0 +1,236 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include "graph_private.h"
+#include "rte_graph_model_work_steal.h"
+
+/* Max number of streams taken from a deque at a time */
+#define STEAL_BURST_SZ 8
+
+int
+graph_steal_deque_create(struct graph *_graph, struct graph *_parent_graph,
+			 struct rte_graph_param *prm)
+{
+	struct rte_graph *parent_graph = _parent_graph->graph;
+	struct rte_graph *graph = _graph->graph;
+	unsigned int flags = RING_F_SP_ENQ;
+	unsigned int deque_size;
+
+	deque_size = RTE_GRAPH_STEAL_DEQUE_SIZE(graph->nb_nodes);
+	deque_size = rte_align32pow2(deque_size + 1);
+
+	if (prm->steal.deque_size_max > 0)
+		deque_size = deque_size <= prm->steal.deque_size_max ? deque_size :
+			prm->steal.deque_size_max;
+
+	if (!rte_is_power_of_2(deque_size))
+		flags |= RING_F_EXACT_SZ;
+
+	graph->steal.deque = rte_ring_create(graph->name, deque_size, graph->socket,
+					     flags);
+	if (graph->steal.deque == NULL)
+		SET_ERR_JMP(EIO, fail, "Failed to allocate graph deque");
+
+	/* Streams are taken by the owner graph only and put back by any graph */
+	graph->steal.mp = rte_mempool_create(graph->name, deque_size,
+					     sizeof(struct graph_work_steal_batch),
+					     0, 0, NULL, NULL, NULL, NULL,
+					     graph->socket, MEMPOOL_F_SC_GET);
+	if (graph->steal.mp == NULL)
+		SET_ERR_JMP(EIO, fail_mp, "Failed to allocate graph deque entry");
+
+	graph->steal.batch_size = prm->steal.batch_size > 0 ?
+		prm->steal.batch_size : RTE_GRAPH_STEAL_BATCH_SIZE;
+	graph->steal.batch_size = RTE_MIN(graph->steal.batch_size,
+					  RTE_GRAPH_BURST_SIZE);
+	graph->steal.idle = false;
+
+	if (parent_graph->steal.rq == NULL) {
+		parent_graph->steal.rq = &parent_graph->steal.rq_head;
+		SLIST_INIT(parent_graph->steal.rq);
+		rte_atomic_store_explicit(&parent_graph->steal.idle_count, 0,
+					  rte_memory_order_relaxed);
+	}
+
+	graph->steal.nb_idle = &parent_graph->steal.idle_count;
+	graph->steal.victim = SLIST_FIRST(parent_graph->steal.rq);
+	graph->steal.rq = parent_graph->steal.rq;
+	SLIST_INSERT_HEAD(graph->steal.rq, graph, next);
+	if (graph->steal.victim == NULL)
+		graph->steal.victim = graph;
+
+	return 0;
+
+fail_mp:
+	rte_ring_free(graph->steal.deque);
+	graph->steal.deque = NULL;
+fail:
+	return -rte_errno;
+}
+
+void
+graph_steal_deque_destroy(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+
+	if (graph == NULL)
+		return;
+
+	rte_ring_free(graph->steal.deque);
+	graph->steal.deque = NULL;
+
+	rte_mempool_free(graph->steal.mp);
+	graph->steal.mp = NULL;
+}
+
+void __rte_noinline
+__rte_graph_work_steal_publish(struct rte_graph *graph, struct rte_node *node)
+{
+	const uint16_t batch_size = graph->steal.batch_size;
+	struct graph_work_steal_batch *batch;
+	uint16_t off = batch_size;
+	uint16_t size;
+
+	/* The first batch stays local, the graph keeps working on it */
+	while (off < node->idx) {
+		if (rte_mempool_get(graph->steal.mp, (void **)&batch) < 0)
+			break;
+
+		size = RTE_MIN(node->idx - off, batch_size);
+		batch->mp = graph->steal.mp;
+		batch->node_off = node->off;
+		batch->nb_objs = size;
+		rte_memcpy(batch->objs, &node->objs[off], size * sizeof(void *));
+
+		if (rte_ring_sp_enqueue_bulk_elem(graph->steal.deque, (void *)&batch,
+						  sizeof(batch), 1, NULL) == 0) {
+			rte_mempool_put(graph->steal.mp, batch);
+			break;
+		}
+
+		off += size;
+		node->steal.total_publish_objs += size;
+	}
+
+	/* Objects which could not be published are processed locally */
+	if (off != batch_size && off < node->idx)
+		memmove(&node->objs[batch_size], &node->objs[off],
+			(node->idx - off) * sizeof(void *));
+
+	node->idx -= off - batch_size;
+}
+
+static void
+graph_steal_batch_process(struct rte_graph *graph,
+			  struct graph_work_steal_batch *batch, bool stolen)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const rte_node_t mask = graph->cir_mask;
+	struct rte_node *node;
+	uint32_t head = 0;
+
+	/* Cloned graphs share the layout, the offset is valid in any of them */
+	node = RTE_PTR_ADD(graph, batch->node_off);
+	RTE_ASSERT(node->fence == RTE_GRAPH_FENCE);
+	RTE_ASSERT(node->idx == 0);
+
+	if (unlikely(node->size < batch->nb_objs))
+		__rte_node_stream_alloc_size(graph, node, batch->nb_objs);
+
+	rte_memcpy(node->objs, batch->objs, batch->nb_objs * sizeof(void *));
+	node->idx = batch->nb_objs;
+	if (stolen)
+		node->steal.total_steal_objs += batch->nb_objs;
+
+	__rte_node_process(graph, node);
+
+	/* Run the streams enqueued by the batch to completion */
+	while (likely(head != graph->tail)) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[head++]);
+		__rte_node_process(graph, node);
+		head &= mask;
+	}
+
+	graph->tail = 0;
+}
+
+static unsigned int
+graph_steal_deque_process(struct rte_graph *graph, struct rte_graph *victim)
+{
+	struct graph_work_steal_batch *batches[STEAL_BURST_SZ];
+	unsigned int i, n;
+
+	n = rte_ring_mc_dequeue_burst_elem(victim->steal.deque, batches,
+					   sizeof(batches[0]), RTE_DIM(batches),
+					   NULL);
+
+	for (i = 0; i < n; i++) {
+		graph_steal_batch_process(graph, batches[i], graph != victim);
+		rte_mempool_put(batches[i]->mp, batches[i]);
+	}
+
+	return n;
+}
+
+void
+__rte_graph_work_steal_process(struct rte_graph *graph, bool busy)
+{
+	struct rte_graph *victim = graph->steal.victim;
+	struct rte_graph *first = victim;
+
+	/* Streams not stolen yet are drained by their owner */
+	if (graph_steal_deque_process(graph, graph) != 0)
+		busy = true;
+
+	if (busy) {
+		if (unlikely(graph->steal.idle)) {
+			graph->steal.idle = false;
+			rte_atomic_fetch_sub_explicit(graph->steal.nb_idle, 1,
+						      rte_memory_order_relaxed);
+		}
+		return;
+	}
+
+	if (!graph->steal.idle) {
+		graph->steal.idle = true;
+		rte_atomic_fetch_add_explicit(graph->steal.nb_idle, 1,
+					      rte_memory_order_relaxed);
+	}
+
+	/* Visit the group round-robin, stop at the first graph with work */
+	do {
+		victim = SLIST_NEXT(victim, next);
+		if (victim == NULL)
+			victim = SLIST_FIRST(graph->steal.rq);
+
+		if (victim != graph && graph_steal_deque_process(graph, victim) != 0)
+			break;
+	} while (victim != first);
+
+	graph->steal.victim = victim;
+}
+
+int
+rte_graph_model_work_steal_node_ordered_set(const char *name, bool ordered)
+{
+	struct node *node;
+	int ret = -EINVAL;
+
+	if (name == NULL)
+		return ret;
+
+	graph_spinlock_lock();
+
+	STAILQ_FOREACH(node, node_list_head_get(), next) {
+		if (strncmp(node->name, name, RTE_NODE_NAMESIZE) == 0) {
+			node->steal_ordered = ordered;
+			ret = 0;
+			break;
+		}
+	}
+
+	graph_spinlock_unlock();
+
+	return ret;
+}
@@ -0,0 +1,141 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_GRAPH_MODEL_WORK_STEAL_H_
+#define _RTE_GRAPH_MODEL_WORK_STEAL_H_
+
+/**
+ * @file rte_graph_model_work_steal.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * These APIs are only used for work steal model.
+ *
+ * In work steal model, the graphs cloned from the same parent graph form a
+ * steal group. While some graphs of the group are idle, a busy graph keeps
+ * the first batch of each pending stream and publishes the remaining objects
+ * of the stream into its deque. The idle graphs of the group steal the
+ * published streams and run them through their own copy of the graph.
+ */
+
+#include <rte_errno.h>
+#include <rte_mempool.h>
+#include <rte_memzone.h>
+#include <rte_ring.h>
+
+#include "rte_graph_worker_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_GRAPH_STEAL_DEQUE_SIZE_MULTIPLIER  8
+#define RTE_GRAPH_STEAL_DEQUE_SIZE(nb_nodes)   \
+	((typeof(nb_nodes))((nb_nodes) * RTE_GRAPH_STEAL_DEQUE_SIZE_MULTIPLIER))
+
+/** Default number of objects per published stream. */
+#define RTE_GRAPH_STEAL_BATCH_SIZE 64
+
+/**
+ * @internal
+ *
+ * Publish the objects of the node stream beyond the first batch into the
+ * graph's deque for work steal model.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param node
+ *   Pointer to the node object with pending stream.
+ *
+ * @note
+ * This implementation is used by work steal model only and user application
+ * should not call it directly.
+ */
+void __rte_noinline __rte_graph_work_steal_publish(struct rte_graph *graph,
+						   struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Process the streams left in the graph's deque and, when the graph is
+ * idle, the streams stolen from the other graphs of the steal group.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param busy
+ *   True if the graph had pending streams in the last walk.
+ *
+ * @note
+ * This implementation is used by work steal model only and user application
+ * should not call it directly.
+ */
+void __rte_graph_work_steal_process(struct rte_graph *graph, bool busy);
+
+/**
+ * Set whether the streams of the node must be processed in order.
+ *
+ * The streams of an ordered node are never published, so the objects are
+ * always processed by the graph which enqueued them.
+ *
+ * @param name
+ *   Valid node name. In the case of the cloned node, the name will be
+ * "parent node name" + "-" + name.
+ * @param ordered
+ *   True to keep the node streams on the local graph.
+ *
+ * @return
+ *   0 on success, error otherwise.
+ */
+__rte_experimental
+int rte_graph_model_work_steal_node_ordered_set(const char *name, bool ordered);
+
+/**
+ * Perform graph walk on the circular buffer and invoke the process function
+ * of the nodes and collect the stats.
+ *
+ * @param graph
+ *   Graph pointer returned from rte_graph_lookup function.
+ *
+ * @see rte_graph_lookup()
+ */
+static inline void
+rte_graph_walk_work_steal(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const rte_node_t mask = graph->cir_mask;
+	uint32_t head = graph->head;
+	struct rte_node *node;
+	bool busy = false;
+
+	while (likely(head != graph->tail)) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+
+		/* Share the large pending streams only when a graph can take them */
+		if ((int32_t)head > 0) {
+			busy = true;
+			if (node->idx > graph->steal.batch_size &&
+			    !node->steal.ordered && graph->steal.deque != NULL &&
+			    rte_atomic_load_explicit(graph->steal.nb_idle,
+						     rte_memory_order_relaxed) != 0)
+				__rte_graph_work_steal_publish(graph, node);
+		}
+
+		__rte_node_process(graph, node);
+
+		head = likely((int32_t)head > 0) ? head & mask : head;
+	}
+
+	graph->tail = 0;
+
+	if (graph->steal.deque != NULL)
+		__rte_graph_work_steal_process(graph, busy);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_GRAPH_MODEL_WORK_STEAL_H_ */
@@ -16,11 +16,13 @@
 #include <stdalign.h>
 #include <stddef.h>
 
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_prefetch.h>
 #include <rte_memcpy.h>
 #include <rte_memory.h>
+#include <rte_stdatomic.h>
 
 #include "rte_graph.h"
 
@@ -33,6 +35,8 @@ extern "C" {
 #define RTE_GRAPH_MODEL_RTC 0 /**< Run-To-Completion model. It is the default model. */
 #define RTE_GRAPH_MODEL_MCORE_DISPATCH 1
 /**< Dispatch model to support cross-core dispatching within core affinity. */
+#define RTE_GRAPH_MODEL_WORK_STEAL 2
+/**< Work stealing model, idle graphs process the streams published by busy graphs. */
 #define RTE_GRAPH_MODEL_DEFAULT RTE_GRAPH_MODEL_RTC /**< Default graph model. */
 
 /**
@@ -68,7 +72,23 @@ struct __rte_cache_aligned rte_graph {
 			unsigned int lcore_id;  /**< The graph running Lcore. */
 			struct rte_ring *wq;    /**< The work-queue for pending streams. */
 			struct rte_mempool *mp; /**< The mempool for scheduling streams. */
+			rte_graph_off_t *deferred; /**< Nodes to schedule on next walk. */
+			uint32_t nb_deferred;   /**< Number of deferred nodes. */
+			bool stall; /**< A node waits for credits, skip the src nodes. */
 		} dispatch; /** Only used by dispatch model */
+		/* Fast schedule area for work steal model */
+		struct {
+			alignas(RTE_CACHE_LINE_SIZE) struct rte_graph_rq_head *rq;
+				/* The run-queue of the steal group */
+			struct rte_graph_rq_head rq_head; /* The head for graph list */
+			struct rte_ring *deque;   /**< Streams published by the graph. */
+			struct rte_mempool *mp;   /**< The mempool for published streams. */
+			struct rte_graph *victim; /**< Next graph to steal from. */
+			RTE_ATOMIC(uint32_t) *nb_idle; /**< Number of idle graphs. */
+			RTE_ATOMIC(uint32_t) idle_count; /* Idle graphs counter */
+			uint16_t batch_size; /**< Number of objs published at a time. */
+			bool idle; /**< No work was found on the last walk. */
+		} steal; /** Only used by work steal model */
 	};
 	SLIST_ENTRY(rte_graph) next;   /* The next for rte_graph list */
 	/* End of Fast path area.*/
@@ -80,6 +100,10 @@ struct __rte_cache_aligned rte_graph {
 	uint64_t nb_pkt_captured;
 	/** Number of packets to capture per core. */
 	uint64_t nb_pkt_to_capture;
+	/** Number of packets dropped when the pcap writer is late. */
+	uint64_t nb_pkt_dropped;
+	uint32_t pcap_sample_cnt; /**< Packets seen since the last sampled one. */
+	struct rte_ring *pcap_ring; /**< Captured packets to the pcap writer. */
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];  /**< Pcap filename. */
 	uint64_t fence;			/**< Fence. */
 };
@@ -104,18 +128,31 @@ struct __rte_cache_aligned rte_node {
 	/** Original process function when pcap is enabled. */
 	rte_node_process_t original_process;
 
+	/** Work steal model data. */
+	struct {
+		uint64_t total_publish_objs; /**< Number of objects published. */
+		uint64_t total_steal_objs; /**< Number of objects stolen. */
+		bool ordered; /**< Streams are never published. */
+	} steal;
+
 	/** Fast schedule area for mcore dispatch model. */
 	union {
 		alignas(RTE_CACHE_LINE_MIN_SIZE) struct {
 			unsigned int lcore_id;  /**< Node running lcore. */
+			uint16_t coalesce_objs; /**< Objects to hold before scheduling. */
+			bool backpressure; /**< Wait for credits instead of running locally. */
 			uint64_t total_sched_objs; /**< Number of objects scheduled. */
 			uint64_t total_sched_fail; /**< Number of scheduled failure. */
+			uint64_t total_sched_stall; /**< Number of objects waiting for credits. */
+			uint64_t coalesce_cycles; /**< Max cycles to hold objects. */
+			uint64_t hold_tsc; /**< Time the objects started to be held. */
 		} dispatch;
 	};
 
 	/** Fast path area cache line 1. */
 	alignas(RTE_CACHE_LINE_MIN_SIZE)
 	rte_graph_off_t xstat_off; /**< Offset to xstat counters. */
+	rte_graph_off_t hist_off; /**< Offset to histograms, 0 if disabled. */
 
 	/** Fast path area cache line 2. */
 	__extension__ struct __rte_cache_aligned {
@@ -148,6 +185,70 @@ struct __rte_cache_aligned rte_node {
 static_assert(offsetof(struct rte_node, nodes) - offsetof(struct rte_node, ctx)
 	== RTE_CACHE_LINE_MIN_SIZE, "rte_node fast path area must fit in 64 bytes");
 
+/**
+ * @internal
+ *
+ * Node histograms of cycles per call and objs per call.
+ */
+struct rte_node_hist {
+	uint64_t cycles[RTE_GRAPH_HIST_CYCLES_BUCKETS]; /**< Cycles per call. */
+	uint64_t objs[RTE_GRAPH_HIST_OBJS_BUCKETS];     /**< Objs per call. */
+};
+
+/**
+ * @internal
+ *
+ * Get the histogram bucket of a value, the values below 2^RTE_GRAPH_HIST_SUB_BITS
+ * have a bucket each, then each power of two is split in
+ * 2^RTE_GRAPH_HIST_SUB_BITS buckets.
+ *
+ * @param val
+ *   Value to record.
+ * @param nb_buckets
+ *   Number of buckets of the histogram, the last one holds the larger values.
+ *
+ * @return
+ *   Bucket index.
+ */
+static __rte_always_inline uint16_t
+__rte_node_hist_bucket(uint64_t val, uint16_t nb_buckets)
+{
+	const uint64_t sub = 1 << RTE_GRAPH_HIST_SUB_BITS;
+	unsigned int msb;
+	uint64_t bucket;
+
+	if (val < sub)
+		return val;
+
+	msb = 63 - rte_clz64(val);
+	bucket = ((uint64_t)(msb - RTE_GRAPH_HIST_SUB_BITS + 1) << RTE_GRAPH_HIST_SUB_BITS) +
+		((val >> (msb - RTE_GRAPH_HIST_SUB_BITS)) & (sub - 1));
+
+	return RTE_MIN(bucket, (uint64_t)nb_buckets - 1);
+}
+
+/**
+ * @internal
+ *
+ * Record a node call in the node histograms. Only the graph walking lcore
+ * updates the histograms, no atomic operation is needed.
+ *
+ * @param node
+ *   Pointer to the node object.
+ * @param cycles
+ *   Cycles spent in the call.
+ * @param objs
+ *   Objs processed in the call.
+ */
+static __rte_always_inline void
+__rte_node_hist_update(struct rte_node *node, uint64_t cycles, uint16_t objs)
+{
+	struct rte_node_hist *hist = RTE_PTR_ADD(node, node->hist_off);
+
+	hist->cycles[__rte_node_hist_bucket(cycles, RTE_GRAPH_HIST_CYCLES_BUCKETS)]++;
+	hist->objs[__rte_node_hist_bucket(objs, RTE_GRAPH_HIST_OBJS_BUCKETS)]++;
+}
+
 /**
  * @internal
  *
@@ -194,7 +295,7 @@ void __rte_node_stream_alloc_size(struct rte_graph *graph,
 static __rte_always_inline void
 __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 {
-	uint64_t start;
+	uint64_t start, cycles;
 	uint16_t rc;
 	void **objs;
 
@@ -205,9 +306,12 @@ __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 	if (rte_graph_has_stats_feature()) {
 		start = rte_rdtsc();
 		rc = node->process(graph, node, objs, node->idx);
-		node->total_cycles += rte_rdtsc() - start;
+		cycles = rte_rdtsc() - start;
+		node->total_cycles += cycles;
 		node->total_calls++;
 		node->total_objs += rc;
+		if (unlikely(node->hist_off != 0))
+			__rte_node_hist_update(node, cycles, rc);
 	} else {
 		node->process(graph, node, objs, node->idx);
 	}
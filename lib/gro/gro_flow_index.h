@@ -0,0 +1,195 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _GRO_FLOW_INDEX_H_
+#define _GRO_FLOW_INDEX_H_
+
+/*
+ * Hash index over the flow array of a GRO reassembly table.
+ *
+ * Without an index, finding the flow of a packet means comparing its
+ * key with every flow in the table, so the reassembly cost grows with
+ * the number of live flows. The index is an open-addressing table with
+ * linear probing, which maps a 32-bit key hash to a flow array index,
+ * and a LIFO of unused flow array entries. The key comparison is only
+ * done for the entries whose hash matches, so the lookup cost does not
+ * depend on the number of flows in the table.
+ *
+ * The index is only allocated for the tables created by
+ * rte_gro_ctx_create(). The tables built on the stack by
+ * rte_gro_reassemble_burst() have at most RTE_GRO_MAX_BURST_ITEM_NUM
+ * flows and keep using the linear flow scan.
+ */
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+
+/* Flow index entry. INVALID_ARRAY_INDEX in flow_idx means empty. */
+struct gro_flow_index_entry {
+	/* Hash of the flow key */
+	uint32_t sig;
+	/* Index of the flow in the flow array */
+	uint32_t flow_idx;
+};
+
+struct gro_flow_index {
+	/* Number of entries in the hash table minus one */
+	uint32_t mask;
+	/* Number of unused flow array entries */
+	uint32_t free_num;
+	/* LIFO of unused flow array entries */
+	uint32_t *free_flows;
+	/* Hash table */
+	struct gro_flow_index_entry entries[];
+};
+
+/*
+ * Create an index for a flow array of max_flow_num entries.
+ * The hash table is kept at most half full to bound the probe length.
+ */
+static inline struct gro_flow_index *
+gro_flow_index_create(uint16_t socket_id, uint32_t max_flow_num)
+{
+	struct gro_flow_index *idx;
+	uint32_t entries_num, i;
+	size_t size;
+
+	entries_num = rte_align32pow2(max_flow_num * 2);
+	size = sizeof(struct gro_flow_index) +
+		sizeof(struct gro_flow_index_entry) * entries_num +
+		sizeof(uint32_t) * max_flow_num;
+
+	idx = rte_malloc_socket(__func__, size, RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (idx == NULL)
+		return NULL;
+
+	idx->mask = entries_num - 1;
+	for (i = 0; i < entries_num; i++)
+		idx->entries[i].flow_idx = INVALID_ARRAY_INDEX;
+
+	/* Hand out the low flow array entries first. */
+	idx->free_flows = (uint32_t *)&idx->entries[entries_num];
+	for (i = 0; i < max_flow_num; i++)
+		idx->free_flows[i] = max_flow_num - i - 1;
+	idx->free_num = max_flow_num;
+
+	return idx;
+}
+
+static inline void
+gro_flow_index_destroy(struct gro_flow_index *idx)
+{
+	rte_free(idx);
+}
+
+/*
+ * Get an unused flow array entry.
+ */
+static inline uint32_t
+gro_flow_index_alloc(struct gro_flow_index *idx)
+{
+	if (unlikely(idx->free_num == 0))
+		return INVALID_ARRAY_INDEX;
+	return idx->free_flows[--idx->free_num];
+}
+
+/*
+ * Return the hash table position where the lookup of sig starts.
+ * The entry is prefetched, so the caller can compute the rest of
+ * the packet metadata before calling gro_flow_index_next().
+ */
+static inline uint32_t
+gro_flow_index_first(const struct gro_flow_index *idx, uint32_t sig)
+{
+	uint32_t pos = sig & idx->mask;
+
+	rte_prefetch0(&idx->entries[pos]);
+	return pos;
+}
+
+/*
+ * Return the next flow array index whose key hash is sig, starting
+ * from position *pos, and advance *pos past it. Return
+ * INVALID_ARRAY_INDEX once an empty entry ends the probe sequence.
+ */
+static inline uint32_t
+gro_flow_index_next(const struct gro_flow_index *idx, uint32_t sig,
+		uint32_t *pos)
+{
+	const struct gro_flow_index_entry *e;
+	uint32_t p = *pos;
+
+	for (;;) {
+		e = &idx->entries[p];
+		p = (p + 1) & idx->mask;
+		if (e->flow_idx == INVALID_ARRAY_INDEX)
+			break;
+		if (e->sig == sig) {
+			*pos = p;
+			return e->flow_idx;
+		}
+	}
+	*pos = p;
+	return INVALID_ARRAY_INDEX;
+}
+
+/*
+ * Map sig to a flow array entry taken by gro_flow_index_alloc().
+ * There is always room, since the hash table has more entries than
+ * the flow array.
+ */
+static inline void
+gro_flow_index_add(struct gro_flow_index *idx, uint32_t sig,
+		uint32_t flow_idx)
+{
+	uint32_t pos = sig & idx->mask;
+
+	while (idx->entries[pos].flow_idx != INVALID_ARRAY_INDEX)
+		pos = (pos + 1) & idx->mask;
+
+	idx->entries[pos].sig = sig;
+	idx->entries[pos].flow_idx = flow_idx;
+}
+
+/*
+ * Remove the mapping of a flow and give its flow array entry back.
+ * The following entries of the probe sequence are shifted back, so
+ * that no tombstones are needed.
+ */
+static inline void
+gro_flow_index_del(struct gro_flow_index *idx, uint32_t sig,
+		uint32_t flow_idx)
+{
+	uint32_t i, j, home;
+
+	i = sig & idx->mask;
+	while (idx->entries[i].flow_idx != flow_idx) {
+		if (unlikely(idx->entries[i].flow_idx == INVALID_ARRAY_INDEX))
+			return;
+		i = (i + 1) & idx->mask;
+	}
+
+	j = i;
+	for (;;) {
+		j = (j + 1) & idx->mask;
+		if (idx->entries[j].flow_idx == INVALID_ARRAY_INDEX)
+			break;
+		/*
+		 * The entry at j can fill the hole at i only if its home
+		 * position is not cyclically within (i, j].
+		 */
+		home = idx->entries[j].sig & idx->mask;
+		if (((j - home) & idx->mask) >= ((j - i) & idx->mask)) {
+			idx->entries[i] = idx->entries[j];
+			i = j;
+		}
+	}
+	idx->entries[i].flow_idx = INVALID_ARRAY_INDEX;
+
+	idx->free_flows[idx->free_num++] = flow_idx;
+}
+
+#endif
@@ -5,6 +5,8 @@
 #ifndef _GRO_TCP4_H_
 #define _GRO_TCP4_H_
 
+#include <rte_hash_crc.h>
+
 #include "gro_tcp.h"
 
 #define GRO_TCP4_TBL_MAX_ITEM_NUM (1024UL * 1024UL)
@@ -41,6 +43,8 @@ struct gro_tcp4_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* flow hash index, NULL if flows are searched linearly */
+	struct gro_flow_index *flow_index;
 };
 
 /**
@@ -144,4 +148,21 @@ is_same_tcp4_flow(struct tcp4_flow_key k1, struct tcp4_flow_key k2)
 			is_same_common_tcp_key(&k1.cmn_key, &k2.cmn_key));
 }
 
+/*
+ * Calculate the flow index hash of a TCP/IPv4 flow key.
+ * Ethernet addresses are left out, as they rarely tell flows apart.
+ */
+static inline uint32_t
+tcp4_flow_hash(const struct tcp4_flow_key *k)
+{
+	uint32_t h;
+
+	h = rte_hash_crc_8byte(((uint64_t)k->ip_src_addr << 32) |
+			k->ip_dst_addr, 0);
+	h = rte_hash_crc_8byte(((uint64_t)k->cmn_key.src_port << 48) |
+			((uint64_t)k->cmn_key.dst_port << 32) |
+			k->cmn_key.recv_ack, h);
+	return h;
+}
+
 #endif
@@ -8,6 +8,7 @@
 
 #include "gro_tcp6.h"
 #include "gro_tcp_internal.h"
+#include "gro_flow_index.h"
 
 void *
 gro_tcp6_tbl_create(uint16_t socket_id,
@@ -57,6 +58,14 @@ gro_tcp6_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	tbl->flow_index = gro_flow_index_create(socket_id, entries_num);
+	if (tbl->flow_index == NULL) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -68,6 +77,7 @@ gro_tcp6_tbl_destroy(void *tbl)
 	if (tcp_tbl) {
 		rte_free(tcp_tbl->items);
 		rte_free(tcp_tbl->flows);
+		gro_flow_index_destroy(tcp_tbl->flow_index);
 	}
 	rte_free(tcp_tbl);
 }
@@ -78,6 +88,9 @@ find_an_empty_flow(struct gro_tcp6_tbl *tbl)
 	uint32_t i;
 	uint32_t max_flow_num = tbl->max_flow_num;
 
+	if (tbl->flow_index != NULL)
+		return gro_flow_index_alloc(tbl->flow_index);
+
 	for (i = 0; i < max_flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
@@ -87,6 +100,7 @@ find_an_empty_flow(struct gro_tcp6_tbl *tbl)
 static inline uint32_t
 insert_new_flow(struct gro_tcp6_tbl *tbl,
 		struct tcp6_flow_key *src,
+		uint32_t sig,
 		uint32_t item_idx)
 {
 	struct tcp6_flow_key *dst;
@@ -106,6 +120,9 @@ insert_new_flow(struct gro_tcp6_tbl *tbl,
 	tbl->flows[flow_idx].start_index = item_idx;
 	tbl->flow_num++;
 
+	if (tbl->flow_index != NULL)
+		gro_flow_index_add(tbl->flow_index, sig, flow_idx);
+
 	return flow_idx;
 }
 
@@ -124,6 +141,40 @@ update_header(struct gro_tcp_item *item)
 			pkt->l2_len - pkt->l3_len);
 }
 
+/*
+ * Search for the flow of a key. The key hash used by the flow
+ * index is returned in sig, for insert_new_flow().
+ */
+static inline uint32_t
+find_flow(struct gro_tcp6_tbl *tbl,
+		struct tcp6_flow_key *key,
+		uint32_t *sig)
+{
+	uint32_t i, pos, max_flow_num, remaining_flow_num;
+
+	if (tbl->flow_index != NULL) {
+		*sig = tcp6_flow_hash(key);
+		pos = gro_flow_index_first(tbl->flow_index, *sig);
+		while ((i = gro_flow_index_next(tbl->flow_index, *sig, &pos)) !=
+				INVALID_ARRAY_INDEX) {
+			if (is_same_tcp6_flow(&tbl->flows[i].key, key))
+				return i;
+		}
+		return INVALID_ARRAY_INDEX;
+	}
+
+	max_flow_num = tbl->max_flow_num;
+	remaining_flow_num = tbl->flow_num;
+	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
+		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
+			if (is_same_tcp6_flow(&tbl->flows[i].key, key))
+				return i;
+			remaining_flow_num--;
+		}
+	}
+	return INVALID_ARRAY_INDEX;
+}
+
 int32_t
 gro_tcp6_reassemble(struct rte_mbuf *pkt,
 		struct gro_tcp6_tbl *tbl,
@@ -134,10 +185,9 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	int32_t tcp_dl;
 	uint16_t ip_tlen;
 	struct tcp6_flow_key key;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, sig = 0;
 	uint32_t sent_seq;
 	struct rte_tcp_hdr *tcp_hdr;
-	uint8_t find;
 	uint32_t item_idx;
 	/*
 	 * Don't process the packet whose TCP header length is greater
@@ -176,27 +226,16 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	key.vtc_flow = ipv6_hdr->vtc_flow;
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_tcp6_flow(&tbl->flows[i].key, &key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	i = find_flow(tbl, &key, &sig);
 
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
 		item_idx = insert_new_tcp_item(pkt, tbl->items, &tbl->item_num,
 						tbl->max_item_num, start_time,
 						INVALID_ARRAY_INDEX, sent_seq, 0, true);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, sig, item_idx) ==
 			INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so delete the
@@ -240,8 +279,12 @@ gro_tcp6_tbl_timeout_flush(struct gro_tcp6_tbl *tbl,
 				j = delete_tcp_item(tbl->items, j,
 						&tbl->item_num, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
-				if (j == INVALID_ARRAY_INDEX)
+				if (j == INVALID_ARRAY_INDEX) {
 					tbl->flow_num--;
+					if (tbl->flow_index != NULL)
+						gro_flow_index_del(tbl->flow_index,
+							tcp6_flow_hash(&tbl->flows[i].key), i);
+				}
 
 				if (unlikely(k == nb_out))
 					return k;
@@ -6,6 +6,7 @@
 #define _GRO_TCP6_H_
 
 #include <rte_ip6.h>
+#include <rte_hash_crc.h>
 
 #include "gro_tcp.h"
 
@@ -44,6 +45,8 @@ struct gro_tcp6_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* flow hash index, NULL if flows are searched linearly */
+	struct gro_flow_index *flow_index;
 };
 
 /**
@@ -159,4 +162,22 @@ is_same_tcp6_flow(struct tcp6_flow_key *k1, struct tcp6_flow_key *k2)
 	return is_same_common_tcp_key(&k1->cmn_key, &k2->cmn_key);
 }
 
+/*
+ * Calculate the flow index hash of a TCP/IPv6 flow key. Like
+ * is_same_tcp6_flow(), it ignores the traffic class.
+ */
+static inline uint32_t
+tcp6_flow_hash(const struct tcp6_flow_key *k)
+{
+	uint32_t h;
+
+	h = rte_hash_crc(&k->src_addr, sizeof(k->src_addr), 0);
+	h = rte_hash_crc(&k->dst_addr, sizeof(k->dst_addr), h);
+	h = rte_hash_crc_4byte(k->vtc_flow & htonl(0xF00FFFFF), h);
+	h = rte_hash_crc_8byte(((uint64_t)k->cmn_key.src_port << 48) |
+			((uint64_t)k->cmn_key.dst_port << 32) |
+			k->cmn_key.recv_ack, h);
+	return h;
+}
+
 #endif
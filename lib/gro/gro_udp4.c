@@ -7,6 +7,7 @@
 #include <rte_ethdev.h>
 
 #include "gro_udp4.h"
+#include "gro_flow_index.h"
 
 void *
 gro_udp4_tbl_create(uint16_t socket_id,
@@ -56,6 +57,14 @@ gro_udp4_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	tbl->flow_index = gro_flow_index_create(socket_id, entries_num);
+	if (tbl->flow_index == NULL) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -67,6 +76,7 @@ gro_udp4_tbl_destroy(void *tbl)
 	if (udp_tbl) {
 		rte_free(udp_tbl->items);
 		rte_free(udp_tbl->flows);
+		gro_flow_index_destroy(udp_tbl->flow_index);
 	}
 	rte_free(udp_tbl);
 }
@@ -89,6 +99,9 @@ find_an_empty_flow(struct gro_udp4_tbl *tbl)
 	uint32_t i;
 	uint32_t max_flow_num = tbl->max_flow_num;
 
+	if (tbl->flow_index != NULL)
+		return gro_flow_index_alloc(tbl->flow_index);
+
 	for (i = 0; i < max_flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
@@ -146,6 +159,7 @@ delete_item(struct gro_udp4_tbl *tbl, uint32_t item_idx,
 static inline uint32_t
 insert_new_flow(struct gro_udp4_tbl *tbl,
 		struct udp4_flow_key *src,
+		uint32_t sig,
 		uint32_t item_idx)
 {
 	struct udp4_flow_key *dst;
@@ -166,6 +180,9 @@ insert_new_flow(struct gro_udp4_tbl *tbl,
 	tbl->flows[flow_idx].start_index = item_idx;
 	tbl->flow_num++;
 
+	if (tbl->flow_index != NULL)
+		gro_flow_index_add(tbl->flow_index, sig, flow_idx);
+
 	return flow_idx;
 }
 
@@ -192,6 +209,40 @@ update_header(struct gro_udp4_item *item)
 	}
 }
 
+/*
+ * Search for the flow of a key. The key hash used by the flow
+ * index is returned in sig, for insert_new_flow().
+ */
+static inline uint32_t
+find_flow(struct gro_udp4_tbl *tbl,
+		struct udp4_flow_key *key,
+		uint32_t *sig)
+{
+	uint32_t i, pos, max_flow_num, remaining_flow_num;
+
+	if (tbl->flow_index != NULL) {
+		*sig = udp4_flow_hash(key);
+		pos = gro_flow_index_first(tbl->flow_index, *sig);
+		while ((i = gro_flow_index_next(tbl->flow_index, *sig, &pos)) !=
+				INVALID_ARRAY_INDEX) {
+			if (is_same_udp4_flow(tbl->flows[i].key, *key))
+				return i;
+		}
+		return INVALID_ARRAY_INDEX;
+	}
+
+	max_flow_num = tbl->max_flow_num;
+	remaining_flow_num = tbl->flow_num;
+	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
+		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
+			if (is_same_udp4_flow(tbl->flows[i].key, *key))
+				return i;
+			remaining_flow_num--;
+		}
+	}
+	return INVALID_ARRAY_INDEX;
+}
+
 int32_t
 gro_udp4_reassemble(struct rte_mbuf *pkt,
 		struct gro_udp4_tbl *tbl,
@@ -206,9 +257,8 @@ gro_udp4_reassemble(struct rte_mbuf *pkt,
 
 	struct udp4_flow_key key;
 	uint32_t cur_idx, prev_idx, item_idx;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, sig = 0;
 	int cmp;
-	uint8_t find;
 
 	eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
 	ipv4_hdr = (struct rte_ipv4_hdr *)((char *)eth_hdr + pkt->l2_len);
@@ -248,30 +298,19 @@ gro_udp4_reassemble(struct rte_mbuf *pkt,
 	key.ip_id = ip_id;
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_udp4_flow(tbl->flows[i].key, key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	i = find_flow(tbl, &key, &sig);
 
 	/*
 	 * Fail to find a matched flow. Insert a new flow and store the
 	 * packet into the flow.
 	 */
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		item_idx = insert_new_item(tbl, pkt, start_time,
 				INVALID_ARRAY_INDEX, frag_offset,
 				is_last_frag);
 		if (unlikely(item_idx == INVALID_ARRAY_INDEX))
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, sig, item_idx) ==
 				INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so delete the
@@ -405,8 +444,12 @@ gro_udp4_tbl_timeout_flush(struct gro_udp4_tbl *tbl,
 				 */
 				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
-				if (j == INVALID_ARRAY_INDEX)
+				if (j == INVALID_ARRAY_INDEX) {
 					tbl->flow_num--;
+					if (tbl->flow_index != NULL)
+						gro_flow_index_del(tbl->flow_index,
+							udp4_flow_hash(&tbl->flows[i].key), i);
+				}
 
 				if (unlikely(k == nb_out))
 					return k;
@@ -6,6 +6,7 @@
 #define _GRO_UDP4_H_
 
 #include <rte_ip.h>
+#include <rte_hash_crc.h>
 
 #define INVALID_ARRAY_INDEX 0xffffffffUL
 #define GRO_UDP4_TBL_MAX_ITEM_NUM (1024UL * 1024UL)
@@ -82,6 +83,8 @@ struct gro_udp4_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* flow hash index, NULL if flows are searched linearly */
+	struct gro_flow_index *flow_index;
 };
 
 /**
@@ -183,6 +186,21 @@ is_same_udp4_flow(struct udp4_flow_key k1, struct udp4_flow_key k2)
 			(k1.ip_id == k2.ip_id));
 }
 
+/*
+ * Calculate the flow index hash of a UDP/IPv4 flow key.
+ * Ethernet addresses are left out, as they rarely tell flows apart.
+ */
+static inline uint32_t
+udp4_flow_hash(const struct udp4_flow_key *k)
+{
+	uint32_t h;
+
+	h = rte_hash_crc_8byte(((uint64_t)k->ip_src_addr << 32) |
+			k->ip_dst_addr, 0);
+	h = rte_hash_crc_2byte(k->ip_id, h);
+	return h;
+}
+
 /*
  * Merge two UDP/IPv4 packets without updating checksums.
  * If cmp is larger than 0, append the new packet to the
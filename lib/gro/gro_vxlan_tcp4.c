@@ -8,6 +8,7 @@
 #include <rte_udp.h>
 
 #include "gro_vxlan_tcp4.h"
+#include "gro_flow_index.h"
 
 void *
 gro_vxlan_tcp4_tbl_create(uint16_t socket_id,
@@ -57,6 +58,14 @@ gro_vxlan_tcp4_tbl_create(uint16_t socket_id,
 		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	tbl->flow_index = gro_flow_index_create(socket_id, entries_num);
+	if (tbl->flow_index == NULL) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+
 	return tbl;
 }
 
@@ -68,6 +77,7 @@ gro_vxlan_tcp4_tbl_destroy(void *tbl)
 	if (vxlan_tbl) {
 		rte_free(vxlan_tbl->items);
 		rte_free(vxlan_tbl->flows);
+		gro_flow_index_destroy(vxlan_tbl->flow_index);
 	}
 	rte_free(vxlan_tbl);
 }
@@ -88,6 +98,9 @@ find_an_empty_flow(struct gro_vxlan_tcp4_tbl *tbl)
 {
 	uint32_t max_flow_num = tbl->max_flow_num, i;
 
+	if (tbl->flow_index != NULL)
+		return gro_flow_index_alloc(tbl->flow_index);
+
 	for (i = 0; i < max_flow_num; i++)
 		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
 			return i;
@@ -152,6 +165,7 @@ delete_item(struct gro_vxlan_tcp4_tbl *tbl,
 static inline uint32_t
 insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 		struct vxlan_tcp4_flow_key *src,
+		uint32_t sig,
 		uint32_t item_idx)
 {
 	struct vxlan_tcp4_flow_key *dst;
@@ -179,6 +193,9 @@ insert_new_flow(struct gro_vxlan_tcp4_tbl *tbl,
 	tbl->flows[flow_idx].start_index = item_idx;
 	tbl->flow_num++;
 
+	if (tbl->flow_index != NULL)
+		gro_flow_index_add(tbl->flow_index, sig, flow_idx);
+
 	return flow_idx;
 }
 
@@ -199,6 +216,24 @@ is_same_vxlan_tcp4_flow(struct vxlan_tcp4_flow_key k1,
 			is_same_tcp4_flow(k1.inner_key, k2.inner_key));
 }
 
+/*
+ * Calculate the flow index hash of a VxLAN flow key. The inner key
+ * hash is extended with the VNI and the outer IPv4 and UDP fields.
+ */
+static inline uint32_t
+vxlan_tcp4_flow_hash(const struct vxlan_tcp4_flow_key *k)
+{
+	uint32_t h;
+
+	h = tcp4_flow_hash(&k->inner_key);
+	h = rte_hash_crc_4byte(k->vxlan_hdr.vx_vni, h);
+	h = rte_hash_crc_8byte(((uint64_t)k->outer_ip_src_addr << 32) |
+			k->outer_ip_dst_addr, h);
+	h = rte_hash_crc_4byte(((uint32_t)k->outer_src_port << 16) |
+			k->outer_dst_port, h);
+	return h;
+}
+
 static inline int
 check_vxlan_seq_option(struct gro_vxlan_tcp4_item *item,
 		struct rte_tcp_hdr *tcp_hdr,
@@ -279,6 +314,40 @@ update_vxlan_header(struct gro_vxlan_tcp4_item *item)
 	ipv4_hdr->total_length = rte_cpu_to_be_16(len);
 }
 
+/*
+ * Search for the flow of a key. The key hash used by the flow
+ * index is returned in sig, for insert_new_flow().
+ */
+static inline uint32_t
+find_flow(struct gro_vxlan_tcp4_tbl *tbl,
+		struct vxlan_tcp4_flow_key *key,
+		uint32_t *sig)
+{
+	uint32_t i, pos, max_flow_num, remaining_flow_num;
+
+	if (tbl->flow_index != NULL) {
+		*sig = vxlan_tcp4_flow_hash(key);
+		pos = gro_flow_index_first(tbl->flow_index, *sig);
+		while ((i = gro_flow_index_next(tbl->flow_index, *sig, &pos)) !=
+				INVALID_ARRAY_INDEX) {
+			if (is_same_vxlan_tcp4_flow(tbl->flows[i].key, *key))
+				return i;
+		}
+		return INVALID_ARRAY_INDEX;
+	}
+
+	max_flow_num = tbl->max_flow_num;
+	remaining_flow_num = tbl->flow_num;
+	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
+		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
+			if (is_same_vxlan_tcp4_flow(tbl->flows[i].key, *key))
+				return i;
+			remaining_flow_num--;
+		}
+	}
+	return INVALID_ARRAY_INDEX;
+}
+
 int32_t
 gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 		struct gro_vxlan_tcp4_tbl *tbl,
@@ -296,10 +365,9 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 
 	struct vxlan_tcp4_flow_key key;
 	uint32_t cur_idx, prev_idx, item_idx;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, sig = 0;
 	int cmp;
 	uint16_t hdr_len;
-	uint8_t find;
 
 	/*
 	 * Don't process the packet whose TCP header length is greater
@@ -370,30 +438,19 @@ gro_vxlan_tcp4_reassemble(struct rte_mbuf *pkt,
 	key.outer_dst_port = udp_hdr->dst_port;
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_vxlan_tcp4_flow(tbl->flows[i].key, key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	i = find_flow(tbl, &key, &sig);
 
 	/*
 	 * Can't find a matched flow. Insert a new flow and store the
 	 * packet into the flow.
 	 */
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		item_idx = insert_new_item(tbl, pkt, start_time,
 				INVALID_ARRAY_INDEX, sent_seq, outer_ip_id,
 				ip_id, outer_is_atomic, is_atomic);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, sig, item_idx) ==
 				INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so
@@ -470,8 +527,12 @@ gro_vxlan_tcp4_tbl_timeout_flush(struct gro_vxlan_tcp4_tbl *tbl,
 				 */
 				j = delete_item(tbl, j, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
-				if (j == INVALID_ARRAY_INDEX)
+				if (j == INVALID_ARRAY_INDEX) {
 					tbl->flow_num--;
+					if (tbl->flow_index != NULL)
+						gro_flow_index_del(tbl->flow_index,
+							vxlan_tcp4_flow_hash(&tbl->flows[i].key), i);
+				}
 
 				if (unlikely(k == nb_out))
 					return k;
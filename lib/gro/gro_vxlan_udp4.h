@@ -61,6 +61,8 @@ struct gro_vxlan_udp4_tbl {
 	uint32_t max_item_num;
 	/* the maximum flow number */
 	uint32_t max_flow_num;
+	/* flow hash index, NULL if flows are searched linearly */
+	struct gro_flow_index *flow_index;
 };
 
 /**
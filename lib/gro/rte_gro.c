@@ -206,6 +206,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		vxlan_tcp_tbl.item_num = 0;
 		vxlan_tcp_tbl.max_flow_num = item_num;
 		vxlan_tcp_tbl.max_item_num = item_num;
+		vxlan_tcp_tbl.flow_index = NULL;
 		do_vxlan_tcp_gro = 1;
 	}
 
@@ -219,6 +220,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		vxlan_udp_tbl.item_num = 0;
 		vxlan_udp_tbl.max_flow_num = item_num;
 		vxlan_udp_tbl.max_item_num = item_num;
+		vxlan_udp_tbl.flow_index = NULL;
 		do_vxlan_udp_gro = 1;
 	}
 
@@ -232,6 +234,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp_tbl.item_num = 0;
 		tcp_tbl.max_flow_num = item_num;
 		tcp_tbl.max_item_num = item_num;
+		tcp_tbl.flow_index = NULL;
 		do_tcp4_gro = 1;
 	}
 
@@ -245,6 +248,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		udp_tbl.item_num = 0;
 		udp_tbl.max_flow_num = item_num;
 		udp_tbl.max_item_num = item_num;
+		udp_tbl.flow_index = NULL;
 		do_udp4_gro = 1;
 	}
 
@@ -258,6 +262,7 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 		tcp6_tbl.item_num = 0;
 		tcp6_tbl.max_flow_num = item_num;
 		tcp6_tbl.max_item_num = item_num;
+		tcp6_tbl.flow_index = NULL;
 		do_tcp6_gro = 1;
 	}
 
@@ -2427,6 +2427,107 @@ rte_hash_lookup_bulk_data(const struct rte_hash *h, const void **keys,
 }
 
 
+/*
+ * Hash the keys of an update burst and prefetch their buckets, then
+ * prefetch the stored keys whose signature matches in the primary bucket,
+ * which are compared when the key is added or removed.
+ */
+static inline void
+__bulk_update_prefetching_loop(const struct rte_hash *h, const void **keys,
+			uint32_t num_keys, hash_sig_t *hashes)
+{
+	const struct rte_hash_bucket *primary_bkt[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t i, j, prim_index, sec_index, key_idx;
+	uint16_t short_sig;
+
+	/* Prefetch first keys */
+	for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
+		rte_prefetch0(keys[i]);
+
+	/*
+	 * Prefetch rest of the keys, calculate primary and
+	 * secondary bucket and prefetch them
+	 */
+	for (i = 0; i < num_keys; i++) {
+		if (i + PREFETCH_OFFSET < num_keys)
+			rte_prefetch0(keys[i + PREFETCH_OFFSET]);
+
+		hashes[i] = rte_hash_hash(h, keys[i]);
+
+		short_sig = get_short_sig(hashes[i]);
+		prim_index = get_prim_bucket_index(h, hashes[i]);
+		sec_index = get_alt_bucket_index(h, prim_index, short_sig);
+
+		primary_bkt[i] = &h->buckets[prim_index];
+
+		rte_prefetch0(primary_bkt[i]);
+		rte_prefetch0(&h->buckets[sec_index]);
+	}
+
+	/* Prefetch the keys which may match in the primary buckets */
+	for (i = 0; i < num_keys; i++) {
+		short_sig = get_short_sig(hashes[i]);
+		for (j = 0; j < RTE_HASH_BUCKET_ENTRIES; j++) {
+			if (primary_bkt[i]->sig_current[j] != short_sig)
+				continue;
+			key_idx = rte_atomic_load_explicit(
+					&primary_bkt[i]->key_idx[j],
+					rte_memory_order_relaxed);
+			if (key_idx != EMPTY_SLOT)
+				rte_prefetch0((const char *)h->key_store +
+					key_idx * h->key_entry_size);
+		}
+	}
+}
+
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		void **data, uint32_t num_keys, int32_t *positions)
+{
+	hash_sig_t hashes[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t i;
+	int num_added = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	__bulk_update_prefetching_loop(h, keys, num_keys, hashes);
+
+	for (i = 0; i < num_keys; i++) {
+		positions[i] = __rte_hash_add_key_with_hash(h, keys[i],
+				hashes[i], data != NULL ? data[i] : NULL);
+		if (positions[i] >= 0)
+			num_added++;
+	}
+
+	return num_added;
+}
+
+int
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions)
+{
+	hash_sig_t hashes[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t i;
+	int num_removed = 0;
+
+	RETURN_IF_TRUE(((h == NULL) || (keys == NULL) || (num_keys == 0) ||
+			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
+			(positions == NULL)), -EINVAL);
+
+	__bulk_update_prefetching_loop(h, keys, num_keys, hashes);
+
+	for (i = 0; i < num_keys; i++) {
+		positions[i] = __rte_hash_del_key_with_hash(h, keys[i],
+				hashes[i]);
+		if (positions[i] >= 0)
+			num_removed++;
+	}
+
+	return num_removed;
+}
+
 static inline void
 __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 			const void **keys, hash_sig_t *prim_hash,
@@ -382,6 +382,69 @@ rte_hash_del_key(const struct rte_hash *h, const void *key);
 int32_t
 rte_hash_del_key_with_hash(const struct rte_hash *h, const void *key, hash_sig_t sig);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add multiple keys to an existing hash table.
+ * The keys of the burst are hashed and their buckets are prefetched
+ * before the first key is added, so that the cache misses of the burst
+ * overlap instead of stalling each insertion in turn.
+ * The keys are then added one by one, as with rte_hash_add_key_data(),
+ * so the multi-thread safety of this API is the one of the table.
+ * If a key exists already in the table, its value is updated.
+ *
+ * @param h
+ *   Hash table to add the keys to.
+ * @param keys
+ *   A pointer to a list of keys to add.
+ * @param data
+ *   A list of data to add with the keys, or NULL to add the keys
+ *   without data.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a list of values, corresponding to the list of keys,
+ *   with for each key either the value returned by rte_hash_add_key(),
+ *   or -ENOSPC if there is no space in the hash for this key.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - The number of keys added or updated.
+ */
+__rte_experimental
+int
+rte_hash_add_key_bulk(const struct rte_hash *h, const void **keys,
+		void **data, uint32_t num_keys, int32_t *positions);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Remove multiple keys from an existing hash table.
+ * The keys of the burst are hashed and their buckets are prefetched
+ * before the first key is removed. The keys are then removed one by one,
+ * as with rte_hash_del_key(), so the multi-thread safety of this API and
+ * the freeing of the key indexes are the same as for rte_hash_del_key().
+ *
+ * @param h
+ *   Hash table to remove the keys from.
+ * @param keys
+ *   A pointer to a list of keys to remove.
+ * @param num_keys
+ *   How many keys are in the keys list (less than RTE_HASH_LOOKUP_BULK_MAX).
+ * @param positions
+ *   Output containing a list of values, corresponding to the list of keys,
+ *   with for each key either the value returned by rte_hash_del_key(),
+ *   or -ENOENT if the key is not found.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - The number of keys removed.
+ */
+__rte_experimental
+int
+rte_hash_del_key_bulk(const struct rte_hash *h, const void **keys,
+		uint32_t num_keys, int32_t *positions);
+
 /**
  * Find a key in the hash table given the position.
  * This operation is multi-thread safe with regarding to other lookup threads.
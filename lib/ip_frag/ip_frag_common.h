@@ -61,6 +61,32 @@ struct ip_frag_pkt * ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	const struct ip_frag_key *key, uint64_t tms,
 	struct ip_frag_pkt **free, struct ip_frag_pkt **stale);
 
+/* fragment parsed by the burst reassembly functions */
+struct ip_frag_burst {
+	struct ip_frag_key key;
+	uint32_t sig1;       /* primary bucket hash */
+	uint32_t sig2;       /* secondary bucket hash */
+	uint16_t ofs;        /* offset into the packet */
+	uint16_t len;        /* length of fragment */
+	uint16_t more_frags; /* more fragments flag */
+};
+
+/*
+ * max number of fragments processed at once by the burst functions,
+ * the mbufs freed by a chunk fit in an empty death row
+ */
+#define IP_FRAG_BURST_SIZE	RTE_IP_FRAG_DEATH_ROW_LEN
+
+uint32_t ip_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mb,
+	struct ip_frag_burst *frag, uint32_t num, uint64_t tms,
+	struct rte_mbuf **out);
+
+struct rte_mbuf *ip_frag_process_mt(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, struct rte_mbuf *mb, uint16_t ofs, uint16_t len,
+	uint16_t more_frags);
+
 /* these functions need to be declared here as ip_frag_process relies on them */
 struct rte_mbuf *ipv4_frag_reassemble(struct ip_frag_pkt *fp);
 struct rte_mbuf *ipv6_frag_reassemble(struct ip_frag_pkt *fp);
@@ -185,4 +211,16 @@ ip_frag_tbl_del(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, del_num, 1);
 }
 
+/* delete an entry of the MT table, its bucket lock is held */
+static inline void
+ip_frag_tbl_mt_del(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct ip_frag_pkt *fp)
+{
+	ip_frag_free(fp, dr);
+	ip_frag_key_invalidate(&fp->key);
+	rte_atomic_fetch_sub_explicit(&tbl->mt_use_entries, 1,
+		rte_memory_order_relaxed);
+	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, del_num, 1);
+}
+
 #endif /* _IP_FRAG_COMMON_H_ */
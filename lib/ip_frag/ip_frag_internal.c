@@ -6,6 +6,7 @@
 
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
+#include <rte_prefetch.h>
 
 #include "ip_frag_common.h"
 
@@ -218,24 +219,18 @@ ip_frag_process(struct ip_frag_pkt *fp, struct rte_ip_frag_death_row *dr,
  * If such entry is not present, then allocate a new one.
  * If the entry is stale, then free and reuse it.
  */
-struct ip_frag_pkt *
-ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
-	const struct ip_frag_key *key, uint64_t tms)
+static inline struct ip_frag_pkt *
+ip_frag_find_update(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, struct ip_frag_pkt *pkt, struct ip_frag_pkt *free,
+	struct ip_frag_pkt *stale)
 {
-	struct ip_frag_pkt *pkt, *free, *stale, *lru;
+	struct ip_frag_pkt *lru;
 	uint64_t max_cycles;
 
-	/*
-	 * Actually the two line below are totally redundant.
-	 * they are here, just to make gcc 4.6 happy.
-	 */
-	free = NULL;
-	stale = NULL;
 	max_cycles = tbl->max_cycles;
 
-	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, find_num, 1);
-
-	if ((pkt = ip_frag_lookup(tbl, key, tms, &free, &stale)) == NULL) {
+	if (pkt == NULL) {
 
 		/*timed-out entry, free and invalidate it*/
 		if (stale != NULL) {
@@ -281,14 +276,34 @@ ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
 }
 
 struct ip_frag_pkt *
-ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
-	const struct ip_frag_key *key, uint64_t tms,
-	struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
+ip_frag_find(struct rte_ip_frag_tbl *tbl, struct rte_ip_frag_death_row *dr,
+	const struct ip_frag_key *key, uint64_t tms)
+{
+	struct ip_frag_pkt *pkt, *free, *stale;
+
+	/*
+	 * Actually the two line below are totally redundant.
+	 * they are here, just to make gcc 4.6 happy.
+	 */
+	free = NULL;
+	stale = NULL;
+
+	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, find_num, 1);
+
+	pkt = ip_frag_lookup(tbl, key, tms, &free, &stale);
+
+	return ip_frag_find_update(tbl, dr, key, tms, pkt, free, stale);
+}
+
+static inline struct ip_frag_pkt *
+ip_frag_lookup_sig(struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key, uint32_t sig1, uint32_t sig2,
+	uint64_t tms, struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
 {
 	struct ip_frag_pkt *p1, *p2;
 	struct ip_frag_pkt *empty, *old;
 	uint64_t max_cycles;
-	uint32_t i, assoc, sig1, sig2;
+	uint32_t i, assoc;
 
 	empty = NULL;
 	old = NULL;
@@ -296,15 +311,6 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	max_cycles = tbl->max_cycles;
 	assoc = tbl->bucket_entries;
 
-	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
-		return tbl->last;
-
-	/* different hashing methods for IPv4 and IPv6 */
-	if (key->key_len == IPV4_KEYLEN)
-		ipv4_frag_hash(key, &sig1, &sig2);
-	else
-		ipv6_frag_hash(key, &sig1, &sig2);
-
 	p1 = IP_FRAG_TBL_POS(tbl, sig1);
 	p2 = IP_FRAG_TBL_POS(tbl, sig2);
 
@@ -366,3 +372,244 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	*stale = old;
 	return NULL;
 }
+
+struct ip_frag_pkt *
+ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key, uint64_t tms,
+	struct ip_frag_pkt **free, struct ip_frag_pkt **stale)
+{
+	uint32_t sig1, sig2;
+
+	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
+		return tbl->last;
+
+	/* different hashing methods for IPv4 and IPv6 */
+	if (key->key_len == IPV4_KEYLEN)
+		ipv4_frag_hash(key, &sig1, &sig2);
+	else
+		ipv6_frag_hash(key, &sig1, &sig2);
+
+	return ip_frag_lookup_sig(tbl, key, sig1, sig2, tms, free, stale);
+}
+
+/*
+ * Lock the two buckets of a key in the MT table.
+ * The locks are taken in address order to avoid deadlocks between lcores.
+ */
+static inline void
+ip_frag_tbl_lock(struct ip_frag_pkt *p1, struct ip_frag_pkt *p2)
+{
+	if (p1 > p2)
+		RTE_SWAP(p1, p2);
+
+	rte_spinlock_lock(&p1->lock);
+	if (p2 != p1)
+		rte_spinlock_lock(&p2->lock);
+}
+
+static inline void
+ip_frag_tbl_unlock(struct ip_frag_pkt *p1, struct ip_frag_pkt *p2)
+{
+	rte_spinlock_unlock(&p1->lock);
+	if (p2 != p1)
+		rte_spinlock_unlock(&p2->lock);
+}
+
+/* reserve an entry of the MT table, fails if the table is full */
+static inline int
+ip_frag_tbl_mt_add(struct rte_ip_frag_tbl *tbl)
+{
+	if (rte_atomic_fetch_add_explicit(&tbl->mt_use_entries, 1,
+			rte_memory_order_relaxed) < tbl->max_entries)
+		return 1;
+
+	rte_atomic_fetch_sub_explicit(&tbl->mt_use_entries, 1,
+		rte_memory_order_relaxed);
+	return 0;
+}
+
+/*
+ * Find or add the entry of a fragment in the MT table and process it,
+ * holding the locks of the two buckets of the key.
+ * There is no LRU list in the MT table: timed out entries are reused when
+ * found in the buckets of a key, or deleted by
+ * rte_ip_frag_table_del_expired_entries().
+ */
+static struct rte_mbuf *
+ip_frag_process_mt_sig(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint32_t sig1, uint32_t sig2, uint64_t tms, struct rte_mbuf *mb,
+	uint16_t ofs, uint16_t len, uint16_t more_frags)
+{
+	struct ip_frag_pkt *p1, *p2, *fp, *free, *stale;
+
+	p1 = IP_FRAG_TBL_POS(tbl, sig1);
+	p2 = IP_FRAG_TBL_POS(tbl, sig2);
+
+	ip_frag_tbl_lock(p1, p2);
+
+	IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, find_num, 1);
+
+	free = NULL;
+	stale = NULL;
+	fp = ip_frag_lookup_sig(tbl, key, sig1, sig2, tms, &free, &stale);
+
+	if (fp == NULL) {
+		/* timed-out entry, free and reuse it in place. */
+		if (stale != NULL) {
+			ip_frag_free(stale, dr);
+			fp = stale;
+			IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, reuse_num, 1);
+		} else if (free != NULL && ip_frag_tbl_mt_add(tbl)) {
+			fp = free;
+			IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, add_num, 1);
+		} else {
+			IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, fail_nospace,
+				(free != NULL));
+			IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, fail_total, 1);
+			ip_frag_tbl_unlock(p1, p2);
+			IP_FRAG_MBUF2DR(dr, mb);
+			return NULL;
+		}
+		fp->key = key[0];
+		ip_frag_reset(fp, tms);
+
+	/* we found the flow, but it is already timed out. */
+	} else if (tbl->max_cycles + fp->start < tms) {
+		ip_frag_free(fp, dr);
+		ip_frag_reset(fp, tms);
+		IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, reuse_num, 1);
+	}
+
+	mb = ip_frag_process(fp, dr, mb, ofs, len, more_frags);
+
+	/* the entry was freed by the reassembly or an error. */
+	if (ip_frag_key_is_empty(&fp->key))
+		rte_atomic_fetch_sub_explicit(&tbl->mt_use_entries, 1,
+			rte_memory_order_relaxed);
+
+	ip_frag_tbl_unlock(p1, p2);
+
+	return mb;
+}
+
+struct rte_mbuf *
+ip_frag_process_mt(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, const struct ip_frag_key *key,
+	uint64_t tms, struct rte_mbuf *mb, uint16_t ofs, uint16_t len,
+	uint16_t more_frags)
+{
+	uint32_t sig1, sig2;
+
+	if (key->key_len == IPV4_KEYLEN)
+		ipv4_frag_hash(key, &sig1, &sig2);
+	else
+		ipv6_frag_hash(key, &sig1, &sig2);
+
+	return ip_frag_process_mt_sig(tbl, dr, key, sig1, sig2, tms, mb, ofs,
+		len, more_frags);
+}
+
+/* prefetch the keys of a hash table bucket */
+static inline void
+ip_frag_tbl_prefetch(const struct rte_ip_frag_tbl *tbl, uint32_t sig)
+{
+	const struct ip_frag_pkt *p;
+	uint32_t i;
+
+	p = IP_FRAG_TBL_POS(tbl, sig);
+	for (i = 0; i != tbl->bucket_entries; i++)
+		rte_prefetch0(&p[i].key);
+}
+
+/*
+ * Delete up to num timed out entries at the head of the LRU list,
+ * so that the lookups of a burst find free entries in a full table,
+ * instead of each checking the LRU list.
+ */
+static inline void
+ip_frag_tbl_expire(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, uint32_t num, uint64_t tms)
+{
+	struct ip_frag_pkt *fp;
+
+	while (num-- != 0 && tbl->use_entries != 0) {
+		fp = TAILQ_FIRST(&tbl->lru);
+		if (tbl->max_cycles + fp->start >= tms ||
+				RTE_IP_FRAG_DEATH_ROW_MBUF_LEN - dr->cnt <
+				fp->last_idx)
+			return;
+		ip_frag_tbl_del(tbl, dr, fp);
+	}
+}
+
+uint32_t
+ip_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mb,
+	struct ip_frag_burst *frag, uint32_t num, uint64_t tms,
+	struct rte_mbuf **out)
+{
+	struct ip_frag_pkt *fp, *free, *stale;
+	struct rte_mbuf *m;
+	uint32_t i, nb_out;
+
+	/* hash all the keys and prefetch their buckets */
+	for (i = 0; i != num; i++) {
+		if (mb[i] == NULL)
+			continue;
+		if (frag[i].key.key_len == IPV4_KEYLEN)
+			ipv4_frag_hash(&frag[i].key, &frag[i].sig1,
+				&frag[i].sig2);
+		else
+			ipv6_frag_hash(&frag[i].key, &frag[i].sig1,
+				&frag[i].sig2);
+		ip_frag_tbl_prefetch(tbl, frag[i].sig1);
+		ip_frag_tbl_prefetch(tbl, frag[i].sig2);
+	}
+
+	if (!tbl->mt_safe && tbl->use_entries + num > tbl->max_entries)
+		ip_frag_tbl_expire(tbl, dr,
+			tbl->use_entries + num - tbl->max_entries, tms);
+
+	nb_out = 0;
+	for (i = 0; i != num; i++) {
+		if (mb[i] == NULL)
+			continue;
+
+		if (tbl->mt_safe) {
+			m = ip_frag_process_mt_sig(tbl, dr, &frag[i].key,
+				frag[i].sig1, frag[i].sig2, tms, mb[i],
+				frag[i].ofs, frag[i].len, frag[i].more_frags);
+			if (m != NULL)
+				out[nb_out++] = m;
+			continue;
+		}
+
+		IP_FRAG_TBL_STAT_UPDATE(&tbl->stat, find_num, 1);
+
+		free = NULL;
+		stale = NULL;
+		if (tbl->last != NULL &&
+				ip_frag_key_cmp(&frag[i].key, &tbl->last->key) == 0)
+			fp = tbl->last;
+		else
+			fp = ip_frag_lookup_sig(tbl, &frag[i].key,
+				frag[i].sig1, frag[i].sig2, tms, &free, &stale);
+
+		fp = ip_frag_find_update(tbl, dr, &frag[i].key, tms, fp, free,
+			stale);
+		if (fp == NULL) {
+			IP_FRAG_MBUF2DR(dr, mb[i]);
+			continue;
+		}
+
+		m = ip_frag_process(fp, dr, mb[i], frag[i].ofs, frag[i].len,
+			frag[i].more_frags);
+		ip_frag_inuse(tbl, fp);
+
+		if (m != NULL)
+			out[nb_out++] = m;
+	}
+
+	return nb_out;
+}
@@ -11,6 +11,8 @@
  */
 
 #include <rte_ip_frag.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 
 enum {
 	IP_LAST_FRAG_IDX,    /* index of last fragment */
@@ -54,6 +56,7 @@ struct __rte_cache_aligned ip_frag_pkt {
 	uint32_t total_size;                   /* expected reassembled size */
 	uint32_t frag_size;                    /* size of fragments received */
 	uint32_t last_idx;                     /* index of next entry to fill */
+	rte_spinlock_t lock;                   /* bucket lock, MT table only */
 	struct ip_frag frags[IP_MAX_FRAG_NUM]; /* fragments */
 };
 
@@ -79,6 +82,8 @@ struct rte_ip_frag_tbl {
 	uint32_t bucket_entries; /* hash associativity. */
 	uint32_t nb_entries;     /* total size of the table. */
 	uint32_t nb_buckets;     /* num of associativity lines. */
+	bool mt_safe;            /* table shared by multiple lcores. */
+	RTE_ATOMIC(uint32_t) mt_use_entries; /* entries in use, MT table. */
 	struct ip_frag_pkt *last;     /* last used entry. */
 	struct ip_pkt_list lru;       /* LRU list for table entries. */
 	struct ip_frag_tbl_stat stat; /* statistics counters. */
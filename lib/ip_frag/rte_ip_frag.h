@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <rte_compat.h>
 #include <rte_config.h>
 #include <rte_malloc.h>
 #include <rte_memory.h>
@@ -64,6 +65,45 @@ struct rte_ip_frag_tbl * rte_ip_frag_table_create(uint32_t bucket_num,
 		uint32_t bucket_entries,  uint32_t max_entries,
 		uint64_t max_cycles, int socket_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a new IP fragmentation table which can be used by multiple lcores
+ * concurrently.
+ *
+ * The fragments of a packet can be processed by any lcore, the lcore
+ * processing the last missing fragment gets the reassembled packet.
+ * Each lcore must use its own death row.
+ *
+ * The lookups lock the two buckets of the fragment key.
+ * There is no LRU list: a timed out entry is reused when found in the
+ * buckets of a new key, otherwise it is deleted by
+ * rte_ip_frag_table_del_expired_entries(), which should be called
+ * periodically as it scans the whole table.
+ * The statistics are not accurate with this table.
+ *
+ * @param bucket_num
+ *   Number of buckets in the hash table.
+ * @param bucket_entries
+ *   Number of entries per bucket (e.g. hash associativity).
+ *   Should be power of two.
+ * @param max_entries
+ *   Maximum number of entries that could be stored in the table.
+ *   The value should be less or equal then bucket_num * bucket_entries.
+ * @param max_cycles
+ *   Maximum TTL in cycles for each fragmented packet.
+ * @param socket_id
+ *   The *socket_id* argument is the socket identifier in the case of
+ *   NUMA. The value can be *SOCKET_ID_ANY* if there is no NUMA constraints.
+ * @return
+ *   The pointer to the new allocated fragmentation table, on success. NULL on error.
+ */
+__rte_experimental
+struct rte_ip_frag_tbl *rte_ip_frag_table_create_mt(uint32_t bucket_num,
+		uint32_t bucket_entries, uint32_t max_entries,
+		uint64_t max_cycles, int socket_id);
+
 /**
  * Free allocated IP fragmentation table.
  *
@@ -128,6 +168,47 @@ struct rte_mbuf *rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 		struct rte_mbuf *mb, uint64_t tms, struct rte_ipv6_hdr *ip_hdr,
 		struct rte_ipv6_fragment_ext *frag_hdr);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * This function implements reassembly of a burst of IPv6 packets.
+ * Incoming mbufs should have their l2_len/l3_len fields setup correctly.
+ *
+ * The table buckets of all the fragments are hashed and prefetched
+ * before the fragments are processed, and the timed out entries are
+ * deleted once per burst if the table is full.
+ * The fragment header must immediately follow the fixed IPv6 header,
+ * see rte_ipv6_frag_get_ipv6_fragment_header().
+ * The packets which are not fragments are returned unchanged in *out*.
+ *
+ * The incoming mbufs are processed in chunks of RTE_IP_FRAG_DEATH_ROW_LEN,
+ * and the death row is freed between the chunks, so *nb_mbs* is not
+ * limited. The death row must be empty when calling this function, and
+ * freed after it returns.
+ *
+ * @param tbl
+ *   Table where to lookup/add the fragmented packets.
+ * @param dr
+ *   Death row to free buffers to
+ * @param mbs
+ *   Incoming mbufs.
+ * @param nb_mbs
+ *   Number of incoming mbufs.
+ * @param tms
+ *   Fragments arrival timestamp.
+ * @param out
+ *   Array of at least *nb_mbs* entries, filled with the reassembled
+ *   packets and the packets which are not fragments, not necessarily
+ *   in the incoming order.
+ * @return
+ *   Number of packets in *out*.
+ */
+__rte_experimental
+uint16_t rte_ipv6_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+		struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+		uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out);
+
 /**
  * Return a pointer to the packet's fragment header, if found.
  * It only looks at the extension header that's right after the fixed IPv6
@@ -234,6 +315,45 @@ struct rte_mbuf * rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 		struct rte_ip_frag_death_row *dr,
 		struct rte_mbuf *mb, uint64_t tms, struct rte_ipv4_hdr *ip_hdr);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * This function implements reassembly of a burst of IPv4 packets.
+ * Incoming mbufs should have their l2_len/l3_len fields setup correctly.
+ *
+ * The table buckets of all the fragments are hashed and prefetched
+ * before the fragments are processed, and the timed out entries are
+ * deleted once per burst if the table is full.
+ * The packets which are not fragments are returned unchanged in *out*.
+ *
+ * The incoming mbufs are processed in chunks of RTE_IP_FRAG_DEATH_ROW_LEN,
+ * and the death row is freed between the chunks, so *nb_mbs* is not
+ * limited. The death row must be empty when calling this function, and
+ * freed after it returns.
+ *
+ * @param tbl
+ *   Table where to lookup/add the fragmented packets.
+ * @param dr
+ *   Death row to free buffers to
+ * @param mbs
+ *   Incoming mbufs.
+ * @param nb_mbs
+ *   Number of incoming mbufs.
+ * @param tms
+ *   Fragments arrival timestamp.
+ * @param out
+ *   Array of at least *nb_mbs* entries, filled with the reassembled
+ *   packets and the packets which are not fragments, not necessarily
+ *   in the incoming order.
+ * @return
+ *   Number of packets in *out*.
+ */
+__rte_experimental
+uint16_t rte_ipv4_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+		struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+		uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out);
+
 /**
  * Check if the IPv4 packet is fragmented
  *
@@ -280,6 +400,9 @@ rte_ip_frag_table_statistics_dump(FILE * f, const struct rte_ip_frag_tbl *tbl);
 /**
  * Delete expired fragments
  *
+ * For a table created with rte_ip_frag_table_create_mt(),
+ * all the entries are checked, stopping if the death row is full.
+ *
  * @param tbl
  *   Table to delete expired fragments from
  * @param dr
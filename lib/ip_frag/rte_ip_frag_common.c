@@ -37,11 +37,12 @@ rte_ip_frag_free_death_row(struct rte_ip_frag_death_row *dr,
 	dr->cnt = 0;
 }
 
-/* create fragmentation table */
-struct rte_ip_frag_tbl *
-rte_ip_frag_table_create(uint32_t bucket_num, uint32_t bucket_entries,
-	uint32_t max_entries, uint64_t max_cycles, int socket_id)
+static struct rte_ip_frag_tbl *
+ip_frag_table_create(uint32_t bucket_num, uint32_t bucket_entries,
+	uint32_t max_entries, uint64_t max_cycles, bool mt_safe, int socket_id)
 {
+	struct ip_frag_pkt *fp;
+	uint32_t i;
 	struct rte_ip_frag_tbl *tbl;
 	size_t sz;
 	uint64_t nb_entries;
@@ -76,19 +77,53 @@ rte_ip_frag_table_create(uint32_t bucket_num, uint32_t bucket_entries,
 	tbl->nb_buckets = bucket_num;
 	tbl->bucket_entries = bucket_entries;
 	tbl->entry_mask = (tbl->nb_entries - 1) & ~(tbl->bucket_entries  - 1);
+	tbl->mt_safe = mt_safe;
+
+	/* the lock of a bucket is in its first entry. */
+	for (i = 0; i < tbl->nb_entries; i += tbl->bucket_entries) {
+		fp = tbl->pkt + i;
+		rte_spinlock_init(&fp->lock);
+	}
 
 	TAILQ_INIT(&(tbl->lru));
 	return tbl;
 }
 
+/* create fragmentation table */
+struct rte_ip_frag_tbl *
+rte_ip_frag_table_create(uint32_t bucket_num, uint32_t bucket_entries,
+	uint32_t max_entries, uint64_t max_cycles, int socket_id)
+{
+	return ip_frag_table_create(bucket_num, bucket_entries, max_entries,
+		max_cycles, false, socket_id);
+}
+
+/* create fragmentation table shared by multiple lcores */
+struct rte_ip_frag_tbl *
+rte_ip_frag_table_create_mt(uint32_t bucket_num, uint32_t bucket_entries,
+	uint32_t max_entries, uint64_t max_cycles, int socket_id)
+{
+	return ip_frag_table_create(bucket_num, bucket_entries, max_entries,
+		max_cycles, true, socket_id);
+}
+
 /* delete fragmentation table */
 void
 rte_ip_frag_table_destroy(struct rte_ip_frag_tbl *tbl)
 {
 	struct ip_frag_pkt *fp;
-
-	TAILQ_FOREACH(fp, &tbl->lru, lru) {
-		ip_frag_free_immediate(fp);
+	uint32_t i;
+
+	if (tbl->mt_safe) {
+		for (i = 0; i != tbl->nb_entries; i++) {
+			fp = tbl->pkt + i;
+			if (!ip_frag_key_is_empty(&fp->key))
+				ip_frag_free_immediate(fp);
+		}
+	} else {
+		TAILQ_FOREACH(fp, &tbl->lru, lru) {
+			ip_frag_free_immediate(fp);
+		}
 	}
 
 	rte_free(tbl);
@@ -99,10 +134,17 @@ void
 rte_ip_frag_table_statistics_dump(FILE *f, const struct rte_ip_frag_tbl *tbl)
 {
 	uint64_t fail_total, fail_nospace;
+	uint32_t use_entries;
 
 	fail_total = tbl->stat.fail_total;
 	fail_nospace = tbl->stat.fail_nospace;
 
+	if (tbl->mt_safe)
+		use_entries = rte_atomic_load_explicit(&tbl->mt_use_entries,
+			rte_memory_order_relaxed);
+	else
+		use_entries = tbl->use_entries;
+
 	fprintf(f, "max entries:\t%u;\n"
 		"entries in use:\t%u;\n"
 		"finds/inserts:\t%" PRIu64 ";\n"
@@ -113,7 +155,7 @@ rte_ip_frag_table_statistics_dump(FILE *f, const struct rte_ip_frag_tbl *tbl)
 		"add no-space failures:\t%" PRIu64 ";\n"
 		"add hash-collisions failures:\t%" PRIu64 ";\n",
 		tbl->max_entries,
-		tbl->use_entries,
+		use_entries,
 		tbl->stat.find_num,
 		tbl->stat.add_num,
 		tbl->stat.del_num,
@@ -123,6 +165,37 @@ rte_ip_frag_table_statistics_dump(FILE *f, const struct rte_ip_frag_tbl *tbl)
 		fail_total - fail_nospace);
 }
 
+/*
+ * Delete expired fragments of the MT table.
+ * There is no LRU list, all the buckets are scanned, each one locked.
+ */
+static void
+ip_frag_table_mt_del_expired_entries(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, uint64_t tms)
+{
+	struct ip_frag_pkt *bkt, *fp;
+	uint32_t i, j;
+
+	for (i = 0; i < tbl->nb_entries; i += tbl->bucket_entries) {
+		bkt = tbl->pkt + i;
+		rte_spinlock_lock(&bkt->lock);
+		for (j = 0; j != tbl->bucket_entries; j++) {
+			fp = bkt + j;
+			if (ip_frag_key_is_empty(&fp->key) ||
+					tbl->max_cycles + fp->start >= tms)
+				continue;
+			/* check that death row has enough space */
+			if (RTE_IP_FRAG_DEATH_ROW_MBUF_LEN - dr->cnt <
+					fp->last_idx) {
+				rte_spinlock_unlock(&bkt->lock);
+				return;
+			}
+			ip_frag_tbl_mt_del(tbl, dr, fp);
+		}
+		rte_spinlock_unlock(&bkt->lock);
+	}
+}
+
 /* Delete expired fragments */
 void
 rte_ip_frag_table_del_expired_entries(struct rte_ip_frag_tbl *tbl,
@@ -131,6 +204,11 @@ rte_ip_frag_table_del_expired_entries(struct rte_ip_frag_tbl *tbl,
 	uint64_t max_cycles;
 	struct ip_frag_pkt *fp;
 
+	if (tbl->mt_safe) {
+		ip_frag_table_mt_del_expired_entries(tbl, dr, tms);
+		return;
+	}
+
 	max_cycles = tbl->max_cycles;
 
 	TAILQ_FOREACH(fp, &tbl->lru, lru)
@@ -137,6 +137,11 @@ rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 	if (unlikely(trim > 0))
 		rte_pktmbuf_trim(mb, trim);
 
+	/* table shared by multiple lcores. */
+	if (tbl->mt_safe)
+		return ip_frag_process_mt(tbl, dr, &key, tms, mb, ip_ofs,
+			ip_len, ip_flag);
+
 	/* try to find/add entry into the fragment's table. */
 	if ((fp = ip_frag_find(tbl, dr, &key, tms)) == NULL) {
 		IP_FRAG_MBUF2DR(dr, mb);
@@ -169,3 +174,74 @@ rte_ipv4_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 
 	return mb;
 }
+
+uint16_t
+rte_ipv4_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+	uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out)
+{
+	struct ip_frag_burst frag[IP_FRAG_BURST_SIZE];
+	struct rte_mbuf *mb[IP_FRAG_BURST_SIZE];
+	struct rte_ipv4_hdr *ip_hdr;
+	struct rte_mbuf *m;
+	uint16_t flag_offset;
+	uint32_t i, j, n, nb_out;
+	int32_t ip_len;
+	int32_t trim;
+
+	nb_out = 0;
+	for (i = 0; i < nb_mbs; i += n) {
+		n = RTE_MIN(nb_mbs - i, (uint32_t)IP_FRAG_BURST_SIZE);
+
+		/* Make room in the death row for the mbufs of the chunk */
+		if (i != 0 && dr->cnt != 0)
+			rte_ip_frag_free_death_row(dr, 0);
+
+		for (j = 0; j != n; j++) {
+			m = mbs[i + j];
+			mb[j] = NULL;
+
+			ip_hdr = rte_pktmbuf_mtod_offset(m,
+				struct rte_ipv4_hdr *, m->l2_len);
+
+			/* not a fragment, nothing to reassemble. */
+			if (!rte_ipv4_frag_pkt_is_fragmented(ip_hdr)) {
+				out[nb_out++] = m;
+				continue;
+			}
+
+			flag_offset = rte_be_to_cpu_16(ip_hdr->fragment_offset);
+			frag[j].ofs = (uint16_t)(flag_offset &
+				RTE_IPV4_HDR_OFFSET_MASK) *
+				RTE_IPV4_HDR_OFFSET_UNITS;
+			frag[j].more_frags = (uint16_t)(flag_offset &
+				RTE_IPV4_HDR_MF_FLAG);
+
+			/* use first 8 bytes only */
+			memcpy(&frag[j].key.src_dst[0], &ip_hdr->src_addr, 8);
+			frag[j].key.id = ip_hdr->packet_id;
+			frag[j].key.key_len = IPV4_KEYLEN;
+
+			ip_len = rte_be_to_cpu_16(ip_hdr->total_length) -
+				m->l3_len;
+			trim = m->pkt_len - (ip_len + m->l3_len + m->l2_len);
+
+			/* check that fragment length is greater then zero. */
+			if (ip_len <= 0) {
+				IP_FRAG_MBUF2DR(dr, m);
+				continue;
+			}
+
+			if (unlikely(trim > 0))
+				rte_pktmbuf_trim(m, trim);
+
+			frag[j].len = ip_len;
+			mb[j] = m;
+		}
+
+		nb_out += ip_frag_reassemble_burst(tbl, dr, mb, frag, n, tms,
+			out + nb_out);
+	}
+
+	return nb_out;
+}
@@ -181,6 +181,11 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 	if (unlikely(trim > 0))
 		rte_pktmbuf_trim(mb, trim);
 
+	/* table shared by multiple lcores. */
+	if (tbl->mt_safe)
+		return ip_frag_process_mt(tbl, dr, &key, tms, mb, ip_ofs,
+			ip_len, MORE_FRAGS(frag_hdr->frag_data));
+
 	/* try to find/add entry into the fragment's table. */
 	fp = ip_frag_find(tbl, dr, &key, tms);
 	if (fp == NULL) {
@@ -215,3 +220,72 @@ rte_ipv6_frag_reassemble_packet(struct rte_ip_frag_tbl *tbl,
 
 	return mb;
 }
+
+uint16_t
+rte_ipv6_frag_reassemble_burst(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **mbs,
+	uint16_t nb_mbs, uint64_t tms, struct rte_mbuf **out)
+{
+	struct ip_frag_burst frag[IP_FRAG_BURST_SIZE];
+	struct rte_mbuf *mb[IP_FRAG_BURST_SIZE];
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	struct rte_ipv6_hdr *ip_hdr;
+	struct rte_mbuf *m;
+	uint32_t i, j, n, nb_out;
+	int32_t ip_len;
+	int32_t trim;
+
+	nb_out = 0;
+	for (i = 0; i < nb_mbs; i += n) {
+		n = RTE_MIN(nb_mbs - i, (uint32_t)IP_FRAG_BURST_SIZE);
+
+		/* Make room in the death row for the mbufs of the chunk */
+		if (i != 0 && dr->cnt != 0)
+			rte_ip_frag_free_death_row(dr, 0);
+
+		for (j = 0; j != n; j++) {
+			m = mbs[i + j];
+			mb[j] = NULL;
+
+			ip_hdr = rte_pktmbuf_mtod_offset(m,
+				struct rte_ipv6_hdr *, m->l2_len);
+			frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ip_hdr);
+
+			/* not a fragment, nothing to reassemble. */
+			if (frag_hdr == NULL) {
+				out[nb_out++] = m;
+				continue;
+			}
+
+			rte_memcpy(&frag[j].key.src_dst[0], &ip_hdr->src_addr, 16);
+			rte_memcpy(&frag[j].key.src_dst[2], &ip_hdr->dst_addr, 16);
+			frag[j].key.id = frag_hdr->id;
+			frag[j].key.key_len = IPV6_KEYLEN;
+
+			frag[j].ofs = FRAG_OFFSET(frag_hdr->frag_data) * 8;
+			frag[j].more_frags = MORE_FRAGS(frag_hdr->frag_data);
+
+			/* see rte_ipv6_frag_reassemble_packet() */
+			ip_len = rte_be_to_cpu_16(ip_hdr->payload_len) -
+				sizeof(*frag_hdr);
+			trim = m->pkt_len - (ip_len + m->l3_len + m->l2_len);
+
+			/* check that fragment length is greater then zero. */
+			if (ip_len <= 0) {
+				IP_FRAG_MBUF2DR(dr, m);
+				continue;
+			}
+
+			if (unlikely(trim > 0))
+				rte_pktmbuf_trim(m, trim);
+
+			frag[j].len = ip_len;
+			mb[j] = m;
+		}
+
+		nb_out += ip_frag_reassemble_burst(tbl, dr, mb, frag, n, tms,
+			out + nb_out);
+	}
+
+	return nb_out;
+}
@@ -23,6 +23,7 @@
 #include <rte_eal.h>
 #include <rte_eal_memconfig.h>
 #include <rte_errno.h>
+#include <rte_spinlock.h>
 #include <rte_string_fns.h>
 #include <rte_tailq.h>
 #include <rte_eal_paging.h>
@@ -40,11 +41,50 @@ static struct rte_tailq_elem rte_mempool_tailq = {
 };
 EAL_REGISTER_TAILQ(rte_mempool_tailq)
 
+/* Statistics of a shared cache, updated with its lock held. */
+struct mempool_shared_cache_stats {
+	uint64_t put_bulk;             /* Number of flushes to the cache. */
+	uint64_t put_objs;             /* Objects flushed to the cache. */
+	uint64_t put_common_pool_objs; /* Objects not fitting in the cache. */
+	uint64_t get_bulk;             /* Number of refills from the cache. */
+	uint64_t get_objs;             /* Objects taken from the cache. */
+	uint64_t get_common_pool_objs; /* Objects missing in the cache. */
+	uint64_t get_fail_bulk;        /* Refills failed in the common pool. */
+};
+
+/* Cache shared by a group of lcores, between their caches and the pool. */
+struct rte_mempool_shared_cache {
+	TAILQ_ENTRY(rte_mempool_shared_cache) next;
+	char name[RTE_MEMPOOL_NAMESIZE];
+	struct rte_mempool *mp;
+	uint32_t size;      /* Maximum number of objects */
+	uint32_t nb_lcores; /* Number of attached lcores */
+	alignas(RTE_CACHE_LINE_SIZE) rte_spinlock_t lock;
+	uint32_t len;       /* Current number of objects */
+	struct mempool_shared_cache_stats stats;
+	alignas(RTE_CACHE_LINE_SIZE) void *objs[];
+};
+
+TAILQ_HEAD(mempool_shared_cache_list, rte_mempool_shared_cache);
+
+/*
+ * Shared caches of all mempools, local to the process which created them.
+ * A dedicated lock is used since the list is also walked from
+ * rte_mempool_walk() callbacks.
+ */
+static struct mempool_shared_cache_list shared_cache_list =
+		TAILQ_HEAD_INITIALIZER(shared_cache_list);
+static rte_spinlock_t shared_cache_list_lock = RTE_SPINLOCK_INITIALIZER;
+
 TAILQ_HEAD(mempool_callback_tailq, mempool_callback_data);
 
 static struct mempool_callback_tailq callback_tailq =
 		TAILQ_HEAD_INITIALIZER(callback_tailq);
 
+/* Free the shared caches of a mempool. */
+static void
+mempool_shared_cache_free_all(struct rte_mempool *mp);
+
 /* Invoke all registered mempool event callbacks. */
 static void
 mempool_event_callback_invoke(enum rte_mempool_event event,
@@ -738,6 +778,7 @@ rte_mempool_free(struct rte_mempool *mp)
 
 	mempool_event_callback_invoke(RTE_MEMPOOL_EVENT_DESTROY, mp);
 	rte_mempool_trace_free(mp);
+	mempool_shared_cache_free_all(mp);
 	rte_mempool_free_memchunks(mp);
 	rte_mempool_ops_free(mp);
 	rte_memzone_free(mp->mz);
@@ -754,6 +795,7 @@ mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
 	cache->size = size;
 	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
 	cache->len = 0;
+	cache->shared = NULL;
 }
 
 /*
@@ -797,6 +839,200 @@ rte_mempool_cache_free(struct rte_mempool_cache *cache)
 	rte_free(cache);
 }
 
+struct rte_mempool_shared_cache *
+rte_mempool_shared_cache_create(struct rte_mempool *mp, const char *name,
+		uint32_t size, int socket_id)
+{
+	struct rte_mempool_shared_cache *sc;
+
+	if (mp == NULL || name == NULL || mp->cache_size == 0 || size == 0 ||
+			size > mp->size) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	TAILQ_FOREACH(sc, &shared_cache_list, next) {
+		if (sc->mp == mp && strncmp(name, sc->name,
+				RTE_MEMPOOL_NAMESIZE) == 0)
+			break;
+	}
+	if (sc != NULL) {
+		rte_spinlock_unlock(&shared_cache_list_lock);
+		rte_errno = EEXIST;
+		return NULL;
+	}
+
+	sc = rte_zmalloc_socket("MEMPOOL_SHARED_CACHE",
+			sizeof(*sc) + sizeof(sc->objs[0]) * size,
+			RTE_CACHE_LINE_SIZE, socket_id);
+	if (sc == NULL) {
+		rte_spinlock_unlock(&shared_cache_list_lock);
+		RTE_MEMPOOL_LOG(ERR, "Cannot allocate mempool shared cache.");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	if (strlcpy(sc->name, name, sizeof(sc->name)) >= sizeof(sc->name)) {
+		rte_spinlock_unlock(&shared_cache_list_lock);
+		rte_free(sc);
+		rte_errno = ENAMETOOLONG;
+		return NULL;
+	}
+	sc->mp = mp;
+	sc->size = size;
+	rte_spinlock_init(&sc->lock);
+	TAILQ_INSERT_TAIL(&shared_cache_list, sc, next);
+	rte_spinlock_unlock(&shared_cache_list_lock);
+
+	return sc;
+}
+
+/* Detach all lcores, optionally flush the objects, and free. */
+static void
+mempool_shared_cache_destroy(struct rte_mempool_shared_cache *sc, bool flush)
+{
+	struct rte_mempool *mp = sc->mp;
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (mp->local_cache[lcore_id].shared == sc)
+			mp->local_cache[lcore_id].shared = NULL;
+	}
+
+	if (flush && sc->len != 0)
+		rte_mempool_ops_enqueue_bulk(mp, sc->objs, sc->len);
+
+	rte_free(sc);
+}
+
+/* Free the shared caches of a mempool being freed. */
+static void
+mempool_shared_cache_free_all(struct rte_mempool *mp)
+{
+	struct rte_mempool_shared_cache *sc, *tmp;
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	RTE_TAILQ_FOREACH_SAFE(sc, &shared_cache_list, next, tmp) {
+		if (sc->mp != mp)
+			continue;
+		TAILQ_REMOVE(&shared_cache_list, sc, next);
+		mempool_shared_cache_destroy(sc, false);
+	}
+	rte_spinlock_unlock(&shared_cache_list_lock);
+}
+
+void
+rte_mempool_shared_cache_free(struct rte_mempool_shared_cache *sc)
+{
+	if (sc == NULL)
+		return;
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	TAILQ_REMOVE(&shared_cache_list, sc, next);
+	rte_spinlock_unlock(&shared_cache_list_lock);
+
+	mempool_shared_cache_destroy(sc, true);
+}
+
+int
+rte_mempool_shared_cache_attach(struct rte_mempool_shared_cache *sc,
+		unsigned int lcore_id)
+{
+	struct rte_mempool_cache *cache;
+
+	if (sc == NULL || lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	cache = &sc->mp->local_cache[lcore_id];
+	if (cache->shared == sc)
+		return 0;
+	if (cache->shared != NULL)
+		return -EBUSY;
+
+	cache->shared = sc;
+	sc->nb_lcores++;
+	return 0;
+}
+
+int
+rte_mempool_shared_cache_detach(struct rte_mempool_shared_cache *sc,
+		unsigned int lcore_id)
+{
+	struct rte_mempool_cache *cache;
+
+	if (sc == NULL || lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	cache = &sc->mp->local_cache[lcore_id];
+	if (cache->shared != sc)
+		return -ENOENT;
+
+	cache->shared = NULL;
+	sc->nb_lcores--;
+	return 0;
+}
+
+void
+rte_mempool_shared_cache_put(struct rte_mempool *mp,
+		struct rte_mempool_shared_cache *sc, void * const *obj_table,
+		unsigned int n)
+{
+	unsigned int len;
+
+	rte_spinlock_lock(&sc->lock);
+	len = RTE_MIN(n, sc->size - sc->len);
+	memcpy(&sc->objs[sc->len], obj_table, sizeof(void *) * len);
+	sc->len += len;
+	sc->stats.put_bulk++;
+	sc->stats.put_objs += n;
+	sc->stats.put_common_pool_objs += n - len;
+	rte_spinlock_unlock(&sc->lock);
+
+	/* The objects which do not fit go to the common pool. */
+	if (n != len)
+		rte_mempool_ops_enqueue_bulk(mp, &obj_table[len], n - len);
+}
+
+int
+rte_mempool_shared_cache_get(struct rte_mempool *mp,
+		struct rte_mempool_shared_cache *sc, void **obj_table,
+		unsigned int n)
+{
+	unsigned int len;
+	int ret;
+
+	/* Take the most recently flushed objects first, they are hotter. */
+	rte_spinlock_lock(&sc->lock);
+	len = RTE_MIN(n, sc->len);
+	sc->len -= len;
+	memcpy(obj_table, &sc->objs[sc->len], sizeof(void *) * len);
+	sc->stats.get_bulk++;
+	sc->stats.get_objs += len;
+	sc->stats.get_common_pool_objs += n - len;
+	rte_spinlock_unlock(&sc->lock);
+
+	if (len == n)
+		return 0;
+
+	ret = rte_mempool_ops_dequeue_bulk(mp, &obj_table[len], n - len);
+	if (unlikely(ret < 0)) {
+		/* Give the objects back, the request cannot be satisfied. */
+		rte_spinlock_lock(&sc->lock);
+		n = RTE_MIN(len, sc->size - sc->len);
+		memcpy(&sc->objs[sc->len], obj_table, sizeof(void *) * n);
+		sc->len += n;
+		sc->stats.get_objs -= len;
+		sc->stats.get_fail_bulk++;
+		rte_spinlock_unlock(&sc->lock);
+
+		if (n != len)
+			rte_mempool_ops_enqueue_bulk(mp, &obj_table[n],
+					len - n);
+	}
+	return ret;
+}
+
 /* create an empty mempool */
 struct rte_mempool *
 rte_mempool_create_empty(const char *name, unsigned n, unsigned elt_size,
@@ -1001,6 +1237,23 @@ rte_mempool_create(const char *name, unsigned n, unsigned elt_size,
 	return NULL;
 }
 
+/* Return the number of objects in the shared caches of a mempool */
+static unsigned int
+mempool_shared_cache_count(const struct rte_mempool *mp)
+{
+	const struct rte_mempool_shared_cache *sc;
+	unsigned int count = 0;
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	TAILQ_FOREACH(sc, &shared_cache_list, next) {
+		if (sc->mp == mp)
+			count += sc->len;
+	}
+	rte_spinlock_unlock(&shared_cache_list_lock);
+
+	return count;
+}
+
 /* Return the number of entries in the mempool */
 unsigned int
 rte_mempool_avail_count(const struct rte_mempool *mp)
@@ -1015,6 +1268,7 @@ rte_mempool_avail_count(const struct rte_mempool *mp)
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
 		count += mp->local_cache[lcore_id].len;
+	count += mempool_shared_cache_count(mp);
 
 	/*
 	 * due to race condition (access to len is not locked), the
@@ -1039,6 +1293,8 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 	unsigned lcore_id;
 	unsigned count = 0;
 	unsigned cache_count;
+	unsigned shared_count = 0;
+	const struct rte_mempool_shared_cache *sc;
 
 	fprintf(f, "  internal cache infos:\n");
 	fprintf(f, "    cache_size=%"PRIu32"\n", mp->cache_size);
@@ -1053,7 +1309,35 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 		count += cache_count;
 	}
 	fprintf(f, "    total_cache_count=%u\n", count);
-	return count;
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	TAILQ_FOREACH(sc, &shared_cache_list, next) {
+		if (sc->mp != mp)
+			continue;
+		fprintf(f, "    shared cache <%s>@%p\n", sc->name, sc);
+		fprintf(f, "      size=%"PRIu32"\n", sc->size);
+		fprintf(f, "      len=%"PRIu32"\n", sc->len);
+		fprintf(f, "      nb_lcores=%"PRIu32"\n", sc->nb_lcores);
+		for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+			if (mp->local_cache[lcore_id].shared == sc)
+				fprintf(f, "      lcore=%u\n", lcore_id);
+		}
+		fprintf(f, "      put_bulk=%"PRIu64"\n", sc->stats.put_bulk);
+		fprintf(f, "      put_objs=%"PRIu64"\n", sc->stats.put_objs);
+		fprintf(f, "      put_common_pool_objs=%"PRIu64"\n",
+			sc->stats.put_common_pool_objs);
+		fprintf(f, "      get_bulk=%"PRIu64"\n", sc->stats.get_bulk);
+		fprintf(f, "      get_objs=%"PRIu64"\n", sc->stats.get_objs);
+		fprintf(f, "      get_common_pool_objs=%"PRIu64"\n",
+			sc->stats.get_common_pool_objs);
+		fprintf(f, "      get_fail_bulk=%"PRIu64"\n",
+			sc->stats.get_fail_bulk);
+		shared_count += sc->len;
+	}
+	rte_spinlock_unlock(&shared_cache_list_lock);
+	fprintf(f, "    total_shared_cache_count=%u\n", shared_count);
+
+	return count + shared_count;
 }
 
 /* check and update cookies or panic (internal) */
@@ -1197,6 +1481,12 @@ mempool_audit_cache(const struct rte_mempool *mp)
 				lcore_id);
 			rte_panic("MEMPOOL: invalid cache len\n");
 		}
+		if (cache->shared != NULL && cache->shared->len >
+				cache->shared->size) {
+			RTE_MEMPOOL_LOG(CRIT, "badness on shared cache <%s>",
+				cache->shared->name);
+			rte_panic("MEMPOOL: invalid shared cache len\n");
+		}
 	}
 }
 
@@ -1531,12 +1821,63 @@ struct mempool_info_cb_arg {
 	struct rte_tel_data *d;
 };
 
+/* Add the shared caches of a mempool, return their number of objects. */
+static uint64_t
+mempool_shared_cache_info(const struct rte_mempool *mp, struct rte_tel_data *d)
+{
+	const struct rte_mempool_shared_cache *sc;
+	struct rte_tel_data *caches, *c;
+	uint64_t count = 0;
+
+	caches = rte_tel_data_alloc();
+	if (caches == NULL) {
+		count = mempool_shared_cache_count(mp);
+		rte_tel_data_add_dict_uint(d, "total_shared_cache_count", count);
+		return count;
+	}
+	rte_tel_data_start_dict(caches);
+
+	rte_spinlock_lock(&shared_cache_list_lock);
+	TAILQ_FOREACH(sc, &shared_cache_list, next) {
+		if (sc->mp != mp)
+			continue;
+		count += sc->len;
+
+		c = rte_tel_data_alloc();
+		if (c == NULL)
+			continue;
+		rte_tel_data_start_dict(c);
+		rte_tel_data_add_dict_uint(c, "size", sc->size);
+		rte_tel_data_add_dict_uint(c, "len", sc->len);
+		rte_tel_data_add_dict_uint(c, "nb_lcores", sc->nb_lcores);
+		rte_tel_data_add_dict_uint(c, "put_bulk", sc->stats.put_bulk);
+		rte_tel_data_add_dict_uint(c, "put_objs", sc->stats.put_objs);
+		rte_tel_data_add_dict_uint(c, "put_common_pool_objs",
+				sc->stats.put_common_pool_objs);
+		rte_tel_data_add_dict_uint(c, "get_bulk", sc->stats.get_bulk);
+		rte_tel_data_add_dict_uint(c, "get_objs", sc->stats.get_objs);
+		rte_tel_data_add_dict_uint(c, "get_common_pool_objs",
+				sc->stats.get_common_pool_objs);
+		rte_tel_data_add_dict_uint(c, "get_fail_bulk",
+				sc->stats.get_fail_bulk);
+		if (rte_tel_data_add_dict_container(caches, sc->name, c, 0) != 0)
+			rte_tel_data_free(c);
+	}
+	rte_spinlock_unlock(&shared_cache_list_lock);
+
+	rte_tel_data_add_dict_uint(d, "total_shared_cache_count", count);
+	if (rte_tel_data_add_dict_container(d, "shared_caches", caches, 0) != 0)
+		rte_tel_data_free(caches);
+
+	return count;
+}
+
 static void
 mempool_info_cb(struct rte_mempool *mp, void *arg)
 {
 	struct mempool_info_cb_arg *info = (struct mempool_info_cb_arg *)arg;
 	const struct rte_memzone *mz;
-	uint64_t cache_count, common_count;
+	uint64_t cache_count, shared_count, common_count;
 
 	if (strncmp(mp->name, info->pool_name, RTE_MEMZONE_NAMESIZE))
 		return;
@@ -1563,6 +1904,8 @@ mempool_info_cb(struct rte_mempool *mp, void *arg)
 			cache_count += mp->local_cache[lcore_id].len;
 	}
 	rte_tel_data_add_dict_uint(info->d, "total_cache_count", cache_count);
+	shared_count = mempool_shared_cache_info(mp, info->d);
+	cache_count += shared_count;
 	common_count = rte_mempool_ops_get_count(mp);
 	if ((cache_count + common_count) > mp->size)
 		common_count = mp->size - cache_count;
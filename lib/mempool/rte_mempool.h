@@ -84,6 +84,8 @@ struct __rte_cache_aligned rte_mempool_debug_stats {
 };
 #endif
 
+struct rte_mempool_shared_cache;
+
 /**
  * A structure that stores a per-core object cache.
  */
@@ -104,6 +106,12 @@ struct __rte_cache_aligned rte_mempool_cache {
 		uint64_t get_success_objs;  /**< Objects successfully allocated. */
 	} stats;                        /**< Statistics */
 #endif
+	/**
+	 * Shared cache consulted before the common pool, NULL if none.
+	 * Only set for the default per-lcore caches, see
+	 * rte_mempool_shared_cache_attach().
+	 */
+	struct rte_mempool_shared_cache *shared;
 	/**
 	 * Cache objects
 	 *
@@ -1319,6 +1327,144 @@ rte_mempool_cache_create(uint32_t size, int socket_id);
 void
 rte_mempool_cache_free(struct rte_mempool_cache *cache);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a cache shared by a group of lcores.
+ *
+ * The default per-lcore caches of the lcores attached to a shared cache
+ * flush objects to it and refill from it, instead of using the common
+ * pool. Objects freed by one lcore of the group can then be allocated by
+ * another one without a round trip to the common pool, which helps when
+ * objects are allocated and freed on different lcores sharing the same
+ * physical core or the same cache hierarchy. The shared cache is
+ * protected by a lock, so it should only be shared by a few lcores.
+ *
+ * @param mp
+ *   A pointer to the mempool. Its per-lcore caches must be enabled.
+ * @param name
+ *   The name of the shared cache, unique for the mempool.
+ * @param size
+ *   The maximum number of objects in the shared cache. A flush exceeding
+ *   it is completed with the common pool. It should be a few times the
+ *   cache size of the mempool.
+ * @param socket_id
+ *   The socket identifier in the case of NUMA. The value can be
+ *   SOCKET_ID_ANY if there is no NUMA constraint for the reserved zone.
+ * @return
+ *   The pointer to the new shared cache, or NULL on error with rte_errno
+ *   set appropriately. Possible rte_errno values include:
+ *    - EINVAL - invalid parameter or mempool without per-lcore caches
+ *    - EEXIST - a shared cache with the same name exists for the mempool
+ *    - ENOMEM - no appropriate memory area found
+ */
+__rte_experimental
+struct rte_mempool_shared_cache *
+rte_mempool_shared_cache_create(struct rte_mempool *mp, const char *name,
+		uint32_t size, int socket_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a shared cache.
+ *
+ * The lcores still attached to it are detached, and the objects of the
+ * shared cache are returned to the common pool. None of the attached
+ * lcores may use the mempool during this call.
+ *
+ * @param sc
+ *   A pointer to the shared cache. If NULL then, the function does nothing.
+ */
+__rte_experimental
+void
+rte_mempool_shared_cache_free(struct rte_mempool_shared_cache *sc);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Attach the default cache of an lcore to a shared cache.
+ *
+ * The lcore must not use the mempool during this call.
+ *
+ * @param sc
+ *   A pointer to the shared cache.
+ * @param lcore_id
+ *   The lcore identifier.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid parameter.
+ *   - -EBUSY: The lcore is attached to another shared cache.
+ */
+__rte_experimental
+int
+rte_mempool_shared_cache_attach(struct rte_mempool_shared_cache *sc,
+		unsigned int lcore_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Detach the default cache of an lcore from a shared cache.
+ *
+ * The lcore must not use the mempool during this call.
+ *
+ * @param sc
+ *   A pointer to the shared cache.
+ * @param lcore_id
+ *   The lcore identifier.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid parameter.
+ *   - -ENOENT: The lcore is not attached to this shared cache.
+ */
+__rte_experimental
+int
+rte_mempool_shared_cache_detach(struct rte_mempool_shared_cache *sc,
+		unsigned int lcore_id);
+
+/**
+ * @internal Put objects flushed from a per-lcore cache in its shared
+ * cache, the objects not fitting in it go to the common pool; used
+ * internally.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param sc
+ *   A pointer to the shared cache.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to put.
+ */
+void
+rte_mempool_shared_cache_put(struct rte_mempool *mp,
+		struct rte_mempool_shared_cache *sc, void * const *obj_table,
+		unsigned int n);
+
+/**
+ * @internal Get objects for a per-lcore cache from its shared cache,
+ * completed from the common pool; used internally.
+ *
+ * @param mp
+ *   A pointer to the mempool structure.
+ * @param sc
+ *   A pointer to the shared cache.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to get.
+ * @return
+ *   - 0: Success; all objects are retrieved.
+ *   - <0: Error; code of driver dequeue function, no object is retrieved.
+ */
+int
+rte_mempool_shared_cache_get(struct rte_mempool *mp,
+		struct rte_mempool_shared_cache *sc, void **obj_table,
+		unsigned int n);
+
 /**
  * Get a pointer to the per-lcore default mempool cache.
  *
@@ -1407,7 +1553,12 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		cache->len += n;
 	} else {
 		cache_objs = &cache->objs[0];
-		rte_mempool_ops_enqueue_bulk(mp, cache_objs, cache->len);
+		if (cache->shared != NULL)
+			rte_mempool_shared_cache_put(mp, cache->shared,
+					cache_objs, cache->len);
+		else
+			rte_mempool_ops_enqueue_bulk(mp, cache_objs,
+					cache->len);
 		cache->len = n;
 	}
 
@@ -1569,9 +1720,16 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 	if (unlikely(remaining > RTE_MEMPOOL_CACHE_MAX_SIZE))
 		goto driver_dequeue;
 
-	/* Fill the cache from the backend; fetch size + remaining objects. */
-	ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs,
-			cache->size + remaining);
+	/*
+	 * Fill the cache from the shared cache if any, or from the backend;
+	 * fetch size + remaining objects.
+	 */
+	if (cache->shared != NULL)
+		ret = rte_mempool_shared_cache_get(mp, cache->shared,
+				cache->objs, cache->size + remaining);
+	else
+		ret = rte_mempool_ops_dequeue_bulk(mp, cache->objs,
+				cache->size + remaining);
 	if (unlikely(ret < 0)) {
 		/*
 		 * We are buffer constrained, and not able to allocate
@@ -1597,7 +1755,11 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 driver_dequeue:
 
 	/* Get remaining objects directly from the backend. */
-	ret = rte_mempool_ops_dequeue_bulk(mp, obj_table, remaining);
+	if (cache != NULL && cache->shared != NULL)
+		ret = rte_mempool_shared_cache_get(mp, cache->shared,
+				obj_table, remaining);
+	else
+		ret = rte_mempool_ops_dequeue_bulk(mp, obj_table, remaining);
 
 	if (ret < 0) {
 		if (likely(cache != NULL)) {
@@ -0,0 +1,56 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _NET_CKSUM_H_
+#define _NET_CKSUM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rte_cksum.h>
+
+/*
+ * The vector implementations add the 16-bit words of the buffer in 32-bit
+ * lanes, each lane taking at most 8 words per loop iteration. The lanes
+ * are folded into a 64-bit sum every NET_CKSUM_MAX_ITER iterations, before
+ * they can overflow.
+ */
+#define NET_CKSUM_MAX_ITER 4096
+
+/*
+ * Add the 16-bit words of a buffer to a sum, return a 32-bit sum which
+ * gives the same checksum as __rte_raw_cksum() once reduced.
+ */
+typedef uint32_t (*net_cksum_sum_t)(const void *buf, size_t len, uint32_t sum);
+
+/* Fold a 64-bit one's complement sum to 32 bits. */
+static inline uint32_t
+net_cksum_fold64(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	return (uint32_t)sum;
+}
+
+/* Sum a buffer with the best implementation available. */
+uint32_t
+net_cksum_sum(const void *buf, size_t len, uint32_t sum);
+
+/*
+ * Different implementations of the sum
+ */
+
+uint32_t
+net_cksum_sum_sse(const void *buf, size_t len, uint32_t sum);
+
+uint32_t
+net_cksum_sum_avx2(const void *buf, size_t len, uint32_t sum);
+
+uint32_t
+net_cksum_sum_avx512(const void *buf, size_t len, uint32_t sum);
+
+uint32_t
+net_cksum_sum_neon(const void *buf, size_t len, uint32_t sum);
+
+#endif /* _NET_CKSUM_H_ */
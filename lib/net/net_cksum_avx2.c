@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "net_cksum.h"
+
+/* Add the 16-bit words of a vector to the 32-bit lanes of the sum. */
+static __rte_always_inline __m256i
+net_cksum_add_avx2(__m256i acc, __m256i v)
+{
+	acc = _mm256_add_epi32(acc,
+		_mm256_and_si256(v, _mm256_set1_epi32(0xffff)));
+	return _mm256_add_epi32(acc, _mm256_srli_epi32(v, 16));
+}
+
+static __rte_always_inline uint64_t
+net_cksum_lanes_avx2(__m256i acc)
+{
+	alignas(32) uint32_t lanes[8];
+	uint64_t sum = 0;
+	unsigned int i;
+
+	_mm256_store_si256((__m256i *)lanes, acc);
+	for (i = 0; i < RTE_DIM(lanes); i++)
+		sum += lanes[i];
+	return sum;
+}
+
+uint32_t
+net_cksum_sum_avx2(const void *buf, size_t len, uint32_t sum)
+{
+	const __m256i *p = buf;
+	uint64_t sum64 = sum;
+	__m256i acc;
+	size_t n;
+
+	/* 128 bytes per iteration */
+	while (len >= 4 * sizeof(__m256i)) {
+		n = RTE_MIN(len / (4 * sizeof(__m256i)),
+			(size_t)NET_CKSUM_MAX_ITER);
+		len -= n * 4 * sizeof(__m256i);
+		acc = _mm256_setzero_si256();
+		for (; n != 0; n--, p += 4) {
+			acc = net_cksum_add_avx2(acc, _mm256_loadu_si256(p));
+			acc = net_cksum_add_avx2(acc, _mm256_loadu_si256(p + 1));
+			acc = net_cksum_add_avx2(acc, _mm256_loadu_si256(p + 2));
+			acc = net_cksum_add_avx2(acc, _mm256_loadu_si256(p + 3));
+		}
+		sum64 += net_cksum_lanes_avx2(acc);
+	}
+
+	if (len >= sizeof(__m256i)) {
+		acc = _mm256_setzero_si256();
+		for (; len >= sizeof(__m256i); len -= sizeof(__m256i), p++)
+			acc = net_cksum_add_avx2(acc, _mm256_loadu_si256(p));
+		sum64 += net_cksum_lanes_avx2(acc);
+	}
+
+	sum64 += __rte_raw_cksum(p, len, 0);
+
+	return net_cksum_fold64(sum64);
+}
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "net_cksum.h"
+
+/* Add the 16-bit words of a vector to the 32-bit lanes of the sum. */
+static __rte_always_inline __m512i
+net_cksum_add_avx512(__m512i acc, __m512i v)
+{
+	acc = _mm512_add_epi32(acc,
+		_mm512_and_si512(v, _mm512_set1_epi32(0xffff)));
+	return _mm512_add_epi32(acc, _mm512_srli_epi32(v, 16));
+}
+
+static __rte_always_inline uint64_t
+net_cksum_lanes_avx512(__m512i acc)
+{
+	/* Widen the lanes to 64 bits, their sum can overflow 32 bits. */
+	return _mm512_reduce_add_epi64(_mm512_add_epi64(
+		_mm512_cvtepu32_epi64(_mm512_castsi512_si256(acc)),
+		_mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(acc, 1))));
+}
+
+uint32_t
+net_cksum_sum_avx512(const void *buf, size_t len, uint32_t sum)
+{
+	const __m512i *p = buf;
+	uint64_t sum64 = sum;
+	__m512i acc;
+	size_t n;
+
+	/* 256 bytes per iteration */
+	while (len >= 4 * sizeof(__m512i)) {
+		n = RTE_MIN(len / (4 * sizeof(__m512i)),
+			(size_t)NET_CKSUM_MAX_ITER);
+		len -= n * 4 * sizeof(__m512i);
+		acc = _mm512_setzero_si512();
+		for (; n != 0; n--, p += 4) {
+			acc = net_cksum_add_avx512(acc, _mm512_loadu_si512(p));
+			acc = net_cksum_add_avx512(acc, _mm512_loadu_si512(p + 1));
+			acc = net_cksum_add_avx512(acc, _mm512_loadu_si512(p + 2));
+			acc = net_cksum_add_avx512(acc, _mm512_loadu_si512(p + 3));
+		}
+		sum64 += net_cksum_lanes_avx512(acc);
+	}
+
+	/*
+	 * The masked load zeroes the bytes past the end of the buffer, which
+	 * gives the same sum as the scalar code for the odd last byte.
+	 */
+	acc = _mm512_setzero_si512();
+	for (; len >= sizeof(__m512i); len -= sizeof(__m512i), p++)
+		acc = net_cksum_add_avx512(acc, _mm512_loadu_si512(p));
+	if (len != 0)
+		acc = net_cksum_add_avx512(acc, _mm512_maskz_loadu_epi8(
+			(__mmask64)(UINT64_MAX >> (64 - len)), p));
+	sum64 += net_cksum_lanes_avx512(acc);
+
+	return net_cksum_fold64(sum64);
+}
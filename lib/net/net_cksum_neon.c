@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "net_cksum.h"
+
+/* Add the 16-bit words of 16 bytes to the 32-bit lanes of the sum. */
+static __rte_always_inline uint32x4_t
+net_cksum_add_neon(uint32x4_t acc, const uint8_t *p)
+{
+	return vpadalq_u16(acc, vreinterpretq_u16_u8(vld1q_u8(p)));
+}
+
+uint32_t
+net_cksum_sum_neon(const void *buf, size_t len, uint32_t sum)
+{
+	const uint8_t *p = buf;
+	uint64_t sum64 = sum;
+	uint32x4_t acc;
+	size_t n;
+
+	/* 64 bytes per iteration */
+	while (len >= 64) {
+		n = RTE_MIN(len / 64, (size_t)NET_CKSUM_MAX_ITER);
+		len -= n * 64;
+		acc = vdupq_n_u32(0);
+		for (; n != 0; n--, p += 64) {
+			acc = net_cksum_add_neon(acc, p);
+			acc = net_cksum_add_neon(acc, p + 16);
+			acc = net_cksum_add_neon(acc, p + 32);
+			acc = net_cksum_add_neon(acc, p + 48);
+		}
+		sum64 += vaddlvq_u32(acc);
+	}
+
+	if (len >= 16) {
+		acc = vdupq_n_u32(0);
+		for (; len >= 16; len -= 16, p += 16)
+			acc = net_cksum_add_neon(acc, p);
+		sum64 += vaddlvq_u32(acc);
+	}
+
+	sum64 += __rte_raw_cksum(p, len, 0);
+
+	return net_cksum_fold64(sum64);
+}
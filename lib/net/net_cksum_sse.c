@@ -0,0 +1,62 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "net_cksum.h"
+
+/* Add the 16-bit words of a vector to the 32-bit lanes of the sum. */
+static __rte_always_inline __m128i
+net_cksum_add_sse(__m128i acc, __m128i v)
+{
+	acc = _mm_add_epi32(acc, _mm_and_si128(v, _mm_set1_epi32(0xffff)));
+	return _mm_add_epi32(acc, _mm_srli_epi32(v, 16));
+}
+
+static __rte_always_inline uint64_t
+net_cksum_lanes_sse(__m128i acc)
+{
+	alignas(16) uint32_t lanes[4];
+
+	_mm_store_si128((__m128i *)lanes, acc);
+	return (uint64_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+uint32_t
+net_cksum_sum_sse(const void *buf, size_t len, uint32_t sum)
+{
+	const __m128i *p = buf;
+	uint64_t sum64 = sum;
+	__m128i acc;
+	size_t n;
+
+	/* 64 bytes per iteration */
+	while (len >= 4 * sizeof(__m128i)) {
+		n = RTE_MIN(len / (4 * sizeof(__m128i)),
+			(size_t)NET_CKSUM_MAX_ITER);
+		len -= n * 4 * sizeof(__m128i);
+		acc = _mm_setzero_si128();
+		for (; n != 0; n--, p += 4) {
+			acc = net_cksum_add_sse(acc, _mm_loadu_si128(p));
+			acc = net_cksum_add_sse(acc, _mm_loadu_si128(p + 1));
+			acc = net_cksum_add_sse(acc, _mm_loadu_si128(p + 2));
+			acc = net_cksum_add_sse(acc, _mm_loadu_si128(p + 3));
+		}
+		sum64 += net_cksum_lanes_sse(acc);
+	}
+
+	if (len >= sizeof(__m128i)) {
+		acc = _mm_setzero_si128();
+		for (; len >= sizeof(__m128i); len -= sizeof(__m128i), p++)
+			acc = net_cksum_add_sse(acc, _mm_loadu_si128(p));
+		sum64 += net_cksum_lanes_sse(acc);
+	}
+
+	sum64 += __rte_raw_cksum(p, len, 0);
+
+	return net_cksum_fold64(sum64);
+}
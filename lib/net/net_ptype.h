@@ -0,0 +1,107 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _NET_PTYPE_H_
+#define _NET_PTYPE_H_
+
+#include <stdalign.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_byteorder.h>
+#include <rte_mbuf.h>
+#include <rte_mbuf_ptype.h>
+
+/*
+ * Vector classification of the common packet types.
+ *
+ * A few 32-bit words of the headers of each packet are gathered, and
+ * the packet types of a group of packets are computed from them with
+ * vector compares, without branches. The words are read at fixed
+ * offsets, assuming an Ether header, then an IPv4 header without
+ * options or an IPv6 header. The packets for which this assumption
+ * does not hold, or which need more parsing (IP options, IPv6 extension
+ * headers, fragments, tunnels, short first segment), are flagged and
+ * left to rte_net_get_ptype().
+ *
+ * The vector code assumes a little-endian CPU.
+ */
+
+/* Offsets of the gathered words */
+#define NET_PTYPE_ETHER_TYPE_OFF 12 /* Ether type, IP version and IHL */
+#define NET_PTYPE_IP_OFF 20 /* IPv4 fragment offset, TTL, proto; IPv6 proto */
+#define NET_PTYPE_L4_IPV4_OFF 34
+#define NET_PTYPE_L4_IPV6_OFF 54
+
+/* Number of packets classified at a time */
+#define NET_PTYPE_VEC_NUM 4
+
+/* Header words of a group of packets, one lane per packet */
+struct net_ptype_words {
+	alignas(16) uint32_t eth[NET_PTYPE_VEC_NUM];  /* bytes 12 to 15 */
+	alignas(16) uint32_t ip[NET_PTYPE_VEC_NUM];   /* bytes 20 to 23 */
+	alignas(16) uint32_t l4[NET_PTYPE_VEC_NUM];   /* L4 ports */
+	alignas(16) uint32_t len[NET_PTYPE_VEC_NUM];  /* first segment length */
+};
+
+/*
+ * Gather the header words of a packet. The ether word is zeroed for a
+ * packet too short to be classified, so that it is not recognized.
+ */
+static inline void
+net_ptype_gather(const struct rte_mbuf *m, struct net_ptype_words *w,
+	unsigned int i)
+{
+	const uint8_t *p = rte_pktmbuf_mtod(m, const uint8_t *);
+	uint32_t l4_off;
+
+	w->len[i] = m->data_len;
+	w->l4[i] = 0;
+	if (unlikely(m->data_len < NET_PTYPE_IP_OFF + sizeof(uint32_t))) {
+		w->eth[i] = 0;
+		w->ip[i] = 0;
+		return;
+	}
+
+	memcpy(&w->eth[i], p + NET_PTYPE_ETHER_TYPE_OFF, sizeof(uint32_t));
+	memcpy(&w->ip[i], p + NET_PTYPE_IP_OFF, sizeof(uint32_t));
+
+	/* The L4 offset is only valid for the packets passing the checks. */
+	l4_off = (p[NET_PTYPE_ETHER_TYPE_OFF + 2] >> 4) == 6 ?
+		NET_PTYPE_L4_IPV6_OFF : NET_PTYPE_L4_IPV4_OFF;
+	if (l4_off + sizeof(uint32_t) <= m->data_len)
+		memcpy(&w->l4[i], p + l4_off, sizeof(uint32_t));
+}
+
+/*
+ * Return the packet type mask of the layers parsed by rte_net_get_ptype(),
+ * which stops at the first layer missing from the list.
+ */
+static inline uint32_t
+net_ptype_layers_mask(uint32_t layers)
+{
+	uint32_t mask = 0;
+
+	if ((layers & RTE_PTYPE_L2_MASK) == 0)
+		return mask;
+	mask |= RTE_PTYPE_L2_MASK;
+	if ((layers & RTE_PTYPE_L3_MASK) == 0)
+		return mask;
+	mask |= RTE_PTYPE_L3_MASK;
+	if ((layers & RTE_PTYPE_L4_MASK) == 0)
+		return mask;
+	return mask | RTE_PTYPE_L4_MASK;
+}
+
+/*
+ * Classify the common packet types of a burst, return the number of
+ * packets processed, a multiple of NET_PTYPE_VEC_NUM. The packet type
+ * of the processed packets which cannot be classified is computed with
+ * rte_net_get_ptype().
+ */
+uint16_t
+net_get_ptype_burst_vec(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers);
+
+#endif /* _NET_PTYPE_H_ */
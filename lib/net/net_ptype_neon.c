@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include <rte_geneve.h>
+#include <rte_gtp.h>
+#include <rte_net.h>
+#include <rte_prefetch.h>
+#include <rte_vect.h>
+#include <rte_vxlan.h>
+
+#include "net_ptype.h"
+
+/*
+ * Compute the packet types of NET_PTYPE_VEC_NUM packets from their header
+ * words. Return a bit mask of the packets which are classified.
+ */
+static inline unsigned int
+net_ptype_classify_neon(const struct net_ptype_words *w, uint32_t mask,
+	uint32_t *ptypes)
+{
+	alignas(16) uint32_t ok_lanes[NET_PTYPE_VEC_NUM];
+	uint32x4_t eth, ip, l4, len;
+	uint32x4_t v4, v6, proto, tcp, udp, sctp, port, tun, need, ok, ptype;
+	unsigned int i, ok_mask = 0;
+
+	eth = vld1q_u32(w->eth);
+	ip = vld1q_u32(w->ip);
+	l4 = vld1q_u32(w->l4);
+	len = vld1q_u32(w->len);
+
+	/* Ether type IPv4 (08 00) and version/IHL 0x45, not a fragment. */
+	v4 = vceqq_u32(vandq_u32(eth, vdupq_n_u32(0x00ffffff)),
+			vdupq_n_u32(0x00450008));
+	v4 = vandq_u32(v4, vceqq_u32(vandq_u32(ip, vdupq_n_u32(0x0000ff3f)),
+			vdupq_n_u32(0)));
+	/* Ether type IPv6 (86 dd) and version 6. */
+	v6 = vceqq_u32(vandq_u32(eth, vdupq_n_u32(0x00f0ffff)),
+			vdupq_n_u32(0x0060dd86));
+
+	/* Protocol is byte 23 for IPv4, byte 20 for IPv6. */
+	proto = vbslq_u32(v4, vshrq_n_u32(ip, 24),
+			vandq_u32(ip, vdupq_n_u32(0xff)));
+	tcp = vceqq_u32(proto, vdupq_n_u32(IPPROTO_TCP));
+	udp = vceqq_u32(proto, vdupq_n_u32(IPPROTO_UDP));
+	sctp = vceqq_u32(proto, vdupq_n_u32(IPPROTO_SCTP));
+
+	/* UDP tunnels are recognized by port, see ptype_tunnel_with_udp(). */
+	port = vandq_u32(l4, vdupq_n_u32(0xffff));
+	tun = vceqq_u32(port, vdupq_n_u32(rte_cpu_to_be_16(RTE_GTPC_UDP_PORT)));
+	port = vshrq_n_u32(l4, 16);
+	tun = vorrq_u32(tun, vceqq_u32(port,
+			vdupq_n_u32(rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT))));
+	tun = vorrq_u32(tun, vceqq_u32(port,
+			vdupq_n_u32(rte_cpu_to_be_16(RTE_VXLAN_GPE_DEFAULT_PORT))));
+	tun = vorrq_u32(tun, vceqq_u32(port,
+			vdupq_n_u32(rte_cpu_to_be_16(RTE_GTPC_UDP_PORT))));
+	tun = vorrq_u32(tun, vceqq_u32(port,
+			vdupq_n_u32(rte_cpu_to_be_16(RTE_GTPU_UDP_PORT))));
+	tun = vorrq_u32(tun, vceqq_u32(port,
+			vdupq_n_u32(rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT))));
+
+	/* The L4 header must be in the first segment, 20 bytes for TCP. */
+	need = vaddq_u32(vdupq_n_u32(NET_PTYPE_L4_IPV4_OFF +
+			sizeof(struct rte_udp_hdr)), vandq_u32(v6,
+			vdupq_n_u32(NET_PTYPE_L4_IPV6_OFF -
+				NET_PTYPE_L4_IPV4_OFF)));
+	need = vaddq_u32(need, vandq_u32(tcp,
+			vdupq_n_u32(sizeof(struct rte_tcp_hdr) -
+				sizeof(struct rte_udp_hdr))));
+
+	ok = vorrq_u32(tcp, sctp);
+	ok = vorrq_u32(ok, vbicq_u32(udp, tun));
+	ok = vandq_u32(ok, vorrq_u32(v4, v6));
+	ok = vandq_u32(ok, vcleq_u32(need, len));
+
+	ptype = vdupq_n_u32(RTE_PTYPE_L2_ETHER);
+	ptype = vorrq_u32(ptype, vandq_u32(v4, vdupq_n_u32(RTE_PTYPE_L3_IPV4)));
+	ptype = vorrq_u32(ptype, vandq_u32(v6, vdupq_n_u32(RTE_PTYPE_L3_IPV6)));
+	ptype = vorrq_u32(ptype, vandq_u32(tcp, vdupq_n_u32(RTE_PTYPE_L4_TCP)));
+	ptype = vorrq_u32(ptype, vandq_u32(udp, vdupq_n_u32(RTE_PTYPE_L4_UDP)));
+	ptype = vorrq_u32(ptype, vandq_u32(sctp, vdupq_n_u32(RTE_PTYPE_L4_SCTP)));
+	ptype = vandq_u32(ptype, vdupq_n_u32(mask));
+	vst1q_u32(ptypes, ptype);
+
+	vst1q_u32(ok_lanes, ok);
+	for (i = 0; i < NET_PTYPE_VEC_NUM; i++)
+		ok_mask |= (ok_lanes[i] & 1) << i;
+
+	return ok_mask;
+}
+
+uint16_t
+net_get_ptype_burst_vec(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers)
+{
+	alignas(16) uint32_t ptypes[NET_PTYPE_VEC_NUM];
+	const uint32_t mask = net_ptype_layers_mask(layers);
+	struct net_ptype_words w;
+	unsigned int ok, i, j;
+
+	for (j = 0; j < NET_PTYPE_VEC_NUM && j < nb_pkts; j++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[j], void *));
+
+	for (i = 0; i + NET_PTYPE_VEC_NUM <= nb_pkts; i += NET_PTYPE_VEC_NUM) {
+		/* Prefetch the headers of the next group. */
+		for (j = i + NET_PTYPE_VEC_NUM;
+				j < i + 2 * NET_PTYPE_VEC_NUM && j < nb_pkts; j++)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[j], void *));
+
+		for (j = 0; j < NET_PTYPE_VEC_NUM; j++)
+			net_ptype_gather(pkts[i + j], &w, j);
+
+		ok = net_ptype_classify_neon(&w, mask, ptypes);
+
+		for (j = 0; j < NET_PTYPE_VEC_NUM; j++) {
+			if (likely(ok & (1 << j)))
+				pkts[i + j]->packet_type = ptypes[j];
+			else
+				pkts[i + j]->packet_type = rte_net_get_ptype(
+					pkts[i + j], NULL, layers);
+		}
+	}
+
+	return i;
+}
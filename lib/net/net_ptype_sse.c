@@ -0,0 +1,129 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include <rte_geneve.h>
+#include <rte_gtp.h>
+#include <rte_net.h>
+#include <rte_prefetch.h>
+#include <rte_vect.h>
+#include <rte_vxlan.h>
+
+#include "net_ptype.h"
+
+/*
+ * Compute the packet types of NET_PTYPE_VEC_NUM packets from their header
+ * words. Return a bit mask of the packets which are classified.
+ */
+static inline unsigned int
+net_ptype_classify_sse(const struct net_ptype_words *w, uint32_t mask,
+	uint32_t *ptypes)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i eth, ip, l4, len;
+	__m128i v4, v6, proto, tcp, udp, sctp, port, tun, need, ok, ptype;
+
+	eth = _mm_load_si128((const __m128i *)w->eth);
+	ip = _mm_load_si128((const __m128i *)w->ip);
+	l4 = _mm_load_si128((const __m128i *)w->l4);
+	len = _mm_load_si128((const __m128i *)w->len);
+
+	/* Ether type IPv4 (08 00) and version/IHL 0x45, not a fragment. */
+	v4 = _mm_cmpeq_epi32(_mm_and_si128(eth, _mm_set1_epi32(0x00ffffff)),
+			_mm_set1_epi32(0x00450008));
+	v4 = _mm_and_si128(v4, _mm_cmpeq_epi32(
+			_mm_and_si128(ip, _mm_set1_epi32(0x0000ff3f)), zero));
+	/* Ether type IPv6 (86 dd) and version 6. */
+	v6 = _mm_cmpeq_epi32(_mm_and_si128(eth, _mm_set1_epi32(0x00f0ffff)),
+			_mm_set1_epi32(0x0060dd86));
+
+	/* Protocol is byte 23 for IPv4, byte 20 for IPv6. */
+	proto = _mm_blendv_epi8(_mm_and_si128(ip, _mm_set1_epi32(0xff)),
+			_mm_srli_epi32(ip, 24), v4);
+	tcp = _mm_cmpeq_epi32(proto, _mm_set1_epi32(IPPROTO_TCP));
+	udp = _mm_cmpeq_epi32(proto, _mm_set1_epi32(IPPROTO_UDP));
+	sctp = _mm_cmpeq_epi32(proto, _mm_set1_epi32(IPPROTO_SCTP));
+
+	/* UDP tunnels are recognized by port, see ptype_tunnel_with_udp(). */
+	port = _mm_and_si128(l4, _mm_set1_epi32(0xffff));
+	tun = _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_GTPC_UDP_PORT)));
+	port = _mm_srli_epi32(l4, 16);
+	tun = _mm_or_si128(tun, _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_VXLAN_DEFAULT_PORT))));
+	tun = _mm_or_si128(tun, _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_VXLAN_GPE_DEFAULT_PORT))));
+	tun = _mm_or_si128(tun, _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_GTPC_UDP_PORT))));
+	tun = _mm_or_si128(tun, _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_GTPU_UDP_PORT))));
+	tun = _mm_or_si128(tun, _mm_cmpeq_epi32(port,
+			_mm_set1_epi32(rte_cpu_to_be_16(RTE_GENEVE_DEFAULT_PORT))));
+
+	/* The L4 header must be in the first segment, 20 bytes for TCP. */
+	need = _mm_add_epi32(_mm_set1_epi32(NET_PTYPE_L4_IPV4_OFF +
+			sizeof(struct rte_udp_hdr)), _mm_and_si128(v6,
+			_mm_set1_epi32(NET_PTYPE_L4_IPV6_OFF -
+				NET_PTYPE_L4_IPV4_OFF)));
+	need = _mm_add_epi32(need, _mm_and_si128(tcp,
+			_mm_set1_epi32(sizeof(struct rte_tcp_hdr) -
+				sizeof(struct rte_udp_hdr))));
+
+	ok = _mm_or_si128(tcp, sctp);
+	ok = _mm_or_si128(ok, _mm_andnot_si128(tun, udp));
+	ok = _mm_and_si128(ok, _mm_or_si128(v4, v6));
+	ok = _mm_andnot_si128(_mm_cmpgt_epi32(need, len), ok);
+
+	ptype = _mm_set1_epi32(RTE_PTYPE_L2_ETHER);
+	ptype = _mm_or_si128(ptype,
+			_mm_and_si128(v4, _mm_set1_epi32(RTE_PTYPE_L3_IPV4)));
+	ptype = _mm_or_si128(ptype,
+			_mm_and_si128(v6, _mm_set1_epi32(RTE_PTYPE_L3_IPV6)));
+	ptype = _mm_or_si128(ptype,
+			_mm_and_si128(tcp, _mm_set1_epi32(RTE_PTYPE_L4_TCP)));
+	ptype = _mm_or_si128(ptype,
+			_mm_and_si128(udp, _mm_set1_epi32(RTE_PTYPE_L4_UDP)));
+	ptype = _mm_or_si128(ptype,
+			_mm_and_si128(sctp, _mm_set1_epi32(RTE_PTYPE_L4_SCTP)));
+	ptype = _mm_and_si128(ptype, _mm_set1_epi32(mask));
+	_mm_storeu_si128((__m128i *)ptypes, ptype);
+
+	return _mm_movemask_ps(_mm_castsi128_ps(ok));
+}
+
+uint16_t
+net_get_ptype_burst_vec(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers)
+{
+	alignas(16) uint32_t ptypes[NET_PTYPE_VEC_NUM];
+	const uint32_t mask = net_ptype_layers_mask(layers);
+	struct net_ptype_words w;
+	unsigned int ok, i, j;
+
+	for (j = 0; j < NET_PTYPE_VEC_NUM && j < nb_pkts; j++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[j], void *));
+
+	for (i = 0; i + NET_PTYPE_VEC_NUM <= nb_pkts; i += NET_PTYPE_VEC_NUM) {
+		/* Prefetch the headers of the next group. */
+		for (j = i + NET_PTYPE_VEC_NUM;
+				j < i + 2 * NET_PTYPE_VEC_NUM && j < nb_pkts; j++)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[j], void *));
+
+		for (j = 0; j < NET_PTYPE_VEC_NUM; j++)
+			net_ptype_gather(pkts[i + j], &w, j);
+
+		ok = net_ptype_classify_sse(&w, mask, ptypes);
+
+		for (j = 0; j < NET_PTYPE_VEC_NUM; j++) {
+			if (likely(ok & (1 << j)))
+				pkts[i + j]->packet_type = ptypes[j];
+			else
+				pkts[i + j]->packet_type = rte_net_get_ptype(
+					pkts[i + j], NULL, layers);
+		}
+	}
+
+	return i;
+}
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_cksum.h>
+#include <rte_cpuflags.h>
+#include <rte_vect.h>
+
+#include "net_cksum.h"
+
+static uint32_t
+net_cksum_sum_scalar(const void *buf, size_t len, uint32_t sum)
+{
+	return net_cksum_fold64((uint64_t)sum + __rte_raw_cksum(buf, len, 0));
+}
+
+static net_cksum_sum_t net_cksum_sum_handler;
+
+static net_cksum_sum_t
+net_cksum_select(void)
+{
+	uint16_t max_simd_bitwidth = rte_vect_get_max_simd_bitwidth();
+
+#ifdef CC_X86_64_AVX512_CKSUM_SUPPORT
+	if (max_simd_bitwidth >= RTE_VECT_SIMD_512 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW))
+		return net_cksum_sum_avx512;
+#endif
+#ifdef RTE_ARCH_X86
+	if (max_simd_bitwidth >= RTE_VECT_SIMD_256 &&
+			rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2))
+		return net_cksum_sum_avx2;
+	if (max_simd_bitwidth >= RTE_VECT_SIMD_128)
+		return net_cksum_sum_sse;
+#endif
+#ifdef RTE_ARCH_ARM64
+	if (max_simd_bitwidth >= RTE_VECT_SIMD_128)
+		return net_cksum_sum_neon;
+#endif
+	RTE_SET_USED(max_simd_bitwidth);
+
+	return net_cksum_sum_scalar;
+}
+
+uint32_t
+net_cksum_sum(const void *buf, size_t len, uint32_t sum)
+{
+	net_cksum_sum_t handler = net_cksum_sum_handler;
+
+	/* The max SIMD bitwidth is only known once EAL is initialized. */
+	if (unlikely(handler == NULL)) {
+		handler = net_cksum_select();
+		net_cksum_sum_handler = handler;
+	}
+
+	return handler(buf, len, sum);
+}
+
+uint16_t
+rte_raw_cksum_vec(const void *buf, size_t len)
+{
+	return __rte_raw_cksum_reduce(net_cksum_sum(buf, len, 0));
+}
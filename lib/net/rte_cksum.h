@@ -19,6 +19,7 @@
 
 #include <rte_byteorder.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_mbuf.h>
 
 #ifdef __cplusplus
@@ -99,6 +100,29 @@ rte_raw_cksum(const void *buf, size_t len)
 	return __rte_raw_cksum_reduce(sum);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Process the non-complemented checksum of a buffer, using vector
+ * instructions when available.
+ *
+ * The result is the same as rte_raw_cksum(). The vector implementation
+ * (SSE, AVX2, AVX-512 or NEON) is selected at the first call, according
+ * to the CPU and the maximum SIMD bitwidth of EAL. It is faster than
+ * rte_raw_cksum() except for the shortest buffers.
+ *
+ * @param buf
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer.
+ * @return
+ *   The non-complemented checksum.
+ */
+__rte_experimental
+uint16_t
+rte_raw_cksum_vec(const void *buf, size_t len);
+
 /**
  * Compute the raw (non complemented) checksum of a packet.
  *
@@ -19,6 +19,11 @@
 #include <rte_gtp.h>
 #include <rte_net.h>
 #include <rte_os_shim.h>
+#include <rte_errno.h>
+#include <rte_prefetch.h>
+
+#include "net_cksum.h"
+#include "net_ptype.h"
 
 /* get l3 packet type from ip6 next protocol */
 static uint32_t
@@ -601,3 +606,173 @@ uint32_t rte_net_get_ptype(const struct rte_mbuf *m,
 
 	return pkt_type;
 }
+
+/* parse a burst of mbufs to get their packet types */
+void
+rte_net_get_ptype_burst(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers)
+{
+	uint16_t i = 0;
+
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	i = net_get_ptype_burst_vec(pkts, nb_pkts, layers);
+#endif
+	for (; i < nb_pkts; i++)
+		pkts[i]->packet_type = rte_net_get_ptype(pkts[i], NULL, layers);
+}
+
+/* get the non-complemented checksum of data spanning several segments */
+static uint16_t
+net_cksum_mbuf(const struct rte_mbuf *m, uint32_t off, uint32_t len)
+{
+	const struct rte_mbuf *seg = m;
+	uint32_t seglen, done = 0;
+	uint32_t sum = 0;
+	uint16_t tmp;
+
+	while (off >= rte_pktmbuf_data_len(seg) && seg->next != NULL) {
+		off -= rte_pktmbuf_data_len(seg);
+		seg = seg->next;
+	}
+
+	for (;;) {
+		seglen = RTE_MIN(rte_pktmbuf_data_len(seg) - off, len - done);
+		tmp = __rte_raw_cksum_reduce(net_cksum_sum(
+			rte_pktmbuf_mtod_offset(seg, const void *, off),
+			seglen, 0));
+		/* words are shifted by one byte after an odd length */
+		if (done & 1)
+			tmp = rte_bswap16(tmp);
+		sum += tmp;
+		done += seglen;
+		if (done == len || seg->next == NULL)
+			break;
+		seg = seg->next;
+		off = 0;
+	}
+
+	return __rte_raw_cksum_reduce(sum);
+}
+
+/* compute the checksums requested in the Tx offload flags of a packet */
+static int
+net_cksum_tx(struct rte_mbuf *m)
+{
+	const uint64_t ol_flags = m->ol_flags;
+	const uint64_t l4_flags = ol_flags & RTE_MBUF_F_TX_L4_MASK;
+	struct rte_ipv4_hdr *ipv4_hdr = NULL;
+	struct rte_ipv6_hdr *ipv6_hdr = NULL;
+	struct rte_udp_hdr *udp_hdr;
+	struct rte_tcp_hdr *tcp_hdr;
+	uint32_t l3_off, l4_off, l4_len, hdr_len;
+	uint32_t cksum;
+
+	if ((ol_flags & RTE_MBUF_F_TX_IP_CKSUM) == 0 &&
+			l4_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
+		return 0;
+
+	if (ol_flags & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG |
+			RTE_MBUF_F_TX_OUTER_IP_CKSUM |
+			RTE_MBUF_F_TX_OUTER_UDP_CKSUM) ||
+			l4_flags == RTE_MBUF_F_TX_SCTP_CKSUM)
+		return -ENOTSUP;
+
+	l3_off = m->l2_len;
+	if (ol_flags & (RTE_MBUF_F_TX_OUTER_IPV4 | RTE_MBUF_F_TX_OUTER_IPV6))
+		l3_off += m->outer_l2_len + m->outer_l3_len;
+	l4_off = l3_off + m->l3_len;
+
+	if (ol_flags & RTE_MBUF_F_TX_IPV4) {
+		if (m->l3_len < sizeof(struct rte_ipv4_hdr))
+			return -EINVAL;
+		hdr_len = l4_off;
+	} else if (ol_flags & RTE_MBUF_F_TX_IPV6) {
+		if ((ol_flags & RTE_MBUF_F_TX_IP_CKSUM) ||
+				m->l3_len < sizeof(struct rte_ipv6_hdr))
+			return -EINVAL;
+		hdr_len = l4_off;
+	} else {
+		return -EINVAL;
+	}
+	if (l4_flags == RTE_MBUF_F_TX_UDP_CKSUM)
+		hdr_len += sizeof(struct rte_udp_hdr);
+	else if (l4_flags == RTE_MBUF_F_TX_TCP_CKSUM)
+		hdr_len += sizeof(struct rte_tcp_hdr);
+
+	/* check if headers are fragmented */
+	if (unlikely(rte_pktmbuf_data_len(m) < hdr_len))
+		return -ENOTSUP;
+
+	if (ol_flags & RTE_MBUF_F_TX_IPV4) {
+		ipv4_hdr = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *,
+				l3_off);
+		l4_len = rte_be_to_cpu_16(ipv4_hdr->total_length) -
+			rte_ipv4_hdr_len(ipv4_hdr);
+	} else {
+		ipv6_hdr = rte_pktmbuf_mtod_offset(m, struct rte_ipv6_hdr *,
+				l3_off);
+		l4_len = rte_be_to_cpu_16(ipv6_hdr->payload_len);
+	}
+
+	if (l4_flags != RTE_MBUF_F_TX_L4_NO_CKSUM &&
+			unlikely(l4_off + l4_len > rte_pktmbuf_pkt_len(m) ||
+				l4_off + l4_len < hdr_len))
+		return -EINVAL;
+
+	if (ol_flags & RTE_MBUF_F_TX_IP_CKSUM) {
+		ipv4_hdr->hdr_checksum = 0;
+		ipv4_hdr->hdr_checksum = rte_ipv4_cksum(ipv4_hdr);
+	}
+
+	if (l4_flags == RTE_MBUF_F_TX_L4_NO_CKSUM)
+		return 0;
+
+	udp_hdr = rte_pktmbuf_mtod_offset(m, struct rte_udp_hdr *, l4_off);
+	tcp_hdr = rte_pktmbuf_mtod_offset(m, struct rte_tcp_hdr *, l4_off);
+	if (l4_flags == RTE_MBUF_F_TX_UDP_CKSUM)
+		udp_hdr->dgram_cksum = 0;
+	else
+		tcp_hdr->cksum = 0;
+
+	cksum = net_cksum_mbuf(m, l4_off, l4_len);
+	if (ipv4_hdr != NULL)
+		cksum += rte_ipv4_phdr_cksum(ipv4_hdr, 0);
+	else
+		cksum += rte_ipv6_phdr_cksum(ipv6_hdr, 0);
+	cksum = (uint16_t)~__rte_raw_cksum_reduce(cksum);
+
+	if (l4_flags == RTE_MBUF_F_TX_UDP_CKSUM) {
+		/*
+		 * Per RFC 768: If the computed checksum is zero for UDP,
+		 * it is transmitted as all ones
+		 * (the equivalent in one's complement arithmetic).
+		 */
+		if (cksum == 0)
+			cksum = 0xffff;
+		udp_hdr->dgram_cksum = (uint16_t)cksum;
+	} else {
+		tcp_hdr->cksum = (uint16_t)cksum;
+	}
+
+	return 0;
+}
+
+/* compute the Tx checksums of a burst of mbufs */
+uint16_t
+rte_net_cksum_burst(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	uint16_t i;
+	int ret;
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (i + 1 < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void *));
+		ret = net_cksum_tx(pkts[i]);
+		if (unlikely(ret != 0)) {
+			rte_errno = -ret;
+			break;
+		}
+	}
+
+	return i;
+}
@@ -5,6 +5,7 @@
 #ifndef _RTE_NET_PTYPE_H_
 #define _RTE_NET_PTYPE_H_
 
+#include <rte_compat.h>
 #include <rte_ip.h>
 #include <rte_udp.h>
 #include <rte_tcp.h>
@@ -85,6 +86,64 @@ rte_net_skip_ip6_ext(uint16_t proto, const struct rte_mbuf *m, uint32_t *off,
 uint32_t rte_net_get_ptype(const struct rte_mbuf *m,
 	struct rte_net_hdr_lens *hdr_lens, uint32_t layers);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Parse a burst of Ethernet packets to get their packet types.
+ *
+ * The packet type of each packet is stored in its packet_type field,
+ * with the same value as returned by rte_net_get_ptype().
+ *
+ * Ether/IPv4/IPv6 packets carrying TCP, UDP or SCTP, without IP options,
+ * extension headers or fragmentation, are classified several at a time
+ * with vector instructions where available. The other packets, including
+ * the tunnels, are parsed by rte_net_get_ptype().
+ *
+ * @param pkts
+ *   The packet mbufs to be parsed.
+ * @param nb_pkts
+ *   The number of packets.
+ * @param layers
+ *   List of layers to parse, see rte_net_get_ptype().
+ */
+__rte_experimental
+void rte_net_get_ptype_burst(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Compute in software the checksums requested in the Tx offload flags
+ * of a burst of packets.
+ *
+ * For each packet, the IPv4 header checksum is computed if
+ * RTE_MBUF_F_TX_IP_CKSUM is set, and the UDP or TCP checksum if
+ * RTE_MBUF_F_TX_UDP_CKSUM or RTE_MBUF_F_TX_TCP_CKSUM is set, using the
+ * offload flags and the l2_len, l3_len (and outer_l2_len, outer_l3_len
+ * for tunnels) fields of the mbuf, as a NIC would do. The L4 data is
+ * summed with rte_raw_cksum_vec() and can span several segments.
+ * The offload flags are left unchanged.
+ *
+ * This function expects that the headers are in the first data segment
+ * of the mbuf and can be safely modified. Segmentation, SCTP and outer
+ * checksum offloads are not supported.
+ *
+ * @param pkts
+ *   The packet mbufs to be processed.
+ * @param nb_pkts
+ *   The number of packets.
+ * @return
+ *   The number of packets processed. If lower than nb_pkts, rte_errno
+ *   is set for the packet pkts[ret], which is not modified:
+ *   - ENOTSUP: an offload is not supported or the headers are not in
+ *     the first segment.
+ *   - EINVAL: the offload flags or the header lengths are not valid.
+ */
+__rte_experimental
+uint16_t rte_net_cksum_burst(struct rte_mbuf **pkts, uint16_t nb_pkts);
+
 /**
  * Prepare pseudo header checksum
  *
@@ -0,0 +1,295 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_fib.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+
+#include "rte_node_ip4_api.h"
+
+#include "node_private.h"
+
+#define IP4_LOOKUP_FIB_NAMESIZE 64
+
+/* IP4 FIB lookup global data struct */
+struct ip4_lookup_fib_node_main {
+	struct rte_fib *fib[RTE_MAX_NUMA_NODES];
+};
+
+struct ip4_lookup_fib_node_ctx {
+	/* Socket's FIB */
+	struct rte_fib *fib;
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+static struct ip4_lookup_fib_node_main ip4_lookup_fib_nm;
+
+#define IP4_LOOKUP_FIB_NODE(ctx) \
+	(((struct ip4_lookup_fib_node_ctx *)ctx)->fib)
+
+#define IP4_LOOKUP_FIB_NODE_PRIV1_OFF(ctx) \
+	(((struct ip4_lookup_fib_node_ctx *)ctx)->mbuf_priv1_off)
+
+/* Next hop returned by the FIB for the addresses without route */
+#define IP4_LOOKUP_FIB_DROP_NH \
+	(((uint64_t)RTE_NODE_IP4_LOOKUP_NEXT_PKT_DROP) << 16)
+
+static uint16_t
+ip4_lookup_fib_node_process(struct rte_graph *graph, struct rte_node *node,
+			void **objs, uint16_t nb_objs)
+{
+	struct rte_fib *fib = IP4_LOOKUP_FIB_NODE(node->ctx);
+	const int dyn = IP4_LOOKUP_FIB_NODE_PRIV1_OFF(node->ctx);
+	uint64_t next_hop[RTE_GRAPH_BURST_SIZE];
+	uint32_t ip[RTE_GRAPH_BURST_SIZE];
+	struct rte_ipv4_hdr *ipv4_hdr;
+	void **to_next, **from;
+	uint16_t last_spec = 0;
+	struct rte_mbuf *mbuf;
+	rte_edge_t next_index;
+	uint16_t held = 0;
+	uint16_t i, j, n;
+
+	if (unlikely(fib == NULL)) {
+		NODE_INCREMENT_XSTAT_ID(node, 0, true, nb_objs);
+		rte_node_next_stream_move(graph, node,
+				RTE_NODE_IP4_LOOKUP_NEXT_PKT_DROP);
+		return nb_objs;
+	}
+
+	/* Speculative next */
+	next_index = RTE_NODE_IP4_LOOKUP_NEXT_REWRITE;
+	from = objs;
+
+	for (i = 0; i < 4 && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset((struct rte_mbuf *)objs[i],
+				void *, sizeof(struct rte_ether_hdr)));
+
+	/* Get stream for the speculated next node */
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, RTE_GRAPH_BURST_SIZE);
+
+		/* Gather the DIPs of the whole chunk for one bulk lookup */
+		for (j = 0; j < n; j++) {
+			if (likely(i + j + 4 < nb_objs))
+				rte_prefetch0(rte_pktmbuf_mtod_offset(
+					(struct rte_mbuf *)objs[i + j + 4],
+					void *, sizeof(struct rte_ether_hdr)));
+
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf,
+					struct rte_ipv4_hdr *,
+					sizeof(struct rte_ether_hdr));
+			/* Extract cksum, ttl as ipv4 hdr is in cache */
+			node_mbuf_priv1(mbuf, dyn)->cksum =
+				ipv4_hdr->hdr_checksum;
+			node_mbuf_priv1(mbuf, dyn)->ttl =
+				ipv4_hdr->time_to_live;
+			ip[j] = rte_be_to_cpu_32(ipv4_hdr->dst_addr);
+		}
+
+		rte_fib_lookup_bulk(fib, ip, next_hop, n);
+
+		for (j = 0; j < n; j++) {
+			uint16_t next;
+
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			NODE_INCREMENT_XSTAT_ID(node, 0,
+					next_hop[j] == IP4_LOOKUP_FIB_DROP_NH, 1);
+
+			node_mbuf_priv1(mbuf, dyn)->nh = (uint16_t)next_hop[j];
+			next = (uint16_t)(next_hop[j] >> 16);
+
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from,
+					   last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	return nb_objs;
+}
+
+int
+rte_node_ip4_fib_create(int socket, struct rte_fib_conf *conf)
+{
+	struct ip4_lookup_fib_node_main *nm = &ip4_lookup_fib_nm;
+	struct rte_fib_conf fib_conf;
+	char s[IP4_LOOKUP_FIB_NAMESIZE];
+
+	if (socket < 0 || socket >= RTE_MAX_NUMA_NODES || conf == NULL)
+		return -EINVAL;
+
+	/* One FIB per socket */
+	if (nm->fib[socket] != NULL)
+		return -EEXIST;
+
+	/* Lookup misses are sent to the drop node */
+	fib_conf = *conf;
+	fib_conf.default_nh = IP4_LOOKUP_FIB_DROP_NH;
+
+	snprintf(s, sizeof(s), "IPV4_L3FWD_FIB_%d", socket);
+	nm->fib[socket] = rte_fib_create(s, socket, &fib_conf);
+	if (nm->fib[socket] == NULL)
+		return -rte_errno;
+
+	return 0;
+}
+
+int
+rte_node_ip4_fib_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
+			   enum rte_node_ip4_lookup_next next_node)
+{
+	char abuf[INET6_ADDRSTRLEN];
+	struct in_addr in;
+	uint8_t socket;
+	uint32_t val;
+	int ret;
+
+	in.s_addr = htonl(ip);
+	inet_ntop(AF_INET, &in, abuf, sizeof(abuf));
+	/* Embedded next node id into 24 bit next hop */
+	val = ((next_node << 16) | next_hop) & ((1ull << 24) - 1);
+	node_dbg("ip4_lookup_fib", "FIB: Adding route %s / %d nh (0x%x)", abuf,
+		 depth, val);
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!ip4_lookup_fib_nm.fib[socket])
+			continue;
+
+		ret = rte_fib_add(ip4_lookup_fib_nm.fib[socket], ip, depth, val);
+		if (ret < 0) {
+			node_err("ip4_lookup_fib",
+				 "Unable to add entry %s / %d nh (%x) to FIB on sock %d, rc=%d",
+				 abuf, depth, val, socket, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int
+rte_node_ip4_fib_route_delete(uint32_t ip, uint8_t depth)
+{
+	char abuf[INET6_ADDRSTRLEN];
+	struct in_addr in;
+	uint8_t socket;
+	int ret;
+
+	in.s_addr = htonl(ip);
+	inet_ntop(AF_INET, &in, abuf, sizeof(abuf));
+	node_dbg("ip4_lookup_fib", "FIB: Deleting route %s / %d", abuf, depth);
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!ip4_lookup_fib_nm.fib[socket])
+			continue;
+
+		ret = rte_fib_delete(ip4_lookup_fib_nm.fib[socket], ip, depth);
+		if (ret < 0) {
+			node_err("ip4_lookup_fib",
+				 "Unable to delete entry %s / %d from FIB on sock %d, rc=%d",
+				 abuf, depth, socket, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int
+rte_node_ip4_fib_destroy(int socket)
+{
+	struct ip4_lookup_fib_node_main *nm = &ip4_lookup_fib_nm;
+
+	if (socket < 0 || socket >= RTE_MAX_NUMA_NODES)
+		return -EINVAL;
+
+	if (nm->fib[socket] == NULL)
+		return -ENOENT;
+
+	rte_fib_free(nm->fib[socket]);
+	nm->fib[socket] = NULL;
+
+	return 0;
+}
+
+static int
+ip4_lookup_fib_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	static uint8_t init_once;
+
+	RTE_BUILD_BUG_ON(sizeof(struct ip4_lookup_fib_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (!init_once) {
+		node_mbuf_priv1_dynfield_offset = rte_mbuf_dynfield_register(
+				&node_mbuf_priv1_dynfield_desc);
+		if (node_mbuf_priv1_dynfield_offset < 0)
+			return -rte_errno;
+		init_once = 1;
+	}
+
+	/* Update socket's FIB and mbuf dyn priv1 offset in node ctx */
+	IP4_LOOKUP_FIB_NODE(node->ctx) = ip4_lookup_fib_nm.fib[graph->socket];
+	IP4_LOOKUP_FIB_NODE_PRIV1_OFF(node->ctx) = node_mbuf_priv1_dynfield_offset;
+
+	if (IP4_LOOKUP_FIB_NODE(node->ctx) == NULL)
+		node_dbg("ip4_lookup_fib", "No FIB on sock %d, packets are dropped",
+			 graph->socket);
+
+	node_dbg("ip4_lookup_fib", "Initialized ip4_lookup_fib node");
+
+	return 0;
+}
+
+static struct rte_node_xstats ip4_lookup_fib_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "ip4_lookup_fib_error",
+	},
+};
+
+static struct rte_node_register ip4_lookup_fib_node = {
+	.process = ip4_lookup_fib_node_process,
+	.name = "ip4_lookup_fib",
+
+	.init = ip4_lookup_fib_node_init,
+	.xstats = &ip4_lookup_fib_xstats,
+
+	.nb_edges = RTE_NODE_IP4_LOOKUP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP4_LOOKUP_NEXT_IP4_LOCAL] = "ip4_local",
+		[RTE_NODE_IP4_LOOKUP_NEXT_REWRITE] = "ip4_rewrite",
+		[RTE_NODE_IP4_LOOKUP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(ip4_lookup_fib_node);
@@ -0,0 +1,287 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_fib6.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+
+#include "rte_node_ip6_api.h"
+
+#include "node_private.h"
+
+#define IP6_LOOKUP_FIB_NAMESIZE 64
+
+/* IP6 FIB lookup global data struct */
+struct ip6_lookup_fib_node_main {
+	struct rte_fib6 *fib[RTE_MAX_NUMA_NODES];
+};
+
+struct ip6_lookup_fib_node_ctx {
+	/* Socket's FIB */
+	struct rte_fib6 *fib;
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+static struct ip6_lookup_fib_node_main ip6_lookup_fib_nm;
+
+#define IP6_LOOKUP_FIB_NODE(ctx) \
+	(((struct ip6_lookup_fib_node_ctx *)ctx)->fib)
+
+#define IP6_LOOKUP_FIB_NODE_PRIV1_OFF(ctx) \
+	(((struct ip6_lookup_fib_node_ctx *)ctx)->mbuf_priv1_off)
+
+/* Next hop returned by the FIB for the addresses without route */
+#define IP6_LOOKUP_FIB_DROP_NH \
+	(((uint64_t)RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP) << 16)
+
+static uint16_t
+ip6_lookup_fib_node_process(struct rte_graph *graph, struct rte_node *node,
+			void **objs, uint16_t nb_objs)
+{
+	struct rte_fib6 *fib = IP6_LOOKUP_FIB_NODE(node->ctx);
+	const int dyn = IP6_LOOKUP_FIB_NODE_PRIV1_OFF(node->ctx);
+	uint64_t next_hop[RTE_GRAPH_BURST_SIZE];
+	struct rte_ipv6_addr ip[RTE_GRAPH_BURST_SIZE];
+	struct rte_ipv6_hdr *ipv6_hdr;
+	void **to_next, **from;
+	uint16_t last_spec = 0;
+	struct rte_mbuf *mbuf;
+	rte_edge_t next_index;
+	uint16_t held = 0;
+	uint16_t i, j, n;
+
+	if (unlikely(fib == NULL)) {
+		NODE_INCREMENT_XSTAT_ID(node, 0, true, nb_objs);
+		rte_node_next_stream_move(graph, node,
+				RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP);
+		return nb_objs;
+	}
+
+	/* Speculative next */
+	next_index = RTE_NODE_IP6_LOOKUP_NEXT_REWRITE;
+	from = objs;
+
+	for (i = 0; i < 4 && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset((struct rte_mbuf *)objs[i],
+				void *, sizeof(struct rte_ether_hdr)));
+
+	/* Get stream for the speculated next node */
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, RTE_GRAPH_BURST_SIZE);
+
+		/* Gather the DIPs of the whole chunk for one bulk lookup */
+		for (j = 0; j < n; j++) {
+			if (likely(i + j + 4 < nb_objs))
+				rte_prefetch0(rte_pktmbuf_mtod_offset(
+					(struct rte_mbuf *)objs[i + j + 4],
+					void *, sizeof(struct rte_ether_hdr)));
+
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf,
+					struct rte_ipv6_hdr *,
+					sizeof(struct rte_ether_hdr));
+			/* Extract hop_limits as ipv6 hdr is in cache */
+			node_mbuf_priv1(mbuf, dyn)->ttl = ipv6_hdr->hop_limits;
+			ip[j] = ipv6_hdr->dst_addr;
+		}
+
+		rte_fib6_lookup_bulk(fib, ip, next_hop, n);
+
+		for (j = 0; j < n; j++) {
+			uint16_t next;
+
+			mbuf = (struct rte_mbuf *)objs[i + j];
+			NODE_INCREMENT_XSTAT_ID(node, 0,
+					next_hop[j] == IP6_LOOKUP_FIB_DROP_NH, 1);
+
+			node_mbuf_priv1(mbuf, dyn)->nh = (uint16_t)next_hop[j];
+			next = (uint16_t)(next_hop[j] >> 16);
+
+			if (unlikely(next_index != next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from,
+					   last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
+		}
+	}
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	return nb_objs;
+}
+
+int
+rte_node_ip6_fib_create(int socket, struct rte_fib6_conf *conf)
+{
+	struct ip6_lookup_fib_node_main *nm = &ip6_lookup_fib_nm;
+	struct rte_fib6_conf fib_conf;
+	char s[IP6_LOOKUP_FIB_NAMESIZE];
+
+	if (socket < 0 || socket >= RTE_MAX_NUMA_NODES || conf == NULL)
+		return -EINVAL;
+
+	/* One FIB per socket */
+	if (nm->fib[socket] != NULL)
+		return -EEXIST;
+
+	/* Lookup misses are sent to the drop node */
+	fib_conf = *conf;
+	fib_conf.default_nh = IP6_LOOKUP_FIB_DROP_NH;
+
+	snprintf(s, sizeof(s), "IPV6_L3FWD_FIB_%d", socket);
+	nm->fib[socket] = rte_fib6_create(s, socket, &fib_conf);
+	if (nm->fib[socket] == NULL)
+		return -rte_errno;
+
+	return 0;
+}
+
+int
+rte_node_ip6_fib_route_add(const struct rte_ipv6_addr *ip, uint8_t depth,
+			   uint16_t next_hop, enum rte_node_ip6_lookup_next next_node)
+{
+	char abuf[INET6_ADDRSTRLEN];
+	uint8_t socket;
+	uint32_t val;
+	int ret;
+
+	inet_ntop(AF_INET6, ip, abuf, sizeof(abuf));
+	/* Embedded next node id into 24 bit next hop */
+	val = ((next_node << 16) | next_hop) & ((1ull << 24) - 1);
+	node_dbg("ip6_lookup_fib", "FIB: Adding route %s / %d nh (0x%x)", abuf,
+		 depth, val);
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!ip6_lookup_fib_nm.fib[socket])
+			continue;
+
+		ret = rte_fib6_add(ip6_lookup_fib_nm.fib[socket], ip, depth, val);
+		if (ret < 0) {
+			node_err("ip6_lookup_fib",
+				 "Unable to add entry %s / %d nh (%x) to FIB on sock %d, rc=%d",
+				 abuf, depth, val, socket, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int
+rte_node_ip6_fib_route_delete(const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	char abuf[INET6_ADDRSTRLEN];
+	uint8_t socket;
+	int ret;
+
+	inet_ntop(AF_INET6, ip, abuf, sizeof(abuf));
+	node_dbg("ip6_lookup_fib", "FIB: Deleting route %s / %d", abuf, depth);
+
+	for (socket = 0; socket < RTE_MAX_NUMA_NODES; socket++) {
+		if (!ip6_lookup_fib_nm.fib[socket])
+			continue;
+
+		ret = rte_fib6_delete(ip6_lookup_fib_nm.fib[socket], ip, depth);
+		if (ret < 0) {
+			node_err("ip6_lookup_fib",
+				 "Unable to delete entry %s / %d from FIB on sock %d, rc=%d",
+				 abuf, depth, socket, ret);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+int
+rte_node_ip6_fib_destroy(int socket)
+{
+	struct ip6_lookup_fib_node_main *nm = &ip6_lookup_fib_nm;
+
+	if (socket < 0 || socket >= RTE_MAX_NUMA_NODES)
+		return -EINVAL;
+
+	if (nm->fib[socket] == NULL)
+		return -ENOENT;
+
+	rte_fib6_free(nm->fib[socket]);
+	nm->fib[socket] = NULL;
+
+	return 0;
+}
+
+static int
+ip6_lookup_fib_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	static uint8_t init_once;
+
+	RTE_BUILD_BUG_ON(sizeof(struct ip6_lookup_fib_node_ctx) > RTE_NODE_CTX_SZ);
+
+	if (!init_once) {
+		node_mbuf_priv1_dynfield_offset = rte_mbuf_dynfield_register(
+				&node_mbuf_priv1_dynfield_desc);
+		if (node_mbuf_priv1_dynfield_offset < 0)
+			return -rte_errno;
+		init_once = 1;
+	}
+
+	/* Update socket's FIB and mbuf dyn priv1 offset in node ctx */
+	IP6_LOOKUP_FIB_NODE(node->ctx) = ip6_lookup_fib_nm.fib[graph->socket];
+	IP6_LOOKUP_FIB_NODE_PRIV1_OFF(node->ctx) = node_mbuf_priv1_dynfield_offset;
+
+	if (IP6_LOOKUP_FIB_NODE(node->ctx) == NULL)
+		node_dbg("ip6_lookup_fib", "No FIB on sock %d, packets are dropped",
+			 graph->socket);
+
+	node_dbg("ip6_lookup_fib", "Initialized ip6_lookup_fib node");
+
+	return 0;
+}
+
+static struct rte_node_xstats ip6_lookup_fib_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "ip6_lookup_fib_error",
+	},
+};
+
+static struct rte_node_register ip6_lookup_fib_node = {
+	.process = ip6_lookup_fib_node_process,
+	.name = "ip6_lookup_fib",
+
+	.init = ip6_lookup_fib_node_init,
+	.xstats = &ip6_lookup_fib_xstats,
+
+	.nb_edges = RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP + 1,
+	.next_nodes = {
+		[RTE_NODE_IP6_LOOKUP_NEXT_REWRITE] = "ip6_rewrite",
+		[RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(ip6_lookup_fib_node);
@@ -17,6 +17,7 @@
  */
 #include <rte_common.h>
 #include <rte_compat.h>
+#include <rte_fib6.h>
 #include <rte_ip6.h>
 
 #ifdef __cplusplus
@@ -71,6 +72,73 @@ __rte_experimental
 int rte_node_ip6_rewrite_add(uint16_t next_hop, uint8_t *rewrite_data,
 			     uint8_t rewrite_len, uint16_t dst_port);
 
+/**
+ * Create the FIB used by the ip6_lookup_fib node on a socket.
+ *
+ * The ip6_lookup_fib node looks up the whole burst of packets at once
+ * with rte_fib6_lookup_bulk(). The FIB must be created before the graphs
+ * using the node, and its next hop size must hold 24 bits.
+ * The default next hop in the configuration is replaced so that
+ * the packets without route are sent to the drop node.
+ *
+ * @param socket
+ *   Socket on which the FIB is created.
+ * @param conf
+ *   FIB configuration.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_fib_create(int socket, struct rte_fib6_conf *conf);
+
+/**
+ * Add IPv6 route to the FIB of the ip6_lookup_fib node.
+ *
+ * @param ip
+ *   IPv6 address of route to be added.
+ * @param depth
+ *   Depth of the rule to be added.
+ * @param next_hop
+ *   Next hop id of the rule result to be added.
+ * @param next_node
+ *   Next node to redirect traffic to.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_fib_route_add(const struct rte_ipv6_addr *ip, uint8_t depth,
+			       uint16_t next_hop, enum rte_node_ip6_lookup_next next_node);
+
+/**
+ * Delete IPv6 route from the FIB of the ip6_lookup_fib node.
+ *
+ * @param ip
+ *   IPv6 address of route to be deleted.
+ * @param depth
+ *   Depth of the rule to be deleted.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_fib_route_delete(const struct rte_ipv6_addr *ip, uint8_t depth);
+
+/**
+ * Free the FIB of the ip6_lookup_fib node on a socket, with its routes.
+ *
+ * The graphs using the node on this socket must be destroyed before.
+ *
+ * @param socket
+ *   Socket of the FIB created with rte_node_ip6_fib_create().
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ip6_fib_destroy(int socket);
+
 #ifdef __cplusplus
 }
 #endif
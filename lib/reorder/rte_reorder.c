@@ -59,6 +59,27 @@ struct __rte_cache_aligned rte_reorder_buffer {
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
+static int
+rte_reorder_seqn_dynfield_register(void)
+{
+	static const struct rte_mbuf_dynfield reorder_seqn_dynfield_desc = {
+		.name = RTE_REORDER_SEQN_DYNFIELD_NAME,
+		.size = sizeof(rte_reorder_seqn_t),
+		.align = alignof(rte_reorder_seqn_t),
+	};
+
+	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
+	if (rte_reorder_seqn_dynfield_offset < 0) {
+		REORDER_LOG(ERR,
+			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
+			rte_errno);
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	return 0;
+}
+
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size)
 {
@@ -70,11 +91,6 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 		const char *name, unsigned int size)
 {
 	const unsigned int min_bufsize = rte_reorder_memory_footprint_get(size);
-	static const struct rte_mbuf_dynfield reorder_seqn_dynfield_desc = {
-		.name = RTE_REORDER_SEQN_DYNFIELD_NAME,
-		.size = sizeof(rte_reorder_seqn_t),
-		.align = alignof(rte_reorder_seqn_t),
-	};
 
 	if (b == NULL) {
 		REORDER_LOG(ERR, "Invalid reorder buffer parameter:"
@@ -101,14 +117,8 @@ rte_reorder_init(struct rte_reorder_buffer *b, unsigned int bufsize,
 		return NULL;
 	}
 
-	rte_reorder_seqn_dynfield_offset = rte_mbuf_dynfield_register(&reorder_seqn_dynfield_desc);
-	if (rte_reorder_seqn_dynfield_offset < 0) {
-		REORDER_LOG(ERR,
-			"Failed to register mbuf field for reorder sequence number, rte_errno: %i",
-			rte_errno);
-		rte_errno = ENOMEM;
+	if (rte_reorder_seqn_dynfield_register() < 0)
 		return NULL;
-	}
 
 	memset(b, 0, bufsize);
 	strlcpy(b->name, name, sizeof(b->name));
@@ -553,3 +563,303 @@ rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_se
 
 	return 0;
 }
+
+/* Flow state flags */
+#define REORDER_FLOW_INIT	(1 << 0) /**< min_seqn is set */
+#define REORDER_FLOW_READY	(1 << 1) /**< flow is in the ready flow FIFO */
+
+/* Reorder state of a flow, its window is in the slot arena */
+struct reorder_flow {
+	uint32_t min_seqn;  /**< Sequence number of the head slot */
+	uint16_t head;      /**< Head slot index in the window */
+	uint16_t flags;
+};
+
+/* The multi-flow reorder context */
+struct __rte_cache_aligned rte_reorder_flows {
+	char name[RTE_REORDER_NAMESIZE];
+	uint32_t nb_flows;
+	uint32_t window;
+	uint32_t window_mask;
+	uint32_t window_shift; /**< log2(window) */
+
+	/* Flows whose head slot is filled, each flow is queued at most once */
+	uint32_t ready_flows_mask;
+	uint32_t ready_flows_head; /**< insertion point */
+	uint32_t ready_flows_tail; /**< extraction point */
+	uint32_t *ready_flows;
+
+	/* mbufs pushed out of their flow window, drained before the flows */
+	struct cir_buffer ready_buf;
+
+	struct reorder_flow *flows;
+	struct rte_mbuf **slots; /**< nb_flows windows of window entries */
+};
+
+struct rte_reorder_flows *
+rte_reorder_flows_create(const struct rte_reorder_flows_param *prm)
+{
+	struct rte_reorder_flows *rf;
+	uint32_t ready_flows_size, ready_size;
+	size_t flows_off, ready_flows_off, ready_buf_off, slots_off, size;
+
+	if (prm == NULL || prm->name == NULL) {
+		REORDER_LOG(ERR, "Invalid reorder flows parameter: NULL");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (prm->nb_flows == 0 || prm->nb_flows >= RTE_BIT32(31)) {
+		REORDER_LOG(ERR, "Invalid reorder flows number: %u",
+				prm->nb_flows);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (!rte_is_power_of_2(prm->window) ||
+			prm->window > RTE_REORDER_FLOWS_WINDOW_MAX) {
+		REORDER_LOG(ERR, "Invalid reorder flows window: %u", prm->window);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	if (prm->ready_size >= RTE_BIT32(31) ||
+			(uint64_t)prm->nb_flows * prm->window >
+			SIZE_MAX / sizeof(struct rte_mbuf *)) {
+		REORDER_LOG(ERR, "Invalid reorder flows size");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (rte_reorder_seqn_dynfield_register() < 0)
+		return NULL;
+
+	/* one entry is kept empty to tell a full buffer from an empty one */
+	ready_flows_size = rte_align32pow2(prm->nb_flows + 1);
+	ready_size = prm->ready_size != 0 ? prm->ready_size : 4 * prm->window;
+	ready_size = rte_align32pow2(ready_size + 1);
+
+	flows_off = RTE_ALIGN_CEIL(sizeof(*rf), RTE_CACHE_LINE_SIZE);
+	ready_flows_off = flows_off + RTE_ALIGN_CEIL(
+			sizeof(struct reorder_flow) * prm->nb_flows,
+			RTE_CACHE_LINE_SIZE);
+	ready_buf_off = ready_flows_off + RTE_ALIGN_CEIL(
+			sizeof(uint32_t) * ready_flows_size, RTE_CACHE_LINE_SIZE);
+	slots_off = ready_buf_off + RTE_ALIGN_CEIL(
+			sizeof(struct rte_mbuf *) * ready_size, RTE_CACHE_LINE_SIZE);
+	size = slots_off +
+		sizeof(struct rte_mbuf *) * prm->nb_flows * prm->window;
+
+	rf = rte_zmalloc_socket("REORDER_FLOWS", size, RTE_CACHE_LINE_SIZE,
+			prm->socket_id);
+	if (rf == NULL) {
+		REORDER_LOG(ERR, "Failed to allocate reorder flows %s",
+				prm->name);
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	strlcpy(rf->name, prm->name, sizeof(rf->name));
+	rf->nb_flows = prm->nb_flows;
+	rf->window = prm->window;
+	rf->window_mask = prm->window - 1;
+	rf->window_shift = rte_ctz32(prm->window);
+	rf->ready_flows_mask = ready_flows_size - 1;
+	rf->ready_flows = RTE_PTR_ADD(rf, ready_flows_off);
+	rf->ready_buf.size = ready_size;
+	rf->ready_buf.mask = ready_size - 1;
+	rf->ready_buf.entries = RTE_PTR_ADD(rf, ready_buf_off);
+	rf->flows = RTE_PTR_ADD(rf, flows_off);
+	rf->slots = RTE_PTR_ADD(rf, slots_off);
+
+	return rf;
+}
+
+void
+rte_reorder_flows_reset(struct rte_reorder_flows *rf)
+{
+	struct cir_buffer *ready_buf = &rf->ready_buf;
+	uint64_t i, nb_slots;
+
+	nb_slots = (uint64_t)rf->nb_flows << rf->window_shift;
+	for (i = 0; i < nb_slots; i++) {
+		rte_pktmbuf_free(rf->slots[i]);
+		rf->slots[i] = NULL;
+	}
+
+	for (; ready_buf->tail != ready_buf->head;
+			ready_buf->tail = (ready_buf->tail + 1) & ready_buf->mask)
+		rte_pktmbuf_free(ready_buf->entries[ready_buf->tail]);
+	ready_buf->head = ready_buf->tail = 0;
+
+	memset(rf->flows, 0, sizeof(*rf->flows) * rf->nb_flows);
+	rf->ready_flows_head = rf->ready_flows_tail = 0;
+}
+
+void
+rte_reorder_flows_free(struct rte_reorder_flows *rf)
+{
+	if (rf == NULL)
+		return;
+
+	rte_reorder_flows_reset(rf);
+	rte_free(rf);
+}
+
+static inline struct rte_mbuf **
+reorder_flow_window(const struct rte_reorder_flows *rf, uint32_t flow_id)
+{
+	return &rf->slots[(size_t)flow_id << rf->window_shift];
+}
+
+static inline void
+reorder_flow_queue(struct rte_reorder_flows *rf, struct reorder_flow *fl,
+		uint32_t flow_id)
+{
+	if (fl->flags & REORDER_FLOW_READY)
+		return;
+
+	fl->flags |= REORDER_FLOW_READY;
+	rf->ready_flows[rf->ready_flows_head] = flow_id;
+	rf->ready_flows_head = (rf->ready_flows_head + 1) & rf->ready_flows_mask;
+}
+
+/*
+ * Insert an mbuf in its flow window.
+ * Return 0 on success, -1 if the mbuf is left to the caller.
+ */
+static inline int
+reorder_flow_insert(struct rte_reorder_flows *rf, struct rte_mbuf *mbuf,
+		uint32_t flow_id)
+{
+	struct cir_buffer *ready_buf = &rf->ready_buf;
+	struct reorder_flow *fl;
+	struct rte_mbuf **win;
+	uint32_t seqn, offset, skip, free_cnt, pos;
+
+	if (unlikely(flow_id >= rf->nb_flows))
+		return -1;
+
+	fl = &rf->flows[flow_id];
+	win = reorder_flow_window(rf, flow_id);
+	seqn = *rte_reorder_seqn(mbuf);
+
+	if (unlikely(!(fl->flags & REORDER_FLOW_INIT))) {
+		fl->min_seqn = seqn;
+		fl->flags |= REORDER_FLOW_INIT;
+	}
+
+	/* the subtraction takes care of the sequence number wrapping */
+	offset = seqn - fl->min_seqn;
+
+	if (unlikely(offset >= rf->window)) {
+		/* too late, or vastly out of the window */
+		if (offset >= 2 * rf->window)
+			return -1;
+
+		/*
+		 * Push the oldest entries out of the window, skipping the
+		 * missing ones, to make room for this sequence number.
+		 */
+		skip = offset + 1 - rf->window;
+		free_cnt = (ready_buf->tail - ready_buf->head - 1) &
+			ready_buf->mask;
+		if (free_cnt < skip)
+			return -1;
+
+		for (; skip != 0; skip--) {
+			if (win[fl->head] != NULL) {
+				ready_buf->entries[ready_buf->head] =
+					win[fl->head];
+				ready_buf->head = (ready_buf->head + 1) &
+					ready_buf->mask;
+				win[fl->head] = NULL;
+			}
+			fl->head = (fl->head + 1) & rf->window_mask;
+			fl->min_seqn++;
+		}
+		offset = rf->window - 1;
+	}
+
+	pos = (fl->head + offset) & rf->window_mask;
+	if (unlikely(win[pos] != NULL))
+		return -1;
+	win[pos] = mbuf;
+
+	if (win[fl->head] != NULL)
+		reorder_flow_queue(rf, fl, flow_id);
+
+	return 0;
+}
+
+#define REORDER_FLOWS_PREFETCH_OFFSET 4
+
+uint16_t
+rte_reorder_flows_insert_burst(struct rte_reorder_flows *rf,
+		struct rte_mbuf **mbufs, const uint32_t *flow_ids,
+		uint16_t nb_mbufs)
+{
+	uint32_t flow_id;
+	uint16_t i, nb_left = 0;
+
+	/* Start fetching the flow states of the burst */
+	for (i = 0; i < RTE_MIN(nb_mbufs, REORDER_FLOWS_PREFETCH_OFFSET); i++) {
+		flow_id = flow_ids != NULL ? flow_ids[i] : mbufs[i]->hash.usr;
+		if (likely(flow_id < rf->nb_flows))
+			rte_prefetch0(&rf->flows[flow_id]);
+	}
+
+	for (i = 0; i < nb_mbufs; i++) {
+		if (i + REORDER_FLOWS_PREFETCH_OFFSET < nb_mbufs) {
+			flow_id = flow_ids != NULL ?
+				flow_ids[i + REORDER_FLOWS_PREFETCH_OFFSET] :
+				mbufs[i + REORDER_FLOWS_PREFETCH_OFFSET]->hash.usr;
+			if (likely(flow_id < rf->nb_flows))
+				rte_prefetch0(&rf->flows[flow_id]);
+		}
+
+		flow_id = flow_ids != NULL ? flow_ids[i] : mbufs[i]->hash.usr;
+		if (unlikely(reorder_flow_insert(rf, mbufs[i], flow_id) < 0))
+			mbufs[nb_left++] = mbufs[i];
+	}
+
+	return nb_left;
+}
+
+unsigned int
+rte_reorder_flows_drain_burst(struct rte_reorder_flows *rf,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs)
+{
+	struct cir_buffer *ready_buf = &rf->ready_buf;
+	struct reorder_flow *fl;
+	struct rte_mbuf **win;
+	unsigned int drain_cnt = 0;
+	uint32_t flow_id;
+
+	/* Pushed out mbufs come first, they precede what is in the windows */
+	while (drain_cnt < max_mbufs && ready_buf->tail != ready_buf->head) {
+		mbufs[drain_cnt++] = ready_buf->entries[ready_buf->tail];
+		ready_buf->tail = (ready_buf->tail + 1) & ready_buf->mask;
+	}
+
+	while (drain_cnt < max_mbufs &&
+			rf->ready_flows_tail != rf->ready_flows_head) {
+		flow_id = rf->ready_flows[rf->ready_flows_tail];
+		fl = &rf->flows[flow_id];
+		win = reorder_flow_window(rf, flow_id);
+
+		while (drain_cnt < max_mbufs && win[fl->head] != NULL) {
+			mbufs[drain_cnt++] = win[fl->head];
+			win[fl->head] = NULL;
+			fl->head = (fl->head + 1) & rf->window_mask;
+			fl->min_seqn++;
+		}
+
+		/* keep the flow queued if the array is full */
+		if (win[fl->head] != NULL)
+			break;
+
+		fl->flags &= ~REORDER_FLOW_READY;
+		rf->ready_flows_tail = (rf->ready_flows_tail + 1) &
+			rf->ready_flows_mask;
+	}
+
+	return drain_cnt;
+}
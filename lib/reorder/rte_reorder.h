@@ -231,6 +231,149 @@ __rte_experimental
 unsigned int
 rte_reorder_memory_footprint_get(unsigned int size);
 
+/** Maximum per-flow window of a multi-flow reorder context. */
+#define RTE_REORDER_FLOWS_WINDOW_MAX 32768
+
+struct rte_reorder_flows;
+
+/**
+ * Multi-flow reorder context creation parameters.
+ */
+struct rte_reorder_flows_param {
+	/** name of the context, used for memory allocation */
+	const char *name;
+	/** NUMA node of the context memory, or SOCKET_ID_ANY */
+	int socket_id;
+	/** number of flows, flow ids are in the [0, nb_flows) range */
+	uint32_t nb_flows;
+	/**
+	 * Number of sequence numbers which can be reordered in each flow,
+	 * must be a power of 2 and not greater than
+	 * RTE_REORDER_FLOWS_WINDOW_MAX.
+	 */
+	uint32_t window;
+	/**
+	 * Number of mbufs which can wait to be drained after being pushed
+	 * out of their flow window by a later sequence number,
+	 * 0 for 4 times the window.
+	 */
+	uint32_t ready_size;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a multi-flow reorder context, and the mbufs it holds.
+ *
+ * @param rf
+ *   Multi-flow reorder context. If NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_reorder_flows_free(struct rte_reorder_flows *rf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a multi-flow reorder context.
+ *
+ * The context restores the order of mbufs in many independent sequence
+ * spaces (flows) at once, for example after a distributor or an event
+ * device spread the packets of each flow over several workers.
+ * Each flow has a reorder window whose entries are allocated in a single
+ * array, and only the flows with in-order mbufs are visited on drain.
+ *
+ * As with rte_reorder_insert(), the first mbuf inserted in a flow sets
+ * the lowest sequence number of that flow, and an mbuf whose sequence
+ * number is beyond the flow window pushes the oldest mbufs of the window
+ * out, skipping the missing ones.
+ *
+ * The context is not thread safe.
+ *
+ * @param prm
+ *   Creation parameters.
+ * @return
+ *   The context, or NULL on error with rte_errno set:
+ *    - EINVAL - invalid parameters
+ *    - ENOMEM - not enough memory
+ */
+__rte_experimental
+struct rte_reorder_flows *
+rte_reorder_flows_create(const struct rte_reorder_flows_param *prm)
+	__rte_malloc __rte_dealloc(rte_reorder_flows_free, 1);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free the mbufs held by a multi-flow reorder context,
+ * and forget the sequence numbers of all its flows.
+ *
+ * @param rf
+ *   Multi-flow reorder context.
+ */
+__rte_experimental
+void
+rte_reorder_flows_reset(struct rte_reorder_flows *rf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Insert a burst of mbufs in their flow windows.
+ *
+ * The sequence number of each mbuf is read with rte_reorder_seqn().
+ * The mbufs which cannot be inserted are left at the beginning of the
+ * mbufs array, in their original order, and are still owned by the caller:
+ *  - the flow id is out of range,
+ *  - the sequence number is too late or too far ahead of the flow window,
+ *  - the sequence number is already in the flow window,
+ *  - there is no room to push the oldest mbufs out of the flow window,
+ *    which is solved by draining the context.
+ *
+ * @param rf
+ *   Multi-flow reorder context.
+ * @param mbufs
+ *   Array of mbufs to insert.
+ * @param flow_ids
+ *   Flow id of each mbuf, or NULL to use the mbuf hash.usr field.
+ * @param nb_mbufs
+ *   Number of mbufs in the array.
+ * @return
+ *   Number of mbufs which were not inserted.
+ */
+__rte_experimental
+uint16_t
+rte_reorder_flows_insert_burst(struct rte_reorder_flows *rf,
+		struct rte_mbuf **mbufs, const uint32_t *flow_ids,
+		uint16_t nb_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Fetch in-order mbufs from all the flows of a multi-flow reorder context.
+ *
+ * The mbufs of a flow are returned in sequence number order, with gaps
+ * only where mbufs were pushed out of the flow window. The mbufs of
+ * different flows are interleaved.
+ *
+ * @param rf
+ *   Multi-flow reorder context.
+ * @param mbufs
+ *   Array where the mbufs are written.
+ * @param max_mbufs
+ *   Size of the array.
+ * @return
+ *   Number of mbufs written to the array.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_flows_drain_burst(struct rte_reorder_flows *rf,
+		struct rte_mbuf **mbufs, unsigned int max_mbufs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,8 @@ soring_dump_stage_headtail(FILE *f, const char *prefix,
 	fprintf(f, "%stail.pos=%"PRIu32"\n", prefix, st->sht.tail.pos);
 	fprintf(f, "%stail.sync=%"PRIu32"\n", prefix, st->sht.tail.sync);
 	fprintf(f, "%shead=%"PRIu32"\n", prefix, st->sht.head);
+	fprintf(f, "%sslice=%"PRIu32"\n", prefix, st->slice);
+	fprintf(f, "%snb_thread=%"PRIu32"\n", prefix, st->nb_thread);
 }
 
 void
@@ -96,6 +98,7 @@ rte_soring_dump(FILE *f, const struct rte_soring *r)
 {
 	uint32_t i;
 	char buf[32];
+	struct rte_soring_stage_stats stats;
 
 	if (f == NULL || r == NULL)
 		return;
@@ -115,9 +118,86 @@ rte_soring_dump(FILE *f, const struct rte_soring *r)
 	for (i = 0; i < r->nb_stage; i++) {
 		snprintf(buf, sizeof(buf), "  stage[%u].", i);
 		soring_dump_stage_headtail(f, buf, r->stage + i);
+		if (rte_soring_stage_stats_get(r, i, &stats) == 0) {
+			fprintf(f, "%swaiting=%"PRIu32"\n", buf, stats.waiting);
+			fprintf(f, "%sinflight=%"PRIu32"\n", buf, stats.inflight);
+		}
 	}
 }
 
+int
+rte_soring_stage_slice_set(struct rte_soring *r, uint32_t stage,
+	uint32_t slice)
+{
+	if (r == NULL || stage >= r->nb_stage || slice > r->capacity)
+		return -EINVAL;
+
+	r->stage[stage].slice = slice;
+	return 0;
+}
+
+int
+rte_soring_stage_join(struct rte_soring *r, uint32_t stage)
+{
+	if (r == NULL || stage >= r->nb_stage)
+		return -EINVAL;
+
+	rte_atomic_fetch_add_explicit(&r->stage[stage].nb_thread, 1,
+			rte_memory_order_relaxed);
+	return 0;
+}
+
+int
+rte_soring_stage_leave(struct rte_soring *r, uint32_t stage)
+{
+	uint32_t n;
+
+	if (r == NULL || stage >= r->nb_stage)
+		return -EINVAL;
+
+	n = rte_atomic_load_explicit(&r->stage[stage].nb_thread,
+			rte_memory_order_relaxed);
+	do {
+		if (n == 0)
+			return -ENOENT;
+	} while (rte_atomic_compare_exchange_weak_explicit(
+			&r->stage[stage].nb_thread, &n, n - 1,
+			rte_memory_order_relaxed, rte_memory_order_relaxed) == 0);
+
+	return 0;
+}
+
+int
+rte_soring_stage_stats_get(const struct rte_soring *r, uint32_t stage,
+	struct rte_soring_stage_stats *stats)
+{
+	uint32_t head, prev, tail;
+	const struct soring_stage *stg;
+
+	if (r == NULL || stage >= r->nb_stage || stats == NULL)
+		return -EINVAL;
+
+	stg = r->stage + stage;
+
+	/* the values are sampled one by one, the result is approximate */
+	tail = rte_atomic_load_explicit(&stg->sht.tail.pos,
+			rte_memory_order_relaxed);
+	head = rte_atomic_load_explicit(&stg->sht.head,
+			rte_memory_order_relaxed);
+	if (stage == 0)
+		prev = rte_atomic_load_explicit(&r->prod.ht.tail,
+				rte_memory_order_relaxed);
+	else
+		prev = rte_atomic_load_explicit(&stg[-1].sht.tail.pos,
+				rte_memory_order_relaxed);
+
+	stats->nb_thread = rte_atomic_load_explicit(&stg->nb_thread,
+			rte_memory_order_relaxed);
+	stats->waiting = RTE_MIN(prev - head, r->capacity);
+	stats->inflight = RTE_MIN(head - tail, r->capacity);
+	return 0;
+}
+
 ssize_t
 rte_soring_get_memsize(const struct rte_soring_param *prm)
 {
@@ -65,6 +65,16 @@ struct rte_soring_param {
 	enum rte_ring_sync_type cons_synt;
 };
 
+/** soring stage occupancy, see rte_soring_stage_stats_get() */
+struct rte_soring_stage_stats {
+	/** number of threads that joined the stage */
+	uint32_t nb_thread;
+	/** number of elems ready for the stage, not acquired yet */
+	uint32_t waiting;
+	/** number of elems acquired by the stage, not available to next yet */
+	uint32_t inflight;
+};
+
 struct rte_soring;
 
 /**
@@ -541,6 +551,164 @@ uint32_t
 rte_soring_acquirx_burst(struct rte_soring *r, void *objs, void *meta,
 	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire a slice of objects from the soring for given stage.
+ * Works as @ref rte_soring_acquire_burst(), but when several threads
+ * joined the stage (see @ref rte_soring_stage_join()), acquires at most
+ * the available objects divided by the number of threads, rounded up
+ * to a multiple of the stage slice size (see @ref rte_soring_stage_slice_set()).
+ * That way the work of the stage is spread over its threads in slices.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param objs
+ *   A pointer to an array of objects to acquire.
+ *   Size of objects must be the same value as 'elem_size' parameter
+ *   used while creating the soring. Otherwise the results are undefined.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The maximum number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   release().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquire_slice(struct rte_soring *r, void *objs,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire a slice of objects plus metadata from the soring for given stage.
+ * Works as @ref rte_soring_acquirx_burst(), with the same limit as
+ * @ref rte_soring_acquire_slice().
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param objs
+ *   A pointer to an array of objects to acquire.
+ *   Size of objects must be the same value as 'elem_size' parameter
+ *   used while creating the soring. Otherwise the results are undefined.
+ * @param meta
+ *   A pointer to an array of metadata values for each for each acquired object.
+ *   Note that if user not using object metadata values, then this parameter
+ *   can be NULL.
+ *   Size of elements in this array must be the same value as 'meta_size'
+ *   parameter used while creating the soring. If user created the soring with
+ *   'meta_size' value equals zero, then 'meta' parameter should be NULL.
+ *   Otherwise the results are undefined.
+ * @param stage
+ *   Stage to acquire objects for.
+ * @param num
+ *   The maximum number of objects to acquire.
+ * @param ftoken
+ *   Pointer to the opaque 'token' value used by release() op.
+ *   User has to store this value somewhere, and later provide to the
+ *   release().
+ * @param available
+ *   If non-NULL, returns the number of remaining soring entries for given stage
+ *   after the acquire has finished.
+ * @return
+ *   - Actual number of objects acquired.
+ */
+__rte_experimental
+uint32_t
+rte_soring_acquirx_slice(struct rte_soring *r, void *objs, void *meta,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the slice size of given stage.
+ * The number of objects returned by @ref rte_soring_acquire_slice() for
+ * this stage is rounded up to a multiple of the slice size, unless fewer
+ * objects are available.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param stage
+ *   Stage to configure.
+ * @param slice
+ *   Slice size, 0 to not round the number of objects.
+ * @return
+ *   - 0 on success, or a negative error code.
+ */
+__rte_experimental
+int
+rte_soring_stage_slice_set(struct rte_soring *r, uint32_t stage,
+	uint32_t slice);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Account one more thread serving given stage.
+ * Threads can join and leave a stage at any time, the work of the stage is
+ * shared by @ref rte_soring_acquire_slice() between the current threads.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param stage
+ *   Stage the thread serves.
+ * @return
+ *   - 0 on success, or a negative error code.
+ */
+__rte_experimental
+int
+rte_soring_stage_join(struct rte_soring *r, uint32_t stage);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Account one thread less serving given stage.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param stage
+ *   Stage the thread stops serving.
+ * @return
+ *   - 0 on success, or a negative error code.
+ */
+__rte_experimental
+int
+rte_soring_stage_leave(struct rte_soring *r, uint32_t stage);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the occupancy of given stage.
+ * The values are sampled without stopping the threads using the soring,
+ * so they are only a snapshot.
+ *
+ * @param r
+ *   A pointer to the soring structure.
+ * @param stage
+ *   Stage to get statistics for.
+ * @param stats
+ *   A pointer to the structure filled with the stage statistics.
+ * @return
+ *   - 0 on success, or a negative error code.
+ */
+__rte_experimental
+int
+rte_soring_stage_stats_get(const struct rte_soring *r, uint32_t stage,
+	struct rte_soring_stage_stats *stats);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
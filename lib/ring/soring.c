@@ -55,6 +55,15 @@
  * even from consumer's 'dequeue()' - in case given stage is the last one.
  * So 'finalize()' has to be MT-safe and inside it we have to
  * guarantee that only one thread will update state[] and stage's tail values.
+ *
+ * Sliced acquire:
+ * ===============
+ * 'acquire_slice()' works as 'acquire_burst()', except that the number
+ * of elems grabbed at once is limited to a fair share of the elems
+ * available for the stage: available elems divided by the number of threads
+ * serving the stage, rounded up to a multiple of the stage slice size.
+ * That way, when several threads serve the same stage, the first one
+ * doesn't take all the work while others stay idle.
  */
 
 #include "soring.h"
@@ -215,10 +224,21 @@ __rte_soring_update_tail(struct __rte_ring_headtail *rht,
 	}
 }
 
+static __rte_always_inline uint32_t
+__rte_soring_stage_share(uint32_t avail, uint32_t slice, uint32_t nb_thread)
+{
+	uint32_t n;
+
+	n = (avail + nb_thread - 1) / nb_thread;
+	if (slice > 1)
+		n = RTE_ALIGN_CEIL(n, slice);
+	return n;
+}
+
 static __rte_always_inline uint32_t
 __rte_soring_stage_move_head(struct soring_stage_headtail *d,
 	const struct rte_ring_headtail *s, uint32_t capacity, uint32_t num,
-	enum rte_ring_queue_behavior behavior,
+	enum rte_ring_queue_behavior behavior, uint32_t slice, uint32_t nb_thread,
 	uint32_t *old_head, uint32_t *new_head, uint32_t *avail)
 {
 	uint32_t n, tail;
@@ -235,6 +255,10 @@ __rte_soring_stage_move_head(struct soring_stage_headtail *d,
 		tail = rte_atomic_load_explicit(&s->tail,
 				rte_memory_order_acquire);
 		*avail = capacity + tail - *old_head;
+		/* leave the rest of the elems to the other threads */
+		if (nb_thread > 1)
+			n = RTE_MIN(n, __rte_soring_stage_share(*avail, slice,
+				nb_thread));
 		if (n > *avail)
 			n = (behavior == RTE_RING_QUEUE_FIXED) ? 0 : *avail;
 		if (n == 0)
@@ -378,9 +402,9 @@ acquire_state_update(const struct rte_soring *r, uint32_t stage, uint32_t idx,
 static __rte_always_inline uint32_t
 soring_acquire(struct rte_soring *r, void *objs, void *meta,
 	uint32_t stage, uint32_t num, enum rte_ring_queue_behavior behavior,
-	uint32_t *ftoken, uint32_t *available)
+	bool sliced, uint32_t *ftoken, uint32_t *available)
 {
-	uint32_t avail, head, idx, n, next, reqn;
+	uint32_t avail, head, idx, n, next, reqn, slice, nb_thread;
 	struct soring_stage *pstg;
 	struct soring_stage_headtail *cons;
 
@@ -389,15 +413,24 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 
 	cons = &r->stage[stage].sht;
 
+	slice = 0;
+	nb_thread = 0;
+	if (sliced) {
+		slice = r->stage[stage].slice;
+		nb_thread = rte_atomic_load_explicit(&r->stage[stage].nb_thread,
+				rte_memory_order_relaxed);
+	}
+
 	if (stage == 0)
 		n = __rte_soring_stage_move_head(cons, &r->prod.ht, 0, num,
-			behavior, &head, &next, &avail);
+			behavior, slice, nb_thread, &head, &next, &avail);
 	else {
 		pstg = r->stage + stage - 1;
 
 		/* try to grab exactly @num elems */
 		n = __rte_soring_stage_move_head(cons, &pstg->ht, 0, num,
-			RTE_RING_QUEUE_FIXED, &head, &next, &avail);
+			RTE_RING_QUEUE_FIXED, slice, nb_thread, &head, &next,
+			&avail);
 		if (n == 0) {
 			/* try to finalize some elems from previous stage */
 			n = __rte_soring_stage_finalize(&pstg->sht, stage - 1,
@@ -408,8 +441,8 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 			reqn = (behavior == RTE_RING_QUEUE_FIXED) ? num : 0;
 			if (avail >= reqn)
 				n = __rte_soring_stage_move_head(cons,
-					&pstg->ht, 0, num, behavior, &head,
-					&next, &avail);
+					&pstg->ht, 0, num, behavior, slice,
+					nb_thread, &head, &next, &avail);
 			else
 				n = 0;
 		}
@@ -573,7 +606,7 @@ rte_soring_acquire_bulk(struct rte_soring *r, void *objs,
 	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
 {
 	return soring_acquire(r, objs, NULL, stage, num,
-			RTE_RING_QUEUE_FIXED, ftoken, available);
+			RTE_RING_QUEUE_FIXED, false, ftoken, available);
 }
 
 uint32_t
@@ -581,7 +614,7 @@ rte_soring_acquirx_bulk(struct rte_soring *r, void *objs, void *meta,
 	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
 {
 	return soring_acquire(r, objs, meta, stage, num,
-			RTE_RING_QUEUE_FIXED, ftoken, available);
+			RTE_RING_QUEUE_FIXED, false, ftoken, available);
 }
 
 uint32_t
@@ -589,7 +622,7 @@ rte_soring_acquire_burst(struct rte_soring *r, void *objs,
 	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
 {
 	return soring_acquire(r, objs, NULL, stage, num,
-			RTE_RING_QUEUE_VARIABLE, ftoken, available);
+			RTE_RING_QUEUE_VARIABLE, false, ftoken, available);
 }
 
 uint32_t
@@ -597,7 +630,23 @@ rte_soring_acquirx_burst(struct rte_soring *r, void *objs, void *meta,
 	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
 {
 	return soring_acquire(r, objs, meta, stage, num,
-			RTE_RING_QUEUE_VARIABLE, ftoken, available);
+			RTE_RING_QUEUE_VARIABLE, false, ftoken, available);
+}
+
+uint32_t
+rte_soring_acquire_slice(struct rte_soring *r, void *objs,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire(r, objs, NULL, stage, num,
+			RTE_RING_QUEUE_VARIABLE, true, ftoken, available);
+}
+
+uint32_t
+rte_soring_acquirx_slice(struct rte_soring *r, void *objs, void *meta,
+	uint32_t stage, uint32_t num, uint32_t *ftoken, uint32_t *available)
+{
+	return soring_acquire(r, objs, meta, stage, num,
+			RTE_RING_QUEUE_VARIABLE, true, ftoken, available);
 }
 
 unsigned int
@@ -91,6 +91,11 @@ struct soring_stage {
 		struct soring_stage_headtail sht;
 	};
 
+	/** Sliced acquire returns a multiple of it, 0 for any number */
+	uint32_t slice;
+	/** Number of threads sharing the stage work, used by sliced acquire */
+	RTE_ATOMIC(uint32_t) nb_thread;
+
 	RTE_CACHE_GUARD;
 };
 
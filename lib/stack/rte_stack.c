@@ -30,7 +30,7 @@ rte_stack_init(struct rte_stack *s, unsigned int count, uint32_t flags)
 	memset(s, 0, sizeof(*s));
 
 	if (flags & RTE_STACK_F_LF)
-		rte_stack_lf_init(s, count);
+		rte_stack_lf_init(s, count, flags);
 	else
 		rte_stack_std_init(s);
 }
@@ -39,7 +39,7 @@ static ssize_t
 rte_stack_get_memsize(unsigned int count, uint32_t flags)
 {
 	if (flags & RTE_STACK_F_LF)
-		return rte_stack_lf_get_memsize(count);
+		return rte_stack_lf_get_memsize(count, flags);
 	else
 		return rte_stack_std_get_memsize(count);
 }
@@ -56,11 +56,17 @@ rte_stack_create(const char *name, unsigned int count, int socket_id,
 	unsigned int sz;
 	int ret;
 
-	if (flags & ~(RTE_STACK_F_LF)) {
+	if (flags & ~(RTE_STACK_F_LF | RTE_STACK_F_LF_ELIM)) {
 		STACK_LOG_ERR("Unsupported stack flags %#x", flags);
 		return NULL;
 	}
 
+	if ((flags & RTE_STACK_F_LF_ELIM) && !(flags & RTE_STACK_F_LF)) {
+		STACK_LOG_ERR("Elimination requires a lock-free stack");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
 #ifdef RTE_ARCH_64
 	RTE_BUILD_BUG_ON(sizeof(struct rte_stack_lf_head) != 16);
 #endif
@@ -21,6 +21,7 @@
 #include <rte_errno.h>
 #include <rte_memzone.h>
 #include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 
 #define RTE_TAILQ_STACK_NAME "RTE_STACK"
 #define RTE_STACK_MZ_PREFIX "STK_"
@@ -57,6 +58,27 @@ struct rte_stack_lf {
 	alignas(RTE_CACHE_LINE_SIZE) struct rte_stack_lf_elem elems[];
 };
 
+/** Number of elimination slots of a lock-free stack. */
+#define RTE_STACK_LF_ELIM_SLOTS 8
+
+/* Elimination slot, holding a push offer waiting for a pop of the same size.
+ */
+struct rte_stack_lf_elim_slot {
+	/** Offer pointer or offer state */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uintptr_t) val;
+};
+
+/* Elimination array of a lock-free stack, located after the LIFO elements.
+ * Concurrent push and pop of the same size exchange their objects through a
+ * slot, without touching the LIFO lists.
+ */
+struct rte_stack_lf_elim {
+	/** Set when the used list head is contended */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint32_t) contended;
+	/** Elimination slots */
+	struct rte_stack_lf_elim_slot slot[RTE_STACK_LF_ELIM_SLOTS];
+};
+
 /* Structure containing the LIFO, its current length, and a lock for mutual
  * exclusion.
  */
@@ -88,6 +110,13 @@ struct __rte_cache_aligned rte_stack {
  */
 #define RTE_STACK_F_LF 0x0001
 
+/**
+ * The lock-free stack pairs concurrent push and pop operations of the same
+ * size through an elimination array when its head is contended. This flag
+ * requires RTE_STACK_F_LF.
+ */
+#define RTE_STACK_F_LF_ELIM 0x0002
+
 #include "rte_stack_std.h"
 #include "rte_stack_lf.h"
 
@@ -197,6 +226,9 @@ rte_stack_free_count(struct rte_stack *s)
  *    - RTE_STACK_F_LF: If this flag is set, the stack uses lock-free
  *      variants of the push and pop functions. Otherwise, it achieves
  *      thread-safety using a lock.
+ *    - RTE_STACK_F_LF_ELIM: If this flag is set along with RTE_STACK_F_LF,
+ *      concurrent push and pop of the same size are paired through an
+ *      elimination array when the stack is contended.
  * @return
  *   On success, the pointer to the new allocated stack. NULL on error with
  *    rte_errno set appropriately. Possible errno values include:
@@ -205,6 +237,7 @@ rte_stack_free_count(struct rte_stack *s)
  *    - ENOMEM - insufficient memory to create the stack
  *    - ENAMETOOLONG - name size exceeds RTE_STACK_NAMESIZE
  *    - ENOTSUP - platform does not support given flags combination.
+ *    - EINVAL - invalid flags combination.
  */
 struct rte_stack *
 rte_stack_create(const char *name, unsigned int count, int socket_id,
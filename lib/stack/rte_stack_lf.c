@@ -2,10 +2,12 @@
  * Copyright(c) 2019 Intel Corporation
  */
 
+#include <string.h>
+
 #include "rte_stack.h"
 
 void
-rte_stack_lf_init(struct rte_stack *s, unsigned int count)
+rte_stack_lf_init(struct rte_stack *s, unsigned int count, uint32_t flags)
 {
 	struct rte_stack_lf_elem *elems = s->stack_lf.elems;
 	unsigned int i;
@@ -13,10 +15,14 @@ rte_stack_lf_init(struct rte_stack *s, unsigned int count)
 	for (i = 0; i < count; i++)
 		__rte_stack_lf_push_elems(&s->stack_lf.free,
 					  &elems[i], &elems[i], 1);
+
+	if (flags & RTE_STACK_F_LF_ELIM)
+		memset(__rte_stack_lf_elim_get(s, count), 0,
+		       sizeof(struct rte_stack_lf_elim));
 }
 
 ssize_t
-rte_stack_lf_get_memsize(unsigned int count)
+rte_stack_lf_get_memsize(unsigned int count, uint32_t flags)
 {
 	ssize_t sz = sizeof(struct rte_stack);
 
@@ -27,5 +33,8 @@ rte_stack_lf_get_memsize(unsigned int count)
 	 */
 	sz += 2 * RTE_CACHE_LINE_SIZE;
 
+	if (flags & RTE_STACK_F_LF_ELIM)
+		sz += sizeof(struct rte_stack_lf_elim);
+
 	return sz;
 }
@@ -20,6 +20,174 @@
 #define RTE_STACK_LF_SUPPORTED
 #endif
 
+#include <rte_lcore.h>
+#include <rte_pause.h>
+
+/* Elimination slot states, any other value is a push offer. */
+#define RTE_STACK_LF_ELIM_FREE 0 /**< Slot is free. */
+#define RTE_STACK_LF_ELIM_BUSY 1 /**< A pop is copying the offer. */
+#define RTE_STACK_LF_ELIM_DONE 2 /**< A pop took the offer. */
+
+/** Number of polls of an offer before it is withdrawn. */
+#define RTE_STACK_LF_ELIM_SPINS 64
+
+/* Push offer, owned by the pushing thread. */
+struct rte_stack_lf_elim_offer {
+	void * const *objs; /**< Objects to push */
+	unsigned int n; /**< Number of objects */
+};
+
+/**
+ * @internal Return the elimination array of a lock-free stack.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param count
+ *   The size of the stack.
+ * @return
+ *   A pointer to the elimination array.
+ */
+static __rte_always_inline struct rte_stack_lf_elim *
+__rte_stack_lf_elim_get(struct rte_stack *s, unsigned int count)
+{
+	return (struct rte_stack_lf_elim *)RTE_PTR_ALIGN_CEIL(
+			&s->stack_lf.elems[count], RTE_CACHE_LINE_SIZE);
+}
+
+/**
+ * @internal Offer several objects to a concurrent pop of the same size.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to push.
+ * @return
+ *   *n* if a pop took the objects, 0 otherwise.
+ */
+static __rte_always_inline unsigned int
+__rte_stack_lf_elim_push(struct rte_stack *s,
+			 void * const *obj_table,
+			 unsigned int n)
+{
+	struct rte_stack_lf_elim *elim = __rte_stack_lf_elim_get(s, s->capacity);
+	struct rte_stack_lf_elim_offer offer = { .objs = obj_table, .n = n };
+	RTE_ATOMIC(uintptr_t) *slot;
+	uintptr_t val = RTE_STACK_LF_ELIM_FREE;
+	unsigned int i;
+
+	slot = &elim->slot[rte_lcore_id() & (RTE_STACK_LF_ELIM_SLOTS - 1)].val;
+
+	/* The offer is visible to the pop before the slot update */
+	if (!rte_atomic_compare_exchange_strong_explicit(slot, &val,
+			(uintptr_t)&offer, rte_memory_order_release,
+			rte_memory_order_relaxed))
+		return 0;
+
+	for (i = 0; i < RTE_STACK_LF_ELIM_SPINS; i++) {
+		if (rte_atomic_load_explicit(slot, rte_memory_order_acquire) ==
+				RTE_STACK_LF_ELIM_DONE)
+			goto done;
+		rte_pause();
+	}
+
+	/* Withdraw the offer, unless a pop is copying it */
+	while (1) {
+		val = (uintptr_t)&offer;
+		if (rte_atomic_compare_exchange_strong_explicit(slot, &val,
+				RTE_STACK_LF_ELIM_FREE, rte_memory_order_acquire,
+				rte_memory_order_acquire)) {
+			/* No pop around, go back to the list */
+			rte_atomic_store_explicit(&elim->contended, 0,
+						  rte_memory_order_relaxed);
+			return 0;
+		}
+		if (val == RTE_STACK_LF_ELIM_DONE)
+			break;
+		rte_pause();
+	}
+
+done:
+	rte_atomic_store_explicit(slot, RTE_STACK_LF_ELIM_FREE,
+				  rte_memory_order_relaxed);
+	return n;
+}
+
+/**
+ * @internal Take several objects offered by a concurrent push.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to pop.
+ * @return
+ *   *n* if a push of the same size was found, 0 otherwise.
+ */
+static __rte_always_inline unsigned int
+__rte_stack_lf_elim_pop(struct rte_stack *s, void **obj_table, unsigned int n)
+{
+	struct rte_stack_lf_elim *elim = __rte_stack_lf_elim_get(s, s->capacity);
+	const struct rte_stack_lf_elim_offer *offer;
+	RTE_ATOMIC(uintptr_t) *slot;
+	unsigned int i, j, first;
+	uintptr_t val;
+
+	first = rte_lcore_id();
+
+	for (i = 0; i < RTE_STACK_LF_ELIM_SLOTS; i++) {
+		slot = &elim->slot[(first + i) & (RTE_STACK_LF_ELIM_SLOTS - 1)].val;
+
+		val = rte_atomic_load_explicit(slot, rte_memory_order_relaxed);
+		if (val <= RTE_STACK_LF_ELIM_DONE)
+			continue;
+
+		/* The push waits for the copy once the slot is busy */
+		if (!rte_atomic_compare_exchange_strong_explicit(slot, &val,
+				RTE_STACK_LF_ELIM_BUSY, rte_memory_order_acquire,
+				rte_memory_order_relaxed))
+			continue;
+
+		offer = (const struct rte_stack_lf_elim_offer *)val;
+		if (offer->n != n) {
+			rte_atomic_store_explicit(slot, val,
+						  rte_memory_order_release);
+			continue;
+		}
+
+		/* The last pushed object is on top */
+		for (j = 0; j < n; j++)
+			obj_table[j] = offer->objs[n - j - 1];
+
+		rte_atomic_store_explicit(slot, RTE_STACK_LF_ELIM_DONE,
+					  rte_memory_order_release);
+		return n;
+	}
+
+	return 0;
+}
+
+/**
+ * @internal Check if the elimination array is worth trying.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @return
+ *   Non-zero if the stack has an elimination array and is contended.
+ */
+static __rte_always_inline int
+__rte_stack_lf_elim_contended(struct rte_stack *s)
+{
+	if (!(s->flags & RTE_STACK_F_LF_ELIM))
+		return 0;
+
+	return rte_atomic_load_explicit(
+			&__rte_stack_lf_elim_get(s, s->capacity)->contended,
+			rte_memory_order_relaxed);
+}
+
 /**
  * @internal Push several objects on the lock-free stack (MT-safe).
  *
@@ -38,11 +206,17 @@ __rte_stack_lf_push(struct rte_stack *s,
 		    unsigned int n)
 {
 	struct rte_stack_lf_elem *tmp, *first, *last = NULL;
+	struct rte_stack_lf_elim *elim;
 	unsigned int i;
 
 	if (unlikely(n == 0))
 		return 0;
 
+	/* Pair with a concurrent pop, without touching the lists */
+	if (__rte_stack_lf_elim_contended(s) &&
+			__rte_stack_lf_elim_push(s, obj_table, n) != 0)
+		return n;
+
 	/* Pop n free elements */
 	first = __rte_stack_lf_pop_elems(&s->stack_lf.free, n, NULL, &last);
 	if (unlikely(first == NULL))
@@ -53,7 +227,14 @@ __rte_stack_lf_push(struct rte_stack *s,
 		tmp->data = obj_table[n - i - 1];
 
 	/* Push them to the used list */
-	__rte_stack_lf_push_elems(&s->stack_lf.used, first, last, n);
+	if (__rte_stack_lf_push_elems(&s->stack_lf.used, first, last, n) != 0 &&
+			(s->flags & RTE_STACK_F_LF_ELIM)) {
+		elim = __rte_stack_lf_elim_get(s, s->capacity);
+		if (!rte_atomic_load_explicit(&elim->contended,
+					      rte_memory_order_relaxed))
+			rte_atomic_store_explicit(&elim->contended, 1,
+						  rte_memory_order_relaxed);
+	}
 
 	return n;
 }
@@ -78,6 +259,11 @@ __rte_stack_lf_pop(struct rte_stack *s, void **obj_table, unsigned int n)
 	if (unlikely(n == 0))
 		return 0;
 
+	/* Pair with a concurrent push, without touching the lists */
+	if (__rte_stack_lf_elim_contended(s) &&
+			__rte_stack_lf_elim_pop(s, obj_table, n) != 0)
+		return n;
+
 	/* Pop n used elements */
 	first = __rte_stack_lf_pop_elems(&s->stack_lf.used,
 					 n, obj_table, &last);
@@ -97,19 +283,23 @@ __rte_stack_lf_pop(struct rte_stack *s, void **obj_table, unsigned int n)
  *   A pointer to the stack structure.
  * @param count
  *   The size of the stack.
+ * @param flags
+ *   The flags supplied at creation.
  */
 void
-rte_stack_lf_init(struct rte_stack *s, unsigned int count);
+rte_stack_lf_init(struct rte_stack *s, unsigned int count, uint32_t flags);
 
 /**
  * @internal Return the memory required for a lock-free stack.
  *
  * @param count
  *   The size of the stack.
+ * @param flags
+ *   The flags supplied at creation.
  * @return
  *   The bytes to allocate for a lock-free stack.
  */
 ssize_t
-rte_stack_lf_get_memsize(unsigned int count);
+rte_stack_lf_get_memsize(unsigned int count, uint32_t flags);
 
 #endif /* _RTE_STACK_LF_H_ */
@@ -57,13 +57,14 @@ __rte_stack_lf_count(struct rte_stack *s)
 					     rte_memory_order_relaxed);
 }
 
-static __rte_always_inline void
+static __rte_always_inline unsigned int
 __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 			  struct rte_stack_lf_elem *first,
 			  struct rte_stack_lf_elem *last,
 			  unsigned int num)
 {
 	struct rte_stack_lf_head old_head;
+	unsigned int retries = 0;
 	int success;
 
 	old_head = list->head;
@@ -88,12 +89,15 @@ __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 				(rte_int128_t *)&new_head,
 				1, rte_memory_order_release,
 				rte_memory_order_relaxed);
+		retries += !success;
 	} while (success == 0);
 
 	/* Ensure the stack modifications are not reordered with respect
 	 * to the LIFO len update.
 	 */
 	rte_atomic_fetch_add_explicit(&list->len, num, rte_memory_order_release);
+
+	return retries;
 }
 
 static __rte_always_inline struct rte_stack_lf_elem *
@@ -30,13 +30,14 @@ __rte_stack_lf_count(struct rte_stack *s)
 	return rte_atomic_load_explicit(&s->stack_lf.used.len, rte_memory_order_seq_cst);
 }
 
-static __rte_always_inline void
+static __rte_always_inline unsigned int
 __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 			  struct rte_stack_lf_elem *first,
 			  struct rte_stack_lf_elem *last,
 			  unsigned int num)
 {
 	struct rte_stack_lf_head old_head;
+	unsigned int retries = 0;
 	int success;
 
 	old_head = list->head;
@@ -66,9 +67,12 @@ __rte_stack_lf_push_elems(struct rte_stack_lf_list *list,
 				(rte_int128_t *)&new_head,
 				1, rte_memory_order_release,
 				rte_memory_order_relaxed);
+		retries += !success;
 	} while (success == 0);
 	/* NOTE: review for potential ordering optimization */
 	rte_atomic_fetch_add_explicit(&list->len, num, rte_memory_order_seq_cst);
+
+	return retries;
 }
 
 static __rte_always_inline struct rte_stack_lf_elem *
@@ -0,0 +1,225 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2025 The DPDK contributors
+ */
+
+#ifndef _RTE_STACK_ZC_H_
+#define _RTE_STACK_ZC_H_
+
+/**
+ * @file
+ * RTE Stack Zero Copy APIs
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * These APIs split the push and pop operations of a lock-free stack into:
+ * - push/pop start, which reserves linked list elements of the stack
+ * - read/write of the objects directly in the list elements
+ * - push/pop finish, which publishes the elements
+ * This avoids copying the objects to and from a temporary table.
+ *
+ * The elements of a reservation are walked from the first one, which is
+ * (or will be) the top of the stack, with RTE_STACK_ZC_FOREACH().
+ * Other threads can push and pop between _start_ and _finish_.
+ *
+ * These APIs are available for stacks created with RTE_STACK_F_LF only,
+ * they return 0 for other stacks.
+ *
+ * Example:
+ *
+ * struct rte_stack_zc_data zcd;
+ * struct rte_stack_lf_elem *e;
+ * unsigned int i;
+ *
+ * n = rte_stack_pop_zc_start(s, 32, &zcd);
+ * RTE_STACK_ZC_FOREACH(&zcd, e, i)
+ *	process(e->data);
+ * rte_stack_pop_zc_finish(s, &zcd);
+ */
+
+#include <rte_compat.h>
+#include <rte_stack.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Stack zero-copy information structure.
+ *
+ * This structure contains the linked list elements reserved on the stack.
+ */
+struct rte_stack_zc_data {
+	struct rte_stack_lf_elem *first; /**< First element, top of the stack */
+	struct rte_stack_lf_elem *last;  /**< Last element */
+	unsigned int n;                  /**< Number of elements */
+};
+
+/**
+ * Iterate over the elements of a zero-copy reservation.
+ *
+ * @param zcd
+ *   A pointer to the zero-copy information structure.
+ * @param e
+ *   A struct rte_stack_lf_elem pointer, set to each element.
+ * @param i
+ *   An unsigned int counter.
+ */
+#define RTE_STACK_ZC_FOREACH(zcd, e, i) \
+	for ((e) = (zcd)->first, (i) = 0; (i) < (zcd)->n; (i)++, (e) = (e)->next)
+
+/**
+ * Start to push several objects on the stack (MT-safe).
+ *
+ * Reserve *n* free elements of the stack. The user has to write the
+ * objects to the data pointer of the elements, then call
+ * rte_stack_push_zc_finish().
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param n
+ *   The number of objects to push.
+ * @param zcd
+ *   Structure filled with the reserved elements.
+ * @return
+ *   Actual number of elements reserved (either 0 or *n*).
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_stack_push_zc_start(struct rte_stack *s, unsigned int n,
+			struct rte_stack_zc_data *zcd)
+{
+	RTE_ASSERT(s != NULL);
+	RTE_ASSERT(zcd != NULL);
+
+	zcd->n = 0;
+
+	if (unlikely(n == 0 || !(s->flags & RTE_STACK_F_LF)))
+		return 0;
+
+	zcd->last = NULL;
+	zcd->first = __rte_stack_lf_pop_elems(&s->stack_lf.free, n, NULL,
+					      &zcd->last);
+	if (unlikely(zcd->first == NULL))
+		return 0;
+
+	zcd->n = n;
+
+	return n;
+}
+
+/**
+ * Finish to push objects on the stack (MT-safe).
+ *
+ * Push the first *n* elements of the reservation, the others are released.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param zcd
+ *   Structure filled by rte_stack_push_zc_start().
+ * @param n
+ *   The number of elements written, at most the number reserved.
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_stack_push_zc_finish(struct rte_stack *s, struct rte_stack_zc_data *zcd,
+			 unsigned int n)
+{
+	struct rte_stack_lf_elem *last;
+	unsigned int i;
+
+	RTE_ASSERT(n <= zcd->n);
+
+	if (unlikely(zcd->n == 0))
+		return;
+
+	if (unlikely(n == 0)) {
+		__rte_stack_lf_push_elems(&s->stack_lf.free, zcd->first,
+					  zcd->last, zcd->n);
+		zcd->n = 0;
+		return;
+	}
+
+	if (unlikely(n != zcd->n)) {
+		/* Release the elements not written */
+		last = zcd->first;
+		for (i = 1; i < n; i++)
+			last = last->next;
+		__rte_stack_lf_push_elems(&s->stack_lf.free, last->next,
+					  zcd->last, zcd->n - n);
+		zcd->last = last;
+	}
+
+	__rte_stack_lf_push_elems(&s->stack_lf.used, zcd->first, zcd->last, n);
+	zcd->n = 0;
+}
+
+/**
+ * Start to pop several objects from the stack (MT-safe).
+ *
+ * Reserve the *n* top elements of the stack. The user can read the
+ * objects from the data pointer of the elements, then has to call
+ * rte_stack_pop_zc_finish().
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param n
+ *   The number of objects to pop.
+ * @param zcd
+ *   Structure filled with the reserved elements.
+ * @return
+ *   Actual number of elements reserved (either 0 or *n*).
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_stack_pop_zc_start(struct rte_stack *s, unsigned int n,
+		       struct rte_stack_zc_data *zcd)
+{
+	RTE_ASSERT(s != NULL);
+	RTE_ASSERT(zcd != NULL);
+
+	zcd->n = 0;
+
+	if (unlikely(n == 0 || !(s->flags & RTE_STACK_F_LF)))
+		return 0;
+
+	zcd->last = NULL;
+	zcd->first = __rte_stack_lf_pop_elems(&s->stack_lf.used, n, NULL,
+					      &zcd->last);
+	if (unlikely(zcd->first == NULL))
+		return 0;
+
+	zcd->n = n;
+
+	return n;
+}
+
+/**
+ * Finish to pop objects from the stack (MT-safe).
+ *
+ * Release the elements of the reservation, their data pointers must not be
+ * accessed anymore.
+ *
+ * @param s
+ *   A pointer to the stack structure.
+ * @param zcd
+ *   Structure filled by rte_stack_pop_zc_start().
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_stack_pop_zc_finish(struct rte_stack *s, struct rte_stack_zc_data *zcd)
+{
+	if (unlikely(zcd->n == 0))
+		return;
+
+	__rte_stack_lf_push_elems(&s->stack_lf.free, zcd->first, zcd->last,
+				  zcd->n);
+	zcd->n = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_STACK_ZC_H_ */
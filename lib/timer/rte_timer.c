@@ -8,9 +8,11 @@
 #include <inttypes.h>
 #include <assert.h>
 
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_eal_memconfig.h>
+#include <rte_malloc.h>
 #include <rte_memory.h>
 #include <rte_lcore.h>
 #include <rte_branch_prediction.h>
@@ -46,9 +48,44 @@ struct __rte_cache_aligned priv_timer {
 #endif
 };
 
+/* Timing wheel geometry: 4 levels of 256 slots cover 2^32 ticks. */
+#define WHEEL_LEVELS		4
+#define WHEEL_SLOT_BITS		8
+#define WHEEL_SLOTS		(1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK		(WHEEL_SLOTS - 1)
+#define WHEEL_RANGE		(UINT64_C(1) << (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+#define WHEEL_DEFAULT_TICK_US	10
+
+/**
+ * Per-lcore hierarchical timing wheel.
+ *
+ * A slot of level n covers WHEEL_SLOTS^n ticks. A timer is linked in the
+ * lowest level whose range covers its expiry tick, and is moved down
+ * (cascaded) when the level below wraps around, so that expired timers
+ * are only ever taken from level 0. It is protected by the list_lock of
+ * the lcore.
+ */
+struct __rte_cache_aligned timer_wheel {
+	/** start time of cur_tick, no pending timer expires before it */
+	uint64_t next_time;
+	/** next tick to process */
+	uint64_t cur_tick;
+	/** number of timers linked in the wheel */
+	uint32_t nb_pending;
+	/** level 0 slots which may be non-empty */
+	uint64_t map[WHEEL_SLOTS / 64];
+	/** slot list heads */
+	struct rte_timer *slots[WHEEL_LEVELS][WHEEL_SLOTS];
+};
+
 #define FL_ALLOCATED	(1 << 0)
+#define FL_WHEEL	(1 << 1)
 struct rte_timer_data {
 	struct priv_timer priv_timer[RTE_MAX_LCORE];
+	/** per-lcore timing wheels, if FL_WHEEL is set */
+	struct timer_wheel *wheels;
+	/** timing wheel tick, in timer cycles */
+	uint64_t wheel_tick;
 	uint8_t internal_flags;
 };
 
@@ -116,6 +153,64 @@ rte_timer_data_dealloc(uint32_t id)
 
 	timer_data->internal_flags &= ~(FL_ALLOCATED);
 
+	if (timer_data->internal_flags & FL_WHEEL) {
+		rte_free(timer_data->wheels);
+		timer_data->wheels = NULL;
+		timer_data->internal_flags &= ~(FL_WHEEL);
+	}
+
+	return 0;
+}
+
+int
+rte_timer_data_alloc_conf(uint32_t *id_ptr,
+			  const struct rte_timer_data_conf *conf)
+{
+	struct rte_timer_data *data;
+	struct timer_wheel *wheels;
+	uint64_t wheel_tick, cur_tick;
+	uint32_t id;
+	int i, ret;
+
+	if (conf == NULL || conf->backend == RTE_TIMER_BACKEND_SKIPLIST)
+		return rte_timer_data_alloc(id_ptr);
+
+	if (conf->backend != RTE_TIMER_BACKEND_WHEEL)
+		return -EINVAL;
+
+	if (!rte_timer_subsystem_initialized)
+		return -ENOMEM;
+
+	wheel_tick = conf->wheel_tick;
+	if (wheel_tick == 0)
+		wheel_tick = RTE_MAX(rte_get_timer_hz() /
+				(US_PER_S / WHEEL_DEFAULT_TICK_US), UINT64_C(1));
+
+	wheels = rte_zmalloc("timer_wheels", sizeof(*wheels) * RTE_MAX_LCORE,
+			RTE_CACHE_LINE_SIZE);
+	if (wheels == NULL)
+		return -ENOMEM;
+
+	cur_tick = rte_get_timer_cycles() / wheel_tick;
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		wheels[i].cur_tick = cur_tick;
+		wheels[i].next_time = cur_tick * wheel_tick;
+	}
+
+	ret = rte_timer_data_alloc(&id);
+	if (ret < 0) {
+		rte_free(wheels);
+		return ret;
+	}
+
+	data = &rte_timer_data_arr[id];
+	data->wheels = wheels;
+	data->wheel_tick = wheel_tick;
+	data->internal_flags |= FL_WHEEL;
+
+	if (id_ptr)
+		*id_ptr = id;
+
 	return 0;
 }
 
@@ -463,6 +558,266 @@ timer_del(struct rte_timer *tim, union rte_timer_status prev_status,
 		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
 }
 
+/* Return the wheel tick in which a timer expiring at time expire runs. */
+static inline uint64_t
+wheel_expire_tick(uint64_t expire, uint64_t wheel_tick)
+{
+	return expire / wheel_tick + (expire % wheel_tick != 0);
+}
+
+/*
+ * Return the first level 0 slot, starting from slot from, which may hold
+ * timers, or WHEEL_SLOTS if there is none before the level 0 wraps.
+ */
+static inline unsigned int
+wheel_next_slot(const struct timer_wheel *w, unsigned int from)
+{
+	unsigned int i = from / 64;
+	uint64_t bits;
+
+	if (from >= WHEEL_SLOTS)
+		return WHEEL_SLOTS;
+
+	bits = w->map[i] & (UINT64_MAX << (from % 64));
+	for (;;) {
+		if (bits != 0)
+			return i * 64 + rte_ctz64(bits);
+		if (++i == RTE_DIM(w->map))
+			return WHEEL_SLOTS;
+		bits = w->map[i];
+	}
+}
+
+/*
+ * Link a timer in the slot matching its expiry time.
+ * Timers already expired go in the current slot, timers beyond the range
+ * of the wheel are parked in its last slot and placed again on cascade.
+ */
+static void
+wheel_link(struct timer_wheel *w, struct rte_timer *tim, uint64_t wheel_tick)
+{
+	uint64_t tick, delta;
+	unsigned int level, idx;
+	struct rte_timer **head;
+
+	tick = wheel_expire_tick(tim->expire, wheel_tick);
+	if (tick < w->cur_tick)
+		tick = w->cur_tick;
+
+	delta = tick - w->cur_tick;
+	if (delta >= WHEEL_RANGE) {
+		delta = WHEEL_RANGE - 1;
+		tick = w->cur_tick + delta;
+	}
+
+	for (level = 0; level < WHEEL_LEVELS - 1; level++)
+		if (delta < (UINT64_C(1) << ((level + 1) * WHEEL_SLOT_BITS)))
+			break;
+
+	idx = (tick >> (level * WHEEL_SLOT_BITS)) & WHEEL_SLOT_MASK;
+	head = &w->slots[level][idx];
+
+	tim->wheel_next = *head;
+	if (*head != NULL)
+		(*head)->wheel_pprev = &tim->wheel_next;
+	tim->wheel_pprev = head;
+	*head = tim;
+
+	if (level == 0) {
+		w->map[idx / 64] |= UINT64_C(1) << (idx % 64);
+		/* NOTE: this is not atomic on 32-bit */
+		if (tick * wheel_tick < w->next_time)
+			w->next_time = tick * wheel_tick;
+	}
+}
+
+/*
+ * Set next_time to the start of the next level 0 slot which may hold
+ * timers, or of the next cascade.
+ */
+static inline void
+wheel_update_next_time(struct timer_wheel *w, uint64_t wheel_tick)
+{
+	unsigned int idx = w->cur_tick & WHEEL_SLOT_MASK;
+	unsigned int next = idx == 0 ? 0 : wheel_next_slot(w, idx);
+
+	/* NOTE: this is not atomic on 32-bit */
+	w->next_time = (w->cur_tick + next - idx) * wheel_tick;
+}
+
+/* Detach the timer list of a slot. */
+static inline struct rte_timer *
+wheel_detach(struct rte_timer **head)
+{
+	struct rte_timer *list = *head;
+
+	*head = NULL;
+	return list;
+}
+
+/*
+ * Move the timers of the upper level slots reached by cur_tick down the
+ * wheel. Must be called when the level 0 index of cur_tick is 0.
+ */
+static void
+wheel_cascade(struct timer_wheel *w, uint64_t wheel_tick)
+{
+	struct rte_timer *tim, *next_tim;
+	unsigned int level, idx;
+
+	for (level = 1; level < WHEEL_LEVELS; level++) {
+		idx = (w->cur_tick >> (level * WHEEL_SLOT_BITS)) &
+			WHEEL_SLOT_MASK;
+
+		for (tim = wheel_detach(&w->slots[level][idx]); tim != NULL;
+		     tim = next_tim) {
+			next_tim = tim->wheel_next;
+			wheel_link(w, tim, wheel_tick);
+		}
+
+		if (idx != 0)
+			break;
+	}
+}
+
+/* call with lock held as necessary
+ * add in wheel
+ * timer must be in config state
+ * timer must not be in a list
+ */
+static void
+wheel_add(struct rte_timer *tim, unsigned int tim_lcore,
+	  struct rte_timer_data *timer_data)
+{
+	struct timer_wheel *w = &timer_data->wheels[tim_lcore];
+	uint64_t now_tick;
+
+	/* an empty wheel is not processed, catch up with the current time */
+	if (w->nb_pending == 0) {
+		now_tick = rte_get_timer_cycles() / timer_data->wheel_tick;
+		if (w->cur_tick < now_tick)
+			w->cur_tick = now_tick;
+		wheel_update_next_time(w, timer_data->wheel_tick);
+	}
+
+	w->nb_pending++;
+	wheel_link(w, tim, timer_data->wheel_tick);
+}
+
+/*
+ * del from wheel, lock if needed
+ * timer must be in config state
+ * timer must be in a list, or detached by wheel_get_expired()
+ */
+static void
+wheel_del(struct rte_timer *tim, union rte_timer_status prev_status,
+	  int local_is_locked, struct rte_timer_data *timer_data)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int prev_owner = prev_status.owner;
+	struct priv_timer *priv_timer = timer_data->priv_timer;
+	struct timer_wheel *w = &timer_data->wheels[prev_owner];
+	struct rte_timer **pprev;
+	size_t idx;
+
+	/* if timer needs is pending another core, we need to lock the
+	 * list; if it is on local core, we need to lock if we are not
+	 * called from rte_timer_manage() */
+	if (prev_owner != lcore_id || !local_is_locked)
+		rte_spinlock_lock(&priv_timer[prev_owner].list_lock);
+
+	/* the timer may have been detached by an expiry on the owner core */
+	pprev = tim->wheel_pprev;
+	if (pprev != NULL) {
+		*pprev = tim->wheel_next;
+		if (tim->wheel_next != NULL)
+			tim->wheel_next->wheel_pprev = pprev;
+		tim->wheel_pprev = NULL;
+		w->nb_pending--;
+
+		/* clear the map bit of an emptied level 0 slot */
+		idx = ((uintptr_t)pprev - (uintptr_t)&w->slots[0][0]) /
+			sizeof(*pprev);
+		if (idx < WHEEL_SLOTS && w->slots[0][idx] == NULL)
+			w->map[idx / 64] &= ~(UINT64_C(1) << (idx % 64));
+	}
+
+	if (prev_owner != lcore_id || !local_is_locked)
+		rte_spinlock_unlock(&priv_timer[prev_owner].list_lock);
+}
+
+/*
+ * Take the expired timers out of the wheel of an lcore, and return them
+ * in expiry tick order as a list linked by sl_next[0], with their state
+ * transitioned from PENDING to RUNNING.
+ */
+static struct rte_timer *
+wheel_get_expired(struct rte_timer_data *timer_data, unsigned int lcore)
+{
+	struct priv_timer *privp = &timer_data->priv_timer[lcore];
+	struct timer_wheel *w = &timer_data->wheels[lcore];
+	uint64_t wheel_tick = timer_data->wheel_tick;
+	struct rte_timer *tim, *next_tim;
+	struct rte_timer *run_first_tim = NULL, **pprev = &run_first_tim;
+	unsigned int idx, next;
+	uint64_t cur_time, now_tick;
+
+	/* optimize for the case where per-cpu wheel is empty */
+	if (w->nb_pending == 0)
+		return NULL;
+	cur_time = rte_get_timer_cycles();
+
+#ifdef RTE_ARCH_64
+	/* on 64-bit the value cached in next_time is updated atomically,
+	 * so we can consult that for a quick check here outside the lock
+	 */
+	if (likely(w->next_time > cur_time))
+		return NULL;
+#endif
+
+	now_tick = cur_time / wheel_tick;
+
+	rte_spinlock_lock(&privp->list_lock);
+
+	while (w->nb_pending != 0 && w->cur_tick <= now_tick) {
+		idx = w->cur_tick & WHEEL_SLOT_MASK;
+		if (idx == 0)
+			wheel_cascade(w, wheel_tick);
+
+		if (w->map[idx / 64] & (UINT64_C(1) << (idx % 64))) {
+			w->map[idx / 64] &= ~(UINT64_C(1) << (idx % 64));
+
+			/* transition the slot from PENDING to RUNNING */
+			for (tim = wheel_detach(&w->slots[0][idx]);
+			     tim != NULL; tim = next_tim) {
+				next_tim = tim->wheel_next;
+				tim->wheel_pprev = NULL;
+				w->nb_pending--;
+
+				/* another core may be trying to re-config
+				 * this one, leave it out of the run list
+				 */
+				if (likely(timer_set_running_state(tim) == 0)) {
+					*pprev = tim;
+					pprev = &tim->sl_next[0];
+				}
+			}
+		}
+
+		/* skip the empty slots, up to the level 0 wrap */
+		next = wheel_next_slot(w, idx + 1);
+		w->cur_tick = RTE_MIN(w->cur_tick + next - idx, now_tick + 1);
+	}
+	*pprev = NULL;
+
+	/* update the next to expire slot time */
+	wheel_update_next_time(w, wheel_tick);
+
+	rte_spinlock_unlock(&privp->list_lock);
+
+	return run_first_tim;
+}
+
 /* Reset and start the timer associated with the timer handle (private func) */
 static int
 __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
@@ -504,7 +859,12 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, local_is_locked, priv_timer);
+		if (timer_data->internal_flags & FL_WHEEL)
+			wheel_del(tim, prev_status, local_is_locked,
+				  timer_data);
+		else
+			timer_del(tim, prev_status, local_is_locked,
+				  priv_timer);
 		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
@@ -521,7 +881,10 @@ __rte_timer_reset(struct rte_timer *tim, uint64_t expire,
 		rte_spinlock_lock(&priv_timer[tim_lcore].list_lock);
 
 	__TIMER_STAT_ADD(priv_timer, pending, 1);
-	timer_add(tim, tim_lcore, priv_timer);
+	if (timer_data->internal_flags & FL_WHEEL)
+		wheel_add(tim, tim_lcore, timer_data);
+	else
+		timer_add(tim, tim_lcore, priv_timer);
 
 	/* update state: as we are in CONFIG state, only us can modify
 	 * the state so we don't need to use cmpset() here */
@@ -602,7 +965,10 @@ __rte_timer_stop(struct rte_timer *tim,
 
 	/* remove it from list */
 	if (prev_status.state == RTE_TIMER_PENDING) {
-		timer_del(tim, prev_status, 0, priv_timer);
+		if (timer_data->internal_flags & FL_WHEEL)
+			wheel_del(tim, prev_status, 0, timer_data);
+		else
+			timer_del(tim, prev_status, 0, priv_timer);
 		__TIMER_STAT_ADD(priv_timer, pending, -1);
 	}
 
@@ -824,6 +1190,13 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 		poll_lcore = poll_lcores[i];
 		privp = &data->priv_timer[poll_lcore];
 
+		if (data->internal_flags & FL_WHEEL) {
+			tim = wheel_get_expired(data, poll_lcore);
+			if (tim != NULL)
+				run_first_tims[nb_runlists++] = tim;
+			continue;
+		}
+
 		/* optimize for the case where per-cpu list is empty */
 		if (privp->pending_head.sl_next[0] == NULL)
 			continue;
@@ -969,6 +1342,30 @@ rte_timer_alt_manage(uint32_t timer_data_id,
 	return 0;
 }
 
+/* Walk the slots of a timing wheel, stopping timers */
+static void
+wheel_stop_all(struct rte_timer_data *timer_data, unsigned int walk_lcore,
+	       rte_timer_stop_all_cb_t f, void *f_arg)
+{
+	struct timer_wheel *w = &timer_data->wheels[walk_lcore];
+	struct rte_timer *tim, *next_tim;
+	unsigned int level, idx;
+
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		for (idx = 0; idx < WHEEL_SLOTS; idx++) {
+			for (tim = w->slots[level][idx]; tim != NULL;
+			     tim = next_tim) {
+				next_tim = tim->wheel_next;
+
+				__rte_timer_stop(tim, timer_data);
+
+				if (f)
+					f(tim, f_arg);
+			}
+		}
+	}
+}
+
 /* Walk pending lists, stopping timers and calling user-specified function */
 int
 rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
@@ -987,6 +1384,11 @@ rte_timer_stop_all(uint32_t timer_data_id, unsigned int *walk_lcores,
 		walk_lcore = walk_lcores[i];
 		priv_timer = &timer_data->priv_timer[walk_lcore];
 
+		if (timer_data->internal_flags & FL_WHEEL) {
+			wheel_stop_all(timer_data, walk_lcore, f, f_arg);
+			continue;
+		}
+
 		for (tim = priv_timer->pending_head.sl_next[0];
 		     tim != NULL;
 		     tim = next_tim) {
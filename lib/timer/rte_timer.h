@@ -38,6 +38,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_spinlock.h>
 
 #ifdef __cplusplus
@@ -98,7 +99,15 @@ typedef void (*rte_timer_cb_t)(struct rte_timer *, void *);
 struct rte_timer
 {
 	uint64_t expire;       /**< Time when timer expire. */
-	struct rte_timer *sl_next[MAX_SKIPLIST_DEPTH];
+	union {
+		/** Skiplist linkage. */
+		struct rte_timer *sl_next[MAX_SKIPLIST_DEPTH];
+		/** Timing wheel linkage, see RTE_TIMER_BACKEND_WHEEL. */
+		struct {
+			struct rte_timer *wheel_next;
+			struct rte_timer **wheel_pprev;
+		};
+	};
 	volatile union rte_timer_status status; /**< Status of timer. */
 	uint64_t period;       /**< Period of timer (0 if not periodic). */
 	rte_timer_cb_t f;      /**< Callback function. */
@@ -156,6 +165,62 @@ int rte_timer_data_alloc(uint32_t *id_ptr);
  */
 int rte_timer_data_dealloc(uint32_t id);
 
+/**
+ * Data structure keeping the pending timers of a timer data instance.
+ */
+enum rte_timer_backend {
+	/**
+	 * Per-lcore skiplist sorted by expiry time, O(log n) arm and cancel.
+	 * Timers of an lcore are run in expiry time order.
+	 */
+	RTE_TIMER_BACKEND_SKIPLIST = 0,
+	/**
+	 * Per-lcore hierarchical timing wheel, O(1) arm and cancel.
+	 * Expiry times are rounded up to the wheel tick, timers expiring
+	 * in the same tick are run in no particular order.
+	 */
+	RTE_TIMER_BACKEND_WHEEL,
+};
+
+/**
+ * Timer data instance configuration.
+ */
+struct rte_timer_data_conf {
+	enum rte_timer_backend backend; /**< Pending timers data structure. */
+	/**
+	 * Timing wheel tick in timer cycles (see rte_get_timer_hz()),
+	 * 0 for the default of 10 microseconds. Unused by the skiplist.
+	 */
+	uint64_t wheel_tick;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a timer data instance in shared memory to track a set of pending
+ * timer lists, using the data structure selected in the configuration.
+ *
+ * The timing wheel backend suits large numbers of timers which are
+ * frequently armed and cancelled, at the cost of tick resolution.
+ * Its memory is freed by rte_timer_data_dealloc().
+ *
+ * @param id_ptr
+ *   Pointer to variable into which to write the identifier of the allocated
+ *   timer data instance.
+ * @param conf
+ *   Timer data configuration, NULL is the same as rte_timer_data_alloc().
+ *
+ * @return
+ *   - 0: Success
+ *   - -EINVAL: invalid configuration
+ *   - -ENOSPC: maximum number of timer data instances already allocated
+ *   - -ENOMEM: unable to allocate the timing wheel
+ */
+__rte_experimental
+int rte_timer_data_alloc_conf(uint32_t *id_ptr,
+		const struct rte_timer_data_conf *conf);
+
 /**
  * Initialize the timer library.
  *